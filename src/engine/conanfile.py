@@ -121,11 +121,12 @@ class Engine(ConanFile):
         if self.settings.os == "Linux":
             self.requires("gperftools/2.15")
             self.requires("libunwind/1.8.1")
-        self.requires("reflect-cpp/0.16.0")
+        self.requires("reflect-cpp/0.16.0", options={"with_msgpack": True})
         # TODO Downgrade xgboost to 1.7.6 because of changes in 2.0.0
         self.requires("xgboost/1.7.6")
         self.requires("range-v3/0.12.0")
         self.requires("gtest/1.15.0")
+        self.requires("benchmark/1.9.0")
 
     def generate(self):
         toolchain = CMakeToolchain(self, generator="Ninja")
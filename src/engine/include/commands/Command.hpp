@@ -25,6 +25,11 @@
 namespace commands {
 
 struct Command {
+  struct GetTraceOp {
+    rfl::Field<"type_", rfl::Literal<"get_trace">> type;
+    rfl::Field<"clear_", bool> clear;
+  };
+
   struct IsAliveOp {
     rfl::Field<"type_", rfl::Literal<"is_alive">> type;
   };
@@ -39,8 +44,8 @@ struct Command {
 
   using ReflectionType =
       std::variant<ColumnCommand, DatabaseCommand, DataFrameCommand,
-                   PipelineCommand, ProjectCommand, ViewCommand, IsAliveOp,
-                   MonitorURLOp, ShutdownOp>;
+                   PipelineCommand, ProjectCommand, ViewCommand, GetTraceOp,
+                   IsAliveOp, MonitorURLOp, ShutdownOp>;
 
   using InputVarType = typename rfl::json::Reader::InputVarType;
 
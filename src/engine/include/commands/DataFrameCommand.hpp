@@ -22,6 +22,7 @@
 #include <rfl/TaggedUnion.hpp>
 #include <rfl/json/Reader.hpp>
 
+#include <optional>
 #include <string>
 #include <variant>
 
@@ -373,6 +374,8 @@ struct DataFrameCommand {
     rfl::Field<"name_", std::string> name;
     rfl::Field<"fname_", std::string> fname;
     rfl::Field<"compression_", std::string> compression;
+    rfl::Field<"row_group_size_", std::optional<size_t>> row_group_size;
+    rfl::Field<"use_dictionary_", std::optional<bool>> use_dictionary;
   };
 
   using ReflectionType = rfl::TaggedUnion<
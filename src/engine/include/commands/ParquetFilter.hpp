@@ -0,0 +1,32 @@
+// Copyright 2024 Code17 GmbH
+//
+// This file is licensed under the Elastic License 2.0 (ELv2).
+// Refer to the LICENSE.txt file in the root of the repository
+// for details.
+//
+
+#ifndef COMMANDS_PARQUETFILTER_HPP_
+#define COMMANDS_PARQUETFILTER_HPP_
+
+#include "commands/Float.hpp"
+
+#include <rfl/Field.hpp>
+
+#include <optional>
+#include <string>
+
+namespace commands {
+
+/// A range filter on a numerical column that is applied while reading a
+/// parquet file. Only rows for which min_ <= value <= max_ are kept. Row
+/// groups whose statistics show that none of their rows can pass are not
+/// read at all.
+struct ParquetFilter {
+  rfl::Field<"column_", std::string> column;
+  rfl::Field<"min_", std::optional<Float>> min;
+  rfl::Field<"max_", std::optional<Float>> max;
+};
+
+}  // namespace commands
+
+#endif  // COMMANDS_PARQUETFILTER_HPP_
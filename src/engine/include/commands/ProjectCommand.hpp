@@ -10,6 +10,7 @@
 
 #include "commands/DataContainer.hpp"
 #include "commands/DataFrameOrView.hpp"
+#include "commands/ParquetFilter.hpp"
 #include "commands/Pipeline.hpp"
 #include "helpers/Saver.hpp"
 
@@ -73,6 +74,7 @@ struct ProjectCommand {
     rfl::Flatten<helpers::SchemaImpl> schema;
     rfl::Field<"append_", bool> append;
     rfl::Field<"fname_", std::string> fname;
+    rfl::Field<"filters_", std::optional<std::vector<ParquetFilter>>> filters;
   };
 
   /// The command to add a data frame from JSON.
@@ -155,6 +157,12 @@ struct ProjectCommand {
     rfl::Field<"name_", std::string> name;
   };
 
+  /// The command to report how much memory the engine uses.
+  struct MemoryUsageOp {
+    using Tag = rfl::Literal<"memory_usage">;
+    rfl::Field<"dummy_", std::optional<int>> dummy;
+  };
+
   /// The command to create a new pipeline.
   using PipelineOp = Pipeline;
 
@@ -196,8 +204,8 @@ struct ProjectCommand {
       AddDfFromParquetOp, AddDfFromQueryOp, AddDfFromViewOp, CopyPipelineOp,
       DeleteDataFrameOp, DeletePipelineOp, DeleteProjectOp, ListDfsOp,
       ListPipelinesOp, ListProjectsOp, LoadDataContainerOp, LoadDfOp,
-      LoadPipelineOp, PipelineOp, ProjectNameOp, SaveDataContainerOp, SaveDfOp,
-      SavePipelineOp, TempDirOp>;
+      LoadPipelineOp, MemoryUsageOp, PipelineOp, ProjectNameOp,
+      SaveDataContainerOp, SaveDfOp, SavePipelineOp, TempDirOp>;
 
   using InputVarType = typename rfl::json::Reader::InputVarType;
 
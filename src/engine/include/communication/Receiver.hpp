@@ -11,6 +11,7 @@
 #include "communication/Logger.hpp"
 #include "communication/ULong.hpp"
 #include "helpers/Endianness.hpp"
+#include "logging/Tracer.hpp"
 
 #include <Poco/Net/StreamSocket.h>
 #include <rfl/Ref.hpp>
@@ -92,6 +93,8 @@ void Receiver::recv(const ULong _size, Poco::Net::StreamSocket *_socket,
 
   assert_true(j == _size);
 
+  logging::Tracer::global().add_to_counter("socket.bytes_received", _size);
+
   // -------------------------------------------------------------------
   // Handle endianness issues, which only apply for numeric types.
   // The only non-numeric type we ever come across is char.
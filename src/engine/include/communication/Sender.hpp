@@ -14,6 +14,7 @@
 #include "containers/Column.hpp"
 #include "containers/NumericalFeatures.hpp"
 #include "helpers/Endianness.hpp"
+#include "logging/Tracer.hpp"
 
 #include <algorithm>
 #include <stdexcept>
@@ -124,6 +125,8 @@ void Sender::send(const ULong _size, const T* _data,
   }
 
   assert_true(j == _size);
+
+  logging::Tracer::global().add_to_counter("socket.bytes_sent", _size);
 }
 
 // ------------------------------------------------------------------------
@@ -15,6 +15,7 @@
 #include "helpers/NullChecker.hpp"
 #include "helpers/SubroleParser.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <fstream>
 #include <ranges>
@@ -61,6 +62,9 @@ class Column {
   static constexpr const char *STRING_COLUMN_VIEW = "StringColumnView";
   static constexpr const char *BOOLEAN_COLUMN_VIEW = "BooleanColumnView";
 
+  /// The maximum number of strings nbytes() looks at.
+  static constexpr size_t NBYTES_SAMPLE_SIZE = 10000;
+
  public:
   Column(const Variant _data_ptr) : data_ptr_(_data_ptr), name_(""), unit_("") {
     static_assert(std::is_arithmetic<T>::value ||
@@ -114,6 +118,10 @@ class Column {
   /// Returns a Column containing all rows for which _key is true.
   Column<T> where(const std::vector<bool> &_condition) const;
 
+  /// Returns a Column containing the rows in _selection, which must be
+  /// sorted row numbers.
+  Column<T> where(const std::vector<size_t> &_selection) const;
+
   /// Boundary-checked accessor to data
   template <class T2, typename IteratorType = iterator,
             typename std::enable_if<std::is_same<IteratorType, T *>::value,
@@ -217,16 +225,21 @@ class Column {
   /// Trivial getter
   const std::string &name() const { return name_; }
 
-  /// Returns number of bytes occupied by the data
+  /// Returns number of bytes occupied by the data. For in-memory string
+  /// columns with more than NBYTES_SAMPLE_SIZE rows, the length of the
+  /// strings is extrapolated from an evenly spaced sample, so we do not have
+  /// to walk every string.
   ULong nbytes() const {
     if constexpr (std::is_same<T, strings::String>()) {
-      ULong nbytes = nrows() * (sizeof(T) + 1);
-
-      for (size_t i = 0; i < nrows(); ++i) {
-        nbytes += static_cast<ULong>((*this)[i].size());
-      }
-
-      return nbytes;
+      const auto calc = [](auto &&_ptr) -> ULong {
+        using PtrType = std::decay_t<decltype(_ptr)>;
+        if constexpr (std::is_same<PtrType, MemmapPtr>()) {
+          return static_cast<ULong>(_ptr->nbytes());
+        } else {
+          return estimate_string_nbytes(*_ptr);
+        }
+      };
+      return std::visit(calc, data_ptr_);
     } else {
       return static_cast<ULong>(nrows()) * sizeof(T);
     }
@@ -356,6 +369,27 @@ class Column {
     return std::make_shared<InMemoryVector>(_nrows);
   }
 
+  /// Called by nbytes() for in-memory string columns.
+  static ULong estimate_string_nbytes(const InMemoryVector &_vec) {
+    const auto n = _vec.size();
+
+    const auto step = std::max(n / NBYTES_SAMPLE_SIZE, 1uz);
+
+    ULong num_chars = 0;
+
+    ULong num_sampled = 0;
+
+    for (size_t i = 0; i < n; i += step, ++num_sampled) {
+      num_chars += static_cast<ULong>(_vec[i].size());
+    }
+
+    if (num_sampled != 0) {
+      num_chars = num_chars * static_cast<ULong>(n) / num_sampled;
+    }
+
+    return static_cast<ULong>(n) * (sizeof(T) + 1) + num_chars;
+  }
+
   /// Called by load_big_endian(...).
   template <class StringType>
   void read_string_big_endian(StringType *_str, std::ifstream *_input) const {
@@ -671,29 +705,65 @@ Column<T> Column<T>::where(const std::vector<bool> &_condition) const {
         "Size of keys must be identical to number of rows!");
   }
 
-  const auto include = [&_condition](size_t _i) -> bool {
-    return _condition[_i];
+  auto selection = std::vector<size_t>();
+
+  selection.reserve(std::count(_condition.begin(), _condition.end(), true));
+
+  for (size_t i = 0; i < _condition.size(); ++i) {
+    if (_condition[i]) {
+      selection.push_back(i);
+    }
+  }
+
+  return where(selection);
+}
+
+// -----------------------------------------------------------------------------
+
+template <class T>
+Column<T> Column<T>::where(const std::vector<size_t> &_selection) const {
+  if (_selection.size() > 0 && _selection.back() >= nrows()) {
+    throw std::runtime_error("Selection out of range!");
+  }
+
+  const auto set_metadata = [this](Column<T> *_trimmed) {
+    _trimmed->set_name(name_);
+    _trimmed->set_subroles(subroles_);
+    _trimmed->set_unit(unit_);
   };
 
-  const auto get_val = [this](size_t _i) -> T { return (*this)[_i]; };
+  // Arithmetic columns are gathered directly through their data pointers,
+  // so we do not have to go through the variant for every single row.
+  if constexpr (std::is_same<iterator, T *>()) {
+    auto trimmed = Column<T>(pool(), _selection.size());
 
-  auto range = std::views::iota(0uz, nrows()) | std::views::filter(include) |
-               std::views::transform(get_val);
+    const auto *in = data();
 
-  const auto data_ptr = pool() ? Variant(std::make_shared<MemmapVector>(
-                                     pool(), range.begin(), range.end()))
-                               : Variant(std::make_shared<std::vector<T>>(
-                                     range | std::ranges::to<std::vector>()));
+    auto *out = trimmed.data();
 
-  Column<T> trimmed(data_ptr);
+    for (size_t i = 0; i < _selection.size(); ++i) {
+      out[i] = in[_selection[i]];
+    }
 
-  trimmed.set_name(name_);
+    set_metadata(&trimmed);
 
-  trimmed.set_subroles(subroles_);
+    return trimmed;
+  } else {
+    const auto get_val = [this](size_t _i) -> T { return (*this)[_i]; };
 
-  trimmed.set_unit(unit_);
+    auto range = _selection | std::views::transform(get_val);
 
-  return trimmed;
+    const auto data_ptr = pool() ? Variant(std::make_shared<MemmapVector>(
+                                       pool(), range.begin(), range.end()))
+                                 : Variant(std::make_shared<std::vector<T>>(
+                                       range | std::ranges::to<std::vector>()));
+
+    auto trimmed = Column<T>(data_ptr);
+
+    set_metadata(&trimmed);
+
+    return trimmed;
+  }
 }
 
 }  // namespace containers
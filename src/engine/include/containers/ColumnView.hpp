@@ -13,6 +13,7 @@
 #include "containers/ColumnViewIterator.hpp"
 #include "helpers/NullChecker.hpp"
 #include "helpers/SubroleParser.hpp"
+#include "multithreading/parallel_for.hpp"
 #include "strings/String.hpp"
 
 #include <arrow/api.h>
@@ -22,7 +23,9 @@
 #include <range/v3/view/take_while.hpp>
 #include <range/v3/view/transform.hpp>
 
+#include <algorithm>
 #include <format>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <ranges>
@@ -43,6 +46,15 @@ class ColumnView {
   typedef std::variant<size_t, UnknownSize> NRowsType;
   typedef std::function<std::optional<T>(size_t)> ValueFunc;
 
+  /// Writes the values of the rows [_begin, _end) into _out, which is
+  /// resized accordingly. Must only be called for rows that exist.
+  typedef std::function<void(size_t _begin, size_t _end, std::vector<T>* _out)>
+      BatchFunc;
+
+  /// The number of rows evaluated at once by the batch functions. Small
+  /// enough for the intermediate buffers to stay in the cache.
+  static constexpr size_t BATCH_SIZE = 16384;
+
   static constexpr UnknownSize NOT_KNOWABLE = true;
   static constexpr UnknownSize NROWS_INFINITE = false;
 
@@ -51,8 +63,10 @@ class ColumnView {
  public:
   ColumnView(const ValueFunc& _value_func, const NRowsType& _nrows,
              const std::vector<std::string>& _subroles = {},
-             const std::string& _unit = "")
-      : nrows_(_nrows),
+             const std::string& _unit = "",
+             const std::optional<BatchFunc>& _batch_func = std::nullopt)
+      : batch_func_(_batch_func),
+        nrows_(_nrows),
         subroles_(_subroles),
         unit_(_unit),
         value_func_(_value_func) {
@@ -140,6 +154,11 @@ class ColumnView {
   /// Accessor to data
   std::optional<T> operator[](const size_t _i) const { return value_func_(_i); }
 
+  /// Trivial getter. The batch function only exists if the entire expression
+  /// can be evaluated batch-wise, which requires the number of rows to be
+  /// known or infinite and the expression to be free of state.
+  const std::optional<BatchFunc>& batch_func() const { return batch_func_; }
+
   /// Trivial getter
   NRowsType nrows() const { return nrows_; }
 
@@ -177,12 +196,19 @@ class ColumnView {
                              const bool _nrows_must_match,
                              const bool _expected_length_not_passed) const;
 
+  /// Evaluates the rows [_begin, _begin + _data->size()) using the batch
+  /// function, in parallel.
+  void fill_batchwise(const size_t _begin, std::vector<T>* _data) const;
+
   /// Generates the arrow::ChunkedArray.
   template <class IteratorType1, class IteratorType2>
   std::shared_ptr<arrow::ChunkedArray> make_array(
       const IteratorType1 _begin, const IteratorType2 _end) const;
 
  private:
+  /// Evaluates entire batches of rows at once, if possible.
+  const std::optional<BatchFunc> batch_func_;
+
   /// Functiona returning the Number of rows (if that is knowable).
   const NRowsType nrows_;
 
@@ -290,7 +316,27 @@ ColumnView<T> ColumnView<T>::from_bin_op(const ColumnView<T1>& _operand1,
            std::get<UnknownSize>(_operand2.nrows());
   };
 
-  return ColumnView<T>(value_func, nrows_func());
+  const auto make_batch_func = [&]() -> std::optional<BatchFunc> {
+    if (!_operand1.batch_func() || !_operand2.batch_func()) {
+      return std::nullopt;
+    }
+    return [batch1 = *_operand1.batch_func(), batch2 = *_operand2.batch_func(),
+            _op](const size_t _begin, const size_t _end,
+                 std::vector<T>* _out) {
+      std::vector<T1> buffer1;
+      std::vector<T2> buffer2;
+      batch1(_begin, _end, &buffer1);
+      batch2(_begin, _end, &buffer2);
+      _out->resize(_end - _begin);
+      for (size_t i = 0; i < _out->size(); ++i) {
+        const T1 val1 = buffer1[i];
+        const T2 val2 = buffer2[i];
+        (*_out)[i] = _op(val1, val2);
+      }
+    };
+  };
+
+  return ColumnView<T>(value_func, nrows_func(), {}, "", make_batch_func());
 }
 
 // -------------------------------------------------------------------------
@@ -425,7 +471,20 @@ ColumnView<T> ColumnView<T>::from_column(const Column<T>& _col) {
     return _col[_i];
   };
 
-  return ColumnView<T>(value_func, _col.nrows(), _col.subroles(), _col.unit());
+  const auto batch_func = [_col](const size_t _begin, const size_t _end,
+                                 std::vector<T>* _out) {
+    _out->resize(_end - _begin);
+    if constexpr (std::is_arithmetic_v<T>) {
+      std::copy(_col.data() + _begin, _col.data() + _end, _out->begin());
+    } else {
+      for (size_t i = _begin; i < _end; ++i) {
+        (*_out)[i - _begin] = _col[i];
+      }
+    }
+  };
+
+  return ColumnView<T>(value_func, _col.nrows(), _col.subroles(), _col.unit(),
+                       batch_func);
 }
 
 // -------------------------------------------------------------------------
@@ -444,7 +503,23 @@ ColumnView<T> ColumnView<T>::from_un_op(const ColumnView<T1>& _operand,
     return _op(*op1);
   };
 
-  return ColumnView<T>(value_func, _operand.nrows());
+  const auto make_batch_func = [&]() -> std::optional<BatchFunc> {
+    if (!_operand.batch_func()) {
+      return std::nullopt;
+    }
+    return [batch1 = *_operand.batch_func(), _op](
+               const size_t _begin, const size_t _end, std::vector<T>* _out) {
+      std::vector<T1> buffer1;
+      batch1(_begin, _end, &buffer1);
+      _out->resize(_end - _begin);
+      for (size_t i = 0; i < _out->size(); ++i) {
+        const T1 val1 = buffer1[i];
+        (*_out)[i] = _op(val1);
+      }
+    };
+  };
+
+  return ColumnView<T>(value_func, _operand.nrows(), {}, "", make_batch_func());
 }
 
 // -------------------------------------------------------------------------
@@ -533,7 +608,32 @@ ColumnView<T> ColumnView<T>::from_tern_op(const ColumnView<T1>& _operand1,
            std::get<UnknownSize>(_operand3.nrows());
   };
 
-  return ColumnView<T>(value_func, nrows_func());
+  const auto make_batch_func = [&]() -> std::optional<BatchFunc> {
+    if (!_operand1.batch_func() || !_operand2.batch_func() ||
+        !_operand3.batch_func()) {
+      return std::nullopt;
+    }
+    return [batch1 = *_operand1.batch_func(), batch2 = *_operand2.batch_func(),
+            batch3 = *_operand3.batch_func(),
+            _op](const size_t _begin, const size_t _end,
+                 std::vector<T>* _out) {
+      std::vector<T1> buffer1;
+      std::vector<T2> buffer2;
+      std::vector<T3> buffer3;
+      batch1(_begin, _end, &buffer1);
+      batch2(_begin, _end, &buffer2);
+      batch3(_begin, _end, &buffer3);
+      _out->resize(_end - _begin);
+      for (size_t i = 0; i < _out->size(); ++i) {
+        const T1 val1 = buffer1[i];
+        const T2 val2 = buffer2[i];
+        const T3 val3 = buffer3[i];
+        (*_out)[i] = _op(val1, val2, val3);
+      }
+    };
+  };
+
+  return ColumnView<T>(value_func, nrows_func(), {}, "", make_batch_func());
 }
 
 // -------------------------------------------------------------------------
@@ -544,7 +644,12 @@ ColumnView<T> ColumnView<T>::from_value(const T _value) {
     return _value;
   };
 
-  return ColumnView<T>(value_func, NROWS_INFINITE);
+  const auto batch_func = [_value](const size_t _begin, const size_t _end,
+                                   std::vector<T>* _out) {
+    _out->assign(_end - _begin, _value);
+  };
+
+  return ColumnView<T>(value_func, NROWS_INFINITE, {}, "", batch_func);
 }
 
 // -------------------------------------------------------------------------
@@ -583,6 +688,20 @@ std::shared_ptr<arrow::ChunkedArray> ColumnView<T>::to_array(
 
   check_expected_length(expected_length, _nrows_must_match, !_expected_length);
 
+  if (batch_func_ && std::holds_alternative<size_t>(nrows())) {
+    auto data = std::vector<T>(std::get<size_t>(nrows()));
+    fill_batchwise(0, &data);
+    if constexpr (std::is_same<T, strings::String>()) {
+      const auto to_str = [](const strings::String& _str) {
+        return _str.str();
+      };
+      auto range = data | std::views::transform(to_str);
+      return make_array(range.begin(), range.end());
+    } else {
+      return make_array(data.begin(), data.end());
+    }
+  }
+
   if constexpr (std::is_same<T, strings::String>()) {
     const auto to_str = [](const strings::String& _str) { return _str.str(); };
     auto range = *this | std::views::transform(to_str);
@@ -680,6 +799,37 @@ void ColumnView<T>::check_expected_length(
 
 // -------------------------------------------------------------------------
 
+template <class T>
+void ColumnView<T>::fill_batchwise(const size_t _begin,
+                                   std::vector<T>* _data) const {
+  assert_true(batch_func_);
+
+  const auto num_batches = (_data->size() + BATCH_SIZE - 1) / BATCH_SIZE;
+
+  // Elements of std::vector<bool> are not separate memory locations, so
+  // they cannot be written by several threads.
+  const auto num_threads = std::is_same<T, bool>()
+                               ? static_cast<size_t>(1)
+                               : multithreading::default_num_threads();
+
+  const auto fill = [this, _begin, _data](const size_t _batch_begin,
+                                          const size_t _batch_end,
+                                          const size_t) {
+    std::vector<T> buffer;
+    for (size_t batch = _batch_begin; batch < _batch_end; ++batch) {
+      const auto begin = batch * BATCH_SIZE;
+      const auto end = std::min(begin + BATCH_SIZE, _data->size());
+      (*batch_func_)(_begin + begin, _begin + end, &buffer);
+      assert_true(buffer.size() == end - begin);
+      std::move(buffer.begin(), buffer.end(), _data->begin() + begin);
+    }
+  };
+
+  multithreading::parallel_for(num_batches, num_threads, fill);
+}
+
+// -------------------------------------------------------------------------
+
 template <class T>
 std::shared_ptr<std::vector<T>> ColumnView<T>::to_vector(
     const size_t _begin, const std::optional<size_t> _expected_length,
@@ -691,6 +841,25 @@ std::shared_ptr<std::vector<T>> ColumnView<T>::to_vector(
 
   check_expected_length(expected_length, _nrows_must_match, !_expected_length);
 
+  if (batch_func_ &&
+      (std::holds_alternative<size_t>(nrows()) || is_infinite())) {
+    const auto available =
+        is_infinite() ? expected_length
+                      : std::get<size_t>(nrows()) -
+                            std::min(_begin, std::get<size_t>(nrows()));
+
+    const auto length = std::min(expected_length, available);
+
+    if ((length_is_known || _nrows_must_match) && length != expected_length) {
+      throw std::runtime_error(std::format("Expected {} nrows, but got {}.",
+                                           expected_length, length));
+    }
+
+    auto data_ptr = std::make_shared<std::vector<T>>(length);
+    fill_batchwise(_begin, data_ptr.get());
+    return data_ptr;
+  }
+
   auto values_view = ranges::views::iota(_begin, _begin + expected_length) |
                      ranges::views::transform(
                          [this](auto i) { return this->value_func_(i); }) |
@@ -766,7 +935,7 @@ ColumnView<T> ColumnView<T>::with_subroles(
     return deep_copy[_i];
   };
 
-  return ColumnView<T>(value_func, nrows(), _subroles, unit());
+  return ColumnView<T>(value_func, nrows(), _subroles, unit(), batch_func());
 }
 
 // -------------------------------------------------------------------------
@@ -779,7 +948,7 @@ ColumnView<T> ColumnView<T>::with_unit(const std::string& _unit) const {
     return deep_copy[_i];
   };
 
-  return ColumnView<T>(value_func, nrows(), subroles(), _unit);
+  return ColumnView<T>(value_func, nrows(), subroles(), _unit, batch_func());
 }
 
 // -------------------------------------------------------------------------
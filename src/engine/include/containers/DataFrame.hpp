@@ -178,6 +178,10 @@ class DataFrame {
       const std::optional<Schema> &_schema = std::nullopt,
       const bool _targets = true) const;
 
+  /// Returns a copy of the data frame that keeps all of its data in
+  /// memory-mapped pools in _temp_dir, so the RAM can be freed.
+  DataFrame to_memory_mapped(const std::string &_temp_dir) const;
+
   /// Extracts the data frame in a format the monitor can
   /// understand
   containers::MonitorSummary to_monitor() const;
@@ -692,6 +696,15 @@ class DataFrame {
                  const std::vector<std::string> &_names,
                  const std::vector<std::string> &_time_formats);
 
+  /// Builds a dataframe from one or several database iterators, each of
+  /// which is read on a separate thread. _indices maps the columns in the
+  /// schema, in the order of concat_colnames(...), to the columns of the
+  /// iterators.
+  void from_iterators(
+      const std::vector<rfl::Ref<database::Iterator>> &_iterators,
+      const std::vector<size_t> &_indices,
+      const std::vector<std::string> &_time_formats, const Schema &_schema);
+
   /// Builds a dataframe from a reader.
   void from_reader(const std::shared_ptr<io::Reader> &_reader,
                    const std::string &_fname, const size_t _skip,
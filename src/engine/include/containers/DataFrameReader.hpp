@@ -10,6 +10,7 @@
 
 #include "containers/DataFrame.hpp"
 #include "containers/Encoding.hpp"
+#include "io/ColumnarData.hpp"
 
 #include <memory>
 #include <string>
@@ -33,6 +34,11 @@ class DataFrameReader final : public io::Reader {
   /// Returns the next line.
   std::vector<std::string> next_line() final;
 
+  /// Returns typed, column-oriented access to the data frame, in the same
+  /// order as colnames() and coltypes(). The result refers to the columns
+  /// held by the reader, so the reader must outlive it.
+  io::ColumnarData to_columnar() const;
+
   // -------------------------------
 
  public:
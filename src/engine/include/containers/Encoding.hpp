@@ -15,6 +15,9 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 #include <variant>
 
 namespace containers {
@@ -60,6 +63,33 @@ class Encoding {
     return *this;
   }
 
+  /// Copies a vector of views.
+  Encoding& operator=(const std::vector<std::string_view>& _vector) {
+    const auto set_pimpl = [&_vector](auto&& _pimpl) {
+      assert_true(_pimpl);
+      *_pimpl = _vector;
+    };
+    std::visit(set_pimpl, pimpl_);
+    return *this;
+  }
+
+  /// Copies a vector of views. A MemoryMappedEncoding restores its hash
+  /// table from _hash_table_fname, if possible, an InMemoryEncoding always
+  /// rebuilds it.
+  void load(const std::vector<std::string_view>& _vector,
+            const std::string& _hash_table_fname) {
+    const auto load_pimpl = [&](auto&& _pimpl) {
+      assert_true(_pimpl);
+      using PimplType = std::decay_t<decltype(_pimpl)>;
+      if constexpr (std::is_same_v<PimplType, MemoryMappedType>) {
+        _pimpl->load(_vector, _hash_table_fname);
+      } else {
+        *_pimpl = _vector;
+      }
+    };
+    std::visit(load_pimpl, pimpl_);
+  }
+
   /// Returns the integer mapped to a string or the string mapped to an
   /// integer, updates the mapping, if necessary.
   template <class T>
@@ -96,6 +126,18 @@ class Encoding {
     return std::visit(get_size, pimpl_);
   }
 
+  /// Writes the hash table of a MemoryMappedEncoding to _fname. Returns
+  /// false for an InMemoryEncoding, which does not persist its hash table.
+  bool save_hash_table(const std::string& _fname) const {
+    if (!std::holds_alternative<MemoryMappedType>(pimpl_)) {
+      return false;
+    }
+    const ConstMemoryMappedType pimpl = std::get<MemoryMappedType>(pimpl_);
+    assert_true(pimpl);
+    pimpl->save_hash_table(_fname);
+    return true;
+  }
+
   /// The temporary directory (only relevant for the MemoryMappedEncoding)
   std::optional<std::string> temp_dir() const {
     if (std::holds_alternative<InMemoryType>(pimpl_)) {
@@ -14,6 +14,7 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <unordered_map>
 #include <vector>
@@ -37,6 +38,10 @@ class InMemoryEncoding {
   /// Copies a vector
   InMemoryEncoding& operator=(const std::vector<std::string>& _vector);
 
+  /// Copies a vector of views, which does not require a std::string to be
+  /// allocated for every entry.
+  InMemoryEncoding& operator=(const std::vector<std::string_view>& _vector);
+
   // -------------------------------
 
   /// Deletes all entries
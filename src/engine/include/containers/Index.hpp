@@ -9,21 +9,23 @@
 #define CONTAINERS_INDEX_HPP_
 
 #include "containers/Column.hpp"
-#include "containers/Float.hpp"
 #include "containers/Int.hpp"
-#include "helpers/NullChecker.hpp"
+#include "helpers/InMemoryIndex.hpp"
 #include "memmap/Index.hpp"
 
-#include <cmath>
 #include <memory>
-#include <unordered_map>
+#include <type_traits>
 #include <variant>
 
 namespace containers {
 
-template <class T, class Hash = std::hash<T>>
+template <class T>
 class Index {
-  using InMemoryType = std::unordered_map<T, std::vector<size_t>, Hash>;
+  static_assert(std::is_same<T, Int>(),
+                "The in-memory index relies on the dense integer encoding "
+                "of the join keys.");
+
+  using InMemoryType = helpers::InMemoryIndex;
   using MemoryMappedType = memmap::Index<T>;
 
  public:
@@ -55,23 +57,10 @@ class Index {
 
  private:
   /// Calculates the index, once the map type has been evaluated.
-  template <class KnownMapType>
-  void calculate_known_type(const Column<T>& _key, KnownMapType* _map);
-
-  // Determines whether this is a NULL value
-  bool is_null(const T& _val) const;
-
-  /// Insert a key-rownum-pair into _map;
-  void insert(const T _key, const size_t _rownum, InMemoryType* _map) const;
-
-  // -------------------------------
+  void calculate_known_type(const Column<T>& _key, InMemoryType* _map);
 
- private:
-  /// Insert a key-rownum-pair into _map;
-  void insert(const T _key, const size_t _rownum,
-              MemoryMappedType* _map) const {
-    _map->insert(_key, _rownum);
-  }
+  /// Calculates the index, once the map type has been evaluated.
+  void calculate_known_type(const Column<T>& _key, MemoryMappedType* _map);
 
   // -------------------------------
 
@@ -88,8 +77,8 @@ class Index {
 // -------------------------------------------------------------------------
 // -------------------------------------------------------------------------
 
-template <class T, class Hash>
-void Index<T, Hash>::calculate(const Column<T>& _key) {
+template <class T>
+void Index<T>::calculate(const Column<T>& _key) {
   assert_true(map_);
 
   if (std::holds_alternative<InMemoryType>(*map_)) {
@@ -107,94 +96,49 @@ void Index<T, Hash>::calculate(const Column<T>& _key) {
 
 // -------------------------------------------------------------------------
 
-template <class T, class Hash>
-template <class KnownMapType>
-void Index<T, Hash>::calculate_known_type(const Column<T>& _key,
-                                          KnownMapType* _map) {
-  if (_key.size() < begin_) {
+template <class T>
+void Index<T>::calculate_known_type(const Column<T>& _key,
+                                    InMemoryType* _map) {
+  if (_key.nrows() < _map->nrows()) {
     _map->clear();
-    begin_ = 0;
   }
 
-  for (size_t i = begin_; i < _key.nrows(); ++i) {
-    if (!is_null(_key[i])) {
-      insert(_key[i], i, _map);
-    }
-  }
+  _map->append(_key.data(), _key.nrows());
 
   begin_ = _key.nrows();
 }
 
 // -------------------------------------------------------------------------
 
-template <class T, class Hash>
-std::pair<const size_t*, const size_t*> Index<T, Hash>::find(
-    const T _key) const {
-  assert_true(map_);
-
-  if (std::holds_alternative<InMemoryType>(*map_)) {
-    const auto& idx = std::get<InMemoryType>(*map_);
-
-    const auto it = idx.find(_key);
-
-    if (it == idx.end()) {
-      return std::make_pair<const size_t*, const size_t*>(nullptr, nullptr);
-    }
-
-    return std::make_pair(it->second.data(),
-                          it->second.data() + it->second.size());
-  }
-
-  if (std::holds_alternative<MemoryMappedType>(*map_)) {
-    const auto& idx = std::get<MemoryMappedType>(*map_);
-
-    const auto opt = idx[_key];
-
-    if (!opt) {
-      return std::make_pair<const size_t*, const size_t*>(nullptr, nullptr);
-    }
-
-    const auto begin = opt->data();
-
-    return std::make_pair(begin, begin + opt->size());
+template <class T>
+void Index<T>::calculate_known_type(const Column<T>& _key,
+                                    MemoryMappedType* _map) {
+  if (_key.nrows() < _map->nrows()) {
+    _map->clear();
   }
 
-  assert_true(false);
+  _map->append(_key, _key.nrows());
 
-  return std::make_pair<const size_t*, const size_t*>(nullptr, nullptr);
+  begin_ = _key.nrows();
 }
 
 // -------------------------------------------------------------------------
 
-template <class T, class Hash>
-void Index<T, Hash>::insert(const T _key, const size_t _rownum,
-                            InMemoryType* _map) const {
-  auto it = _map->find(_key);
-
-  if (it == _map->end()) {
-    (*_map)[_key] = {_rownum};
-  } else {
-    it->second.push_back(_rownum);
-  }
-}
-
-// -------------------------------------------------------------------------
+template <class T>
+std::pair<const size_t*, const size_t*> Index<T>::find(const T _key) const {
+  assert_true(map_);
 
-template <class T, class Hash>
-bool Index<T, Hash>::is_null(const T& _val) const {
-  if constexpr (std::is_same<T, Int>()) {
-    return _val < 0;
+  if (std::holds_alternative<InMemoryType>(*map_)) {
+    return std::get<InMemoryType>(*map_).find(_key);
   }
 
-  if constexpr (std::is_same<T, Float>()) {
-    return (std::isnan(_val) || std::isinf(_val));
+  if (std::holds_alternative<MemoryMappedType>(*map_)) {
+    return std::get<MemoryMappedType>(*map_).find(_key);
   }
 
-  if constexpr (std::is_same<T, strings::String>()) {
-    return helpers::NullChecker::is_null(_val);
-  }
+  assert_true(false);
 
-  return false;
+  return std::make_pair<const size_t*, const size_t*>(nullptr, nullptr);
 }
 
 // -------------------------------------------------------------------------
@@ -9,23 +9,28 @@
 #define CONTAINERS_MEMORYMAPPEDENCODING_HPP_
 
 #include "containers/Int.hpp"
-#include "memmap/BTree.hpp"
+#include "memmap/HashTable.hpp"
 #include "memmap/StringVector.hpp"
 #include "strings/String.hpp"
 
+#include <functional>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <vector>
 
 namespace containers {
 
 class MemoryMappedEncoding {
-  using BTreeType = memmap::BTree<size_t, size_t>;
-  using RownumsType = memmap::Vector<std::pair<Int, memmap::VectorImpl<Int>>>;
+  using HashTableType = memmap::HashTable<Int>;
 
   constexpr static Int NOT_FOUND = -1;
-  constexpr static Int HASH_COLLISION = -2;
+
+  /// The number of strings we look ahead when prefetching during bulk
+  /// inserts.
+  constexpr static size_t PREFETCH_DISTANCE = 8;
 
  public:
   explicit MemoryMappedEncoding(
@@ -47,9 +52,19 @@ class MemoryMappedEncoding {
   void append(const MemoryMappedEncoding& _other,
               bool _include_subencoding = false);
 
+  /// Copies a vector of views like operator=, but restores the hash table
+  /// from _hash_table_fname instead of inserting every string, if the file
+  /// has been written by save_hash_table(...) for the same strings.
+  void load(const std::vector<std::string_view>& _vector,
+            const std::string& _hash_table_fname);
+
   /// Copies a vector
   MemoryMappedEncoding& operator=(const std::vector<std::string>& _vector);
 
+  /// Copies a vector of views, which does not require a std::string to be
+  /// allocated for every entry.
+  MemoryMappedEncoding& operator=(const std::vector<std::string_view>& _vector);
+
   /// Move assignment operator.
   MemoryMappedEncoding& operator=(MemoryMappedEncoding&& _other) = delete;
 
@@ -107,6 +122,12 @@ class MemoryMappedEncoding {
   /// Trivial (const) accessor
   std::shared_ptr<memmap::Pool> pool() const { return pool_; }
 
+  /// Writes the hash table to _fname, so that load(...) can restore it.
+  void save_hash_table(const std::string& _fname) const {
+    assert_true(!subencoding_);
+    hash_table().save(_fname);
+  }
+
   /// Number of encoded elements
   size_t size() const { return subsize_ + string_vector().size(); }
 
@@ -126,27 +147,15 @@ class MemoryMappedEncoding {
 
  private:
   /// Trivial (private) accessor
-  BTreeType& btree() {
-    assert_true(btree_);
-    return *btree_;
-  }
-
-  /// Trivial (private) accessor
-  const BTreeType& btree() const {
-    assert_true(btree_);
-    return *btree_;
+  HashTableType& hash_table() {
+    assert_true(hash_table_);
+    return *hash_table_;
   }
 
   /// Trivial (private) accessor
-  RownumsType& rownums() {
-    assert_true(rownums_);
-    return *rownums_;
-  }
-
-  /// Trivial (private) accessor
-  const RownumsType& rownums() const {
-    assert_true(rownums_);
-    return *rownums_;
+  const HashTableType& hash_table() const {
+    assert_true(hash_table_);
+    return *hash_table_;
   }
 
   /// Trivial (private) accessor
@@ -171,8 +180,20 @@ class MemoryMappedEncoding {
   /// files.
   void deallocate();
 
-  /// Adds an integer to map_ and vector_, assuming it is not already included
-  Int insert(const strings::String& _val, const std::optional<size_t>& _opt);
+  /// Adds an integer to hash_table_ and string_vector_, assuming it is not
+  /// already included
+  Int insert(const strings::String& _val);
+
+  /// Returns the slot in hash_table_ containing _val, if there is one.
+  std::optional<size_t> find(const strings::String& _val) const;
+
+  /// Whether the string at _ix can be found in the hash table.
+  bool is_indexed(const size_t _ix) const;
+
+  /// Hints the CPU to fetch the slot _val maps to.
+  void prefetch(const std::string_view _val) const {
+    hash_table().prefetch(std::hash<std::string_view>()(_val));
+  }
 
   /// Returns the string mapped to an integer.
   strings::String int_to_string(const Int _i) const;
@@ -186,8 +207,8 @@ class MemoryMappedEncoding {
   // -------------------------------
 
  private:
-  /// For fast lookup
-  std::shared_ptr<BTreeType> btree_;
+  /// Maps the hashes of the strings to their integers, for fast lookup.
+  std::shared_ptr<HashTableType> hash_table_;
 
   /// The null value (needed because strings are returned by reference).
   const strings::String null_value_;
@@ -195,9 +216,6 @@ class MemoryMappedEncoding {
   /// The pool containing the data.
   std::shared_ptr<memmap::Pool> pool_;
 
-  /// The rownums
-  std::shared_ptr<RownumsType> rownums_;
-
   /// A subencoding can be used to separate the existing encoding from new
   /// data. Under some circumstance, we want to avoid the global encoding
   /// being edited, such as when we process requests in parallel.
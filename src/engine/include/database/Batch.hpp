@@ -0,0 +1,131 @@
+// Copyright 2024 Code17 GmbH
+//
+// This file is licensed under the Elastic License 2.0 (ELv2).
+// Refer to the LICENSE.txt file in the root of the repository
+// for details.
+//
+
+#ifndef DATABASE_BATCH_HPP_
+#define DATABASE_BATCH_HPP_
+
+#include "database/Float.hpp"
+#include "io/Datatype.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace database {
+
+/// Typed buffers for a single column of a batch fetched through
+/// Iterator::fetch_batch(...). Which of the buffers is used depends on the
+/// requested type.
+class BatchColumn {
+ public:
+  BatchColumn() : type_(io::Datatype::unknown) { offsets_.push_back(0); }
+
+  ~BatchColumn() = default;
+
+ public:
+  /// Removes all values, but keeps the allocated memory.
+  void clear(const io::Datatype _type) {
+    type_ = _type;
+    floats_.clear();
+    ints_.clear();
+    arena_.clear();
+    offsets_.clear();
+    offsets_.push_back(0);
+    is_null_.clear();
+  }
+
+  /// Appends a floating point value, used for double_precision and
+  /// time_stamp. NULL values are expressed as NaN.
+  void push_float(const Float _val) { floats_.push_back(_val); }
+
+  /// Appends an integer value.
+  void push_int(const std::int64_t _val, const bool _is_null) {
+    ints_.push_back(_val);
+    is_null_.push_back(_is_null);
+  }
+
+  /// Appends a NULL value, regardless of the type.
+  void push_null() {
+    switch (type_) {
+      case io::Datatype::double_precision:
+      case io::Datatype::time_stamp:
+        push_float(static_cast<Float>(NAN));
+        break;
+
+      case io::Datatype::integer:
+        push_int(0, true);
+        break;
+
+      case io::Datatype::string:
+        offsets_.push_back(arena_.size());
+        is_null_.push_back(true);
+        break;
+
+      default:
+        break;
+    }
+  }
+
+  /// Appends a string to the arena.
+  void push_string(const char* _ptr, const size_t _len) {
+    arena_.append(_ptr, _len);
+    offsets_.push_back(arena_.size());
+    is_null_.push_back(false);
+  }
+
+ public:
+  /// Trivial accessor.
+  const std::vector<Float>& floats() const { return floats_; }
+
+  /// Trivial accessor.
+  const std::vector<std::int64_t>& ints() const { return ints_; }
+
+  /// Whether the value in row _i is NULL - not applicable to floating point
+  /// values, which use NaN instead.
+  bool is_null(const size_t _i) const { return is_null_[_i]; }
+
+  /// Returns a view on the string in row _i. Only valid until the next call
+  /// to clear(...).
+  std::string_view string(const size_t _i) const {
+    return std::string_view(arena_.data() + offsets_[_i],
+                            offsets_[_i + 1] - offsets_[_i]);
+  }
+
+  /// Trivial accessor.
+  io::Datatype type() const { return type_; }
+
+ private:
+  /// All strings, stored back-to-back.
+  std::string arena_;
+
+  /// The floating point values.
+  std::vector<Float> floats_;
+
+  /// The integer values.
+  std::vector<std::int64_t> ints_;
+
+  /// Whether a string or integer value is NULL.
+  std::vector<bool> is_null_;
+
+  /// The offsets of the strings in the arena, always contains one more
+  /// element than there are strings.
+  std::vector<size_t> offsets_;
+
+  /// The type the values have been converted to. Columns of type unknown
+  /// are skipped.
+  io::Datatype type_;
+};
+
+/// A batch of rows fetched through Iterator::fetch_batch(...).
+using Batch = std::vector<BatchColumn>;
+
+}  // namespace database
+
+#endif  // DATABASE_BATCH_HPP_
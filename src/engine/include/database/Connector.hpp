@@ -10,6 +10,7 @@
 
 #include "database/Iterator.hpp"
 #include "database/TableContent.hpp"
+#include "io/ColumnarData.hpp"
 #include "io/Datatype.hpp"
 #include "io/Reader.hpp"
 
@@ -82,8 +83,23 @@ class Connector {
   /// Returns a shared_ptr containing an iterator for the SQL query.
   virtual rfl::Ref<Iterator> select(const std::string& _sql) = 0;
 
+  /// Returns iterators over disjoint partitions of the rows returned by
+  /// select(_colnames, _tname, _where), which can be consumed on separate
+  /// threads. Connectors that cannot read a table in parallel return a single
+  /// iterator.
+  virtual std::vector<rfl::Ref<Iterator>> select_partitioned(
+      const std::vector<std::string>& _colnames, const std::string& _tname,
+      const std::string& _where, const size_t _num_partitions) {
+    return {select(_colnames, _tname, _where)};
+  }
+
   /// Returns the time formats used.
   virtual const std::vector<std::string>& time_formats() const = 0;
+
+  /// Writes typed, column-oriented data into an existing table. This is
+  /// considerably faster than read(...), because no values need to be parsed.
+  virtual void write(const std::string& _table,
+                     const io::ColumnarData& _data) = 0;
 };
 
 }  // namespace database
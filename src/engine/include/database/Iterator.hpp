@@ -8,9 +8,12 @@
 #ifndef DATABASE_ITERATOR_HPP_
 #define DATABASE_ITERATOR_HPP_
 
+#include "database/Batch.hpp"
 #include "database/Float.hpp"
 #include "database/Int.hpp"
+#include "io/Datatype.hpp"
 
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -29,6 +32,50 @@ class Iterator {
   /// Whether the end is reached.
   virtual bool end() const = 0;
 
+  /// Fetches up to _max_rows rows, converting column i to _coltypes[i], and
+  /// returns the number of rows fetched, which is 0 once the end is reached.
+  /// Columns of type unknown are skipped. Must not be called in the middle
+  /// of a row. The default implementation relies on the get_... methods, the
+  /// connectors override it to avoid the detour through strings.
+  virtual size_t fetch_batch(const std::vector<io::Datatype>& _coltypes,
+                             const size_t _max_rows, Batch* _batch) {
+    prepare_batch(_coltypes, _batch);
+
+    size_t nrows = 0;
+
+    for (; nrows < _max_rows && !end(); ++nrows) {
+      for (size_t j = 0; j < _coltypes.size(); ++j) {
+        auto& col = (*_batch)[j];
+
+        switch (_coltypes[j]) {
+          case io::Datatype::double_precision:
+            col.push_float(get_double());
+            break;
+
+          case io::Datatype::integer:
+            col.push_int(get_int(), false);
+            break;
+
+          case io::Datatype::string: {
+            const auto str = get_string();
+            col.push_string(str.data(), str.size());
+            break;
+          }
+
+          case io::Datatype::time_stamp:
+            col.push_float(get_time_stamp());
+            break;
+
+          default:
+            get_string();
+            break;
+        }
+      }
+    }
+
+    return nrows;
+  }
+
   /// Returns a double and increments the iterator.
   virtual Float get_double() = 0;
 
@@ -41,6 +88,24 @@ class Iterator {
   /// Returns a time stamp transformed to the number of days since epoch and
   /// increments the iterator.
   virtual Float get_time_stamp() = 0;
+
+ protected:
+  /// Makes sure that _batch has one empty column for every element in
+  /// _coltypes.
+  void prepare_batch(const std::vector<io::Datatype>& _coltypes,
+                     Batch* _batch) const {
+    if (_coltypes.size() != colnames().size()) {
+      throw std::runtime_error("Expected " + std::to_string(colnames().size()) +
+                               " column types, got " +
+                               std::to_string(_coltypes.size()) + ".");
+    }
+
+    _batch->resize(_coltypes.size());
+
+    for (size_t j = 0; j < _coltypes.size(); ++j) {
+      (*_batch)[j].clear(_coltypes[j]);
+    }
+  }
 };
 
 }  // namespace database
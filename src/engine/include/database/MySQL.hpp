@@ -22,6 +22,23 @@
 namespace database {
 
 class MySQL final : public Connector {
+ public:
+  /// The approximate size of a single bulk insert query generated by
+  /// write(...), in bytes.
+  static constexpr size_t BULK_INSERT_SIZE = 1 << 22;
+
+  /// The server does not permit LOAD DATA LOCAL INFILE
+  /// (ER_NOT_ALLOWED_COMMAND).
+  static constexpr unsigned int ERR_LOCAL_INFILE_NOT_ALLOWED = 1148;
+
+  /// The client has rejected LOAD DATA LOCAL INFILE
+  /// (CR_LOAD_DATA_LOCAL_INFILE_REJECTED).
+  static constexpr unsigned int ERR_LOCAL_INFILE_REJECTED = 2068;
+
+  /// Loading local data is disabled on either side
+  /// (ER_CLIENT_LOCAL_FILES_DISABLED).
+  static constexpr unsigned int ERR_LOCAL_FILES_DISABLED = 3948;
+
  public:
   MySQL(const typename Command::MySQLOp& _obj, const std::string& _passwd);
 
@@ -58,6 +75,11 @@ class MySQL final : public Connector {
   void read(const std::string& _table, const size_t _skip,
             io::Reader* _reader) final;
 
+  /// Writes typed, column-oriented data into an existing table using
+  /// LOAD DATA LOCAL INFILE. If the server does not permit that, it falls
+  /// back to bulk inserts.
+  void write(const std::string& _table, const io::ColumnarData& _data) final;
+
  public:
   /// Returns the dialect of the connector.
   std::string dialect() const final { return "mysql"; }
@@ -110,10 +132,10 @@ class MySQL final : public Connector {
   const std::vector<std::string>& time_formats() const { return time_formats_; }
 
  private:
-  /// Makes sure that the colnames of the CSV file match the colnames of the
+  /// Makes sure that the colnames of the source match the colnames of the
   /// target table.
   void check_colnames(const std::vector<std::string>& _colnames,
-                      io::Reader* _reader);
+                      const std::vector<std::string>& _csv_colnames) const;
 
   /// Executes and SQL command given a connection.
   std::shared_ptr<MYSQL_RES> exec(const std::string& _sql,
@@ -122,6 +144,11 @@ class MySQL final : public Connector {
   /// Parses a field for the CSV reader.
   io::Datatype interpret_field_type(const enum_field_types _type) const;
 
+  /// Writes the data using INSERT INTO ... VALUES ..., in a single
+  /// transaction.
+  void bulk_insert(const std::string& _table, const io::ColumnarData& _data,
+                   const std::shared_ptr<MYSQL>& _conn) const;
+
   /// Prepares a INSERT INTO .. VALUES ... query
   /// to insert a large CSV file.
   std::string make_bulk_insert_query(
@@ -136,11 +163,17 @@ class MySQL final : public Connector {
 
  private:
   /// Returns a new connection based on the connection_string_
-  std::shared_ptr<MYSQL> make_connection() const {
+  std::shared_ptr<MYSQL> make_connection(
+      const bool _allow_local_infile = false) const {
     auto raw_ptr = mysql_init(NULL);
 
     const auto conn = std::shared_ptr<MYSQL>(raw_ptr, mysql_close);
 
+    if (_allow_local_infile) {
+      const unsigned int local_infile = 1;
+      mysql_options(conn.get(), MYSQL_OPT_LOCAL_INFILE, &local_infile);
+    }
+
     const auto res = mysql_real_connect(
         conn.get(), host_.c_str(), user_.c_str(), passwd_.c_str(),
         dbname_.c_str(), port_, unix_socket_.c_str(), CLIENT_MULTI_STATEMENTS);
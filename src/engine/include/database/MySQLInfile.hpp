@@ -0,0 +1,92 @@
+// Copyright 2024 Code17 GmbH
+//
+// This file is licensed under the Elastic License 2.0 (ELv2).
+// Refer to the LICENSE.txt file in the root of the repository
+// for details.
+//
+
+#ifndef DATABASE_MYSQLINFILE_HPP_
+#define DATABASE_MYSQLINFILE_HPP_
+
+#include "io/ColumnarData.hpp"
+
+#include <cstddef>
+#include <string>
+
+namespace database {
+
+/// Serves typed, column-oriented data as an in-memory file for
+/// LOAD DATA LOCAL INFILE. The rows are generated lazily, so the entire file
+/// never needs to be held in memory.
+class MySQLInfile {
+ public:
+  /// The name of the virtual file passed to LOAD DATA LOCAL INFILE.
+  static constexpr const char* FILE_NAME = "getml_columnar_data";
+
+ public:
+  explicit MySQLInfile(const io::ColumnarData& _data);
+
+  ~MySQLInfile() = default;
+
+ public:
+  /// Appends a row in the format expected by the LOAD DATA statement
+  /// generated by make_load_data_query(...).
+  static void append_infile_row(const io::ColumnarData& _data,
+                                const size_t _row, std::string* _buffer);
+
+  /// Appends a row in the format expected by an INSERT INTO ... VALUES
+  /// statement, including the parentheses.
+  static void append_values_row(const io::ColumnarData& _data,
+                                const size_t _row, std::string* _buffer);
+
+  /// Callback for mysql_set_local_infile_handler(...).
+  static void infile_end(void*) {}
+
+  /// Callback for mysql_set_local_infile_handler(...).
+  static int infile_error(void* _ptr, char* _msg, unsigned int _len);
+
+  /// Callback for mysql_set_local_infile_handler(...).
+  static int infile_init(void** _ptr, const char* _fname, void* _userdata);
+
+  /// Callback for mysql_set_local_infile_handler(...).
+  static int infile_read(void* _ptr, char* _buf, unsigned int _len);
+
+  /// Generates the LOAD DATA LOCAL INFILE statement.
+  static std::string make_load_data_query(const std::string& _table,
+                                          const io::ColumnarData& _data);
+
+  /// Copies up to _len bytes into _buf, returns the number of bytes copied
+  /// and 0, once all rows have been served.
+  int read(char* _buf, unsigned int _len);
+
+ private:
+  /// Appends a single value - strings are escaped, NULL values are
+  /// represented by _null.
+  static void append_value(const io::ColumnarData& _data, const size_t _col,
+                           const size_t _row, const char* _null,
+                           const bool _quote_strings, std::string* _buffer);
+
+  /// Escapes the characters that have a special meaning to MySQL, both in
+  /// string literals and in LOAD DATA statements.
+  static void escape(const std::string& _str, std::string* _buffer);
+
+ private:
+  /// Contains rows that have been generated, but not yet read.
+  std::string buffer_;
+
+  /// The data to be written.
+  const io::ColumnarData& data_;
+
+  /// The error message, if generating the rows failed.
+  std::string error_;
+
+  /// The position in buffer_ up to which data has been read.
+  size_t pos_;
+
+  /// The next row to be generated.
+  size_t row_;
+};
+
+}  // namespace database
+
+#endif  // DATABASE_MYSQLINFILE_HPP_
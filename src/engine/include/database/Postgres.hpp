@@ -16,12 +16,27 @@
 
 #include <libpq-fe.h>
 
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
 namespace database {
 
 class Postgres final : public Connector {
+ public:
+  /// The number of bytes we accumulate before sending them to the server.
+  static constexpr size_t COPY_BUFFER_SIZE = 1 << 20;
+
+  /// The difference between the postgres epoch (2000-01-01) and the UNIX
+  /// epoch in seconds.
+  static constexpr double POSTGRES_EPOCH = 946684800.0;
+
+  /// The minimum number of pages a partition in select_partitioned(...)
+  /// should span, so that small tables are not split at all.
+  static constexpr std::int64_t MIN_PAGES_PER_PARTITION = 1024;
+
  public:
   Postgres(const typename Command::PostgresOp& _obj,
            const std::string& _passwd);
@@ -56,6 +71,19 @@ class Postgres final : public Connector {
   void read(const std::string& _table, const size_t _skip,
             io::Reader* _reader) final;
 
+  /// Splits the table into ranges of physical pages (using TID range scans),
+  /// which are read on separate connections sharing the same snapshot.
+  /// Falls back to a single iterator for views, small tables and servers
+  /// older than Postgres 14.
+  std::vector<rfl::Ref<Iterator>> select_partitioned(
+      const std::vector<std::string>& _colnames, const std::string& _tname,
+      const std::string& _where, const size_t _num_partitions) final;
+
+  /// Writes typed, column-oriented data into an existing table using the
+  /// binary COPY protocol. The table is expected to have been created with
+  /// the types generated by the io::StatementMaker.
+  void write(const std::string& _table, const io::ColumnarData& _data) final;
+
  public:
   /// Returns the dialect of the connector.
   std::string dialect() const final { return "postgres"; }
@@ -115,10 +143,18 @@ class Postgres final : public Connector {
   const std::vector<std::string>& time_formats() const { return time_formats_; }
 
  private:
-  /// Makes sure that the colnames of the CSV file match the colnames of the
+  /// Makes sure that the colnames of the source match the colnames of the
   /// target table.
   void check_colnames(const std::vector<std::string>& _colnames,
-                      io::Reader* _reader);
+                      const std::vector<std::string>& _csv_colnames) const;
+
+  /// Appends a single field in the binary COPY format to the buffer.
+  static void append_field(const io::ColumnarData& _data, const size_t _col,
+                           const size_t _row, std::string* _buffer);
+
+  /// Returns the number of pages of a table or materialized view and 0 for
+  /// anything that cannot be scanned by TID ranges.
+  std::int64_t count_pages(const std::string& _tname) const;
 
   /// Returns the io::Datatype associated with a oid.
   io::Datatype interpret_oid(Oid _oid) const;
@@ -161,6 +197,27 @@ class Postgres final : public Connector {
     return conn;
   }
 
+  /// Appends an integral value in network byte order, as required by the
+  /// binary COPY format.
+  template <class T>
+  static void append_big_endian(const T _val, std::string* _buffer) {
+    auto val = _val;
+    if constexpr (std::endian::native == std::endian::little) {
+      val = std::byteswap(val);
+    }
+    _buffer->append(reinterpret_cast<const char*>(&val), sizeof(T));
+  }
+
+  /// Sends the buffer to the server and clears it.
+  static void put_copy_data(PGconn* _conn, std::string* _buffer) {
+    const auto success = PQputCopyData(_conn, _buffer->data(),
+                                       static_cast<int>(_buffer->size()));
+    if (success != 1) {
+      throw std::runtime_error(PQerrorMessage(_conn));
+    }
+    _buffer->clear();
+  }
+
   /// List of all typnames that will be interpreted as double precision.
   static std::vector<std::string> typnames_double_precision() {
     return {"float4", "float8", "_float4", "_float8", "numeric", "_numeric"};
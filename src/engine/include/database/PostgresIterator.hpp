@@ -15,26 +15,46 @@
 
 #include <libpq-fe.h>
 
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace database {
 
 class PostgresIterator final : public Iterator {
+  // The OIDs of the types we can decode in binary format, as defined in
+  // pg_type.dat.
+  static constexpr Oid NAME_OID = 19;
+  static constexpr Oid INT8_OID = 20;
+  static constexpr Oid INT2_OID = 21;
+  static constexpr Oid INT4_OID = 23;
+  static constexpr Oid TEXT_OID = 25;
+  static constexpr Oid FLOAT4_OID = 700;
+  static constexpr Oid FLOAT8_OID = 701;
+  static constexpr Oid BPCHAR_OID = 1042;
+  static constexpr Oid VARCHAR_OID = 1043;
+  static constexpr Oid NUMERIC_OID = 1700;
+
  public:
-  PostgresIterator(const std::shared_ptr<PGconn>& _connection,
-                   const std::string& _sql,
-                   const std::vector<std::string>& _time_formats,
-                   const std::int32_t _begin = -1,
-                   const std::int32_t _end = -1);
-
-  PostgresIterator(const std::shared_ptr<PGconn>& _connection,
-                   const std::vector<std::string>& _colnames,
-                   const std::vector<std::string>& _time_formats,
-                   const std::string& _tname, const std::string& _where,
-                   const std::int32_t _begin = -1,
-                   const std::int32_t _end = -1);
+  /// If _snapshot is set, the query is executed in a repeatable read
+  /// transaction using the snapshot exported by pg_export_snapshot(), so
+  /// that several iterators see exactly the same data.
+  PostgresIterator(
+      const std::shared_ptr<PGconn>& _connection, const std::string& _sql,
+      const std::vector<std::string>& _time_formats,
+      const std::int32_t _begin = -1, const std::int32_t _end = -1,
+      const std::optional<std::string>& _snapshot = std::nullopt);
+
+  PostgresIterator(
+      const std::shared_ptr<PGconn>& _connection,
+      const std::vector<std::string>& _colnames,
+      const std::vector<std::string>& _time_formats, const std::string& _tname,
+      const std::string& _where, const std::int32_t _begin = -1,
+      const std::int32_t _end = -1,
+      const std::optional<std::string>& _snapshot = std::nullopt);
 
   ~PostgresIterator() final;
 
@@ -42,6 +62,13 @@ class PostgresIterator final : public Iterator {
   /// Returns the column names of the query.
   std::vector<std::string> colnames() const final;
 
+  /// Fetches up to _max_rows rows. Once the rows fetched in text format have
+  /// been consumed, the remaining rows are fetched in binary format, if that
+  /// is supported for all column types. Queries containing time stamps stay
+  /// on the text format.
+  size_t fetch_batch(const std::vector<io::Datatype>& _coltypes,
+                     const size_t _max_rows, Batch* _batch) final;
+
   /// Returns a double.
   Float get_double() final;
 
@@ -59,8 +86,40 @@ class PostgresIterator final : public Iterator {
   bool end() const final { return (PQntuples(result()) == 0); }
 
  private:
-  /// Executes an SQL command.
-  std::shared_ptr<PGresult> execute(const std::string& _sql) const;
+  /// Appends the values of column _col in the rows [_begin, _end) of the
+  /// current result to _out.
+  void append_values(const int _col, const int _begin, const int _end,
+                     const io::Datatype _type, BatchColumn* _out) const;
+
+  /// Decodes a number in the binary format.
+  static Float decode_binary(const Oid _oid, const char* _val,
+                             const size_t _len);
+
+  /// Executes an SQL command. If _binary is true, the results are returned
+  /// in binary format.
+  std::shared_ptr<PGresult> execute(const std::string& _sql,
+                                    const bool _binary = false) const;
+
+  /// Whether the type is a string type.
+  static bool is_text_oid(const Oid _oid) {
+    return _oid == BPCHAR_OID || _oid == NAME_OID || _oid == TEXT_OID ||
+           _oid == VARCHAR_OID;
+  }
+
+  /// Reads an integer in network byte order.
+  template <class T>
+  static T read_big_endian(const char* _val) {
+    std::make_unsigned_t<T> u = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+      u = static_cast<std::make_unsigned_t<T>>(
+          (u << 8) | static_cast<unsigned char>(_val[i]));
+    }
+    return static_cast<T>(u);
+  }
+
+  /// Whether the binary format of all columns can be decoded into the
+  /// requested types with the same semantics as the text format.
+  bool supports_binary(const std::vector<io::Datatype>& _coltypes) const;
 
   /// Generates an SQL statement fro the colnames, the table name and an
   /// optional _where.
@@ -100,10 +159,10 @@ class PostgresIterator final : public Iterator {
     end_required_ = false;
   }
 
-  /// Fetches the next n rows.
-  void fetch_next(const std::int32_t _n) {
-    result_ =
-        execute("FETCH FORWARD " + std::to_string(_n) + " FROM getmlcursor;");
+  /// Fetches the next n rows, optionally in binary format.
+  void fetch_next(const std::int32_t _n, const bool _binary = false) {
+    result_ = execute(
+        "FETCH FORWARD " + std::to_string(_n) + " FROM getmlcursor;", _binary);
   }
 
   /// Returns the raw value.
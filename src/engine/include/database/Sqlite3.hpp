@@ -27,6 +27,10 @@ extern "C" {
 namespace database {
 
 class Sqlite3 final : public Connector {
+ public:
+  /// The maximum number of rows inserted by a single statement in write(...).
+  static constexpr size_t MAX_ROWS_PER_INSERT = 500;
+
  public:
   explicit Sqlite3(const typename Command::SQLite3Op& _obj);
 
@@ -61,6 +65,9 @@ class Sqlite3 final : public Connector {
   /// Lists the name of the tables held in the database.
   std::vector<std::string> list_tables() final;
 
+  /// Writes typed, column-oriented data into an existing table.
+  void write(const std::string& _table, const io::ColumnarData& _data) final;
+
   // -------------------------------
 
  public:
@@ -111,16 +118,23 @@ class Sqlite3 final : public Connector {
   // -------------------------------
 
  private:
-  /// Makes sure that the colnames of the CSV file match the colnames of the
+  /// Makes sure that the colnames of the source match the colnames of the
   /// target table.
   void check_colnames(const std::vector<std::string>& _colnames,
-                      io::Reader* _reader);
+                      const std::vector<std::string>& _csv_colnames) const;
 
   /// Inserts a single line from a CSV file into a table.
   void insert_line(const std::vector<std::string>& _line,
                    const std::vector<io::Datatype>& _coltypes,
                    sqlite3_stmt* stmt) const;
 
+  /// Binds the rows [_begin, _end) to a statement inserting multiple rows at
+  /// once and executes it. The strings are stored in _buffer, so they remain
+  /// valid until the statement has been executed.
+  void insert_batch(const io::ColumnarData& _data, const size_t _begin,
+                    const size_t _end, sqlite3_stmt* _stmt,
+                    std::vector<std::string>* _buffer) const;
+
   /// Inserts a column in double format.
   void insert_double(const std::vector<std::string>& _line, const int _colnum,
                      sqlite3_stmt* _stmt) const;
@@ -137,10 +151,13 @@ class Sqlite3 final : public Connector {
   /// a custom deleter. Called by the constructor.
   static std::shared_ptr<sqlite3> make_db(const std::string& _name);
 
-  /// Prepares an insert statement for reading in CSV data.
+  /// Prepares an insert statement inserting _num_rows rows at once.
   std::unique_ptr<sqlite3_stmt, int (*)(sqlite3_stmt*)> make_insert_statement(
-      const std::string& _table,
-      const std::vector<std::string>& _colnames) const;
+      const std::string& _table, const size_t _num_cols,
+      const size_t _num_rows) const;
+
+  /// Executes a statement that has been bound and resets it.
+  void step_and_reset(sqlite3_stmt* _stmt) const;
 
   // -------------------------------
 
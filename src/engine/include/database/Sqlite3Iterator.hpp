@@ -45,6 +45,11 @@ class Sqlite3Iterator final : public Iterator {
   /// Returns the column names of the query.
   std::vector<std::string> colnames() const final;
 
+  /// Fetches up to _max_rows rows using the typed sqlite3_column_...
+  /// functions.
+  size_t fetch_batch(const std::vector<io::Datatype>& _coltypes,
+                     const size_t _max_rows, Batch* _batch) final;
+
   /// Returns a double and increments the iterator.
   Float get_double() final;
 
@@ -21,6 +21,9 @@ struct EngineOptions {
   static constexpr bool IN_MEMORY = true;
   static constexpr bool MEMORY_MAPPING = false;
 
+  /// The default size limit of the persistent cache, in MB.
+  static constexpr size_t PERSISTENT_CACHE_SIZE = 10000;
+
   using ReflectionType = rfl::NamedTuple<rfl::Field<"port", size_t>>;
 
  public:
@@ -36,6 +39,26 @@ struct EngineOptions {
   /// Whether you want this to be in memory or memory mapped.
   bool in_memory_;
 
+  /// Whether data frames and the fitted parts of a pipeline (preprocessors,
+  /// feature learners and predictors) should only be loaded from the project
+  /// directory once they are first needed. When the memory budget is
+  /// exceeded, data frames that are identical to their saved versions are
+  /// unloaded rather than moved to memory mapping.
+  bool lazy_loading_;
+
+  /// The amount of RAM the engine may use before new data is memory mapped
+  /// and existing data frames are moved to memory mapping, in MB. 0 means
+  /// that there is no limit. Only relevant when in_memory_ is true.
+  size_t memory_budget_;
+
+  /// Whether fitted preprocessors, feature learners and predictors should
+  /// also be cached in the project directory, so they can be reused after a
+  /// restart.
+  bool persistent_cache_;
+
+  /// The maximum size of the persistent cache, in MB.
+  size_t persistent_cache_size_;
+
   /// The port of the engine
   size_t port_;
 
@@ -10,6 +10,7 @@
 
 #include "engine/config/EngineOptions.hpp"
 #include "engine/config/MonitorOptions.hpp"
+#include "memmap/MemoryLedger.hpp"
 #include "memmap/Pool.hpp"
 
 #include <memory>
@@ -73,10 +74,14 @@ class Options {
   /// Trivial accessor
   const MonitorOptions& monitor() const { return monitor_; }
 
-  /// Generates a new memory-mapped pool.
+  /// Generates a new memory-mapped pool. Returns a nullptr, if the engine
+  /// runs in memory and the memory budget has not been exceeded.
   std::shared_ptr<memmap::Pool> make_pool() const {
-    return engine_.in_memory_ ? std::shared_ptr<memmap::Pool>()
-                              : std::make_shared<memmap::Pool>(temp_dir());
+    const bool in_memory =
+        engine_.in_memory_ && !memmap::MemoryLedger::global().exceeds_budget(
+                                  engine_.memory_budget_ * 1000000);
+    return in_memory ? std::shared_ptr<memmap::Pool>()
+                     : std::make_shared<memmap::Pool>(temp_dir());
   }
 
   /// Generates the path for the project directory.
@@ -0,0 +1,154 @@
+// Copyright 2024 Code17 GmbH
+//
+// This file is licensed under the Elastic License 2.0 (ELv2).
+// Refer to the LICENSE.txt file in the root of the repository
+// for details.
+//
+
+#ifndef ENGINE_DEPENDENCY_PERSISTENTCACHE_HPP_
+#define ENGINE_DEPENDENCY_PERSISTENTCACHE_HPP_
+
+#include "containers/Encoding.hpp"
+
+#include <rfl/Ref.hpp>
+
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace engine {
+namespace dependency {
+
+/// A content-addressed cache on disk, which maps the JSON representation of a
+/// fingerprint to a fitted object. Unlike the in-memory trackers, it survives
+/// restarts of the engine. When the cache exceeds its size limit, the least
+/// recently used entries are evicted.
+///
+/// The fitted objects refer to categories and join keys by their integer
+/// ids, which are only meaningful with respect to the encodings they were
+/// fitted with. Every entry therefore records the state of the encodings and
+/// is discarded, when the current encodings do not start with the same
+/// strings.
+class PersistentCache {
+ public:
+  /// The name of the file containing the state of the encodings.
+  static constexpr const char* ENCODINGS_FILE = "encodings.json";
+
+  /// The name of the file containing the fingerprint. It is written last, so
+  /// entries without it are incomplete.
+  static constexpr const char* FINGERPRINT_FILE = "fingerprint.json";
+
+  /// The name under which the object itself is stored.
+  static constexpr const char* OBJECT_FILE = "obj";
+
+ private:
+  struct Entry {
+    /// The size of all files in the entry.
+    size_t nbytes_;
+
+    /// Used for the LRU eviction.
+    std::filesystem::file_time_type last_access_;
+  };
+
+  /// The number of strings in an encoding and a digest of these strings.
+  struct EncodingState {
+    std::string digest_;
+    size_t size_;
+  };
+
+  /// The state of the encodings when an entry was stored.
+  struct EncodingStates {
+    EncodingState categories_;
+    EncodingState join_keys_encoding_;
+  };
+
+ public:
+  PersistentCache(const std::string& _dir, const size_t _max_bytes,
+                  const rfl::Ref<containers::Encoding>& _categories,
+                  const rfl::Ref<containers::Encoding>& _join_keys_encoding);
+
+  ~PersistentCache() = default;
+
+ public:
+  /// Returns the name of the file the object has been stored in, if an entry
+  /// for this fingerprint exists.
+  std::optional<std::string> lookup(const std::string& _f_str);
+
+  /// Removes an entry, for instance because it could not be loaded.
+  void remove(const std::string& _f_str);
+
+  /// Stores a new entry, _save is expected to write the object to the file
+  /// name passed to it.
+  void store(const std::string& _f_str,
+             const std::function<void(const std::string&)>& _save);
+
+  /// Trivial accessor
+  size_t nbytes() const { return nbytes_; }
+
+ private:
+  /// Calculates the size of all files in a directory.
+  static size_t calc_nbytes(const std::filesystem::path& _path);
+
+  /// Calculates a SHA-256 digest of the first _size strings of _encoding -
+  /// the mutex must already be locked.
+  std::string digest(const containers::Encoding& _encoding,
+                     const size_t _size);
+
+  /// Evicts the least recently used entries until the size limit is met.
+  void evict();
+
+  /// Whether the current encodings start with the strings described by
+  /// _states - the mutex must already be locked.
+  bool is_valid(const EncodingStates& _states);
+
+  /// Describes the current state of the encodings - the mutex must already
+  /// be locked.
+  EncodingStates make_encoding_states();
+
+  /// Generates the key under which the fingerprint is stored. It is a
+  /// SHA-256 digest, so it is the same for every build of the engine.
+  static std::string make_key(const std::string& _f_str);
+
+  /// Reads the entries that already exist in the directory.
+  void read_entries();
+
+  /// Removes an entry - the mutex must already be locked.
+  void remove_key(const std::string& _key);
+
+ private:
+  /// The encoding for categorical variables.
+  const rfl::Ref<containers::Encoding> categories_;
+
+  /// Digests that have already been calculated, by encoding and size. The
+  /// encodings only grow until the project is changed, which also replaces
+  /// the cache, so they remain valid.
+  std::map<std::pair<const containers::Encoding*, size_t>, std::string>
+      digests_;
+
+  /// The directory in which the entries are stored.
+  const std::filesystem::path dir_;
+
+  /// Maps the key to the entries.
+  std::map<std::string, Entry> entries_;
+
+  /// The encoding for join keys.
+  const rfl::Ref<containers::Encoding> join_keys_encoding_;
+
+  /// The maximum size of the cache.
+  const size_t max_bytes_;
+
+  /// For thread safety.
+  std::mutex mtx_;
+
+  /// The current size of the cache.
+  size_t nbytes_;
+};
+
+}  // namespace dependency
+}  // namespace engine
+
+#endif  // ENGINE_DEPENDENCY_PERSISTENTCACHE_HPP_
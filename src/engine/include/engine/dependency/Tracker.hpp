@@ -8,10 +8,15 @@
 #ifndef ENGINE_DEPENDENCY_TRACKER_HPP_
 #define ENGINE_DEPENDENCY_TRACKER_HPP_
 
+#include "engine/dependency/PersistentCache.hpp"
+#include "helpers/Saver.hpp"
+
 #include <rfl/Ref.hpp>
 #include <rfl/json/write.hpp>
 
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 
@@ -32,15 +37,45 @@ class Tracker {
   /// Removes all elements.
   void clear();
 
+  /// Writes the element to the persistent cache, if there is one.
+  void persist(const rfl::Ref<const T>& _elem) const;
+
   /// Retrieves a deep copy of an element from the tracker, if an element
   /// containing this fingerprint exists.
   template <class FingerprintType>
   std::optional<rfl::Ref<T>> retrieve(
       const FingerprintType& _fingerprint) const;
 
+  /// Retrieves a fitted version of _elem from the persistent cache, if an
+  /// element with the same fingerprint has been persisted. The element is
+  /// also added to the tracker.
+  std::optional<rfl::Ref<T>> retrieve_persisted(const rfl::Ref<const T>& _elem);
+
+  /// Makes the tracker persist its elements on disk, so they can be
+  /// retrieved after the engine has been restarted.
+  void set_persistent_cache(
+      const std::shared_ptr<PersistentCache>& _persistent_cache) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    persistent_cache_ = _persistent_cache;
+  }
+
+ private:
+  /// Returns the persistent cache, which may be a nullptr.
+  std::shared_ptr<PersistentCache> get_persistent_cache() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return persistent_cache_;
+  }
+
  private:
   /// A map keeping track of the elements.
   std::map<size_t, rfl::Ref<const T>> elements_;
+
+  /// Optional cache on disk, shared between the trackers.
+  std::shared_ptr<PersistentCache> persistent_cache_;
+
+  /// Pipelines can be loaded lazily while the engine only holds a read lock,
+  /// so the tracker must protect its own state.
+  mutable std::mutex mtx_;
 };
 
 // -------------------------------------------------------------------------
@@ -54,6 +89,8 @@ void Tracker<T>::add(const rfl::Ref<const T>& _elem) {
 
   const auto f_hash = std::hash<std::string>()(f_str);
 
+  std::lock_guard<std::mutex> lock(mtx_);
+
   elements_.insert_or_assign(f_hash, _elem);
 }
 
@@ -61,7 +98,28 @@ void Tracker<T>::add(const rfl::Ref<const T>& _elem) {
 
 template <class T>
 void Tracker<T>::clear() {
-  *this = Tracker();
+  std::lock_guard<std::mutex> lock(mtx_);
+  elements_.clear();
+  persistent_cache_.reset();
+}
+
+// -------------------------------------------------------------------------
+
+template <class T>
+void Tracker<T>::persist(const rfl::Ref<const T>& _elem) const {
+  const auto persistent_cache = get_persistent_cache();
+
+  if (!persistent_cache) {
+    return;
+  }
+
+  const auto f_str = rfl::json::write(_elem->fingerprint());
+
+  const auto save = [&_elem](const std::string& _fname) {
+    _elem->save(_fname, helpers::Saver::Format::make<"msgpack">());
+  };
+
+  persistent_cache->store(f_str, save);
 }
 
 // -------------------------------------------------------------------------
@@ -74,14 +132,16 @@ std::optional<rfl::Ref<T>> Tracker<T>::retrieve(
 
   const auto f_hash = std::hash<std::string>()(f_str);
 
-  const auto it = elements_.find(f_hash);
+  const auto ptr = [&]() -> std::shared_ptr<const T> {
+    std::lock_guard<std::mutex> lock(mtx_);
+    const auto it = elements_.find(f_hash);
+    return it != elements_.end() ? it->second.ptr() : nullptr;
+  }();
 
-  if (it == elements_.end()) {
+  if (!ptr) {
     return std::nullopt;
   }
 
-  const auto ptr = it->second;
-
   const auto fingerprint2 = ptr->fingerprint();
 
   const auto f2_str = rfl::json::write(fingerprint2);
@@ -94,6 +154,39 @@ std::optional<rfl::Ref<T>> Tracker<T>::retrieve(
   return ptr->clone();
 }
 
+// -------------------------------------------------------------------------
+
+template <class T>
+std::optional<rfl::Ref<T>> Tracker<T>::retrieve_persisted(
+    const rfl::Ref<const T>& _elem) {
+  const auto persistent_cache = get_persistent_cache();
+
+  if (!persistent_cache) {
+    return std::nullopt;
+  }
+
+  const auto f_str = rfl::json::write(_elem->fingerprint());
+
+  const auto fname = persistent_cache->lookup(f_str);
+
+  if (!fname) {
+    return std::nullopt;
+  }
+
+  const auto loaded = _elem->clone();
+
+  try {
+    loaded->load(*fname);
+  } catch (std::exception& e) {
+    persistent_cache->remove(f_str);
+    return std::nullopt;
+  }
+
+  add(loaded);
+
+  return loaded->clone();
+}
+
 // -------------------------------------------------------------------------
 }  // namespace dependency
 }  // namespace engine
@@ -10,6 +10,7 @@
 
 #include "engine/dependency/DataFrameTracker.hpp"
 #include "engine/dependency/FETracker.hpp"
+#include "engine/dependency/PersistentCache.hpp"
 #include "engine/dependency/PredTracker.hpp"
 #include "engine/dependency/PreprocessorTracker.hpp"
 #include "engine/dependency/Tracker.hpp"
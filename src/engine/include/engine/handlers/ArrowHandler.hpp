@@ -8,6 +8,7 @@
 #ifndef ENGINE_HANDLERS_ARROWHANDLER_HPP_
 #define ENGINE_HANDLERS_ARROWHANDLER_HPP_
 
+#include "commands/ParquetFilter.hpp"
 #include "containers/DataFrame.hpp"
 #include "containers/Encoding.hpp"
 #include "engine/Float.hpp"
@@ -20,6 +21,7 @@
 #include <arrow/ipc/api.h>
 #include <parquet/arrow/reader.h>
 #include <parquet/arrow/writer.h>
+#include <parquet/metadata.h>
 #include <rfl/Ref.hpp>
 
 #include <cctype>
@@ -34,6 +36,16 @@ class ArrowHandler {
   using FloatFunction = std::function<Float(const std::int64_t)>;
   using StringFunction = std::function<strings::String(const std::int64_t)>;
 
+  /// The columns read from a single row group of a parquet file.
+  struct ParquetPart {
+    std::vector<containers::Column<Float>> floats_;
+    std::vector<containers::Column<strings::String>> strings_;
+  };
+
+ public:
+  /// The number of rows per row group, unless explicitly set otherwise.
+  static constexpr size_t DEFAULT_ROW_GROUP_SIZE = 100000;
+
  public:
   ArrowHandler(const rfl::Ref<containers::Encoding>& _categories,
                const rfl::Ref<containers::Encoding>& _join_keys_encoding,
@@ -46,9 +58,20 @@ class ArrowHandler {
   std::shared_ptr<arrow::Table> df_to_table(
       const containers::DataFrame& _df) const;
 
-  /// Reads a parquet file and returns an arrow::Table.
-  std::shared_ptr<arrow::Table> read_parquet(
-      const std::string& _filename) const;
+  /// Reads a parquet file into a DataFrame. Only the columns contained in
+  /// _schema are read. The row groups are read in parallel, but never more
+  /// row groups than there are threads are held in memory at any point.
+  /// Rows that do not pass _filters are dropped.
+  containers::DataFrame read_parquet(
+      const std::string& _filename, const std::string& _name,
+      const containers::Schema& _schema,
+      const std::vector<commands::ParquetFilter>& _filters) const;
+
+  /// Whether any row in the column chunk could pass the _filter, judging by
+  /// its statistics. Returns true whenever the statistics are inconclusive.
+  static bool row_group_may_pass(const parquet::ColumnChunkMetaData& _chunk,
+                                 const parquet::ColumnDescriptor& _descr,
+                                 const commands::ParquetFilter& _filter);
 
   /// Receives an arrow::Table from a stream socket.
   template <class T>
@@ -69,10 +92,14 @@ class ArrowHandler {
   void send_table(const std::shared_ptr<arrow::Table>& _table,
                   Poco::Net::StreamSocket* _socket) const;
 
-  /// Stores an arrow table as a parquet file.
-  void to_parquet(const std::shared_ptr<arrow::Table>& _table,
+  /// Stores a DataFrame as a parquet file. The data frame is converted and
+  /// written one row group at a time, the columns of each row group are
+  /// converted in parallel.
+  void to_parquet(const containers::DataFrame& _df,
                   const std::string& _filename,
-                  const std::string& _compression) const;
+                  const std::string& _compression,
+                  const size_t _row_group_size = DEFAULT_ROW_GROUP_SIZE,
+                  const bool _use_dictionary = true) const;
 
   /// Extracts a DataFrame from an arrow::Table.
   containers::DataFrame table_to_df(const std::shared_ptr<arrow::Table>& _table,
@@ -84,14 +111,25 @@ class ArrowHandler {
   std::shared_ptr<arrow::Schema> df_to_schema(
       const containers::DataFrame& _df) const;
 
-  /// Extracts the arrays from a DataFrame.
+  /// Extracts the rows _begin to _end of every column in a DataFrame as
+  /// arrays. The columns are converted in parallel.
   std::vector<std::shared_ptr<arrow::ChunkedArray>> extract_arrays(
-      const containers::DataFrame& _df) const;
+      const containers::DataFrame& _df, const size_t _begin,
+      const size_t _end) const;
 
   /// Returns the appropriate compression format.
   parquet::Compression::type parse_compression(
       const std::string& _compression) const;
 
+  /// Reads the columns _float_colnames and _string_colnames from a single
+  /// row group and drops all rows that do not pass _filters.
+  ParquetPart read_row_group(
+      parquet::arrow::FileReader* _reader, const int _row_group,
+      const std::vector<int>& _column_indices,
+      const std::vector<std::string>& _float_colnames,
+      const std::vector<std::string>& _string_colnames,
+      const std::vector<commands::ParquetFilter>& _filters) const;
+
   /// Converts a chunked array to a float column.
   template <class T>
   containers::Column<T> to_column(
@@ -21,14 +21,21 @@
 #include <rfl/NamedTuple.hpp>
 #include <rfl/Ref.hpp>
 
+#include <chrono>
 #include <map>
 #include <string>
+#include <vector>
 
 namespace engine {
 namespace handlers {
 
 class DataFrameManager {
  public:
+  /// How long enforce_memory_budget() waits for the write lock, before it
+  /// leaves the budget to the next request.
+  static constexpr std::chrono::milliseconds MEMORY_BUDGET_LOCK_TIMEOUT =
+      std::chrono::milliseconds(100);
+
   static constexpr const char* FLOAT_COLUMN =
       containers::Column<bool>::FLOAT_COLUMN;
   static constexpr const char* STRING_COLUMN =
@@ -52,6 +59,12 @@ class DataFrameManager {
   ~DataFrameManager() = default;
 
  public:
+  /// Moves in-memory data frames to memory mapping, starting with the ones
+  /// that have not been changed for the longest time, until the engine is
+  /// within its memory budget again. Does nothing, if there is nothing to
+  /// move or the write lock cannot be acquired quickly.
+  void enforce_memory_budget();
+
   /// Executes a DataFrameCommand.
   void execute_command(const Command& _command,
                        Poco::Net::StreamSocket* _socket);
@@ -206,7 +219,8 @@ class DataFrameManager {
   void remove_column(const typename Command::RemoveColumnOp& _cmd,
                      Poco::Net::StreamSocket* _socket);
 
-  /// Sends summary statistics back to the client.
+  /// Sends summary statistics back to the client, including the
+  /// correlations and histograms of the numerical columns.
   void summarize(const typename Command::SummarizeDataFrameOp& _cmd,
                  Poco::Net::StreamSocket* _socket);
 
@@ -256,6 +270,24 @@ class DataFrameManager {
       containers::DataFrame* _df,
       multithreading::WeakWriteLock* _weak_write_lock) const;
 
+  /// The names of the data frames that are still held in memory, the ones
+  /// that have not been changed for the longest time first.
+  std::vector<std::string> memory_budget_candidates() const;
+
+  /// Whether the data frame can be removed from memory and loaded from the
+  /// project directory once it is needed again, instead of being moved to
+  /// memory mapping. The write lock must be held.
+  bool may_unload(const containers::DataFrame& _df) const;
+
+  /// Moves the data frames returned by memory_budget_candidates() to memory
+  /// mapping until the engine is within its memory budget. Data frames that
+  /// may be unloaded are removed from memory instead. Stops early, once a
+  /// move no longer lowers the resident memory. The write lock must
+  /// be held. Called by the commands that create large data frames
+  /// while they still hold the lock, so the budget is not left to the next
+  /// request.
+  void move_to_memory_mapping();
+
   /// Receives the actual data contained in a DataFrame
   void receive_data(
       const rfl::Ref<containers::Encoding>& _local_categories,
@@ -11,10 +11,12 @@
 #include "containers/DataFrame.hpp"
 #include "containers/Encoding.hpp"
 #include "engine/handlers/DatabaseManager.hpp"
+#include "engine/handlers/LazyDataFrames.hpp"
 
 #include <Poco/Net/StreamSocket.h>
 
 #include <map>
+#include <memory>
 #include <string>
 
 namespace engine {
@@ -33,6 +35,11 @@ struct DataFrameManagerParams {
   /// Maps integers to join key names
   const rfl::Ref<containers::Encoding> join_keys_encoding_;
 
+  /// The data frames that are saved in the project directory, but not held
+  /// in memory. nullptr for data frames that only exist for the duration of
+  /// a request, which are never unloaded.
+  const std::shared_ptr<LazyDataFrames> lazy_data_frames_;
+
   /// For logging
   const rfl::Ref<const communication::Logger> logger_;
 
@@ -32,6 +32,10 @@ struct FileHandler {
   /// "data" and "models", if they do not already exist
   static void create_project_directory(const std::string& _project_directory);
 
+  /// Calculates a SHA-256 digest of the first _size strings of _encoding.
+  static std::string digest(const containers::Encoding& _encoding,
+                            const size_t _size);
+
   /// Determines the appropriate file ending for ColumnType
   template <class ColumnType>
   static std::string file_ending();
@@ -53,11 +57,23 @@ struct FileHandler {
                              containers::Encoding* _categories,
                              containers::Encoding* _join_keys_encodings);
 
-  /// Reads categories or join keys encoding from file
+  /// Returns the number of entries of _encoding that have already been
+  /// written to the files starting with _fname by write_encoding(...). If
+  /// the files do not contain a prefix of _encoding, this is zero.
+  static size_t num_saved(const std::string& _fname,
+                          const containers::Encoding& _encoding);
+
+  /// Reads an encoding written by write_encoding(...). A
+  /// MemoryMappedEncoding restores its hash table from _fname + ".hashes",
+  /// if possible, instead of rehashing every string.
+  static void read_encoding(const std::string& _fname,
+                            containers::Encoding* _encoding);
+
+  /// Reads categories or join keys encoding from file (legacy format)
   static std::vector<std::string> read_strings_big_endian(
       const std::string& _fname);
 
-  /// Reads categories or join keys encoding from file
+  /// Reads categories or join keys encoding from file (legacy format)
   static std::vector<std::string> read_strings_little_endian(
       const std::string& _fname);
 
@@ -79,13 +95,16 @@ struct FileHandler {
       const std::shared_ptr<const containers::Encoding> _categories,
       const std::shared_ptr<const containers::Encoding> _join_keys_encodings);
 
-  /// Writes categories or join keys encoding to file
-  static void write_string_big_endian(const std::string& _fname,
-                                      const containers::Encoding& _strings);
-
-  /// Writes categories or join keys encoding to file
-  static void write_string_little_endian(const std::string& _fname,
-                                         const containers::Encoding& _strings);
+  /// Writes categories or join keys encoding to _fname + ".strings", which
+  /// contains all strings back to back, and _fname + ".offsets", which
+  /// contains the end of every string as a big-endian 64-bit integer. Both
+  /// files are append-only, so only the entries that have been added since
+  /// the last call are written. The digest of the saved strings goes to
+  /// _fname + ".digest", so num_saved(...) can check that they are a prefix
+  /// of the encoding. A MemoryMappedEncoding also writes its hash table to
+  /// _fname + ".hashes".
+  static void write_encoding(const std::string& _fname,
+                             const containers::Encoding& _encoding);
 
   // ------------------------------------------------------------------------
 
@@ -184,7 +184,16 @@ class FloatOpParser {
       return static_cast<Float>(_i);
     };
 
-    return containers::ColumnView<Float>(value_func, NROWS_INFINITE);
+    const auto batch_func = [](const size_t _begin, const size_t _end,
+                               std::vector<Float>* _out) {
+      _out->resize(_end - _begin);
+      for (size_t i = _begin; i < _end; ++i) {
+        (*_out)[i - _begin] = static_cast<Float>(i);
+      }
+    };
+
+    return containers::ColumnView<Float>(value_func, NROWS_INFINITE, {}, "",
+                                         batch_func);
   }
 
   /// Undertakes a unary operation based on template class
@@ -0,0 +1,138 @@
+// Copyright 2024 Code17 GmbH
+//
+// This file is licensed under the Elastic License 2.0 (ELv2).
+// Refer to the LICENSE.txt file in the root of the repository
+// for details.
+//
+
+#ifndef ENGINE_HANDLERS_LAZYDATAFRAMES_HPP_
+#define ENGINE_HANDLERS_LAZYDATAFRAMES_HPP_
+
+#include "containers/DataFrame.hpp"
+#include "containers/Encoding.hpp"
+#include "engine/config/Options.hpp"
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace engine {
+namespace handlers {
+
+/// Keeps track of the data frames that are saved in the project directory,
+/// but are not held in memory, either because they have not been needed
+/// since the project was loaded or because they have been unloaded to stay
+/// within the memory budget. They are loaded once a request refers to them.
+/// Access to the registered names must be coordinated using the same
+/// read_write_lock as the data frames themselves.
+class LazyDataFrames {
+ public:
+  struct Entry {
+    /// The last change recorded when the data frame was registered.
+    std::string last_change_;
+
+    /// The roles of the data frame's columns as JSON, so they can be
+    /// retrieved without loading it. Data frames saved by older versions
+    /// do not contain them.
+    std::optional<std::string> roles_;
+  };
+
+  /// Counts a request as being handled for as long as it lives.
+  class RequestScope {
+   public:
+    explicit RequestScope(LazyDataFrames* _lazy_data_frames)
+        : lazy_data_frames_(_lazy_data_frames) {
+      ++lazy_data_frames_->num_requests_;
+    }
+
+    ~RequestScope() { --lazy_data_frames_->num_requests_; }
+
+    RequestScope(const RequestScope&) = delete;
+
+    RequestScope& operator=(const RequestScope&) = delete;
+
+   private:
+    /// The registry whose requests are counted.
+    LazyDataFrames* const lazy_data_frames_;
+  };
+
+ public:
+  LazyDataFrames() : num_requests_(0) {}
+
+  ~LazyDataFrames() = default;
+
+ public:
+  /// Registers a data frame saved in the project directory, so it can be
+  /// loaded once it is needed.
+  void add(const std::string& _name, const std::string& _project_directory);
+
+  /// Registers a data frame that is about to be removed from memory. The
+  /// data frame must have been saved, see is_saved(...).
+  void add(const containers::DataFrame& _df);
+
+  /// Whether _df is identical to the version saved in the project
+  /// directory, so it can be removed from memory without losing anything.
+  static bool is_saved(const containers::DataFrame& _df,
+                       const std::string& _project_directory);
+
+  /// Loads a registered data frame from the project directory. Throws, if
+  /// it has been changed on disk since it was registered.
+  containers::DataFrame load(
+      const std::string& _name,
+      const std::shared_ptr<containers::Encoding>& _categories,
+      const std::shared_ptr<containers::Encoding>& _join_keys_encoding,
+      const config::Options& _options) const;
+
+  /// The names of all registered data frames.
+  std::vector<std::string> names() const;
+
+  /// The names of the registered data frames that are referred to in the
+  /// command.
+  std::vector<std::string> referenced_by(const std::string& _cmd_str) const;
+
+  /// The roles of a registered data frame's columns as JSON, if they are
+  /// known.
+  std::optional<std::string> roles(const std::string& _name) const;
+
+  /// Whether data frames may be removed from memory. Only the case when the
+  /// calling request is the only one being handled, because the others may
+  /// have loaded the data frames they need before acquiring their locks.
+  bool unload_allowed() const { return num_requests_ <= 1; }
+
+ public:
+  /// Removes all registered data frames.
+  void clear() { entries_.clear(); }
+
+  /// Whether the data frame is registered.
+  bool contains(const std::string& _name) const {
+    return entries_.contains(_name);
+  }
+
+  /// Whether no data frames are registered.
+  bool empty() const { return entries_.empty(); }
+
+  /// Removes a data frame from the registry.
+  void erase(const std::string& _name) { entries_.erase(_name); }
+
+ private:
+  /// Reads a text file saved along with a data frame, if it exists.
+  static std::optional<std::string> read_textfile(
+      const std::string& _name, const std::string& _project_directory,
+      const std::string& _fname);
+
+ private:
+  /// Maps the names of the registered data frames to what is known about
+  /// them.
+  std::map<std::string, Entry> entries_;
+
+  /// The number of requests that are currently being handled.
+  std::atomic<size_t> num_requests_;
+};
+
+}  // namespace handlers
+}  // namespace engine
+
+#endif  // ENGINE_HANDLERS_LAZYDATAFRAMES_HPP_
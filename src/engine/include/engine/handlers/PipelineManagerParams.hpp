@@ -14,6 +14,7 @@
 #include "engine/dependency/PreprocessorTracker.hpp"
 #include "engine/dependency/WarningTracker.hpp"
 #include "engine/handlers/DatabaseManager.hpp"
+#include "engine/handlers/LazyDataFrames.hpp"
 #include "engine/pipelines/Pipeline.hpp"
 
 #include <Poco/Net/StreamSocket.h>
@@ -46,6 +47,10 @@ struct PipelineManagerParams {
   /// Maps integers to join key names
   const rfl::Ref<containers::Encoding> join_keys_encoding_;
 
+  /// The data frames that are saved in the project directory, but not held
+  /// in memory.
+  const rfl::Ref<LazyDataFrames> lazy_data_frames_;
+
   /// For logging
   const rfl::Ref<const communication::Logger> logger_;
 
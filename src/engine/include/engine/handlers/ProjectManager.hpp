@@ -36,6 +36,11 @@ class ProjectManager {
   void execute_command(const Command& _command,
                        Poco::Net::StreamSocket* _socket);
 
+  /// Loads the unloaded data frames the command refers to from the project
+  /// directory, so they are in memory before the command is handled.
+  void load_lazy_data_frames(const std::string& _type,
+                             const std::string& _cmd_str);
+
  private:
   /// Adds a new data frame read from an arrow table.
   void add_data_frame_from_arrow(const typename Command::AddDfFromArrowOp& _cmd,
@@ -111,6 +116,11 @@ class ProjectManager {
   void load_pipeline(const typename Command::LoadPipelineOp& _cmd,
                      Poco::Net::StreamSocket* _socket);
 
+  /// Reports how much memory the engine uses, as a whole and per data
+  /// frame.
+  void memory_usage(const typename Command::MemoryUsageOp& _cmd,
+                    Poco::Net::StreamSocket* _socket) const;
+
   /// Get the name of the current project.
   void project_name(const typename Command::ProjectNameOp& _cmd,
                     Poco::Net::StreamSocket* _socket) const;
@@ -145,6 +155,10 @@ class ProjectManager {
   /// encodings.
   void clear();
 
+  /// Connects the trackers to the persistent cache in the project directory,
+  /// if the persistent cache has been enabled.
+  void init_persistent_cache();
+
  private:
   /// Trivial accessor
   containers::Encoding& categories() { return *params_.categories_; }
@@ -199,6 +213,14 @@ class ProjectManager {
     return *params_.join_keys_encoding_;
   }
 
+  /// Trivial accessor
+  LazyDataFrames& lazy_data_frames() { return *params_.lazy_data_frames_; }
+
+  /// Trivial (const) accessor
+  const LazyDataFrames& lazy_data_frames() const {
+    return *params_.lazy_data_frames_;
+  }
+
   /// Trivial (private) accessor
   const communication::Logger& logger() { return *params_.logger_; }
 
@@ -214,6 +236,11 @@ class ProjectManager {
   /// Trivial accessor
   dependency::PredTracker& pred_tracker() { return *params_.pred_tracker_; }
 
+  /// Trivial accessor
+  dependency::PreprocessorTracker& preprocessor_tracker() {
+    return *params_.preprocessor_tracker_;
+  }
+
   /// Trivial (private) setter.
   void set_pipeline(const std::string& _name,
                     const pipelines::Pipeline& _pipeline) {
@@ -44,6 +44,10 @@ struct ProjectManagerParams {
   /// Maps integers to join key names
   const rfl::Ref<containers::Encoding> join_keys_encoding_;
 
+  /// The data frames that are saved in the project directory, but not held
+  /// in memory.
+  const rfl::Ref<LazyDataFrames> lazy_data_frames_;
+
   /// For logging
   const rfl::Ref<const communication::Logger> logger_;
 
@@ -17,6 +17,9 @@
 #include <rfl/NamedTuple.hpp>
 #include <rfl/Ref.hpp>
 
+#include <optional>
+#include <set>
+#include <string>
 #include <vector>
 
 namespace engine {
@@ -51,6 +54,11 @@ struct FeaturesOnlyParams {
   rfl::Field<"predictor_impl_", rfl::Ref<const predictors::PredictorImpl>>
       predictor_impl;
 
+  /// The staged columns read by the preprocessors and feature learners, if
+  /// known. Staging only joins these columns of the peripheral tables.
+  rfl::Field<"referenced_columns_", std::optional<std::set<std::string>>>
+      referenced_columns;
+
   /// The parameters needed for transform(...).
   rfl::Field<"transform_params_", TransformParams> transform_params;
 };
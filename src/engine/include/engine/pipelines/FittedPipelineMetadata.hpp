@@ -0,0 +1,45 @@
+// Copyright 2024 Code17 GmbH
+//
+// This file is licensed under the Elastic License 2.0 (ELv2).
+// Refer to the LICENSE.txt file in the root of the repository
+// for details.
+//
+
+#ifndef ENGINE_PIPELINES_FITTEDPIPELINEMETADATA_HPP_
+#define ENGINE_PIPELINES_FITTEDPIPELINEMETADATA_HPP_
+
+#include "helpers/Schema.hpp"
+
+#include <rfl/Ref.hpp>
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace engine {
+namespace pipelines {
+
+/// The parts of a fitted pipeline that are needed to describe it. They are
+/// stored in pipeline.json, so they are available without loading the
+/// preprocessors, feature learners and predictors of a lazily loaded
+/// pipeline.
+struct FittedPipelineMetadata {
+  /// The number of features, std::nullopt for pipelines saved by older
+  /// versions.
+  std::optional<size_t> num_features_;
+
+  /// The schema of the peripheral tables as they are originally passed.
+  rfl::Ref<const std::vector<helpers::Schema>> peripheral_schema_;
+
+  /// The schema of the population table as originally passed.
+  rfl::Ref<const helpers::Schema> population_schema_;
+
+  /// The names of the targets.
+  std::vector<std::string> targets_;
+};
+
+}  // namespace pipelines
+}  // namespace engine
+
+#endif  // ENGINE_PIPELINES_FITTEDPIPELINEMETADATA_HPP_
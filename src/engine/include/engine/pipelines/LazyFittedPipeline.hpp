@@ -0,0 +1,69 @@
+// Copyright 2024 Code17 GmbH
+//
+// This file is licensed under the Elastic License 2.0 (ELv2).
+// Refer to the LICENSE.txt file in the root of the repository
+// for details.
+//
+
+#ifndef ENGINE_PIPELINES_LAZYFITTEDPIPELINE_HPP_
+#define ENGINE_PIPELINES_LAZYFITTEDPIPELINE_HPP_
+
+#include "engine/pipelines/FittedPipeline.hpp"
+#include "engine/pipelines/FittedPipelineMetadata.hpp"
+
+#include <rfl/Ref.hpp>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace engine {
+namespace pipelines {
+
+/// A fitted pipeline that is only loaded from disk once it is first needed.
+/// It is shared by all copies of the pipeline, so it is loaded at most once.
+/// The metadata is read from pipeline.json right away, so the pipeline can
+/// be described without being loaded.
+class LazyFittedPipeline {
+ public:
+  using LoaderType = std::function<rfl::Ref<const FittedPipeline>()>;
+
+ public:
+  LazyFittedPipeline(const LoaderType& _loader,
+                     const FittedPipelineMetadata& _metadata)
+      : loader_(_loader), metadata_(_metadata) {}
+
+  ~LazyFittedPipeline() = default;
+
+ public:
+  /// Returns the fitted pipeline, loading it if necessary. If loading fails,
+  /// the exception is passed on and the next call tries again.
+  std::shared_ptr<const FittedPipeline> get() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (!fitted_) {
+      fitted_ = loader_().ptr();
+    }
+    return fitted_;
+  }
+
+  /// Trivial (const) accessor
+  const FittedPipelineMetadata& metadata() const { return metadata_; }
+
+ private:
+  /// The fitted pipeline, once it has been loaded.
+  mutable std::shared_ptr<const FittedPipeline> fitted_;
+
+  /// Loads the fitted pipeline.
+  const LoaderType loader_;
+
+  /// Describes the fitted pipeline without loading it.
+  const FittedPipelineMetadata metadata_;
+
+  /// Makes sure that only one thread loads the fitted pipeline.
+  mutable std::mutex mtx_;
+};
+
+}  // namespace pipelines
+}  // namespace engine
+
+#endif  // ENGINE_PIPELINES_LAZYFITTEDPIPELINE_HPP_
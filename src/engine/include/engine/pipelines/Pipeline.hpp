@@ -11,6 +11,8 @@
 
 #include "commands/Pipeline.hpp"
 #include "engine/pipelines/FittedPipeline.hpp"
+#include "engine/pipelines/FittedPipelineMetadata.hpp"
+#include "engine/pipelines/LazyFittedPipeline.hpp"
 #include "engine/pipelines/MonitorSummary.hpp"
 #include "helpers/Placeholder.hpp"
 #include "helpers/StringIterator.hpp"
@@ -23,6 +25,7 @@
 #include <Poco/TemporaryFile.h>
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -58,12 +61,24 @@ class Pipeline {
   /// Trivial (const) accessor
   const auto& creation_time() const { return creation_time_; }
 
-  /// Trivial (const) accessor
-  const auto& fitted() const { return fitted_; }
+  /// Returns the fitted pipeline, loading it first, if it has been loaded
+  /// lazily.
+  std::shared_ptr<const FittedPipeline> fitted() const {
+    return lazy_fitted_ ? lazy_fitted_->get() : fitted_;
+  }
+
+  /// Describes the fitted pipeline, without loading it, if it has been
+  /// loaded lazily. Returns std::nullopt, if the pipeline has not been
+  /// fitted.
+  std::optional<FittedPipelineMetadata> fitted_metadata() const;
 
   /// Trivial (const) accessor
   bool include_categorical() const { return include_categorical_; }
 
+  /// Whether the pipeline has been fitted. Unlike fitted(), this never loads
+  /// a lazily loaded pipeline.
+  bool is_fitted() const { return lazy_fitted_ || fitted_; }
+
   /// Trivial (const) accessor
   const commands::Pipeline& obj() const { return *obj_; }
 
@@ -88,6 +103,17 @@ class Pipeline {
   Pipeline with_fitted(const rfl::Ref<const FittedPipeline>& _fitted) const {
     auto new_pipeline = *this;
     new_pipeline.fitted_ = _fitted.ptr();
+    new_pipeline.lazy_fitted_.reset();
+    return new_pipeline;
+  }
+
+  /// Returns a new pipeline, the fitted part of which is loaded on first
+  /// access.
+  Pipeline with_lazy_fitted(
+      const rfl::Ref<const LazyFittedPipeline>& _lazy_fitted) const {
+    auto new_pipeline = *this;
+    new_pipeline.fitted_.reset();
+    new_pipeline.lazy_fitted_ = _lazy_fitted.ptr();
     return new_pipeline;
   }
 
@@ -124,6 +150,9 @@ class Pipeline {
   /// Whether we want to include categorical features
   bool include_categorical_;
 
+  /// The fitted pipeline, if it is loaded lazily.
+  std::shared_ptr<const LazyFittedPipeline> lazy_fitted_;
+
   /// The JSON object used to construct the pipeline.
   rfl::Ref<const commands::Pipeline> obj_;
 
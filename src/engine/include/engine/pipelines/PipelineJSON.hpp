@@ -15,6 +15,8 @@
 #include <rfl/Flatten.hpp>
 #include <rfl/Ref.hpp>
 
+#include <cstddef>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -42,6 +44,10 @@ struct PipelineJSON {
   rfl::Field<"modified_population_schema_", rfl::Ref<const helpers::Schema>>
       modified_population_schema;
 
+  /// The number of features generated by the pipeline. Pipelines saved by
+  /// older versions do not contain this field.
+  rfl::Field<"num_features_", std::optional<size_t>> num_features;
+
   /// The schema of the peripheral tables as they are originally passed.
   rfl::Field<"peripheral_schema_", rfl::Ref<const std::vector<helpers::Schema>>>
       peripheral_schema;
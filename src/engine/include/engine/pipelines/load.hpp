@@ -15,9 +15,11 @@ namespace engine {
 namespace pipelines {
 namespace load {
 
-/// Loads the pipeline from the hard disk.
+/// Loads the pipeline from the hard disk. If _lazy is true, the fitted part
+/// of the pipeline is only loaded once it is first needed.
 Pipeline load(const std::string& _path,
-              const dependency::PipelineTrackers& _pipeline_trackers);
+              const dependency::PipelineTrackers& _pipeline_trackers,
+              const bool _lazy = false);
 
 }  // namespace load
 }  // namespace pipelines
@@ -12,6 +12,8 @@
 
 #include <Poco/Net/StreamSocket.h>
 
+#include <optional>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -20,10 +22,12 @@ namespace pipelines {
 namespace staging {
 
 /// Parses the joined names to execute the many-to-one joins required in the
-/// data model.
+/// data model. If _referenced is set, only the join keys, the time stamps
+/// and the referenced columns of the joined peripheral tables are copied.
 void join_tables(const std::vector<std::string>& _origin_peripheral_names,
                  const std::string& _joined_population_name,
                  const std::vector<std::string>& _joined_peripheral_names,
+                 const std::optional<std::set<std::string>>& _referenced,
                  containers::DataFrame* _population_df,
                  std::vector<containers::DataFrame>* _peripheral_dfs);
 
@@ -21,6 +21,8 @@
 
 #include <memory>
 #include <optional>
+#include <set>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -49,13 +51,29 @@ make_features(
     const predictors::PredictorImpl& _predictor_impl,
     const std::vector<commands::Fingerprint>& _fs_fingerprints);
 
-/// Applies the staging step.
+/// Returns the number of bytes occupied by the features.
+size_t nbytes(const containers::CategoricalFeatures& _categorical_features,
+              const containers::NumericalFeatures& _numerical_features);
+
+/// Returns the number of bytes occupied by the data frames.
+size_t nbytes(const containers::DataFrame& _population_df,
+              const std::vector<containers::DataFrame>& _peripheral_dfs);
+
+/// The directory in which large matrices, such as the features, are
+/// allocated, std::nullopt for keeping them in memory. Called whenever they
+/// are allocated, so exceeding the memory budget in the middle of fitting
+/// moves the remaining ones to memory mapping.
+std::optional<std::string> temp_dir(const containers::Encoding& _categories);
+
+/// Applies the staging step. If _referenced is set, only the referenced
+/// columns of the peripheral tables are joined.
 std::pair<containers::DataFrame, std::vector<containers::DataFrame>>
 stage_data_frames(const Pipeline& _pipeline,
                   const containers::DataFrame& _population_df,
                   const std::vector<containers::DataFrame>& _peripheral_dfs,
                   const std::shared_ptr<const communication::Logger>& _logger,
                   const std::optional<std::string>& _temp_dir,
+                  const std::optional<std::set<std::string>>& _referenced,
                   Poco::Net::StreamSocket* _socket);
 
 /// Transforms a set of input data using the fitted pipeline.
@@ -52,6 +52,9 @@ class EMailDomain final : public Preprocessor {
   std::pair<containers::DataFrame, std::vector<containers::DataFrame>>
   fit_transform(const Params& _params) final;
 
+  /// Returns the names of the staged columns the preprocessor reads.
+  std::vector<std::string> input_columns() const final;
+
   /// Loads the predictor
   void load(const std::string& _fname) final;
 
@@ -52,6 +52,10 @@ class Preprocessor {
   virtual std::pair<containers::DataFrame, std::vector<containers::DataFrame>>
   fit_transform(const Params& _params) = 0;
 
+  /// Returns the names of the staged columns the preprocessor reads, so
+  /// that staging can skip everything else during transform.
+  virtual std::vector<std::string> input_columns() const = 0;
+
   /// Loads the preprocessor.
   virtual void load(const std::string& _fname) = 0;
 
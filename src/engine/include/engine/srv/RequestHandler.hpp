@@ -8,12 +8,14 @@
 #ifndef ENGINE_SRV_REQUESTHANDLER_HPP_
 #define ENGINE_SRV_REQUESTHANDLER_HPP_
 
+#include "commands/Command.hpp"
 #include "engine/handlers/ColumnManager.hpp"
 #include "engine/handlers/DataFrameManager.hpp"
 #include "engine/handlers/DatabaseManager.hpp"
 #include "engine/handlers/PipelineManager.hpp"
 #include "engine/handlers/ProjectManager.hpp"
 #include "engine/handlers/ViewManager.hpp"
+#include "logging/ScopedTimer.hpp"
 
 #include <Poco/Net/StreamSocket.h>
 #include <Poco/Net/TCPServerConnection.h>
@@ -21,6 +23,9 @@
 #include <rfl/define_tagged_union.hpp>
 
 #include <atomic>
+#include <memory>
+#include <optional>
+#include <string>
 
 namespace engine {
 namespace srv {
@@ -48,6 +53,22 @@ class RequestHandler final : public Poco::Net::TCPServerConnection {
   /// Required by Poco::Net::TCPServerConnection. Does the actual handling.
   void run();
 
+ private:
+  /// The type_ of the command, if it can be parsed.
+  std::optional<std::string> cmd_type(const std::string& _cmd_str) const;
+
+  /// Sends the trace of the engine to the client.
+  void get_trace(const typename commands::Command::GetTraceOp& _cmd);
+
+  /// Times the handling of the command, unless it is too frequent to be of
+  /// interest.
+  std::unique_ptr<logging::ScopedTimer> make_timer(
+      const std::optional<std::string>& _type) const;
+
+  /// Whether handling the command may allocate memory, so the memory budget
+  /// needs to be enforced afterwards. The polling commands do not.
+  bool may_allocate(const commands::Command& _cmd) const;
+
  private:
   /// Trivial accessor
   handlers::DatabaseManager& database_manager() { return *database_manager_; }
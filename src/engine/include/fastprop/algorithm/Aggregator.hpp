@@ -33,13 +33,13 @@ class Aggregator {
 
  public:
   /// Applies the aggregation defined in _abstract feature to each of the
-  /// matches.
+  /// matches. The matches must already be filtered by the conditions of the
+  /// abstract feature.
   static Float apply_aggregation(
       const containers::DataFrame &_population,
       const containers::DataFrame &_peripheral,
       const std::optional<containers::Features> &_subfeatures,
       const std::vector<containers::Match> &_matches,
-      const std::function<bool(const containers::Match &)> &_condition_function,
       const containers::AbstractFeature &_abstract_feature,
       const rfl::Ref<Memoization> &_memoization);
 
@@ -56,7 +56,6 @@ class Aggregator {
       const containers::DataFrame &_population,
       const containers::DataFrame &_peripheral,
       const std::vector<containers::Match> &_matches,
-      const std::function<bool(const containers::Match &)> &_condition_function,
       const containers::AbstractFeature &_abstract_feature,
       const rfl::Ref<Memoization> &_memoization);
 
@@ -69,7 +68,6 @@ class Aggregator {
       const containers::DataFrame &_population,
       const containers::DataFrame &_peripheral,
       const std::vector<containers::Match> &_matches,
-      const std::function<bool(const containers::Match &)> &_condition_function,
       const containers::AbstractFeature &_abstract_feature,
       const rfl::Ref<Memoization> &_memoization);
 
@@ -77,7 +75,6 @@ class Aggregator {
   static Float apply_not_applicable(
       const containers::DataFrame &_peripheral,
       const std::vector<containers::Match> &_matches,
-      const std::function<bool(const containers::Match &)> &_condition_function,
       const containers::AbstractFeature &_abstract_feature,
       const rfl::Ref<Memoization> &_memoization);
 
@@ -86,7 +83,6 @@ class Aggregator {
       const containers::DataFrame &_population,
       const containers::DataFrame &_peripheral,
       const std::vector<containers::Match> &_matches,
-      const std::function<bool(const containers::Match &)> &_condition_function,
       const containers::AbstractFeature &_abstract_feature,
       const rfl::Ref<Memoization> &_memoization);
 
@@ -95,7 +91,6 @@ class Aggregator {
       const containers::DataFrame &_population,
       const containers::DataFrame &_peripheral,
       const std::vector<containers::Match> &_matches,
-      const std::function<bool(const containers::Match &)> &_condition_function,
       const containers::AbstractFeature &_abstract_feature,
       const rfl::Ref<Memoization> &_memoization);
 
@@ -104,7 +99,6 @@ class Aggregator {
       const containers::DataFrame &_population,
       const containers::DataFrame &_peripheral,
       const std::vector<containers::Match> &_matches,
-      const std::function<bool(const containers::Match &)> &_condition_function,
       const containers::AbstractFeature &_abstract_feature,
       const rfl::Ref<Memoization> &_memoization);
 
@@ -113,7 +107,6 @@ class Aggregator {
       const containers::DataFrame &_population,
       const containers::DataFrame &_peripheral,
       const std::vector<containers::Match> &_matches,
-      const std::function<bool(const containers::Match &)> &_condition_function,
       const containers::AbstractFeature &_abstract_feature,
       const rfl::Ref<Memoization> &_memoization);
 
@@ -123,7 +116,6 @@ class Aggregator {
       const containers::DataFrame &_peripheral,
       const containers::Features &_subfeatures,
       const std::vector<containers::Match> &_matches,
-      const std::function<bool(const containers::Match &)> &_condition_function,
       const containers::AbstractFeature &_abstract_feature,
       const rfl::Ref<Memoization> &_memoization);
 
@@ -132,7 +124,6 @@ class Aggregator {
       const containers::DataFrame &_population,
       const containers::DataFrame &_peripheral,
       const std::vector<containers::Match> &_matches,
-      const std::function<bool(const containers::Match &)> &_condition_function,
       const containers::AbstractFeature &_abstract_feature,
       const rfl::Ref<Memoization> &_memoization);
 
@@ -257,20 +248,10 @@ class Aggregator {
   static Float aggregate_matches_categorical(
       const std::vector<containers::Match> &_matches,
       const ExtractValueType &_extract_value,
-      const std::function<bool(const containers::Match &)> &_condition_function,
       const containers::AbstractFeature &_abstract_feature) {
     const auto is_non_null = [](Int val) { return val >= 0; };
 
-    if (_abstract_feature.conditions_.size() == 0) {
-      auto range = _matches | std::views::transform(_extract_value) |
-                   std::views::filter(is_non_null);
-
-      return aggregate_categorical_range(range.begin(), range.end(),
-                                         _abstract_feature.aggregation_);
-    }
-
-    auto range = _matches | std::views::filter(_condition_function) |
-                 std::views::transform(_extract_value) |
+    auto range = _matches | std::views::transform(_extract_value) |
                  std::views::filter(is_non_null);
 
     return aggregate_categorical_range(range.begin(), range.end(),
@@ -376,7 +357,6 @@ class Aggregator {
       const containers::DataFrame &_peripheral,
       const std::vector<containers::Match> &_matches,
       const ExtractValueType &_extract_value,
-      const std::function<bool(const containers::Match &)> &_condition_function,
       const containers::AbstractFeature &_abstract_feature,
       const rfl::Ref<Memoization> &_memoization) {
     assert_true(is_first_last(_abstract_feature.aggregation_));
@@ -394,8 +374,8 @@ class Aggregator {
       return std::make_pair(key, value);
     };
 
-    memorize_pairs_range(_matches, extract_pair, _condition_function,
-                         _abstract_feature, _memoization);
+    memorize_pairs_range(_matches, extract_pair, _abstract_feature,
+                         _memoization);
 
     if (_abstract_feature.aggregation_.value() ==
             enums::Aggregation::value_of<"FIRST">() ||
@@ -461,16 +441,9 @@ class Aggregator {
   static void memorize_numerical_range(
       const std::vector<containers::Match> &_matches,
       const ExtractValueType &_extract_value,
-      const std::function<bool(const containers::Match &)> &_condition_function,
       const containers::AbstractFeature &_abstract_feature,
       const rfl::Ref<Memoization> &_memoization) {
-    if (_abstract_feature.conditions_.size() == 0) {
-      const auto range = _matches | std::views::transform(_extract_value) |
-                         std::views::filter(is_not_nan_or_inf);
-      _memoization->memorize_numerical(_abstract_feature, range);
-    }
-    const auto range = _matches | std::views::filter(_condition_function) |
-                       std::views::transform(_extract_value) |
+    const auto range = _matches | std::views::transform(_extract_value) |
                        std::views::filter(is_not_nan_or_inf);
     _memoization->memorize_numerical(_abstract_feature, range);
   }
@@ -480,17 +453,10 @@ class Aggregator {
   static void memorize_pairs_range(
       const std::vector<containers::Match> &_matches,
       const ExtractValueType &_extract_value,
-      const std::function<bool(const containers::Match &)> &_condition_function,
       const containers::AbstractFeature &_abstract_feature,
       const rfl::Ref<Memoization> &_memoization) {
     assert_true(is_first_last(_abstract_feature.aggregation_));
-    if (_abstract_feature.conditions_.size() == 0) {
-      const auto range = _matches | std::views::transform(_extract_value) |
-                         std::views::filter(second_is_not_nan_or_inf);
-      _memoization->memorize_pairs(_abstract_feature, range);
-    }
-    const auto range = _matches | std::views::filter(_condition_function) |
-                       std::views::transform(_extract_value) |
+    const auto range = _matches | std::views::transform(_extract_value) |
                        std::views::filter(second_is_not_nan_or_inf);
     _memoization->memorize_pairs(_abstract_feature, range);
   }
@@ -0,0 +1,71 @@
+// Copyright 2024 Code17 GmbH
+//
+// This file is licensed under the Elastic License 2.0 (ELv2).
+// Refer to the LICENSE.txt file in the root of the repository
+// for details.
+//
+
+#ifndef FASTPROP_ALGORITHM_CATEGORYBUCKETS_HPP_
+#define FASTPROP_ALGORITHM_CATEGORYBUCKETS_HPP_
+
+#include "debug/assert_true.hpp"
+#include "fastprop/Int.hpp"
+#include "fastprop/containers/DataFrame.hpp"
+#include "fastprop/containers/Match.hpp"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace fastprop {
+namespace algorithm {
+
+/// Partitions the matches of a single row by the value of one categorical
+/// column in the peripheral table. Only the categories that are actually
+/// used by a categorical condition get a bucket, all other matches are
+/// dropped.
+class CategoryBuckets {
+ public:
+  explicit CategoryBuckets(const size_t _input_col);
+
+  ~CategoryBuckets() = default;
+
+ public:
+  /// Returns the bucket for _category, adding a new one if necessary.
+  size_t add_category(const Int _category);
+
+  /// Sorts the _matches into the buckets.
+  void partition(const containers::DataFrame& _peripheral,
+                 const std::vector<containers::Match>& _matches);
+
+  /// Sorts the _matches into the buckets, given the categorical column of
+  /// the peripheral table.
+  void partition(const Int* _categories,
+                 const std::vector<containers::Match>& _matches);
+
+ public:
+  /// Returns the matches in bucket _k.
+  const std::vector<containers::Match>& bucket(const size_t _k) const {
+    assert_true(_k < buckets_.size());
+    return buckets_[_k];
+  }
+
+  /// Trivial accessor.
+  size_t input_col() const { return input_col_; }
+
+ private:
+  /// The matches, sorted into buckets. The memory is reused between rows.
+  std::vector<std::vector<containers::Match>> buckets_;
+
+  /// The categorical column in the peripheral table.
+  size_t input_col_;
+
+  /// Maps the categories to their buckets, sorted by category, so we can use
+  /// binary search.
+  std::vector<std::pair<Int, size_t>> lookup_;
+};
+
+}  // namespace algorithm
+}  // namespace fastprop
+
+#endif  // FASTPROP_ALGORITHM_CATEGORYBUCKETS_HPP_
@@ -0,0 +1,142 @@
+// Copyright 2024 Code17 GmbH
+//
+// This file is licensed under the Elastic License 2.0 (ELv2).
+// Refer to the LICENSE.txt file in the root of the repository
+// for details.
+//
+
+#ifndef FASTPROP_ALGORITHM_CONDITIONFUNCTION_HPP_
+#define FASTPROP_ALGORITHM_CONDITIONFUNCTION_HPP_
+
+#include "fastprop/Float.hpp"
+#include "fastprop/Int.hpp"
+#include "fastprop/containers/Match.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace fastprop {
+namespace algorithm {
+
+/// The conditions of an abstract feature, compiled into a flat list of typed
+/// instructions. Instead of calling a chain of type-erased lambdas for every
+/// single match, each instruction is evaluated over the whole block of
+/// matches by a kernel specialized for its kind, compacting the matches
+/// that pass into a selection.
+class ConditionFunction {
+ public:
+  enum class Kind { categorical, lag, same_units_categorical };
+
+  /// A single condition. The pointers point directly into the columns of the
+  /// data frames in the TableHolder, which must outlive this object.
+  struct Instruction {
+    Kind kind_;
+    Int category_used_;
+    const Int* categorical_input_;
+    const Int* categorical_output_;
+    Float lower_;
+    Float upper_;
+    const Float* ts_input_;
+    const Float* ts_output_;
+  };
+
+ public:
+  explicit ConditionFunction(const std::vector<Instruction>& _instructions)
+      : instructions_(_instructions) {}
+
+  ~ConditionFunction() = default;
+
+ public:
+  /// Whether there are no conditions, in which case all matches pass.
+  bool is_trivial() const { return instructions_.size() == 0; }
+
+  /// Writes all of _matches that pass every condition into _selected.
+  void select(const std::vector<containers::Match>& _matches,
+              std::vector<containers::Match>* _selected) const {
+    if (is_trivial()) {
+      *_selected = _matches;
+      return;
+    }
+
+    _selected->resize(_matches.size());
+
+    size_t n = _matches.size();
+
+    const auto* input = _matches.data();
+
+    for (const auto& instruction : instructions_) {
+      switch (instruction.kind_) {
+        case Kind::categorical:
+          n = compact<Kind::categorical>(instruction, input, n,
+                                         _selected->data());
+          break;
+
+        case Kind::lag:
+          n = compact<Kind::lag>(instruction, input, n, _selected->data());
+          break;
+
+        case Kind::same_units_categorical:
+          n = compact<Kind::same_units_categorical>(instruction, input, n,
+                                                    _selected->data());
+          break;
+      }
+
+      // The first instruction reads from _matches, all others compact the
+      // selection in place.
+      input = _selected->data();
+    }
+
+    _selected->resize(n);
+  }
+
+ private:
+  /// Copies the matches in [_input, _input + _n) that pass _instruction to
+  /// _output and returns their number. The match is always written and the
+  /// output position only advanced if it passes, so the loop contains no
+  /// data-dependent branches. _output may be identical to _input.
+  template <Kind _kind>
+  static size_t compact(const Instruction& _instruction,
+                        const containers::Match* _input, const size_t _n,
+                        containers::Match* _output) {
+    size_t j = 0;
+
+    for (size_t i = 0; i < _n; ++i) {
+      const auto match = _input[i];
+      _output[j] = match;
+      j += passes<_kind>(_instruction, match) ? 1 : 0;
+    }
+
+    return j;
+  }
+
+  /// Whether a single match passes the instruction.
+  template <Kind _kind>
+  static bool passes(const Instruction& _instruction,
+                     const containers::Match& _match) {
+    if constexpr (_kind == Kind::categorical) {
+      return _instruction.categorical_input_[_match.ix_input] ==
+             _instruction.category_used_;
+    }
+
+    if constexpr (_kind == Kind::lag) {
+      const auto ts_input = _instruction.ts_input_[_match.ix_input];
+      const auto ts_output = _instruction.ts_output_[_match.ix_output];
+      return (ts_input + _instruction.upper_ > ts_output) &
+             (ts_input + _instruction.lower_ <= ts_output);
+    }
+
+    if constexpr (_kind == Kind::same_units_categorical) {
+      return _instruction.categorical_output_[_match.ix_output] ==
+             _instruction.categorical_input_[_match.ix_input];
+    }
+  }
+
+ private:
+  /// The compiled conditions, all of which must be true.
+  std::vector<Instruction> instructions_;
+};
+
+}  // namespace algorithm
+}  // namespace fastprop
+
+#endif  // FASTPROP_ALGORITHM_CONDITIONFUNCTION_HPP_
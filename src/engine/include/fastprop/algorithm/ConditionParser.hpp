@@ -8,6 +8,7 @@
 #ifndef FASTPROP_ALGORITHM_CONDITIONPARSER_HPP_
 #define FASTPROP_ALGORITHM_CONDITIONPARSER_HPP_
 
+#include "fastprop/algorithm/ConditionFunction.hpp"
 #include "fastprop/algorithm/TableHolder.hpp"
 #include "fastprop/containers/AbstractFeature.hpp"
 #include "fastprop/containers/DataFrame.hpp"
@@ -21,45 +22,43 @@ namespace algorithm {
 
 class ConditionParser {
  public:
-  /// Generates a vector of lambda function each of which determines whether a
-  /// match is to be included in the aggregation based on the
-  /// abstract_feature's conditions.
-  static std::vector<std::function<bool(const containers::Match &)>>
-  make_condition_functions(
+  /// Compiles the conditions of each abstract feature in the index into a
+  /// ConditionFunction that determines which matches are to be included in
+  /// the aggregation.
+  static std::vector<ConditionFunction> make_condition_functions(
       const TableHolder &_table_holder, const std::vector<size_t> &_index,
       const std::vector<containers::AbstractFeature> &_abstract_features);
 
  private:
-  /// Generates a lambda function that determines whether a match is to be
-  /// included in the aggregation based on the abstract_feature's conditions.
-  static std::function<bool(const containers::Match &)> make_apply_conditions(
+  /// Compiles the abstract_feature's conditions into a ConditionFunction.
+  static ConditionFunction make_apply_conditions(
       const TableHolder &_table_holder,
       const containers::AbstractFeature &_abstract_feature);
 
-  /// Generates a filtering function based on a categorical column.
-  static std::function<bool(const containers::Match &)> make_categorical(
+  /// Generates a filtering instruction based on a categorical column.
+  static ConditionFunction::Instruction make_categorical(
       const containers::DataFrame &_peripheral,
       const containers::Condition &_condition);
 
-  /// Generates a filtering function based on lags.
-  static std::function<bool(const containers::Match &)> make_lag(
+  /// Generates a filtering instruction based on lags.
+  static ConditionFunction::Instruction make_lag(
       const containers::DataFrame &_population,
       const containers::DataFrame &_peripheral,
       const containers::Condition &_condition);
 
-  /// Generates a filtering function based on same_units_categorical.
-  static std::function<bool(const containers::Match &)>
-  make_same_units_categorical(const containers::DataFrame &_population,
-                              const containers::DataFrame &_peripheral,
-                              const containers::Condition &_condition);
+  /// Generates a filtering instruction based on same_units_categorical.
+  static ConditionFunction::Instruction make_same_units_categorical(
+      const containers::DataFrame &_population,
+      const containers::DataFrame &_peripheral,
+      const containers::Condition &_condition);
 
   /// Parses all conditions in the abstract features.
-  static std::vector<std::function<bool(const containers::Match &)>>
-  parse_conditions(const TableHolder &_table_holder,
-                   const containers::AbstractFeature &_abstract_feature);
+  static std::vector<ConditionFunction::Instruction> parse_conditions(
+      const TableHolder &_table_holder,
+      const containers::AbstractFeature &_abstract_feature);
 
   /// Parses one condition in the abstract features.
-  static std::function<bool(const containers::Match &)> parse_single_condition(
+  static ConditionFunction::Instruction parse_single_condition(
       const containers::DataFrame &_population,
       const containers::DataFrame &_peripheral,
       const containers::Condition &_condition);
@@ -9,9 +9,12 @@
 #define FASTPROP_ALGORITHM_FASTPROP_HPP_
 
 #include "fastprop/Hyperparameters.hpp"
+#include "fastprop/algorithm/ConditionFunction.hpp"
 #include "fastprop/algorithm/FitParams.hpp"
+#include "fastprop/algorithm/MatchBuckets.hpp"
 #include "fastprop/algorithm/Memoization.hpp"
 #include "fastprop/algorithm/TableHolder.hpp"
+#include "fastprop/algorithm/TableHolderCache.hpp"
 #include "fastprop/algorithm/TransformParams.hpp"
 #include "fastprop/containers/Column.hpp"
 #include "fastprop/containers/DataFrame.hpp"
@@ -131,22 +134,25 @@ class FastProp {
       const TableHolder& _table_holder,
       const std::vector<containers::Features>& _subfeatures,
       const std::vector<size_t>& _index,
-      const std::vector<std::function<bool(const containers::Match&)>>&
-          _condition_functions,
+      const std::vector<ConditionFunction>& _condition_functions,
       const size_t _rownum, const rfl::Ref<Memoization>& _memoization,
+      MatchBuckets* _match_buckets, std::vector<containers::Match>* _selected,
       Float* _row) const;
 
   /// Builds all rows for the thread associated with _thread_num
-  void build_rows(const TransformParams& _params,
-                  const std::vector<containers::Features>& _subfeatures,
-                  const std::shared_ptr<std::vector<size_t>>& _rownums,
-                  const size_t _thread_num, std::atomic<size_t>* _num_completed,
-                  containers::Features* _features) const;
+  void build_rows(
+      const TransformParams& _params, const TableHolder& _table_holder,
+      const std::vector<containers::Features>& _subfeatures,
+      const std::vector<ConditionFunction>& _condition_functions,
+      const std::shared_ptr<std::vector<size_t>>& _rownums,
+      const size_t _thread_num, std::atomic<size_t>* _num_completed,
+      containers::Features* _features) const;
 
   /// Builds the subfeatures.
   std::vector<containers::Features> build_subfeatures(
       const TransformParams& _params,
-      const std::shared_ptr<std::vector<size_t>>& _rownums) const;
+      const std::shared_ptr<std::vector<size_t>>& _rownums,
+      TableHolderCache* _table_holder_cache) const;
 
   /// Copies the data from the cache into the actual features.
   void cache_to_features(const std::vector<size_t>& _rownums,
@@ -156,7 +162,8 @@ class FastProp {
   /// Calculates the R-squared for each feature vis-a-vis the targets.
   std::vector<Float> calc_r_squared(
       const FitParams& _params,
-      const std::shared_ptr<std::vector<size_t>>& _rownums) const;
+      const std::shared_ptr<std::vector<size_t>>& _rownums,
+      TableHolderCache* _table_holder_cache) const;
 
   /// Calculates the threshold on the basis of which we throw out features.
   Float calc_threshold(const std::vector<Float>& _r_squared) const;
@@ -326,6 +333,15 @@ class FastProp {
       const containers::DataFrame& _population,
       const containers::DataFrame& _peripheral, const size_t _ix) const;
 
+  /// Generates a fingerprint of the data frames and rows a TableHolder is
+  /// built from, used as the key for the TableHolderCache. The data frames
+  /// are identified by the names and the memory locations of their columns,
+  /// which cannot be reused as long as the cached TableHolders refer to them.
+  std::string make_fingerprint(
+      const containers::DataFrame& _population,
+      const std::vector<containers::DataFrame>& _peripheral,
+      const std::shared_ptr<std::vector<size_t>>& _rownums) const;
+
   /// Generates the matches for a particular row in the population table.
   std::vector<std::vector<containers::Match>> make_matches(
       const TableHolder& _table_holder, const size_t _rownum) const;
@@ -335,6 +351,17 @@ class FastProp {
       const size_t _thread_num, const size_t _nrows,
       const std::shared_ptr<std::vector<size_t>>& _rownums) const;
 
+  /// Returns the TableHolder for the rows _rownums of the population table,
+  /// which is shared by all threads. During fitting, the TableHolders are
+  /// kept in _table_holder_cache, so they are only built once for all
+  /// batches of features. _table_holder_cache is nullptr otherwise.
+  std::shared_ptr<const TableHolder> make_table_holder(
+      const containers::DataFrame& _population,
+      const std::vector<containers::DataFrame>& _peripheral,
+      const helpers::WordIndexContainer& _word_indices,
+      const std::shared_ptr<std::vector<size_t>>& _rownums,
+      TableHolderCache* _table_holder_cache) const;
+
   /// Creates a random subsample for fitting.
   std::shared_ptr<std::vector<size_t>> sample_from_population(
       const size_t _nrows) const;
@@ -342,7 +369,8 @@ class FastProp {
   /// Weeds out features for which the correlation coefficient is too small.
   std::shared_ptr<const std::vector<containers::AbstractFeature>>
   select_features(const FitParams& _params,
-                  const std::shared_ptr<std::vector<size_t>>& _rownums) const;
+                  const std::shared_ptr<std::vector<size_t>>& _rownums,
+                  TableHolderCache* _table_holder_cache) const;
 
   /// Returns true if _agg is FIRST or LAST, but there are no time stamps in
   /// _peripheral.
@@ -352,6 +380,7 @@ class FastProp {
 
   /// Spawns the threads for building the features.
   void spawn_threads(const TransformParams& _params,
+                     const TableHolder& _table_holder,
                      const std::vector<containers::Features>& _subfeatures,
                      const std::shared_ptr<std::vector<size_t>>& _rownums,
                      containers::Features* _features) const;
@@ -365,6 +394,13 @@ class FastProp {
       const std::string& _feature_prefix, const size_t _offset,
       std::vector<std::string>* _sql) const;
 
+  /// Like the public transform, but reuses the TableHolders in
+  /// _table_holder_cache, if it is not nullptr.
+  containers::Features transform(
+      const TransformParams& _params,
+      const std::shared_ptr<std::vector<size_t>>& _rownums,
+      const bool _as_subfeatures, TableHolderCache* _table_holder_cache) const;
+
  public:
   /// Trivial accessor
   bool& allow_http() { return allow_http_; }
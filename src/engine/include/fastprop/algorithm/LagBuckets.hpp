@@ -0,0 +1,85 @@
+// Copyright 2024 Code17 GmbH
+//
+// This file is licensed under the Elastic License 2.0 (ELv2).
+// Refer to the LICENSE.txt file in the root of the repository
+// for details.
+//
+
+#ifndef FASTPROP_ALGORITHM_LAGBUCKETS_HPP_
+#define FASTPROP_ALGORITHM_LAGBUCKETS_HPP_
+
+#include "debug/assert_true.hpp"
+#include "fastprop/Float.hpp"
+#include "fastprop/containers/Condition.hpp"
+#include "fastprop/containers/DataFrame.hpp"
+#include "fastprop/containers/Match.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace fastprop {
+namespace algorithm {
+
+/// The lag conditions generated by FastProp::make_lag_conditions(...) split
+/// the time between a row in the population table and its matches into
+/// max_lag intervals of length delta_t, so every match fulfills at most one
+/// of them. Instead of filtering all matches once for every feature with a
+/// lag condition, we sort the matches into buckets once per row and let the
+/// features aggregate over their bucket only.
+class LagBuckets {
+ public:
+  LagBuckets(const Float _delta_t, const size_t _max_lag);
+
+  ~LagBuckets() = default;
+
+ public:
+  /// Returns the bucket corresponding to the lag condition in _condition
+  /// or std::nullopt, if _condition has not been generated by
+  /// make_lag_conditions(...) using the same delta_t and max_lag.
+  std::optional<size_t> find_bucket(
+      const containers::Condition& _condition) const;
+
+  /// Returns the bucket whose lag condition has exactly the bounds
+  /// _bound_lower and _bound_upper or std::nullopt, if there is none.
+  std::optional<size_t> find_bucket(const Float _bound_lower,
+                                    const Float _bound_upper) const;
+
+  /// Sorts the _matches into the buckets. A match ends up in bucket k if and
+  /// only if it fulfills the lag condition bound_lower_ = delta_t * k,
+  /// bound_upper_ = delta_t * (k + 1), evaluated exactly as in
+  /// ConditionParser::make_lag(...).
+  void partition(const containers::DataFrame& _population,
+                 const containers::DataFrame& _peripheral,
+                 const std::vector<containers::Match>& _matches);
+
+  /// Sorts the _matches into the buckets, given the time stamps of the
+  /// population table (_ts_output) and the peripheral table (_ts_input).
+  void partition(const Float* _ts_output, const Float* _ts_input,
+                 const std::vector<containers::Match>& _matches);
+
+ public:
+  /// Returns the matches in bucket _k.
+  const std::vector<containers::Match>& bucket(const size_t _k) const {
+    assert_true(_k < buckets_.size());
+    return buckets_[_k];
+  }
+
+ private:
+  /// The lower bound of bucket _k.
+  Float bound(const size_t _k) const {
+    return delta_t_ * static_cast<Float>(_k);
+  }
+
+ private:
+  /// The matches, sorted into buckets. The memory is reused between rows.
+  std::vector<std::vector<containers::Match>> buckets_;
+
+  /// The length of the interval covered by a single bucket.
+  const Float delta_t_;
+};
+
+}  // namespace algorithm
+}  // namespace fastprop
+
+#endif  // FASTPROP_ALGORITHM_LAGBUCKETS_HPP_
@@ -0,0 +1,74 @@
+// Copyright 2024 Code17 GmbH
+//
+// This file is licensed under the Elastic License 2.0 (ELv2).
+// Refer to the LICENSE.txt file in the root of the repository
+// for details.
+//
+
+#ifndef FASTPROP_ALGORITHM_MATCHBUCKETS_HPP_
+#define FASTPROP_ALGORITHM_MATCHBUCKETS_HPP_
+
+#include "fastprop/Float.hpp"
+#include "fastprop/algorithm/CategoryBuckets.hpp"
+#include "fastprop/algorithm/LagBuckets.hpp"
+#include "fastprop/algorithm/TableHolder.hpp"
+#include "fastprop/containers/AbstractFeature.hpp"
+#include "fastprop/containers/Match.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace fastprop {
+namespace algorithm {
+
+/// Many features only differ by a lag or categorical condition. Rather than
+/// letting each of them filter all matches of a row, the matches are
+/// partitioned once per row and every feature with such a condition only
+/// aggregates over its own bucket. The condition functions are still
+/// applied to the buckets, so any other conditions remain in effect.
+///
+/// A MatchBuckets object holds the buckets for a single thread.
+class MatchBuckets {
+ public:
+  MatchBuckets(
+      const std::vector<containers::AbstractFeature>& _abstract_features,
+      const std::vector<size_t>& _index, const Float _delta_t,
+      const size_t _max_lag, const size_t _num_peripheral);
+
+  ~MatchBuckets() = default;
+
+ public:
+  /// Returns the matches the _i-th feature in the index needs to look at.
+  const std::vector<containers::Match>& matches(
+      const size_t _i,
+      const std::vector<std::vector<containers::Match>>& _all_matches) const;
+
+  /// Sorts the matches of a row into the buckets.
+  void partition(
+      const TableHolder& _table_holder,
+      const std::vector<std::vector<containers::Match>>& _all_matches);
+
+ private:
+  /// The category buckets for each peripheral table.
+  std::vector<std::vector<CategoryBuckets>> category_buckets_;
+
+  /// For every feature in the index, the category buckets (as an index into
+  /// category_buckets_.at(peripheral)) and the bucket within them.
+  std::vector<std::optional<std::pair<size_t, size_t>>> category_bucket_ix_;
+
+  /// The lag buckets for each peripheral table, if any feature needs them.
+  std::vector<std::optional<LagBuckets>> lag_buckets_;
+
+  /// For every feature in the index, the lag bucket.
+  std::vector<std::optional<size_t>> lag_bucket_ix_;
+
+  /// For every feature in the index, the peripheral table.
+  std::vector<size_t> peripheral_;
+};
+
+}  // namespace algorithm
+}  // namespace fastprop
+
+#endif  // FASTPROP_ALGORITHM_MATCHBUCKETS_HPP_
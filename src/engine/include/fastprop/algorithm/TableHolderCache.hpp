@@ -0,0 +1,87 @@
+// Copyright 2024 Code17 GmbH
+//
+// This file is licensed under the Elastic License 2.0 (ELv2).
+// Refer to the LICENSE.txt file in the root of the repository
+// for details.
+//
+
+#ifndef FASTPROP_ALGORITHM_TABLEHOLDERCACHE_HPP_
+#define FASTPROP_ALGORITHM_TABLEHOLDERCACHE_HPP_
+
+#include "fastprop/algorithm/TableHolder.hpp"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace fastprop {
+namespace algorithm {
+
+/// Building a TableHolder requires creating subviews and time series indices
+/// for all peripheral tables, which is expensive. During fitting, the same
+/// TableHolder is needed by every batch of candidate features, so we keep
+/// them here, keyed by a fingerprint of the underlying data frames. Because
+/// the fingerprint only contains a hash of the rownums, the rownums are
+/// compared as well. The TableHolders are read-only and can be shared by all
+/// threads. The cache only lives as long as FastProp::fit.
+class TableHolderCache {
+  using RownumsPtr = std::shared_ptr<const std::vector<size_t>>;
+
+  /// A TableHolder and the rownums it has been built from.
+  struct Entry {
+    RownumsPtr rownums_;
+    std::shared_ptr<const TableHolder> table_holder_;
+  };
+
+ public:
+  TableHolderCache() = default;
+
+  ~TableHolderCache() = default;
+
+ public:
+  /// Returns the TableHolder for _fingerprint and _rownums, calling _make()
+  /// to build it, if it is not in the cache yet.
+  template <class MakeType>
+  std::shared_ptr<const TableHolder> get(const std::string& _fingerprint,
+                                         const RownumsPtr& _rownums,
+                                         const MakeType& _make) {
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    auto& entries = table_holders_[_fingerprint];
+
+    const auto same_rownums = [&_rownums](const Entry& _entry) {
+      if (!_entry.rownums_ || !_rownums) {
+        return !_entry.rownums_ && !_rownums;
+      }
+      return *_entry.rownums_ == *_rownums;
+    };
+
+    const auto it = std::ranges::find_if(entries, same_rownums);
+
+    if (it != entries.end()) {
+      return it->table_holder_;
+    }
+
+    const auto table_holder = std::make_shared<const TableHolder>(_make());
+
+    entries.push_back(
+        Entry{.rownums_ = _rownums, .table_holder_ = table_holder});
+
+    return table_holder;
+  }
+
+ private:
+  /// Protects the table holders.
+  std::mutex mtx_;
+
+  /// The TableHolders, keyed by their fingerprint.
+  std::map<std::string, std::vector<Entry>> table_holders_;
+};
+
+}  // namespace algorithm
+}  // namespace fastprop
+
+#endif  // FASTPROP_ALGORITHM_TABLEHOLDERCACHE_HPP_
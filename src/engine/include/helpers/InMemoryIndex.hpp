@@ -12,11 +12,100 @@
 
 #include <cstddef>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace helpers {
 
-using InMemoryIndex = std::unordered_map<Int, std::vector<size_t>>;
+/// Maps join keys to the rows they occur in. The row numbers of every key
+/// are stored in a contiguous segment of a single array, sorted by row
+/// number. The join keys are encoded by the global encoding, so a data frame
+/// usually only contains a small fraction of them. Every key that actually
+/// occurs is therefore given a local key number, which addresses its
+/// segment.
+///
+/// Large appends are merged into a compact layout by a counting sort on the
+/// local key numbers. Small appends are written into the segments of their
+/// keys. A segment that is full is moved to the end of the array with twice
+/// its capacity, so appending takes amortized constant time per row. The
+/// array is compacted, once the abandoned segments take up more than half
+/// of it.
+class InMemoryIndex {
+  /// Below this number of new rows, we do not bother spawning threads.
+  static constexpr size_t MIN_ROWS_PER_THREAD = 100000;
+
+ public:
+  InMemoryIndex() : nrows_(0), num_abandoned_(0) {}
+
+  ~InMemoryIndex() = default;
+
+ public:
+  /// Adds the rows [nrows(), _nrows) to the index. The rows that are already
+  /// indexed must not have changed. Negative keys are NULL values and are
+  /// not indexed.
+  void append(const Int* _keys, const size_t _nrows);
+
+  /// Removes all entries.
+  void clear() { *this = InMemoryIndex(); }
+
+  /// Returns a pointer to the beginning and end of the rownums, or two
+  /// nullptrs, if the key is not found.
+  std::pair<const size_t*, const size_t*> find(const Int _key) const {
+    const auto it = key_nums_.find(_key);
+
+    if (it == key_nums_.end() || begins_[it->second] == ends_[it->second]) {
+      return std::make_pair<const size_t*, const size_t*>(nullptr, nullptr);
+    }
+
+    return std::make_pair(rownums_.data() + begins_[it->second],
+                          rownums_.data() + ends_[it->second]);
+  }
+
+  /// The number of rows that have been indexed.
+  size_t nrows() const { return nrows_; }
+
+ private:
+  /// Returns the local key number of _key, adding it, if necessary.
+  size_t add_key(const Int _key);
+
+  /// The number of threads to use for _num_new_rows new rows and _num_keys
+  /// keys. Every thread needs its own histogram, so we make sure that the
+  /// histograms do not outgrow the data.
+  static size_t calc_num_threads(const size_t _num_new_rows,
+                                 const size_t _num_keys);
+
+  /// Moves the segment of key number _k to the end of rownums_ and doubles
+  /// its capacity.
+  void grow_segment(const size_t _k);
+
+  /// Rebuilds a compact layout containing the indexed rows and the rows
+  /// [_begin, _end), whose keys must already have been added.
+  void rebuild(const Int* _keys, const size_t _begin, const size_t _end);
+
+ private:
+  /// The beginning of the segment of every local key number in rownums_.
+  std::vector<size_t> begins_;
+
+  /// The end of the rows of every local key number in rownums_.
+  std::vector<size_t> ends_;
+
+  /// Maps the join keys to their local key numbers.
+  std::unordered_map<Int, size_t> key_nums_;
+
+  /// The end of the segment of every local key number in rownums_, which is
+  /// the end of its rows plus the room left for further rows.
+  std::vector<size_t> limits_;
+
+  /// The number of rows that have been indexed.
+  size_t nrows_;
+
+  /// The number of elements of rownums_ that belong to segments that have
+  /// been moved.
+  size_t num_abandoned_;
+
+  /// The row numbers, in segments by local key number.
+  std::vector<size_t> rownums_;
+};
 
 }  // namespace helpers
 
@@ -9,6 +9,7 @@
 #define HELPERS_LOADER_HPP_
 
 #include <rfl/json/read.hpp>
+#include <rfl/msgpack/read.hpp>
 
 #include <filesystem>
 #include <fstream>
@@ -27,7 +28,8 @@ class Loader {
   static T load(const std::string& _fname) {
     const auto endings = std::vector<
         std::pair<std::string, std::function<T(const std::string&)>>>(
-        {std::make_pair(".json", load_from_json<T>)});
+        {std::make_pair(".msgpack", load_from_msgpack<T>),
+         std::make_pair(".json", load_from_json<T>)});
 
     for (const auto& [e, f] : endings) {
       if (_fname.size() > e.size() &&
@@ -53,6 +55,16 @@ class Loader {
     return rfl::json::read<T>(json_str).value();
   }
 
+  /// Loads any class that is supported by the json library from
+  /// msgpack.
+  template <class T>
+  static T load_from_msgpack(const std::string& _fname) {
+    const auto bytes = read_bytes(_fname);
+    return rfl::msgpack::read<T>(reinterpret_cast<const char*>(bytes.data()),
+                                 bytes.size())
+        .value();
+  }
+
  private:
   /// Reads bytes from a file.
   static std::vector<unsigned char> read_bytes(const std::string& _fname) {
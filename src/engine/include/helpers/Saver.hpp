@@ -11,6 +11,7 @@
 #include <rfl/Literal.hpp>
 #include <rfl/always_false.hpp>
 #include <rfl/json/write.hpp>
+#include <rfl/msgpack/write.hpp>
 #include <rfl/visit.hpp>
 
 #include <fstream>
@@ -19,7 +20,9 @@
 namespace helpers {
 
 struct Saver {
-  using Format = rfl::Literal<"json">;
+  /// JSON is human-readable and meant for debugging, msgpack is a compact
+  /// binary format that is much faster to parse.
+  using Format = rfl::Literal<"json", "msgpack">;
 
   /// Saves the object in one of the supported formats.
   template <class T>
@@ -28,6 +31,8 @@ struct Saver {
     const auto handle_variant = [&]<typename U>(const U&) {
       if constexpr (std::is_same<U, rfl::Literal<"json">>()) {
         save_as_json(_fname, _obj);
+      } else if constexpr (std::is_same<U, rfl::Literal<"msgpack">>()) {
+        save_as_msgpack(_fname, _obj);
       } else {
         static_assert(rfl::always_false_v<U>, "Not all cases were supported");
       }
@@ -48,6 +53,20 @@ struct Saver {
     output << json_str;
     output.close();
   }
+
+  /// Saves any class that is supported by the json library to
+  /// msgpack.
+  template <class T>
+  static void save_as_msgpack(const std::string& _fname, const T& _obj) {
+    const auto bytes = rfl::msgpack::write(_obj);
+    const auto fname =
+        _fname.size() > 8 && _fname.substr(_fname.size() - 8) == ".msgpack"
+            ? _fname
+            : _fname + ".msgpack";
+    std::ofstream output(fname, std::ios::binary);
+    output.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    output.close();
+  }
 };
 
 }  // namespace helpers
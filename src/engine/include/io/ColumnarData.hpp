@@ -0,0 +1,55 @@
+// Copyright 2024 Code17 GmbH
+//
+// This file is licensed under the Elastic License 2.0 (ELv2).
+// Refer to the LICENSE.txt file in the root of the repository
+// for details.
+//
+
+#ifndef IO_COLUMNARDATA_HPP_
+#define IO_COLUMNARDATA_HPP_
+
+#include "io/Datatype.hpp"
+#include "io/Float.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace io {
+// ----------------------------------------------------------------------------
+
+/// Typed, column-oriented access to data that is to be written into a
+/// database. Unlike the io::Reader, this does not require the connectors to
+/// parse every single value from a string.
+struct ColumnarData {
+  /// Numerical values (double_precision, integer or time_stamp) are passed
+  /// as a view on contiguous memory. NaN and infinity signify NULL.
+  using FloatColumn = std::span<const Float>;
+
+  /// Strings are generated on demand, because they usually need to be decoded
+  /// first.
+  using StringColumn = std::function<std::string(size_t)>;
+
+  using ColumnType = std::variant<FloatColumn, StringColumn>;
+
+  /// The names of the columns.
+  std::vector<std::string> colnames_;
+
+  /// The datatypes of the columns. Columns of type string are expected to be
+  /// StringColumns, all other columns are expected to be FloatColumns.
+  std::vector<Datatype> coltypes_;
+
+  /// The columns themselves.
+  std::vector<ColumnType> columns_;
+
+  /// The number of rows.
+  size_t nrows_;
+};
+
+// ----------------------------------------------------------------------------
+}  // namespace io
+
+#endif  // IO_COLUMNARDATA_HPP_
@@ -10,6 +10,7 @@
 
 #include "io/Float.hpp"
 #include "io/Int.hpp"
+#include "io/TimeStampParser.hpp"
 
 #include <Poco/DateTimeFormat.h>
 #include <Poco/DateTimeFormatter.h>
@@ -20,6 +21,7 @@
 #include <cmath>
 #include <iomanip>
 #include <iostream>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -149,28 +151,15 @@ class Parser {
   /// Transforms a string to a time stamp.
   static std::pair<Float, bool> to_time_stamp(
       const std::string& _str, const std::vector<std::string>& _time_formats) {
-    const auto trimmed = trim(_str);
-
-    int utc = Poco::DateTimeFormatter::UTC;
-
-    for (const auto& fmt : _time_formats) {
-      Poco::DateTime date_time;
-
-      const auto success =
-          Poco::DateTimeParser::tryParse(fmt, trimmed, date_time, utc);
-
-      const auto time_stamp = date_time.timestamp();
-
-      if (!success ||
-          Poco::DateTimeFormatter::format(time_stamp, fmt) != trimmed) {
-        continue;
-      }
+    // Compiling the formats is not free, so every thread keeps the parser
+    // for the formats it has used most recently.
+    thread_local std::optional<TimeStampParser> parser;
 
-      return std::pair<Float, bool>(
-          static_cast<Float>(time_stamp.epochMicroseconds()) / 1.0e6, true);
+    if (!parser || parser->time_formats() != _time_formats) {
+      parser.emplace(_time_formats);
     }
 
-    return std::pair<Float, bool>(0.0, false);
+    return parser->parse(_str);
   }
 
   // -------------------------------
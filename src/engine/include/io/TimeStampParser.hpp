@@ -0,0 +1,89 @@
+// Copyright 2024 Code17 GmbH
+//
+// This file is licensed under the Elastic License 2.0 (ELv2).
+// Refer to the LICENSE.txt file in the root of the repository
+// for details.
+//
+
+#ifndef IO_TIMESTAMPPARSER_HPP_
+#define IO_TIMESTAMPPARSER_HPP_
+
+#include "io/Float.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace io {
+
+/// Parses time stamps given a list of formats in the syntax of
+/// Poco::DateTimeFormatter. A string is accepted by a format if formatting the
+/// parsed time stamp in the same format reproduces the string exactly; the
+/// first format that accepts the string wins.
+///
+/// Formats that consist of fixed-width numeric fields (%Y, %m, %d, %H, %M,
+/// %S, %i, %F, %s), %z and literal characters - which covers ISO 8601 and
+/// the defaults - are compiled into a parser that requires no allocations.
+/// All other formats fall back to Poco::DateTimeParser.
+class TimeStampParser {
+  /// A single element of a compiled format: Either a field, signified by the
+  /// character following the '%', or a literal character.
+  struct Token {
+    bool is_field_;
+    char char_;
+  };
+
+  /// A format and its compiled tokens, if it could be compiled.
+  struct Format {
+    std::string format_;
+    std::optional<std::vector<Token>> tokens_;
+  };
+
+ public:
+  explicit TimeStampParser(const std::vector<std::string>& _time_formats);
+
+  ~TimeStampParser() = default;
+
+ public:
+  /// Returns the number of seconds since epoch and whether parsing was
+  /// successful. Leading and trailing whitespace is ignored.
+  std::pair<Float, bool> parse(const std::string_view _str) const;
+
+  /// Trivial accessor.
+  const std::vector<std::string>& time_formats() const {
+    return time_formats_;
+  }
+
+ private:
+  /// Compiles a format, returns std::nullopt if it contains any elements the
+  /// compiled parser does not support.
+  static std::optional<std::vector<Token>> compile(const std::string& _format);
+
+  /// The number of days since 1970-01-01 in the proleptic Gregorian
+  /// calendar.
+  static std::int64_t days_from_civil(const std::int64_t _year,
+                                      const std::int64_t _month,
+                                      const std::int64_t _day);
+
+  /// Parses the string using Poco::DateTimeParser.
+  static std::optional<Float> parse_poco(const std::string& _format,
+                                         const std::string_view _str);
+
+  /// Parses the string using the compiled tokens.
+  static std::optional<Float> parse_tokens(const std::vector<Token>& _tokens,
+                                           const std::string_view _str);
+
+ private:
+  /// The formats, in the order in which they are tried.
+  std::vector<Format> formats_;
+
+  /// The original time formats.
+  std::vector<std::string> time_formats_;
+};
+
+}  // namespace io
+
+#endif  // IO_TIMESTAMPPARSER_HPP_
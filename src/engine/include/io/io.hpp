@@ -11,6 +11,7 @@
 #include "io/CSVReader.hpp"
 #include "io/CSVSniffer.hpp"
 #include "io/CSVWriter.hpp"
+#include "io/ColumnarData.hpp"
 #include "io/Datatype.hpp"
 #include "io/Float.hpp"
 #include "io/Int.hpp"
@@ -18,5 +19,6 @@
 #include "io/Reader.hpp"
 #include "io/Sniffer.hpp"
 #include "io/StatementMaker.hpp"
+#include "io/TimeStampParser.hpp"
 
 #endif  // IO_IO_HPP_
@@ -0,0 +1,65 @@
+// Copyright 2024 Code17 GmbH
+//
+// This file is licensed under the Elastic License 2.0 (ELv2).
+// Refer to the LICENSE.txt file in the root of the repository
+// for details.
+//
+
+#ifndef LOGGING_SCOPEDTIMER_HPP_
+#define LOGGING_SCOPEDTIMER_HPP_
+
+#include "logging/Tracer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace logging {
+
+/// Measures the time between its construction and its destruction and
+/// records it in the global Tracer. Timers are meant for coarse stages, not
+/// for inner loops.
+class ScopedTimer {
+ public:
+  ScopedTimer(const std::string& _name, const std::string& _category)
+      : begin_(Tracer::global().now()),
+        bytes_(0),
+        category_(_category),
+        name_(_name),
+        rows_(0) {}
+
+  ScopedTimer(const ScopedTimer&) = delete;
+
+  ~ScopedTimer() {
+    Tracer::global().record(name_, category_, begin_, rows_, bytes_);
+  }
+
+ public:
+  /// Adds to the number of bytes processed during this stage.
+  void add_bytes(const size_t _bytes) { bytes_ += _bytes; }
+
+  /// Adds to the number of rows processed during this stage.
+  void add_rows(const size_t _rows) { rows_ += _rows; }
+
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+ private:
+  /// When the stage began.
+  const std::int64_t begin_;
+
+  /// The number of bytes processed.
+  size_t bytes_;
+
+  /// The category of the stage, such as "fastprop" or "predictor".
+  const std::string category_;
+
+  /// The name of the stage.
+  const std::string name_;
+
+  /// The number of rows processed.
+  size_t rows_;
+};
+
+}  // namespace logging
+
+#endif  // LOGGING_SCOPEDTIMER_HPP_
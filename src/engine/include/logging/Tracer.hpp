@@ -0,0 +1,135 @@
+// Copyright 2024 Code17 GmbH
+//
+// This file is licensed under the Elastic License 2.0 (ELv2).
+// Refer to the LICENSE.txt file in the root of the repository
+// for details.
+//
+
+#ifndef LOGGING_TRACER_HPP_
+#define LOGGING_TRACER_HPP_
+
+#include <rfl/Field.hpp>
+#include <rfl/Literal.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace logging {
+
+/// Collects the timings of the major stages of the engine (ingest, staging,
+/// preprocessing, feature learning, predictors, socket transfer), so we can
+/// tell which part of a slow pipeline to tune. Events are usually recorded
+/// through a ScopedTimer.
+///
+/// There is a single, process-wide tracer, because the stages are spread
+/// over modules that do not share any parameters. Only the most recent
+/// MAX_EVENTS events are kept, the aggregate statistics per stage cover all
+/// events since the last call to clear().
+class Tracer {
+ public:
+  /// The maximum number of individual events that are kept in memory.
+  static constexpr size_t MAX_EVENTS = 100000;
+
+  /// Additional information on an event.
+  struct Args {
+    rfl::Field<"rows", size_t> rows;
+    rfl::Field<"bytes", size_t> bytes;
+    rfl::Field<"peak_rss_kb", size_t> peak_rss_kb;
+  };
+
+  /// A complete event in the Chrome trace format. Timestamps are in
+  /// microseconds since the tracer was started.
+  struct Event {
+    rfl::Field<"name", std::string> name;
+    rfl::Field<"cat", std::string> cat;
+    rfl::Field<"ph", rfl::Literal<"X">> ph;
+    rfl::Field<"ts", std::int64_t> ts;
+    rfl::Field<"dur", std::int64_t> dur;
+    rfl::Field<"pid", int> pid;
+    rfl::Field<"tid", size_t> tid;
+    rfl::Field<"args", Args> args;
+  };
+
+  /// Aggregate statistics on all events with the same name.
+  struct Stage {
+    rfl::Field<"count", size_t> count;
+    rfl::Field<"total_us", std::int64_t> total_us;
+    rfl::Field<"max_us", std::int64_t> max_us;
+    rfl::Field<"rows", size_t> rows;
+    rfl::Field<"bytes", size_t> bytes;
+    rfl::Field<"peak_rss_kb", size_t> peak_rss_kb;
+  };
+
+  /// The trace as it is sent to the client. It can be loaded into
+  /// chrome://tracing or Perfetto, which ignore the additional fields.
+  struct Trace {
+    rfl::Field<"traceEvents", std::vector<Event>> trace_events;
+    rfl::Field<"displayTimeUnit", std::string> display_time_unit;
+    rfl::Field<"stages", std::map<std::string, Stage>> stages;
+    rfl::Field<"counters", std::map<std::string, size_t>> counters;
+    rfl::Field<"dropped_events", size_t> dropped_events;
+  };
+
+ public:
+  Tracer();
+
+  ~Tracer() = default;
+
+ public:
+  /// Adds _value to the counter _name.
+  void add_to_counter(const std::string& _name, const size_t _value);
+
+  /// Removes all events, stages and counters.
+  void clear();
+
+  /// The process-wide tracer.
+  static Tracer& global();
+
+  /// The number of microseconds since the tracer was started.
+  std::int64_t now() const;
+
+  /// The peak resident set size of the process in kilobytes.
+  static size_t peak_rss_kb();
+
+  /// Records an event that began at _begin (as returned by now()).
+  void record(const std::string& _name, const std::string& _category,
+              const std::int64_t _begin, const size_t _rows,
+              const size_t _bytes);
+
+  /// Returns the trace as JSON in the Chrome trace format.
+  std::string to_json() const;
+
+ private:
+  /// A small, stable id for the calling thread.
+  static size_t thread_id();
+
+ private:
+  /// The point in time at which the tracer was started.
+  const std::chrono::steady_clock::time_point begin_;
+
+  /// Counters, such as the number of bytes sent over the socket.
+  std::map<std::string, size_t> counters_;
+
+  /// The number of events that were discarded, because there were more than
+  /// MAX_EVENTS.
+  size_t dropped_events_;
+
+  /// The most recent events.
+  std::deque<Event> events_;
+
+  /// Protects all of the above.
+  mutable std::mutex mtx_;
+
+  /// Aggregate statistics, keyed by the name of the event.
+  std::map<std::string, Stage> stages_;
+};
+
+}  // namespace logging
+
+#endif  // LOGGING_TRACER_HPP_
@@ -10,5 +10,7 @@
 
 #include "logging/AbstractLogger.hpp"
 #include "logging/ProgressLogger.hpp"
+#include "logging/ScopedTimer.hpp"
+#include "logging/Tracer.hpp"
 
 #endif  // LOGGING_LOGGING_HPP_
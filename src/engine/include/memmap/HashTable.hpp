@@ -0,0 +1,371 @@
+// Copyright 2024 Code17 GmbH
+//
+// This file is licensed under the Elastic License 2.0 (ELv2).
+// Refer to the LICENSE.txt file in the root of the repository
+// for details.
+//
+
+#ifndef MEMMAP_HASHTABLE_HPP_
+#define MEMMAP_HASHTABLE_HPP_
+
+#include "debug/assert_true.hpp"
+#include "memmap/Pool.hpp"
+#include "memmap/Vector.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace memmap {
+// ----------------------------------------------------------------------------
+
+/// An open-addressing hash table with linear probing that lives inside a
+/// Pool. The table only stores the hashes of the keys and leaves it to the
+/// caller to decide whether an entry really matches. That way, the keys can
+/// be stored elsewhere (such as in a StringVector) and are not duplicated.
+///
+/// Like everything inside a Pool, pointers into the table are invalidated by
+/// any allocation in the same pool, so entries are referred to by their slot.
+template <class ValueType>
+class HashTable {
+  /// The table is grown when the load factor exceeds 7/10.
+  static constexpr size_t MAX_LOAD_NUMERATOR = 7;
+  static constexpr size_t MAX_LOAD_DENOMINATOR = 10;
+
+  static constexpr size_t MIN_CAPACITY = 16;
+
+  /// Identifies files written by save(...). Because the slots are written in
+  /// the native byte order, a file written on a machine with a different
+  /// byte order does not start with this number.
+  static constexpr std::uint64_t MAGIC_NUMBER = 0x67656d6c48544231ull;
+
+  /// The number of slots read from or written to a file at once.
+  static constexpr size_t IO_BATCH_SIZE = 65536;
+
+  struct Slot {
+    size_t hash_;
+    bool is_occupied_;
+    ValueType value_;
+  };
+
+ public:
+  explicit HashTable(const std::shared_ptr<Pool> &_pool,
+                     const size_t _expected_size = 0)
+      : pool_(_pool),
+        shift_(0),
+        size_(0),
+        slots_(make_slots(_pool, capacity_for(_expected_size))) {
+    shift_ = calc_shift(slots_.size());
+  }
+
+  HashTable(HashTable<ValueType> &&_other) noexcept = default;
+
+  HashTable(const HashTable<ValueType> &_other) = delete;
+
+  ~HashTable() = default;
+
+ public:
+  /// Returns the slot containing an entry with hash _hash for which
+  /// _is_match(value) is true, if there is one.
+  template <class IsMatch>
+  std::optional<size_t> find(const size_t _hash,
+                             const IsMatch &_is_match) const {
+    for (auto i = home(_hash);; i = (i + 1) & mask()) {
+      const auto &slot = slots_.data()[i];
+
+      if (!slot.is_occupied_) {
+        return std::nullopt;
+      }
+
+      if (slot.hash_ == _hash && _is_match(slot.value_)) {
+        return i;
+      }
+    }
+  }
+
+  /// Calls _f(value) for every entry.
+  template <class F>
+  void for_each(const F &_f) const {
+    for (size_t i = 0; i < slots_.size(); ++i) {
+      if (slots_.data()[i].is_occupied_) {
+        _f(slots_.data()[i].value_);
+      }
+    }
+  }
+
+  /// Restores a table written by save(...), which only requires reading the
+  /// slots rather than inserting every entry again. Returns std::nullopt, if
+  /// the file does not exist or was written in an incompatible format. Note
+  /// that the caller must make sure the hashes were produced by the same
+  /// hash function.
+  static std::optional<HashTable<ValueType>> load(
+      const std::shared_ptr<Pool> &_pool, const std::string &_fname);
+
+  /// Inserts a new entry, the caller must make sure that no matching entry
+  /// exists yet. Returns the slot of the new entry.
+  size_t insert(const size_t _hash, const ValueType &_value) {
+    if ((size_ + 1) * MAX_LOAD_DENOMINATOR >
+        slots_.size() * MAX_LOAD_NUMERATOR) {
+      rehash(slots_.size() * 2);
+    }
+
+    auto i = home(_hash);
+
+    while (slots_.data()[i].is_occupied_) {
+      i = (i + 1) & mask();
+    }
+
+    slots_[i] = Slot{.hash_ = _hash, .is_occupied_ = true, .value_ = _value};
+
+    ++size_;
+
+    return i;
+  }
+
+  /// Move assignment operator.
+  HashTable<ValueType> &operator=(HashTable<ValueType> &&_other) noexcept =
+      default;
+
+  /// Copy assignment operator.
+  HashTable<ValueType> &operator=(const HashTable<ValueType> &_other) = delete;
+
+  /// Hints the CPU to fetch the slot _hash maps to. When looking up many keys
+  /// in a row, prefetching a few keys ahead hides most of the latency of the
+  /// random accesses.
+  void prefetch(const size_t _hash) const {
+    __builtin_prefetch(slots_.data() + home(_hash));
+  }
+
+  /// Makes sure that _size entries can be inserted without growing the
+  /// table. Calling this before a bulk insert avoids repeated rehashing.
+  void reserve(const size_t _size) {
+    const auto capacity = capacity_for(_size);
+    if (capacity > slots_.size()) {
+      rehash(capacity);
+    }
+  }
+
+  /// Writes the slots to _fname, so the table can be restored by load(...).
+  void save(const std::string &_fname) const;
+
+  /// Replaces the value in the slot _slot.
+  void set_value(const size_t _slot, const ValueType &_value) {
+    assert_true(_slot < slots_.size());
+    assert_true(slots_[_slot].is_occupied_);
+    slots_[_slot].value_ = _value;
+  }
+
+  /// The number of entries.
+  size_t size() const { return size_; }
+
+  /// Returns the value in the slot _slot.
+  ValueType value(const size_t _slot) const {
+    assert_true(_slot < slots_.size());
+    assert_true(slots_.data()[_slot].is_occupied_);
+    return slots_.data()[_slot].value_;
+  }
+
+ private:
+  /// The smallest power of two that can hold _size entries without exceeding
+  /// the maximum load factor.
+  static size_t capacity_for(const size_t _size) {
+    return std::bit_ceil(std::max(
+        MIN_CAPACITY,
+        _size * MAX_LOAD_DENOMINATOR / MAX_LOAD_NUMERATOR + 1));
+  }
+
+  /// The number of bits by which the scrambled hash is shifted.
+  static int calc_shift(const size_t _capacity) {
+    return 64 - std::countr_zero(static_cast<std::uint64_t>(_capacity));
+  }
+
+  /// The slot at which the search for _hash begins.
+  size_t home(const size_t _hash) const { return position(_hash, shift_); }
+
+  /// Allocates _capacity empty slots.
+  static Vector<Slot> make_slots(const std::shared_ptr<Pool> &_pool,
+                                 const size_t _capacity) {
+    auto slots = Vector<Slot>(_pool);
+    slots.allocate(_capacity);
+    for (size_t i = 0; i < _capacity; ++i) {
+      slots.push_back(Slot{.hash_ = 0, .is_occupied_ = false, .value_ = {}});
+    }
+    return slots;
+  }
+
+  /// Used for the wrap-around during probing.
+  size_t mask() const { return slots_.size() - 1; }
+
+  /// Maps a hash to a slot. We use Fibonacci hashing, so that poorly
+  /// distributed hashes (such as integer keys) do not result in long probe
+  /// sequences.
+  static size_t position(const size_t _hash, const int _shift) {
+    return static_cast<size_t>(
+        (static_cast<std::uint64_t>(_hash) * 11400714819323198485ull) >>
+        _shift);
+  }
+
+  /// Moves all entries into a table with _capacity slots.
+  void rehash(const size_t _capacity) {
+    auto slots = make_slots(pool_, _capacity);
+
+    const auto shift = calc_shift(_capacity);
+
+    for (size_t i = 0; i < slots_.size(); ++i) {
+      const auto slot = slots_.data()[i];
+
+      if (!slot.is_occupied_) {
+        continue;
+      }
+
+      auto j = position(slot.hash_, shift);
+
+      while (slots.data()[j].is_occupied_) {
+        j = (j + 1) & (_capacity - 1);
+      }
+
+      slots[j] = slot;
+    }
+
+    slots_ = std::move(slots);
+
+    shift_ = shift;
+  }
+
+ private:
+  /// The pool containing the slots.
+  std::shared_ptr<Pool> pool_;
+
+  /// 64 minus the base-2 logarithm of the number of slots.
+  int shift_;
+
+  /// The number of entries.
+  size_t size_;
+
+  /// The slots, the number of slots is always a power of two.
+  Vector<Slot> slots_;
+};
+
+// ----------------------------------------------------------------------------
+
+template <class ValueType>
+std::optional<HashTable<ValueType>> HashTable<ValueType>::load(
+    const std::shared_ptr<Pool> &_pool, const std::string &_fname) {
+  static_assert(std::is_trivially_copyable_v<Slot>,
+                "The slots must be trivially copyable.");
+
+  std::ifstream input(_fname, std::ios::binary);
+
+  if (!input) {
+    return std::nullopt;
+  }
+
+  auto header = std::array<std::uint64_t, 4>();
+
+  input.read(reinterpret_cast<char *>(header.data()),
+             header.size() * sizeof(std::uint64_t));
+
+  const auto [magic_number, slot_size, capacity, size] = header;
+
+  if (!input || magic_number != MAGIC_NUMBER || slot_size != sizeof(Slot) ||
+      capacity < MIN_CAPACITY || !std::has_single_bit(capacity) ||
+      size * MAX_LOAD_DENOMINATOR > capacity * MAX_LOAD_NUMERATOR) {
+    return std::nullopt;
+  }
+
+  auto table = HashTable<ValueType>(_pool);
+
+  auto slots = Vector<Slot>(_pool);
+
+  slots.allocate(capacity);
+
+  auto buffer = std::vector<Slot>(std::min(capacity, IO_BATCH_SIZE));
+
+  size_t num_occupied = 0;
+
+  for (size_t begin = 0; begin < capacity; begin += buffer.size()) {
+    const auto n = std::min(buffer.size(), capacity - begin);
+
+    input.read(reinterpret_cast<char *>(buffer.data()), n * sizeof(Slot));
+
+    if (!input) {
+      return std::nullopt;
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+      num_occupied += buffer[i].is_occupied_ ? 1 : 0;
+      slots.push_back(buffer[i]);
+    }
+  }
+
+  if (num_occupied != size ||
+      input.peek() != std::ifstream::traits_type::eof()) {
+    return std::nullopt;
+  }
+
+  table.slots_ = std::move(slots);
+
+  table.shift_ = calc_shift(capacity);
+
+  table.size_ = size;
+
+  return table;
+}
+
+// ----------------------------------------------------------------------------
+
+template <class ValueType>
+void HashTable<ValueType>::save(const std::string &_fname) const {
+  static_assert(std::is_trivially_copyable_v<Slot>,
+                "The slots must be trivially copyable.");
+
+  std::ofstream output(_fname, std::ios::binary | std::ios::trunc);
+
+  const auto header = std::array<std::uint64_t, 4>(
+      {MAGIC_NUMBER, sizeof(Slot), slots_.size(), size_});
+
+  output.write(reinterpret_cast<const char *>(header.data()),
+               header.size() * sizeof(std::uint64_t));
+
+  // Slot contains padding, which we zero out so that the files do not
+  // depend on uninitialized memory.
+  auto buffer = std::vector<Slot>(std::min(slots_.size(), IO_BATCH_SIZE));
+
+  for (size_t begin = 0; begin < slots_.size(); begin += buffer.size()) {
+    const auto n = std::min(buffer.size(), slots_.size() - begin);
+
+    std::memset(static_cast<void *>(buffer.data()), 0, n * sizeof(Slot));
+
+    for (size_t i = 0; i < n; ++i) {
+      const auto &slot = slots_.data()[begin + i];
+      buffer[i].hash_ = slot.hash_;
+      buffer[i].is_occupied_ = slot.is_occupied_;
+      buffer[i].value_ = slot.value_;
+    }
+
+    output.write(reinterpret_cast<const char *>(buffer.data()),
+                 n * sizeof(Slot));
+  }
+
+  output.close();
+
+  if (!output) {
+    throw std::runtime_error("Could not write the hash table to '" + _fname +
+                             "'.");
+  }
+}
+
+// ----------------------------------------------------------------------------
+}  // namespace memmap
+
+#endif  // MEMMAP_HASHTABLE_HPP_
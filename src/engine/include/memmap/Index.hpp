@@ -8,25 +8,41 @@
 #ifndef MEMMAP_INDEX_HPP_
 #define MEMMAP_INDEX_HPP_
 
-#include "memmap/BTree.hpp"
-#include "memmap/VectorImpl.hpp"
+#include "debug/assert_true.hpp"
+#include "memmap/HashTable.hpp"
+#include "memmap/Pool.hpp"
+#include "memmap/Vector.hpp"
 
 #include <cstddef>
+#include <functional>
+#include <limits>
 #include <memory>
 #include <optional>
+#include <utility>
 
 namespace memmap {
 // ----------------------------------------------------------------------------
 
+/// Maps keys to the rows they occur in, using a compressed sparse row
+/// layout: The row numbers are stored in a single array sorted by key (and
+/// by row number within each key) and offsets_ marks where the rows of each
+/// key begin. Like in helpers::InMemoryIndex, the keys are not assumed to be
+/// dense, so the hash table maps every key to its position in offsets_.
 template <class KeyType>
 class Index {
-  using ValueType = memmap::VectorImpl<size_t>;
-  using BTreeType = BTree<KeyType, ValueType>;
+  using HashTableType = HashTable<std::pair<KeyType, size_t>>;
+
+  /// Marks the new rows that have a NULL key while appending.
+  static constexpr size_t NO_KEY = std::numeric_limits<size_t>::max();
 
  public:
   /// Standard constructor.
   explicit Index(const std::shared_ptr<Pool> &_pool)
-      : btree_(BTreeType(_pool)), pool_(_pool) {
+      : hash_table_(HashTableType(_pool)),
+        nrows_(0),
+        offsets_(Vector<size_t>(_pool)),
+        pool_(_pool),
+        rownums_(Vector<size_t>(_pool)) {
     assert_true(pool_);
   }
 
@@ -34,106 +50,212 @@ class Index {
   Index(const Index<KeyType> &_other) = delete;
 
   /// Move constructor
-  Index(Index<KeyType> &&_other) noexcept
-      : btree_(std::move(_other.btree_)), pool_(_other.pool_) {}
+  Index(Index<KeyType> &&_other) noexcept = default;
 
   /// Destructor
-  ~Index() { deallocate(); }
+  ~Index() = default;
 
  public:
-  /// Deletes all data in the btree_ and declares a fresh btree_.
+  /// Adds the rows [nrows(), _nrows) to the index. The rows that are already
+  /// indexed must not have changed. Negative keys are NULL values and are
+  /// not indexed. _keys is accessed through its access operator rather than
+  /// a raw pointer, because it may live in the same pool and any allocation
+  /// in the pool invalidates raw pointers.
+  template <class KeysType>
+  void append(const KeysType &_keys, const size_t _nrows);
+
+  /// Deletes all data and declares a fresh index.
   void clear();
 
-  /// Inserts a new key-rownum-pair into the index.
-  void insert(const KeyType _key, const size_t _rownum);
+  /// Returns a pointer to the beginning and end of the rownums, or two
+  /// nullptrs, if the key is not found. The pointers are only valid until
+  /// the next allocation in the pool.
+  std::pair<const size_t *, const size_t *> find(const KeyType _key) const {
+    const auto slot = find_slot(_key);
+
+    if (!slot) {
+      return std::make_pair<const size_t *, const size_t *>(nullptr,
+                                                            nullptr);
+    }
+
+    const auto k = hash_table_.value(*slot).second;
+
+    const auto begin = offsets_[k];
+
+    const auto end = offsets_[k + 1];
+
+    return std::make_pair(rownums_.data() + begin, rownums_.data() + end);
+  }
+
+  /// The number of rows that have been indexed.
+  size_t nrows() const { return nrows_; }
 
   /// Move assignment operator.
-  Index<KeyType> &operator=(Index<KeyType> &&_other) noexcept;
+  Index<KeyType> &operator=(Index<KeyType> &&_other) noexcept = default;
 
- public:
   /// Copy assignment operator.
   Index<KeyType> &operator=(const Index<KeyType> &_other) = delete;
 
-  /// Access operator
-  std::optional<ValueType> operator[](const KeyType _key) const {
-    return btree_[_key];
+ private:
+  /// Returns the slot containing _key, if there is one.
+  std::optional<size_t> find_slot(const KeyType _key) const {
+    return hash_table_.find(
+        std::hash<KeyType>()(_key),
+        [_key](const auto &_entry) { return _entry.first == _key; });
   }
 
- private:
-  /// Deallocates all VectorImpls.
-  void deallocate();
+  /// Returns an empty vector with room for at least _capacity elements.
+  static Vector<size_t> make_vector(const std::shared_ptr<Pool> &_pool,
+                                    const size_t _capacity) {
+    auto vec = Vector<size_t>(_pool);
+    if (_capacity > vec.capacity()) {
+      vec.allocate(_capacity);
+    }
+    return vec;
+  }
+
+  /// The number of keys in the index.
+  size_t num_keys() const { return hash_table_.size(); }
 
  private:
-  /// The underlying btree_.
-  BTreeType btree_;
+  /// Maps the keys to their position in offsets_.
+  HashTableType hash_table_;
+
+  /// The number of rows that have been indexed.
+  size_t nrows_;
 
-  /// The pool used to store the values.
+  /// The rownums of key number k are rownums_[offsets_[k]] to
+  /// rownums_[offsets_[k + 1]]. Always contains one more element than there
+  /// are keys.
+  Vector<size_t> offsets_;
+
+  /// The pool used to store the index.
   std::shared_ptr<Pool> pool_;
+
+  /// The row numbers, sorted by key number.
+  Vector<size_t> rownums_;
 };
 
 // ----------------------------------------------------------------------------
 // ----------------------------------------------------------------------------
 
 template <class KeyType>
-void Index<KeyType>::clear() {
-  deallocate();
-  btree_ = BTreeType(pool_);
-}
+template <class KeysType>
+void Index<KeyType>::append(const KeysType &_keys, const size_t _nrows) {
+  assert_true(_nrows >= nrows_);
 
-// ----------------------------------------------------------------------------
-
-template <class KeyType>
-void Index<KeyType>::deallocate() {
-  if (!btree_.is_allocated()) {
+  if (_nrows == nrows_) {
     return;
   }
 
-  auto values = btree_.values();
+  // The new rows are indexed by a counting sort on the key numbers. Because
+  // the new row numbers are greater than all existing ones, the rows of
+  // every key remain sorted when the new rows are placed behind the existing
+  // ones. Everything is accessed through the access operators, because every
+  // allocation in the pool may move the data.
+
+  const auto begin = nrows_;
+
+  const auto num_old_keys = num_keys();
+
+  auto key_nums = make_vector(pool_, _nrows - begin);
+
+  for (size_t i = begin; i < _nrows; ++i) {
+    const KeyType key = _keys[i];
+
+    if (key < 0) {
+      key_nums.push_back(NO_KEY);
+      continue;
+    }
+
+    const auto slot = find_slot(key);
+
+    if (slot) {
+      key_nums.push_back(hash_table_.value(*slot).second);
+      continue;
+    }
 
-  for (auto &v : values) {
-    v.deallocate();
+    const auto k = num_keys();
+
+    hash_table_.insert(std::hash<KeyType>()(key), std::make_pair(key, k));
+
+    key_nums.push_back(k);
   }
-}
 
-// ----------------------------------------------------------------------------
+  // ------------------------------------------------------------------------
 
-template <class KeyType>
-void Index<KeyType>::insert(const KeyType _key, const size_t _rownum) {
-  auto opt = btree_[_key];
+  // positions[k] first holds the number of new rows with key number k and is
+  // then turned into the position at which the next such row is written.
+  auto positions = make_vector(pool_, num_keys());
 
-  if (opt) {
-    opt->push_back(_rownum);
-    btree_.insert(_key, *opt);
-    return;
+  for (size_t k = 0; k < num_keys(); ++k) {
+    positions.push_back(0);
+  }
+
+  for (size_t i = 0; i < key_nums.size(); ++i) {
+    if (key_nums[i] != NO_KEY) {
+      ++positions[key_nums[i]];
+    }
   }
 
-  auto rownums = Vector<size_t>(pool_);
+  auto offsets = make_vector(pool_, num_keys() + 1);
 
-  rownums.push_back(_rownum);
+  offsets.push_back(0);
 
-  assert_true(btree_.is_allocated());
+  for (size_t k = 0; k < num_keys(); ++k) {
+    auto pos = offsets[k];
 
-  btree_.insert(_key, rownums.yield_impl());
-}
+    if (k < num_old_keys) {
+      pos += offsets_[k + 1] - offsets_[k];
+    }
 
-// ----------------------------------------------------------------------------
+    const auto count = positions[k];
 
-template <class KeyType>
-Index<KeyType> &Index<KeyType>::operator=(Index<KeyType> &&_other) noexcept {
-  if (&_other == this) {
-    return *this;
+    positions[k] = pos;
+
+    offsets.push_back(pos + count);
   }
 
-  deallocate();
+  // ------------------------------------------------------------------------
+
+  const auto total = offsets[num_keys()];
 
-  btree_ = std::move(_other.btree_);
+  auto rownums = make_vector(pool_, total);
 
-  pool_ = _other.pool_;
+  for (size_t i = 0; i < total; ++i) {
+    rownums.push_back(0);
+  }
 
-  return *this;
+  for (size_t k = 0; k < num_old_keys; ++k) {
+    auto pos = offsets[k];
+    for (size_t j = offsets_[k]; j < offsets_[k + 1]; ++j) {
+      rownums[pos++] = rownums_[j];
+    }
+  }
+
+  for (size_t i = 0; i < key_nums.size(); ++i) {
+    if (key_nums[i] != NO_KEY) {
+      rownums[positions[key_nums[i]]++] = begin + i;
+    }
+  }
+
+  // ------------------------------------------------------------------------
+
+  offsets_ = std::move(offsets);
+
+  rownums_ = std::move(rownums);
+
+  nrows_ = _nrows;
+}
+
+// ----------------------------------------------------------------------------
+
+template <class KeyType>
+void Index<KeyType>::clear() {
+  *this = Index<KeyType>(pool_);
 }
 
 // ----------------------------------------------------------------------------
 }  // namespace memmap
 
-#endif  // MEMMAP_BTREE_HPP_
+#endif  // MEMMAP_INDEX_HPP_
@@ -0,0 +1,98 @@
+// Copyright 2024 Code17 GmbH
+//
+// This file is licensed under the Elastic License 2.0 (ELv2).
+// Refer to the LICENSE.txt file in the root of the repository
+// for details.
+//
+
+#ifndef MEMMAP_MEMORYLEDGER_HPP_
+#define MEMMAP_MEMORYLEDGER_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <string>
+
+namespace memmap {
+
+/// Keeps track of how much memory the engine uses, so it can switch to
+/// memory mapping before the process is killed for running out of RAM.
+///
+/// The memory-mapped pools report their size to the ledger. Everything else
+/// (in-memory columns, encodings, indices, feature and predictor matrices) is
+/// measured as the resident anonymous memory of the process, because
+/// estimating every allocation would be neither cheap nor accurate and the
+/// anonymous memory is what the OOM killer looks at.
+class MemoryLedger {
+ public:
+  MemoryLedger() : budget_(0), memory_mapped_bytes_(0), num_pools_(0) {}
+
+  ~MemoryLedger() = default;
+
+ public:
+  /// Records that a new pool has been created.
+  void add_pool() { ++num_pools_; }
+
+  /// Whether the resident anonymous memory exceeds _budget, in bytes. A
+  /// budget of 0 means that there is no limit.
+  bool exceeds_budget(const size_t _budget) const {
+    return _budget != 0 && resident_bytes() > _budget;
+  }
+
+  /// The process-wide ledger.
+  static MemoryLedger& global();
+
+  /// The directory large matrices should be memory-mapped to, because the
+  /// budget set by set_budget(...) has been exceeded. std::nullopt while
+  /// the engine is within its budget.
+  std::optional<std::string> overflow_dir() const {
+    if (!exceeds_budget(budget_)) {
+      return std::nullopt;
+    }
+    return overflow_dir_;
+  }
+
+  /// Records that a pool has grown by _bytes.
+  void grow_pool(const size_t _bytes) { memory_mapped_bytes_ += _bytes; }
+
+  /// The number of bytes held by all memory-mapped pools, on disk.
+  size_t memory_mapped_bytes() const { return memory_mapped_bytes_; }
+
+  /// The number of memory-mapped pools.
+  size_t num_pools() const { return num_pools_; }
+
+  /// Records that a pool of _bytes has been destroyed.
+  void remove_pool(const size_t _bytes) {
+    --num_pools_;
+    memory_mapped_bytes_ -= _bytes;
+  }
+
+  /// The resident anonymous memory of the process in bytes, which does not
+  /// include memory-mapped files. Falls back to the resident set size on
+  /// kernels that do not report it and returns 0 on other platforms.
+  static size_t resident_bytes();
+
+  /// Sets the budget in bytes and the directory memory is mapped to once it
+  /// has been exceeded. Must be called before any requests are handled.
+  void set_budget(const size_t _budget, const std::string& _overflow_dir) {
+    budget_ = _budget;
+    overflow_dir_ = _overflow_dir;
+  }
+
+ private:
+  /// The budget in bytes, 0 meaning that there is no limit.
+  std::atomic<size_t> budget_;
+
+  /// The number of bytes held by all memory-mapped pools.
+  std::atomic<size_t> memory_mapped_bytes_;
+
+  /// The number of memory-mapped pools.
+  std::atomic<size_t> num_pools_;
+
+  /// The directory memory is mapped to once the budget has been exceeded.
+  std::string overflow_dir_;
+};
+
+}  // namespace memmap
+
+#endif  // MEMMAP_MEMORYLEDGER_HPP_
@@ -50,6 +50,11 @@ class StringVector {
                            indptr_[_i + 1] - indptr_[_i]);
   }
 
+  /// The number of bytes occupied by the strings and their offsets.
+  size_t nbytes() const {
+    return data_.size() + indptr_.size() * sizeof(size_t);
+  }
+
   /// Copy assignment operator.
   StringVector &operator=(const StringVector &_other) = delete;
 
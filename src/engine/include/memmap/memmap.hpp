@@ -10,7 +10,9 @@
 
 #include "memmap/BTree.hpp"
 #include "memmap/BTreeNode.hpp"
+#include "memmap/HashTable.hpp"
 #include "memmap/Index.hpp"
+#include "memmap/MemoryLedger.hpp"
 #include "memmap/Page.hpp"
 #include "memmap/Pool.hpp"
 #include "memmap/StringVector.hpp"
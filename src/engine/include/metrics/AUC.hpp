@@ -15,6 +15,7 @@
 
 #include <rfl/NamedTuple.hpp>
 
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -70,19 +71,14 @@ class AUC {
   std::vector<Float> calc_rate(const std::vector<Float>& _raw,
                                const Float _all) const;
 
-  /// Calculates the number of true positives, before "compression"
-  /// (summarizing values for which the prediction is the same)
-  std::pair<std::vector<Float>, Float> calc_true_positives_uncompressed(
+  /// "Compresses" the sorted pairs, meaning that we summarize values where
+  /// the prediction is the same. This is necessary, because there is no
+  /// clear order to such values. Returns the true positives and the
+  /// predicted negatives for every threshold as well as the number of all
+  /// positives.
+  std::tuple<std::vector<Float>, std::vector<Float>, Float> compress(
       const std::vector<std::pair<Float, Float>>& _pairs) const;
 
-  /// "Compresses" _true_postives and _all_positives, meaning that we
-  /// summarize values where the prediction is the same. This is necessary,
-  /// because there is no clear order to such values.
-  std::pair<std::vector<Float>, std::vector<Float>> compress(
-      const std::vector<std::pair<Float, Float>>& _pairs,
-      const std::vector<Float>& _true_positives_uncompressed,
-      const Float _all_positives) const;
-
   /// Downsamples _original to 200 values or less.
   std::vector<Float> downsample(const std::vector<Float>& _original) const;
 
@@ -90,15 +86,24 @@ class AUC {
   std::pair<Float, Float> find_min_max(const size_t _j) const;
 
   /// Generates the default values when there is no meaningful prediction.
-  void make_default_values(std::vector<std::vector<Float>>* _true_positive_arr,
-                           std::vector<std::vector<Float>>* _false_positive_arr,
-                           std::vector<std::vector<Float>>* _lift_arr,
-                           std::vector<std::vector<Float>>* _precision_arr,
-                           std::vector<std::vector<Float>>* _proportion_arr,
-                           Float* _auc) const;
-
-  /// Generates a vector of prediction-target-pairs.
-  std::vector<std::pair<Float, Float>> make_pairs(const size_t _j) const;
+  void make_default_values(std::vector<Float>* _true_positive_rate,
+                           std::vector<Float>* _false_positive_rate,
+                           std::vector<Float>* _lift,
+                           std::vector<Float>* _precision,
+                           std::vector<Float>* _proportion, Float* _auc) const;
+
+  /// Generates a vector of prediction-target-pairs, sorted by the
+  /// prediction.
+  std::vector<std::pair<Float, Float>> make_pairs(
+      const size_t _j, const size_t _num_threads) const;
+
+  /// Calculates the scores for target _j. All curves are derived from a
+  /// single sort of the predictions.
+  void score_column(const size_t _j, const size_t _num_threads,
+                    std::vector<Float>* _true_positive_rate,
+                    std::vector<Float>* _false_positive_rate,
+                    std::vector<Float>* _lift, std::vector<Float>* _precision,
+                    std::vector<Float>* _proportion, Float* _auc) const;
 
  private:
   /// Trivial getter
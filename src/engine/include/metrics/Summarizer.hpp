@@ -33,6 +33,11 @@ class Summarizer {
   using FeaturePlots =
       rfl::NamedTuple<f_average_targets, f_feature_densities, f_labels>;
 
+  /// The feature plots plus the feature correlations.
+  using FeatureSummary =
+      rfl::NamedTuple<f_average_targets, f_feature_correlations,
+                      f_feature_densities, f_labels>;
+
   /// The data returned by the different functions must have a common format.
   using PlotWithLabels =
       rfl::NamedTuple<rfl::Field<"labels_", std::vector<std::string>>,
@@ -64,36 +69,14 @@ class Summarizer {
       const Features& _features, const size_t _nrows, const size_t _ncols,
       const size_t _num_bins, const std::vector<const Float*>& _targets);
 
- private:
-  /// Calculates the average targets, which are displayed in the feature view.
-  static std::vector<std::vector<std::vector<Float>>> calculate_average_targets(
-      const std::vector<Float>& _minima, const std::vector<Float>& _step_sizes,
-      const std::vector<size_t>& _actual_num_bins,
-      const std::vector<std::vector<Int>>& _feature_densities,
+  /// Calculates the feature correlations and the feature plots at the same
+  /// time, which is much cheaper than calling calculate_feature_correlations
+  /// and calculate_feature_plots separately.
+  static FeatureSummary calculate_feature_summary(
       const Features& _features, const size_t _nrows, const size_t _ncols,
-      const std::vector<const Float*>& _targets);
-
-  /// Helper function for calculating labels, which
-  /// are needed for column densities and average targets.
-  static std::vector<std::vector<Float>> calculate_labels(
-      const std::vector<Float>& _minima, const std::vector<Float>& _step_sizes,
-      const std::vector<size_t>& _actual_num_bins,
-      const std::vector<std::vector<Int>>& _feature_densities,
-      const Features& _features, const size_t _nrows, const size_t _ncols);
-
-  /// Helper function for calculating the step size and number of bins, which
-  /// is needed for column densities and average targets.
-  static void calculate_step_sizes_and_num_bins(
-      const std::vector<Float>& _minima, const std::vector<Float>& _maxima,
-      const Float _num_bins, std::vector<Float>* _step_sizes,
-      std::vector<size_t>* _actual_num_bins);
-
-  /// Helper function for identifying the correct bin, which
-  /// finds the minimum and maximum.
-  static void find_min_and_max(const Features& _features, const size_t _nrows,
-                               const size_t _ncols, std::vector<Float>* _minima,
-                               std::vector<Float>* _maxima);
+      const size_t _num_bins, const std::vector<const Float*>& _targets);
 
+ private:
   /// Helper function for identifying the correct bin, which
   /// is needed for column densities and average targets.
   static size_t identify_bin(const size_t _num_bins, const Float _step_size,
@@ -109,32 +92,17 @@ class Summarizer {
       const size_t _num_bins,
       const std::vector<std::pair<Float, Float>>& _pairs);
 
- private:
-  /// Helper function
-  template <typename T>
-  static const T& get(const size_t _i, const size_t _j, const size_t _ncols,
-                      const std::vector<T>& _vec) {
-    assert_true(_j < _ncols);
-    assert_true(_i * _ncols + _j < _vec.size());
-    return _vec[_i * _ncols + _j];
-  }
-
-  /// Helper function
-  template <typename T>
-  static T& get(const size_t _i, const size_t _j, const size_t _ncols,
-                std::vector<T>* _vec) {
-    assert_true(_j < _ncols);
-    assert_true(_i * _ncols + _j < _vec->size());
-    return (*_vec)[_i * _ncols + _j];
-  }
-
-  /// Helper function
-  static Float get(const size_t _i, const size_t _j,
-                   const Features& _features) {
-    assert_true(_j < _features.size());
-    assert_true(_i < _features[_j].size());
-    return _features[_j][_i];
-  }
+  /// Calculates the statistics of a single feature and writes them into
+  /// _correlations, _densities, _labels and _average_targets. The features
+  /// are stored column by column, so processing them one at a time makes
+  /// for contiguous memory access.
+  static void summarize_feature(
+      const Float* _feature, const size_t _nrows, const size_t _num_bins,
+      const std::vector<const Float*>& _targets,
+      const std::vector<Float>& _sum_y, const std::vector<Float>& _sum_y_y,
+      std::vector<Float>* _correlations, std::vector<Int>* _densities,
+      std::vector<Float>* _labels,
+      std::vector<std::vector<Float>>* _average_targets);
 };
 
 }  // namespace metrics
@@ -101,10 +101,10 @@ class ReadWriteLock {
     const auto acquired = weak_writer_cond_.wait_for(lock, _duration, [this] {
       return no_active_writers() && no_active_weak_writers();
     });
+    --num_waiting_weak_writers_;
     if (!acquired) {
       throw std::runtime_error("Could not acquire lock: Timeout.");
     }
-    --num_waiting_weak_writers_;
     active_weak_writer_exists_ = true;
     lock.unlock();
   }
@@ -143,10 +143,10 @@ class ReadWriteLock {
       return no_active_readers() && no_active_writers() &&
              no_active_weak_writers();
     });
+    --num_waiting_writers_;
     if (!acquired) {
       throw std::runtime_error("Could not acquire lock: Timeout.");
     }
-    --num_waiting_writers_;
     active_writer_exists_ = true;
     lock.unlock();
   }
@@ -18,5 +18,7 @@
 #include "multithreading/broadcast.hpp"
 #include "multithreading/maximum.hpp"
 #include "multithreading/minimum.hpp"
+#include "multithreading/parallel_for.hpp"
+#include "multithreading/parallel_sort.hpp"
 
 #endif  // MULTITHREADING_HPP_
@@ -0,0 +1,78 @@
+// Copyright 2024 Code17 GmbH
+//
+// This file is licensed under the Elastic License 2.0 (ELv2).
+// Refer to the LICENSE.txt file in the root of the repository
+// for details.
+//
+
+#ifndef MULTITHREADING_PARALLEL_FOR_HPP_
+#define MULTITHREADING_PARALLEL_FOR_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace multithreading {
+// ----------------------------------------------------------------------------
+
+/// The number of threads used when the user has not specified anything.
+inline size_t default_num_threads() {
+  return std::max(static_cast<size_t>(2),
+                  static_cast<size_t>(std::thread::hardware_concurrency()) / 2);
+}
+
+// ----------------------------------------------------------------------------
+
+/// Splits [0, _size) into contiguous chunks and calls
+/// _f(_begin, _end, _thread_num) for every chunk. The first chunk is
+/// processed by the calling thread. If any of the threads throws, the first
+/// exception is rethrown once all threads have been joined.
+template <class F>
+void parallel_for(const size_t _size, const size_t _num_threads, const F& _f) {
+  const auto num_threads =
+      std::max(static_cast<size_t>(1), std::min(_num_threads, _size));
+
+  if (num_threads <= 1) {
+    _f(static_cast<size_t>(0), _size, static_cast<size_t>(0));
+    return;
+  }
+
+  const auto chunk_size = (_size + num_threads - 1) / num_threads;
+
+  std::vector<std::exception_ptr> exceptions(num_threads);
+
+  const auto execute_task = [&](const size_t _thread_num) {
+    const auto begin = std::min(_thread_num * chunk_size, _size);
+    const auto end = std::min(begin + chunk_size, _size);
+    try {
+      _f(begin, end, _thread_num);
+    } catch (...) {
+      exceptions[_thread_num] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> threads;
+
+  for (size_t thread_num = 1; thread_num < num_threads; ++thread_num) {
+    threads.push_back(std::thread(execute_task, thread_num));
+  }
+
+  execute_task(0);
+
+  for (auto& thr : threads) {
+    thr.join();
+  }
+
+  for (const auto& e : exceptions) {
+    if (e) {
+      std::rethrow_exception(e);
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+}  // namespace multithreading
+
+#endif  // MULTITHREADING_PARALLEL_FOR_HPP_
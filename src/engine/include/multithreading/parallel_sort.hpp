@@ -0,0 +1,86 @@
+// Copyright 2024 Code17 GmbH
+//
+// This file is licensed under the Elastic License 2.0 (ELv2).
+// Refer to the LICENSE.txt file in the root of the repository
+// for details.
+//
+
+#ifndef MULTITHREADING_PARALLEL_SORT_HPP_
+#define MULTITHREADING_PARALLEL_SORT_HPP_
+
+#include "multithreading/parallel_for.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace multithreading {
+// ----------------------------------------------------------------------------
+
+/// Sorts [_begin, _end) using up to _num_threads threads: The range is split
+/// into chunks that are sorted in parallel and then merged pairwise, again
+/// in parallel. Like std::sort, this is not stable.
+template <class RandomIt, class Compare>
+void parallel_sort(const RandomIt _begin, const RandomIt _end,
+                   const size_t _num_threads, const Compare& _comp) {
+  const auto size = static_cast<size_t>(std::distance(_begin, _end));
+
+  const auto num_chunks =
+      std::max(static_cast<size_t>(1), std::min(_num_threads, size));
+
+  if (num_chunks <= 1) {
+    std::sort(_begin, _end, _comp);
+    return;
+  }
+
+  const auto chunk_size = (size + num_chunks - 1) / num_chunks;
+
+  auto bounds = std::vector<size_t>();
+
+  for (size_t i = 0; i < num_chunks; ++i) {
+    bounds.push_back(std::min(i * chunk_size, size));
+  }
+
+  bounds.push_back(size);
+
+  const auto sort_chunks = [&](const size_t _b, const size_t _e,
+                               const size_t) {
+    for (size_t i = _b; i < _e; ++i) {
+      std::sort(_begin + bounds[i], _begin + bounds[i + 1], _comp);
+    }
+  };
+
+  parallel_for(num_chunks, num_chunks, sort_chunks);
+
+  while (bounds.size() > 2) {
+    const auto num_merges = (bounds.size() - 1) / 2;
+
+    const auto merge_chunks = [&](const size_t _b, const size_t _e,
+                                  const size_t) {
+      for (size_t i = _b; i < _e; ++i) {
+        std::inplace_merge(_begin + bounds[2 * i], _begin + bounds[2 * i + 1],
+                           _begin + bounds[2 * i + 2], _comp);
+      }
+    };
+
+    parallel_for(num_merges, num_merges, merge_chunks);
+
+    auto merged = std::vector<size_t>();
+
+    for (size_t i = 0; i < bounds.size(); i += 2) {
+      merged.push_back(bounds[i]);
+    }
+
+    if (merged.back() != size) {
+      merged.push_back(size);
+    }
+
+    bounds = std::move(merged);
+  }
+}
+
+// ----------------------------------------------------------------------------
+}  // namespace multithreading
+
+#endif  // MULTITHREADING_PARALLEL_SORT_HPP_
@@ -8,7 +8,9 @@
 #ifndef TEXTMINING_STRINGSPLITTER_HPP_
 #define TEXTMINING_STRINGSPLITTER_HPP_
 
+#include <array>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace textmining {
@@ -19,8 +21,28 @@ namespace textmining {
 struct StringSplitter {
   static constexpr const char* separators_ = " ;,.!?-|\t\"\t\v\f\r\n%'()[]{}";
 
+  /// Whether the character is one of the separators.
+  static bool is_separator(const char _c) {
+    return separator_table_[static_cast<unsigned char>(_c)];
+  }
+
   /// Splits a string into its individual components.
   static std::vector<std::string> split(const std::string& _str);
+
+  /// Splits a string into its individual components, without copying. Empty
+  /// components are not included.
+  static void split(const std::string_view _str,
+                    std::vector<std::string_view>* _tokens);
+
+ private:
+  /// Lookup table for is_separator(...).
+  static constexpr std::array<bool, 256> separator_table_ = []() {
+    std::array<bool, 256> table = {};
+    for (const char* c = separators_; *c != '\0'; ++c) {
+      table[static_cast<unsigned char>(*c)] = true;
+    }
+    return table;
+  }();
 };
 
 // ----------------------------------------------------------------------------
@@ -9,14 +9,19 @@
 #define TEXTMINING_VOCABULARY_HPP_
 
 #include "fct/Range.hpp"
+#include "multithreading/parallel_for.hpp"
 #include "strings/String.hpp"
 #include "textmining/Int.hpp"
 
+#include <algorithm>
+#include <functional>
 #include <map>
 #include <memory>
 #include <ranges>
 #include <set>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -24,6 +29,25 @@ namespace textmining {
 // -------------------------------------------------------------------------
 
 class Vocabulary {
+ public:
+  /// Below this number of rows per thread, spawning threads is not worth it.
+  static constexpr size_t MIN_ROWS_PER_THREAD = 10000;
+
+ private:
+  /// Allows us to look up std::string_view in a map with std::string keys
+  /// without allocating.
+  struct StringViewHasher {
+    using is_transparent = void;
+
+    size_t operator()(const std::string_view _str) const {
+      return std::hash<std::string_view>()(_str);
+    }
+  };
+
+  /// Maps each word to its document frequency.
+  using DfMap =
+      std::unordered_map<std::string, size_t, StringViewHasher, std::equal_to<>>;
+
  public:
   /// Generates the vocabulary based on a column.
   template <class IteratorType>
@@ -56,6 +80,13 @@ class Vocabulary {
     return vocab;
   }
 
+  /// The number of threads used for a column containing _nrows rows.
+  static size_t num_threads(const size_t _nrows) {
+    return std::max(static_cast<size_t>(1),
+                    std::min(multithreading::default_num_threads(),
+                             _nrows / MIN_ROWS_PER_THREAD));
+  }
+
   /// Processes a single text field to extract a set of unique words.
   static std::set<std::string> process_text_field(
       const strings::String& _text_field);
@@ -64,6 +95,13 @@ class Vocabulary {
   static std::vector<std::string> split_text_field(
       const strings::String& _text_field);
 
+  /// Writes the lower case version of the text field into _buffer and the
+  /// unique words contained in it into _tokens, as sorted views on _buffer.
+  /// Both are cleared first, so they can be reused for every row without
+  /// allocating.
+  static void tokenize(const strings::String& _text_field, std::string* _buffer,
+                       std::vector<std::string_view>* _tokens);
+
   /// Generates an unordered_map for the vocabulary.
   template <class IteratorType>
   static std::map<strings::String, Int> to_map(
@@ -80,52 +118,73 @@ class Vocabulary {
   }
 
  private:
-  /// Counts the document frequency for each individual word.
+  /// Counts the document frequency for each individual word. The rows are
+  /// distributed over several threads, each of which counts into its own map,
+  /// and the maps are merged afterwards. The result is sorted by document
+  /// frequency in descending order, ties are broken alphabetically.
   template <class IteratorType>
   static std::vector<std::pair<strings::String, size_t>> count_df(
       const fct::Range<IteratorType> _range) {
-    const auto process =
-        [](const strings::String& _text_field) -> std::set<std::string> {
-      return Vocabulary::process_text_field(_text_field);
-    };
+    const auto nrows = _range.size();
 
-    const auto range = _range | std::views::transform(process);
+    auto df_maps = std::vector<DfMap>(num_threads(nrows));
 
-    const auto df_map = make_map(range);
+    const auto count = [&_range, &df_maps](const size_t _begin,
+                                           const size_t _end,
+                                           const size_t _thread_num) {
+      auto& df_map = df_maps.at(_thread_num);
 
-    using Pair = std::pair<strings::String, size_t>;
+      std::string buffer;
 
-    auto df_vec = std::vector<Pair>(df_map.begin(), df_map.end());
+      std::vector<std::string_view> tokens;
 
-    const auto by_count = [](const Pair& p1, const Pair& p2) -> bool {
-      return p1.second > p2.second;
-    };
+      auto it = _range.begin() + _begin;
 
-    std::ranges::sort(df_vec, by_count);
+      for (size_t i = _begin; i < _end; ++i, ++it) {
+        tokenize(*it, &buffer, &tokens);
 
-    return df_vec;
-  }
+        for (const auto token : tokens) {
+          const auto df = df_map.find(token);
 
-  /// Counts the document frequency for each individual word.
-  template <class RangeType>
-  static std::map<strings::String, size_t> make_map(const RangeType& _range) {
-    std::map<strings::String, size_t> df_map;
+          if (df == df_map.end()) {
+            df_map.emplace(std::string(token), 1);
+          } else {
+            df->second++;
+          }
+        }
+      }
+    };
 
-    for (const auto& unique_tokens : _range) {
-      for (const auto& token_str : unique_tokens) {
-        const auto token = strings::String(token_str);
+    multithreading::parallel_for(nrows, df_maps.size(), count);
 
-        const auto it = df_map.find(token);
+    auto& df_map = df_maps.at(0);
 
-        if (it == df_map.end()) {
-          df_map[token] = 1;
-        } else {
-          it->second++;
-        }
+    for (size_t i = 1; i < df_maps.size(); ++i) {
+      for (const auto& [token, df] : df_maps.at(i)) {
+        df_map[token] += df;
       }
     }
 
-    return df_map;
+    using Pair = std::pair<strings::String, size_t>;
+
+    auto df_vec = std::vector<Pair>();
+
+    df_vec.reserve(df_map.size());
+
+    for (const auto& [token, df] : df_map) {
+      df_vec.emplace_back(strings::String(token), df);
+    }
+
+    const auto by_count = [](const Pair& p1, const Pair& p2) -> bool {
+      if (p1.second != p2.second) {
+        return p1.second > p2.second;
+      }
+      return p1.first < p2.first;
+    };
+
+    std::ranges::sort(df_vec, by_count);
+
+    return df_vec;
   }
 };
 
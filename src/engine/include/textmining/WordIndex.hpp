@@ -12,7 +12,11 @@
 #include "textmining/Int.hpp"
 #include "textmining/Vocabulary.hpp"
 
+#include <algorithm>
 #include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -66,48 +70,77 @@ class WordIndex {
   const std::vector<Int>& words() const { return words_; }
 
  private:
-  /// Generates the index and the indptr during construction.
+  /// Generates the index and the indptr during construction. The rows are
+  /// distributed over several threads, each of which writes the words for
+  /// its own rows. Because every thread processes a contiguous block of rows,
+  /// the blocks can simply be concatenated afterwards.
   template <class RangeType>
   std::pair<std::vector<size_t>, std::vector<Int>> make_indptr_and_words(
       const RangeType& _range) const {
-    const auto voc_range = fct::Range<const strings::String*>(
-        vocabulary().data(), vocabulary().data() + vocabulary().size());
+    auto voc_map = std::unordered_map<std::string_view, Int>();
 
-    const auto voc_map = Vocabulary::to_map(voc_range);
+    voc_map.reserve(vocabulary().size());
 
-    const auto to_number = [&voc_map](const strings::String& word) -> Int {
-      const auto it = voc_map.find(word);
-      if (it == voc_map.end()) {
-        return -1;
-      }
-      return it->second;
-    };
+    for (size_t i = 0; i < vocabulary().size(); ++i) {
+      const auto& word = vocabulary()[i];
+      voc_map[std::string_view(word.c_str(), word.size())] =
+          static_cast<Int>(i);
+    }
+
+    const auto nrows = _range.size();
+
+    auto num_words = std::vector<size_t>(nrows);
+
+    auto local_words =
+        std::vector<std::vector<Int>>(Vocabulary::num_threads(nrows));
+
+    const auto make_words = [&_range, &voc_map, &num_words, &local_words](
+                                const size_t _begin, const size_t _end,
+                                const size_t _thread_num) {
+      auto& words = local_words.at(_thread_num);
+
+      std::string buffer;
 
-    const auto in_vocabulary = [](const Int val) -> bool { return val >= 0; };
+      std::vector<std::string_view> tokens;
 
-    auto indptr = std::vector<size_t>({0});
+      auto it = _range.begin() + _begin;
 
-    auto words = std::vector<Int>(0);
+      for (size_t i = _begin; i < _end; ++i, ++it) {
+        Vocabulary::tokenize(*it, &buffer, &tokens);
 
-    for (const auto& textfield : _range) {
-      const auto processed = Vocabulary::process_text_field(textfield);
+        const auto begin = words.size();
 
-      auto range = processed | std::views::transform(to_number) |
-                   std::views::filter(in_vocabulary);
+        for (const auto token : tokens) {
+          const auto word = voc_map.find(token);
+          if (word != voc_map.end()) {
+            words.push_back(word->second);
+          }
+        }
 
-      size_t num_words = 0;
+        std::sort(words.begin() + begin, words.end());
 
-      for (const auto& word_ix : range) {
-        words.push_back(word_ix);
-        ++num_words;
+        num_words[i] = words.size() - begin;
       }
+    };
+
+    multithreading::parallel_for(nrows, local_words.size(), make_words);
 
-      std::sort(words.begin() + indptr.back(),
-                words.begin() + indptr.back() + num_words);
+    auto indptr = std::vector<size_t>(nrows + 1);
 
-      indptr.push_back(indptr.back() + num_words);
+    for (size_t i = 0; i < nrows; ++i) {
+      indptr[i + 1] = indptr[i] + num_words[i];
     }
 
+    auto words = std::vector<Int>();
+
+    words.reserve(indptr.back());
+
+    for (const auto& w : local_words) {
+      words.insert(words.end(), w.begin(), w.end());
+    }
+
+    assert_true(words.size() == indptr.back());
+
     return std::make_pair(indptr, words);
   }
 
@@ -8,13 +8,23 @@
 #include "containers/DataFrame.hpp"
 
 #include "containers/DataFramePrinter.hpp"
+#include "containers/Roles.hpp"
 #include "database/Getter.hpp"
 #include "io/CSVReader.hpp"
+#include "multithreading/parallel_for.hpp"
 
 #include <Poco/Path.h>
 #include <Poco/TemporaryFile.h>
 #include <rfl/Field.hpp>
-
+#include <rfl/json/write.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <mutex>
+#include <numeric>
+#include <optional>
 #include <stdexcept>
 
 namespace containers {
@@ -488,9 +498,12 @@ std::vector<std::string> DataFrame::concat_colnames(
 // ----------------------------------------------------------------------------
 
 void DataFrame::create_indices() {
+  // Every index needs its own map, so we must not copy them.
   if (indices().size() != join_keys().size()) {
-    indices() =
-        std::vector<DataFrameIndex>(join_keys().size(), DataFrameIndex(pool_));
+    indices().clear();
+    for (size_t i = 0; i < join_keys().size(); ++i) {
+      indices().emplace_back(DataFrameIndex(pool_));
+    }
   }
 
   for (size_t i = 0; i < join_keys().size(); ++i) {
@@ -582,47 +595,343 @@ void DataFrame::from_csv(
 
 void DataFrame::from_db(rfl::Ref<database::Connector> _connector,
                         const std::string &_tname, const Schema &_schema) {
-  auto categoricals = make_vectors<Int>(_schema.categoricals().size());
+  const auto all_colnames = concat_colnames(_schema);
 
-  auto join_keys = make_vectors<Int>(_schema.join_keys().size());
+  const auto iterators = _connector->select_partitioned(
+      all_colnames, _tname, "", multithreading::default_num_threads());
 
-  auto numericals = make_vectors<Float>(_schema.numericals().size());
+  auto indices = std::vector<size_t>(all_colnames.size());
 
-  auto targets = make_vectors<Float>(_schema.targets().size());
+  std::iota(indices.begin(), indices.end(), 0);
 
-  auto text = make_vectors<strings::String>(_schema.text().size());
+  from_iterators(iterators, indices, _connector->time_formats(), _schema);
+}
 
-  auto time_stamps = make_vectors<Float>(_schema.time_stamps().size());
+// ----------------------------------------------------------------------------
 
-  auto unused_floats = make_vectors<Float>(_schema.unused_floats().size());
+void DataFrame::from_iterators(
+    const std::vector<rfl::Ref<database::Iterator>> &_iterators,
+    const std::vector<size_t> &_indices,
+    const std::vector<std::string> &_time_formats, const Schema &_schema) {
+  assert_true(_iterators.size() > 0);
 
-  auto unused_strings =
-      make_vectors<strings::String>(_schema.unused_strings().size());
+  size_t k = 0;
 
-  const auto all_colnames = concat_colnames(_schema);
+  const auto take_indices = [&_indices, &k](const size_t _n) {
+    assert_true(k + _n <= _indices.size());
+    const auto begin = _indices.begin() + k;
+    k += _n;
+    return std::vector<size_t>(begin, begin + _n);
+  };
 
-  auto iterator = _connector->select(all_colnames, _tname, "");
+  const auto categorical_ix = take_indices(_schema.categoricals().size());
 
-  while (!iterator->end()) {
-    for (auto &vec : categoricals)
-      vec->push_back((*categories_)[iterator->get_string()]);
+  const auto join_key_ix = take_indices(_schema.join_keys().size());
 
-    for (auto &vec : join_keys)
-      vec->push_back((*join_keys_encoding_)[iterator->get_string()]);
+  const auto numerical_ix = take_indices(_schema.numericals().size());
 
-    for (auto &vec : numericals) vec->push_back(iterator->get_double());
+  const auto target_ix = take_indices(_schema.targets().size());
 
-    for (auto &vec : targets) vec->push_back(iterator->get_double());
+  const auto text_ix = take_indices(_schema.text().size());
 
-    for (auto &vec : text)
-      vec->emplace_back(strings::String::parse_null(iterator->get_string()));
+  const auto time_stamp_ix = take_indices(_schema.time_stamps().size());
 
-    for (auto &vec : time_stamps) vec->push_back(iterator->get_time_stamp());
+  const auto unused_float_ix = take_indices(_schema.unused_floats().size());
 
-    for (auto &vec : unused_floats) vec->push_back(iterator->get_double());
+  const auto unused_string_ix = take_indices(_schema.unused_strings().size());
 
-    for (auto &vec : unused_strings)
-      vec->emplace_back(strings::String::parse_null(iterator->get_string()));
+  assert_true(k == _indices.size());
+
+  // Every column is fetched in the type required by its role. Columns
+  // required by several roles with different types are fetched as strings
+  // and parsed. Columns that are not required at all are skipped.
+  auto coltypes = std::vector<io::Datatype>(
+      _iterators.at(0)->colnames().size(), io::Datatype::unknown);
+
+  const auto require = [&coltypes](const std::vector<size_t> &_ix,
+                                   const io::Datatype _type) {
+    for (const auto ix : _ix) {
+      auto &coltype = coltypes.at(ix);
+      coltype = (coltype == io::Datatype::unknown || coltype == _type)
+                    ? _type
+                    : io::Datatype::string;
+    }
+  };
+
+  require(categorical_ix, io::Datatype::string);
+
+  require(join_key_ix, io::Datatype::string);
+
+  require(numerical_ix, io::Datatype::double_precision);
+
+  require(target_ix, io::Datatype::double_precision);
+
+  require(text_ix, io::Datatype::string);
+
+  require(time_stamp_ix, io::Datatype::time_stamp);
+
+  require(unused_float_ix, io::Datatype::double_precision);
+
+  require(unused_string_ix, io::Datatype::string);
+
+  const auto get_string = [](const database::BatchColumn &_col,
+                             const size_t _i) -> std::string {
+    return _col.is_null(_i) ? std::string("NULL")
+                            : std::string(_col.string(_i));
+  };
+
+  const auto get_double = [](const database::BatchColumn &_col,
+                             const size_t _i) {
+    if (_col.type() != io::Datatype::string) {
+      return _col.floats()[_i];
+    }
+    return _col.is_null(_i) ? static_cast<Float>(NAN)
+                            : database::Getter::get_double(
+                                  std::string(_col.string(_i)));
+  };
+
+  const auto get_time_stamp = [&_time_formats](
+                                  const database::BatchColumn &_col,
+                                  const size_t _i) {
+    if (_col.type() != io::Datatype::string) {
+      return _col.floats()[_i];
+    }
+    return _col.is_null(_i) ? static_cast<Float>(NAN)
+                            : database::Getter::get_time_stamp(
+                                  std::string(_col.string(_i)), _time_formats);
+  };
+
+  // The data read from a single partition. The encodings are not
+  // thread-safe and must not depend on the order in which the threads
+  // finish, so only one partition at a time may encode, in the order of the
+  // iterators. Until it is a partition's turn, its categoricals and join
+  // keys are buffered as strings in to_encode_.
+  struct Partition {
+    std::vector<std::string> to_encode_;
+    std::vector<std::shared_ptr<std::vector<Int>>> categoricals_;
+    std::vector<std::shared_ptr<std::vector<Int>>> join_keys_;
+    std::vector<std::shared_ptr<std::vector<Float>>> numericals_;
+    std::vector<std::shared_ptr<std::vector<Float>>> targets_;
+    std::vector<std::shared_ptr<std::vector<strings::String>>> text_;
+    std::vector<std::shared_ptr<std::vector<Float>>> time_stamps_;
+    std::vector<std::shared_ptr<std::vector<Float>>> unused_floats_;
+    std::vector<std::shared_ptr<std::vector<strings::String>>> unused_strings_;
+    size_t nrows_ = 0;
+  };
+
+  auto partitions = std::vector<Partition>(_iterators.size());
+
+  // The partition that is currently allowed to encode. It is only advanced
+  // by the thread that has just finished reading that partition, while
+  // holding encoding_mtx.
+  std::atomic<size_t> next_to_encode = 0;
+
+  std::mutex encoding_mtx;
+
+  auto finished = std::vector<bool>(_iterators.size());
+
+  const auto flush = [this](Partition *_partition) {
+    size_t pos = 0;
+
+    while (pos < _partition->to_encode_.size()) {
+      for (auto &vec : _partition->categoricals_) {
+        vec->push_back((*categories_)[_partition->to_encode_[pos++]]);
+      }
+
+      for (auto &vec : _partition->join_keys_) {
+        vec->push_back(
+            (*join_keys_encoding_)[_partition->to_encode_[pos++]]);
+      }
+    }
+
+    _partition->to_encode_ = std::vector<std::string>();
+  };
+
+  // Called when partition _p has been read completely. If it is the
+  // partition currently encoding, the turn passes on to the next partition,
+  // flushing all partitions that have finished in the meantime.
+  const auto finish = [&](const size_t _p) {
+    std::lock_guard<std::mutex> lock(encoding_mtx);
+
+    finished[_p] = true;
+
+    auto next = next_to_encode.load(std::memory_order_acquire);
+
+    if (next != _p) {
+      return;
+    }
+
+    while (next < partitions.size() && finished[next]) {
+      flush(&partitions[next]);
+      ++next;
+    }
+
+    next_to_encode.store(next, std::memory_order_release);
+  };
+
+  const auto read_partition = [&](const size_t _p) {
+    auto *iterator = _iterators[_p].get();
+
+    auto *partition = &partitions[_p];
+
+    partition->categoricals_ = make_vectors<Int>(categorical_ix.size());
+    partition->join_keys_ = make_vectors<Int>(join_key_ix.size());
+    partition->numericals_ = make_vectors<Float>(numerical_ix.size());
+    partition->targets_ = make_vectors<Float>(target_ix.size());
+    partition->text_ = make_vectors<strings::String>(text_ix.size());
+    partition->time_stamps_ = make_vectors<Float>(time_stamp_ix.size());
+    partition->unused_floats_ = make_vectors<Float>(unused_float_ix.size());
+    partition->unused_strings_ =
+        make_vectors<strings::String>(unused_string_ix.size());
+
+    const auto read_floats = [](const database::Batch &_batch,
+                                const std::vector<size_t> &_ix,
+                                const size_t _nrows, const auto &_get,
+                                auto *_vectors) {
+      for (size_t i = 0; i < _ix.size(); ++i) {
+        const auto &col = _batch[_ix[i]];
+        for (size_t r = 0; r < _nrows; ++r) {
+          (*_vectors)[i]->push_back(_get(col, r));
+        }
+      }
+    };
+
+    const auto read_strings = [&get_string](const database::Batch &_batch,
+                                            const std::vector<size_t> &_ix,
+                                            const size_t _nrows,
+                                            auto *_vectors) {
+      for (size_t i = 0; i < _ix.size(); ++i) {
+        const auto &col = _batch[_ix[i]];
+        for (size_t r = 0; r < _nrows; ++r) {
+          (*_vectors)[i]->emplace_back(
+              strings::String::parse_null(get_string(col, r)));
+        }
+      }
+    };
+
+    constexpr size_t batch_size = 10000;
+
+    auto batch = database::Batch();
+
+    while (true) {
+      const auto nrows = iterator->fetch_batch(coltypes, batch_size, &batch);
+
+      if (nrows == 0) {
+        break;
+      }
+
+      // When reading from a single iterator, this is always true, so
+      // nothing is ever buffered.
+      const bool my_turn =
+          next_to_encode.load(std::memory_order_acquire) == _p;
+
+      if (my_turn) {
+        flush(partition);
+      }
+
+      for (size_t r = 0; r < nrows; ++r) {
+        for (size_t i = 0; i < categorical_ix.size(); ++i) {
+          auto str = get_string(batch[categorical_ix[i]], r);
+          if (my_turn) {
+            partition->categoricals_[i]->push_back((*categories_)[str]);
+          } else {
+            partition->to_encode_.emplace_back(std::move(str));
+          }
+        }
+
+        for (size_t i = 0; i < join_key_ix.size(); ++i) {
+          auto str = get_string(batch[join_key_ix[i]], r);
+          if (my_turn) {
+            partition->join_keys_[i]->push_back(
+                (*join_keys_encoding_)[str]);
+          } else {
+            partition->to_encode_.emplace_back(std::move(str));
+          }
+        }
+      }
+
+      read_floats(batch, numerical_ix, nrows, get_double,
+                  &partition->numericals_);
+
+      read_floats(batch, target_ix, nrows, get_double, &partition->targets_);
+
+      read_strings(batch, text_ix, nrows, &partition->text_);
+
+      read_floats(batch, time_stamp_ix, nrows, get_time_stamp,
+                  &partition->time_stamps_);
+
+      read_floats(batch, unused_float_ix, nrows, get_double,
+                  &partition->unused_floats_);
+
+      read_strings(batch, unused_string_ix, nrows,
+                   &partition->unused_strings_);
+
+      partition->nrows_ += nrows;
+    }
+
+    finish(_p);
+  };
+
+  multithreading::parallel_for(
+      _iterators.size(), _iterators.size(),
+      [&](const size_t _begin, const size_t _end, const size_t) {
+        for (size_t p = _begin; p < _end; ++p) {
+          read_partition(p);
+        }
+      });
+
+  assert_true(next_to_encode == partitions.size());
+
+  auto categoricals = make_vectors<Int>(categorical_ix.size());
+
+  auto join_keys = make_vectors<Int>(join_key_ix.size());
+
+  auto numericals = make_vectors<Float>(numerical_ix.size());
+
+  auto targets = make_vectors<Float>(target_ix.size());
+
+  auto text = make_vectors<strings::String>(text_ix.size());
+
+  auto time_stamps = make_vectors<Float>(time_stamp_ix.size());
+
+  auto unused_floats = make_vectors<Float>(unused_float_ix.size());
+
+  auto unused_strings = make_vectors<strings::String>(unused_string_ix.size());
+
+  // The first partition is moved rather than copied, so reading from a
+  // single iterator requires no additional memory.
+  const auto append = [](auto *_from, auto *_to) {
+    assert_true(_from->size() == _to->size());
+    for (size_t i = 0; i < _to->size(); ++i) {
+      auto &from = *(*_from)[i];
+      auto &to = *(*_to)[i];
+      if (to.size() == 0) {
+        to = std::move(from);
+      } else {
+        to.insert(to.end(), from.begin(), from.end());
+      }
+      from = std::remove_reference_t<decltype(from)>();
+    }
+  };
+
+  for (auto &partition : partitions) {
+    assert_true(partition.to_encode_.size() == 0);
+
+    append(&partition.categoricals_, &categoricals);
+
+    append(&partition.join_keys_, &join_keys);
+
+    append(&partition.numericals_, &numericals);
+
+    append(&partition.targets_, &targets);
+
+    append(&partition.text_, &text);
+
+    append(&partition.time_stamps_, &time_stamps);
+
+    append(&partition.unused_floats_, &unused_floats);
+
+    append(&partition.unused_strings_, &unused_strings);
   }
 
   auto df = DataFrame(name(), categories_, join_keys_encoding_, make_pool());
@@ -832,136 +1141,24 @@ void DataFrame::from_json(const commands::DataFrameFromJSON &_obj,
 
 void DataFrame::from_query(const rfl::Ref<database::Connector> _connector,
                            const std::string &_query, const Schema &_schema) {
-  auto categoricals = make_vectors<Int>(_schema.categoricals().size());
-
-  auto join_keys = make_vectors<Int>(_schema.join_keys().size());
-
-  auto numericals = make_vectors<Float>(_schema.numericals().size());
-
-  auto targets = make_vectors<Float>(_schema.targets().size());
-
-  auto text = make_vectors<strings::String>(_schema.text().size());
-
-  auto time_stamps = make_vectors<Float>(_schema.time_stamps().size());
-
-  auto unused_floats = make_vectors<Float>(_schema.unused_floats().size());
-
-  auto unused_strings =
-      make_vectors<strings::String>(_schema.unused_strings().size());
-
   auto iterator = _connector->select(_query);
 
   const auto iter_colnames = iterator->colnames();
 
-  const auto make_column_indices = [iter_colnames](
-                                       const std::vector<std::string> &_names) {
-    std::vector<size_t> indices;
+  auto indices = std::vector<size_t>();
 
-    for (const auto &name : _names) {
-      const auto it =
-          std::find(iter_colnames.begin(), iter_colnames.end(), name);
+  for (const auto &name : concat_colnames(_schema)) {
+    const auto it = std::find(iter_colnames.begin(), iter_colnames.end(), name);
 
-      if (it == _names.end()) {
-        throw std::runtime_error("No column named '" + name + "' in query!");
-      }
-
-      indices.push_back(
-          static_cast<size_t>(std::distance(iter_colnames.begin(), it)));
+    if (it == iter_colnames.end()) {
+      throw std::runtime_error("No column named '" + name + "' in query!");
     }
 
-    return indices;
-  };
-
-  const auto categorical_ix = make_column_indices(_schema.categoricals());
-
-  const auto join_key_ix = make_column_indices(_schema.join_keys());
-
-  const auto numerical_ix = make_column_indices(_schema.numericals());
-
-  const auto target_ix = make_column_indices(_schema.targets());
-
-  const auto text_ix = make_column_indices(_schema.text());
-
-  const auto time_stamp_ix = make_column_indices(_schema.time_stamps());
-
-  const auto unused_float_ix = make_column_indices(_schema.unused_floats());
-
-  const auto unused_string_ix = make_column_indices(_schema.unused_strings());
-
-  const auto time_formats = _connector->time_formats();
-
-  while (!iterator->end()) {
-    auto line = std::vector<std::string>(iter_colnames.size());
-
-    for (auto &field : line) {
-      field = iterator->get_string();
-    }
-
-    for (size_t i = 0; i < categoricals.size(); ++i) {
-      const auto &str = line[categorical_ix[i]];
-      categoricals[i]->push_back((*categories_)[str]);
-    }
-
-    for (size_t i = 0; i < join_keys.size(); ++i) {
-      const auto &str = line[join_key_ix[i]];
-      join_keys[i]->push_back((*join_keys_encoding_)[str]);
-    }
-
-    for (size_t i = 0; i < numericals.size(); ++i) {
-      const auto &str = line[numerical_ix[i]];
-      numericals[i]->push_back(database::Getter::get_double(str));
-    }
-
-    for (size_t i = 0; i < targets.size(); ++i) {
-      const auto &str = line[target_ix[i]];
-      targets[i]->push_back(database::Getter::get_double(str));
-    }
-
-    for (size_t i = 0; i < text.size(); ++i) {
-      const auto &str = line[text_ix[i]];
-      text[i]->push_back(strings::String::parse_null(str));
-    }
-
-    for (size_t i = 0; i < time_stamps.size(); ++i) {
-      const auto &str = line[time_stamp_ix[i]];
-      time_stamps[i]->push_back(
-          database::Getter::get_time_stamp(str, time_formats));
-    }
-
-    for (size_t i = 0; i < unused_floats.size(); ++i) {
-      const auto &str = line[unused_float_ix[i]];
-      unused_floats[i]->push_back(database::Getter::get_double(str));
-    }
-
-    for (size_t i = 0; i < unused_strings.size(); ++i) {
-      const auto &str = line[unused_string_ix[i]];
-      unused_strings[i]->emplace_back(strings::String::parse_null(str));
-    }
+    indices.push_back(
+        static_cast<size_t>(std::distance(iter_colnames.begin(), it)));
   }
 
-  auto df = DataFrame(name(), categories_, join_keys_encoding_, make_pool());
-
-  df.add_int_vectors(_schema.categoricals(), categoricals, ROLE_CATEGORICAL);
-
-  df.add_int_vectors(_schema.join_keys(), join_keys, ROLE_JOIN_KEY);
-
-  df.add_float_vectors(_schema.numericals(), numericals, ROLE_NUMERICAL);
-
-  df.add_float_vectors(_schema.targets(), targets, ROLE_TARGET);
-
-  df.add_string_vectors(_schema.text(), text, ROLE_TEXT);
-
-  df.add_float_vectors(_schema.time_stamps(), time_stamps, ROLE_TIME_STAMP);
-
-  df.add_float_vectors(_schema.unused_floats(), unused_floats,
-                       ROLE_UNUSED_FLOAT);
-
-  df.add_string_vectors(_schema.unused_strings(), unused_strings,
-                        ROLE_UNUSED_STRING);
-
-  df.check_plausibility();
-
-  *this = std::move(df);
+  from_iterators({iterator}, indices, _connector->time_formats(), _schema);
 }
 
 // ----------------------------------------------------------------------------
@@ -1587,6 +1784,10 @@ void DataFrame::save(const std::string &_temp_dir, const std::string &_path,
 
   save_text(tpath, "last_change.txt", last_change_);
 
+  // Allows the engine to retrieve the roles without loading the data frame.
+  save_text(tpath, "roles.json",
+            rfl::json::write(Roles::from_schema(to_schema(false))));
+
   if (build_history_) {
     save_text(tpath, "build_history.json", build_history_->to_json());
   }
@@ -1732,6 +1933,37 @@ std::vector<std::string> DataFrame::subroles(const std::string &_name) const {
 
 // ----------------------------------------------------------------------------
 
+DataFrame DataFrame::to_memory_mapped(const std::string &_temp_dir) const {
+  auto df = *this;
+
+  df.pool_ = std::make_shared<memmap::Pool>(_temp_dir);
+
+  const auto move_to_pool = [&df](auto *_columns) {
+    for (auto &col : *_columns) {
+      auto new_col = col.clone(df.pool_);
+      new_col.set_subroles(col.subroles());
+      col = new_col;
+    }
+  };
+
+  move_to_pool(&df.categoricals_);
+  move_to_pool(&df.join_keys_);
+  move_to_pool(&df.numericals_);
+  move_to_pool(&df.targets_);
+  move_to_pool(&df.text_);
+  move_to_pool(&df.time_stamps_);
+  move_to_pool(&df.unused_floats_);
+  move_to_pool(&df.unused_strings_);
+
+  // The indices must be rebuilt in the new pool.
+  df.indices_.clear();
+  df.create_indices();
+
+  return df;
+}
+
+// ----------------------------------------------------------------------------
+
 containers::MonitorSummary DataFrame::to_monitor() const {
   const auto get_colname = [](const auto &_col) { return _col.unit(); };
 
@@ -1842,42 +2074,100 @@ Schema DataFrame::to_schema(const bool _separate_discrete) const {
 // ----------------------------------------------------------------------------
 
 void DataFrame::where(const std::vector<bool> &_condition) {
-  auto df = DataFrame(name(), categories_, join_keys_encoding_, make_pool());
+  if (ncols() > 0 && _condition.size() != nrows()) {
+    throw std::runtime_error(
+        "Size of keys must be identical to number of rows!");
+  }
 
-  for (size_t i = 0; i < num_categoricals(); ++i) {
-    df.add_int_column(categorical(i).where(_condition), ROLE_CATEGORICAL);
+  // The selection is computed once and then applied to all columns.
+  auto selection = std::vector<size_t>();
+
+  selection.reserve(std::count(_condition.begin(), _condition.end(), true));
+
+  for (size_t i = 0; i < _condition.size(); ++i) {
+    if (_condition[i]) {
+      selection.push_back(i);
+    }
   }
 
-  for (size_t i = 0; i < num_join_keys(); ++i) {
-    df.add_int_column(join_key(i).where(_condition), ROLE_JOIN_KEY);
+  auto tasks = std::vector<std::function<void()>>();
+
+  const auto add_tasks = [&selection, &tasks]<class T>(
+                             const std::vector<Column<T>> &_columns,
+                             std::vector<std::optional<Column<T>>> *_trimmed) {
+    _trimmed->resize(_columns.size());
+    for (size_t i = 0; i < _columns.size(); ++i) {
+      tasks.push_back([&selection, &_columns, _trimmed, i]() {
+        _trimmed->at(i).emplace(_columns.at(i).where(selection));
+      });
+    }
+  };
+
+  auto categoricals = std::vector<std::optional<Column<Int>>>();
+  auto join_keys = std::vector<std::optional<Column<Int>>>();
+  auto numericals = std::vector<std::optional<Column<Float>>>();
+  auto targets = std::vector<std::optional<Column<Float>>>();
+  auto text = std::vector<std::optional<Column<strings::String>>>();
+  auto time_stamps = std::vector<std::optional<Column<Float>>>();
+  auto unused_floats = std::vector<std::optional<Column<Float>>>();
+  auto unused_strings = std::vector<std::optional<Column<strings::String>>>();
+
+  add_tasks(categoricals_, &categoricals);
+  add_tasks(join_keys_, &join_keys);
+  add_tasks(numericals_, &numericals);
+  add_tasks(targets_, &targets);
+  add_tasks(text_, &text);
+  add_tasks(time_stamps_, &time_stamps);
+  add_tasks(unused_floats_, &unused_floats);
+  add_tasks(unused_strings_, &unused_strings);
+
+  // Columns in memory are compacted concurrently. Memory-mapped columns
+  // share a single pool, which must not be allocated from by several
+  // threads at once.
+  const auto num_threads =
+      pool_ ? static_cast<size_t>(1) : multithreading::default_num_threads();
+
+  multithreading::parallel_for(
+      tasks.size(), num_threads,
+      [&tasks](const size_t _begin, const size_t _end, const size_t) {
+        for (size_t i = _begin; i < _end; ++i) {
+          tasks[i]();
+        }
+      });
+
+  auto df = DataFrame(name(), categories_, join_keys_encoding_, make_pool());
+
+  for (const auto &col : categoricals) {
+    df.add_int_column(*col, ROLE_CATEGORICAL);
   }
 
-  for (size_t i = 0; i < num_numericals(); ++i) {
-    df.add_float_column(numerical(i).where(_condition), ROLE_NUMERICAL);
+  for (const auto &col : join_keys) {
+    df.add_int_column(*col, ROLE_JOIN_KEY);
   }
 
-  for (size_t i = 0; i < num_targets(); ++i) {
-    df.add_float_column(target(i).where(_condition), ROLE_TARGET);
+  for (const auto &col : numericals) {
+    df.add_float_column(*col, ROLE_NUMERICAL);
   }
 
-  for (size_t i = 0; i < num_text(); ++i) {
-    df.add_string_column(text(i).where(_condition), ROLE_TEXT);
+  for (const auto &col : targets) {
+    df.add_float_column(*col, ROLE_TARGET);
   }
 
-  for (size_t i = 0; i < num_time_stamps(); ++i) {
-    df.add_float_column(time_stamp(i).where(_condition), ROLE_TIME_STAMP);
+  for (const auto &col : text) {
+    df.add_string_column(*col, ROLE_TEXT);
   }
 
-  for (size_t i = 0; i < num_unused_floats(); ++i) {
-    df.add_float_column(unused_float(i).where(_condition), ROLE_UNUSED_FLOAT);
+  for (const auto &col : time_stamps) {
+    df.add_float_column(*col, ROLE_TIME_STAMP);
   }
 
-  for (size_t i = 0; i < num_unused_strings(); ++i) {
-    df.add_string_column(unused_string(i).where(_condition),
-                         ROLE_UNUSED_STRING);
+  for (const auto &col : unused_floats) {
+    df.add_float_column(*col, ROLE_UNUSED_FLOAT);
   }
 
-  df.create_indices();
+  for (const auto &col : unused_strings) {
+    df.add_string_column(*col, ROLE_UNUSED_STRING);
+  }
 
   *this = std::move(df);
 }
@@ -196,6 +196,87 @@ std::vector<std::string> DataFrameReader::next_line() {
 
 // ----------------------------------------------------------------------------
 
+io::ColumnarData DataFrameReader::to_columnar() const {
+  using FloatColumn = typename io::ColumnarData::FloatColumn;
+
+  std::vector<typename io::ColumnarData::ColumnType> columns;
+
+  const auto nrows = df_.nrows();
+
+  const auto from_float_column = [nrows](const Column<Float>& _col) {
+    return FloatColumn(_col.data(), nrows);
+  };
+
+  const auto from_encoded_column =
+      [](const Column<Int>& _col,
+         const std::shared_ptr<const containers::Encoding>& _encoding) {
+        assert_true(_encoding);
+        return [_col, _encoding](const size_t _i) -> std::string {
+          return (*_encoding)[_col[_i]].str();
+        };
+      };
+
+  const auto from_string_column = [](const Column<strings::String>& _col) {
+    return [_col](const size_t _i) -> std::string { return _col[_i].str(); };
+  };
+
+  for (size_t i = 0; i < df_.num_categoricals(); ++i) {
+    columns.push_back(from_encoded_column(df_.categorical(i), categories_));
+  }
+
+  for (size_t i = 0; i < df_.num_join_keys(); ++i) {
+    columns.push_back(
+        from_encoded_column(df_.join_key(i), join_keys_encoding_));
+  }
+
+  for (size_t i = 0; i < df_.num_numericals(); ++i) {
+    const auto& col = df_.numerical(i);
+    if (coltypes()[columns.size()] == io::Datatype::string) {
+      columns.push_back([col](const size_t _i) -> std::string {
+        return io::Parser::ts_to_string(col[_i]);
+      });
+    } else {
+      columns.push_back(from_float_column(col));
+    }
+  }
+
+  for (size_t i = 0; i < df_.num_targets(); ++i) {
+    columns.push_back(from_float_column(df_.target(i)));
+  }
+
+  for (size_t i = 0; i < df_.num_text(); ++i) {
+    columns.push_back(from_string_column(df_.text(i)));
+  }
+
+  for (size_t i = 0; i < df_.num_time_stamps(); ++i) {
+    columns.push_back(from_float_column(df_.time_stamp(i)));
+  }
+
+  for (size_t i = 0; i < df_.num_unused_floats(); ++i) {
+    const auto& col = df_.unused_float(i);
+    if (coltypes()[columns.size()] == io::Datatype::string) {
+      columns.push_back([col](const size_t _i) -> std::string {
+        return io::Parser::ts_to_string(col[_i]);
+      });
+    } else {
+      columns.push_back(from_float_column(col));
+    }
+  }
+
+  for (size_t i = 0; i < df_.num_unused_strings(); ++i) {
+    columns.push_back(from_string_column(df_.unused_string(i)));
+  }
+
+  assert_true(columns.size() == coltypes().size());
+
+  return io::ColumnarData{.colnames_ = colnames(),
+                          .coltypes_ = coltypes(),
+                          .columns_ = std::move(columns),
+                          .nrows_ = nrows};
+}
+
+// ----------------------------------------------------------------------------
+
 void DataFrameReader::update_counts(const std::string& _colname,
                                     std::map<std::string, Int>* _counts) {
   const auto it = _counts->find(_colname);
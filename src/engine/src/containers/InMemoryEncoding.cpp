@@ -83,6 +83,25 @@ InMemoryEncoding& InMemoryEncoding::operator=(
 
 // ----------------------------------------------------------------------------
 
+InMemoryEncoding& InMemoryEncoding::operator=(
+    const std::vector<std::string_view>& _vector) {
+  assert_true(!subencoding_);
+
+  clear();
+
+  map_.reserve(_vector.size());
+
+  vector_->reserve(_vector.size());
+
+  for (const auto& val : _vector) {
+    string_to_int(strings::String(val.data(), val.size()));
+  }
+
+  return *this;
+}
+
+// ----------------------------------------------------------------------------
+
 Int InMemoryEncoding::string_to_int(const strings::String& _val) {
   // -----------------------------------
   // If this is a NULL value, return -1.
@@ -25,8 +25,7 @@ MemoryMappedEncoding::MemoryMappedEncoding(
 MemoryMappedEncoding::~MemoryMappedEncoding() { deallocate(); };
 
 void MemoryMappedEncoding::allocate() {
-  btree_ = std::make_shared<BTreeType>(pool_);
-  rownums_ = std::make_shared<RownumsType>(pool_);
+  hash_table_ = std::make_shared<HashTableType>(pool_);
   string_vector_ = std::make_shared<memmap::StringVector>(pool_);
 }
 
@@ -48,44 +47,26 @@ void MemoryMappedEncoding::append(const MemoryMappedEncoding& _other,
 // ----------------------------------------------------------------------------
 
 void MemoryMappedEncoding::deallocate() {
-  if (rownums_) {
-    for (size_t i = 0; i < rownums().size(); ++i) {
-      rownums()[i].second.deallocate();
-    }
-  }
-
-  btree_.reset();
-  rownums_.reset();
+  hash_table_.reset();
   string_vector_.reset();
 }
 
 // ----------------------------------------------------------------------------
 
-Int MemoryMappedEncoding::insert(const strings::String& _str,
-                                 const std::optional<size_t>& _opt) {
+std::optional<size_t> MemoryMappedEncoding::find(
+    const strings::String& _val) const {
+  const auto is_match = [this, &_val](const Int _ix) {
+    return string_vector()[_ix - subsize_] == _val;
+  };
+  return hash_table().find(_val.hash(), is_match);
+}
+
+// ----------------------------------------------------------------------------
+
+Int MemoryMappedEncoding::insert(const strings::String& _str) {
   const auto ix = static_cast<Int>(string_vector().size() + subsize_);
 
-  const auto hash = _str.hash();
-
-  if (!_opt) [[likely]] {
-    auto p = std::make_pair(ix, memmap::VectorImpl<Int>());
-    rownums().push_back(p);
-    btree().insert(hash, rownums().size() - 1);
-    assert_true(btree()[hash]);
-    assert_true(*btree()[hash] == rownums().size() - 1);
-  } else if (rownums()[*_opt].first != HASH_COLLISION) {
-    // First hash collision
-    assert_true(string_vector()[rownums()[*_opt].first - subsize_] != _str);
-    auto p =
-        std::make_pair(HASH_COLLISION, memmap::Vector<Int>(pool_).yield_impl());
-    p.second.push_back(rownums()[*_opt].first);
-    p.second.push_back(ix);
-    rownums()[*_opt] = p;
-  } else {
-    // All subsequent hash collisions
-    assert_true(rownums()[*_opt].second.is_allocated());
-    rownums()[*_opt].second.push_back(ix);
-  }
+  hash_table().insert(_str.hash(), ix);
 
   string_vector().push_back(_str);
 
@@ -116,14 +97,77 @@ strings::String MemoryMappedEncoding::int_to_string(const Int _i) const {
 
 // ----------------------------------------------------------------------------
 
+bool MemoryMappedEncoding::is_indexed(const size_t _ix) const {
+  const auto slot = find(string_vector()[_ix]);
+  return slot && hash_table().value(*slot) == static_cast<Int>(_ix);
+}
+
+// ----------------------------------------------------------------------------
+
+void MemoryMappedEncoding::load(const std::vector<std::string_view>& _vector,
+                                const std::string& _hash_table_fname) {
+  assert_true(!subencoding_);
+
+  clear();
+
+  auto hash_table = HashTableType::load(pool_, _hash_table_fname);
+
+  if (!hash_table || hash_table->size() != _vector.size()) {
+    *this = _vector;
+    return;
+  }
+
+  hash_table_ = std::make_shared<HashTableType>(std::move(*hash_table));
+
+  for (const auto& str : _vector) {
+    string_vector().push_back(strings::String(str.data(), str.size()));
+  }
+
+  // The hashes are only meaningful if they have been produced by the same
+  // hash function for the same strings, which we spot-check here. The
+  // FileHandler removes the file whenever the strings are rewritten.
+  if (!_vector.empty() &&
+      (!is_indexed(0) || !is_indexed(_vector.size() / 2) ||
+       !is_indexed(_vector.size() - 1))) {
+    *this = _vector;
+  }
+}
+
+// ----------------------------------------------------------------------------
+
 MemoryMappedEncoding& MemoryMappedEncoding::operator=(
     const std::vector<std::string>& _vector) {
   assert_true(!subencoding_);
 
   clear();
 
-  for (const auto& val : _vector) {
-    (*this)[val];
+  hash_table().reserve(_vector.size());
+
+  for (size_t i = 0; i < _vector.size(); ++i) {
+    if (i + PREFETCH_DISTANCE < _vector.size()) {
+      prefetch(_vector[i + PREFETCH_DISTANCE]);
+    }
+    (*this)[_vector[i]];
+  }
+
+  return *this;
+}
+
+// ----------------------------------------------------------------------------
+
+MemoryMappedEncoding& MemoryMappedEncoding::operator=(
+    const std::vector<std::string_view>& _vector) {
+  assert_true(!subencoding_);
+
+  clear();
+
+  hash_table().reserve(_vector.size());
+
+  for (size_t i = 0; i < _vector.size(); ++i) {
+    if (i + PREFETCH_DISTANCE < _vector.size()) {
+      prefetch(_vector[i + PREFETCH_DISTANCE]);
+    }
+    string_to_int(strings::String(_vector[i].data(), _vector[i].size()));
   }
 
   return *this;
@@ -150,37 +194,13 @@ Int MemoryMappedEncoding::string_to_int(const strings::String& _val) {
 
   // -----------------------------------
 
-  const auto opt = btree()[_val.hash()];
-
-  if (!opt) {
-    return insert(_val, opt);
-  }
-
-  // -----------------------------------
-
-  const auto& p = rownums()[*opt];
-
-  // -----------------------------------
-
-  if (p.first != HASH_COLLISION &&
-      string_vector()[p.first - subsize_] == _val) {
-    return p.first;
-  }
-
-  // -----------------------------------
+  const auto slot = find(_val);
 
-  if (p.first == HASH_COLLISION) {
-    assert_true(p.second.is_allocated());
-    for (auto i : p.second) {
-      if (string_vector()[i - subsize_] == _val) {
-        return i;
-      }
-    }
+  if (!slot) {
+    return insert(_val);
   }
 
-  // -----------------------------------
-
-  return insert(_val, opt);
+  return hash_table().value(*slot);
 }
 
 // ----------------------------------------------------------------------------
@@ -204,35 +224,13 @@ Int MemoryMappedEncoding::string_to_int(const strings::String& _val) const {
 
   // -----------------------------------
 
-  const auto opt = btree()[_val.hash()];
+  const auto slot = find(_val);
 
-  if (!opt) {
+  if (!slot) {
     return NOT_FOUND;
   }
 
-  // -----------------------------------
-
-  const auto& p = rownums()[*opt];
-
-  // -----------------------------------
-
-  if (p.first != HASH_COLLISION) {
-    return string_vector()[p.first - subsize_] == _val ? p.first : NOT_FOUND;
-  }
-
-  // -----------------------------------
-
-  assert_true(p.second.is_allocated());
-
-  for (auto i : p.second) {
-    if (string_vector()[i - subsize_] == _val) {
-      return i;
-    }
-  }
-
-  // -----------------------------------
-
-  return NOT_FOUND;
+  return hash_table().value(*slot);
 }
 
 // ----------------------------------------------------------------------------
@@ -9,6 +9,7 @@
 
 #include "database/CSVBuffer.hpp"
 #include "database/ContentGetter.hpp"
+#include "database/MySQLInfile.hpp"
 
 #include <rfl/json/write.hpp>
 
@@ -35,21 +36,54 @@ MySQL::MySQL(const std::string& _dbname, const std::string& _host,
       unix_socket_(_unix_socket),
       user_(_user) {}
 
-void MySQL::check_colnames(const std::vector<std::string>& _colnames,
-                           io::Reader* _reader) {
-  const auto csv_colnames = _reader->colnames();
+void MySQL::bulk_insert(const std::string& _table,
+                        const io::ColumnarData& _data,
+                        const std::shared_ptr<MYSQL>& _conn) const {
+  const auto query = make_bulk_insert_query(_table, _data.colnames_);
 
-  if (csv_colnames.size() != _colnames.size()) {
+  exec("START TRANSACTION;", _conn);
+
+  try {
+    size_t row = 0;
+
+    while (row < _data.nrows_) {
+      auto current_query = query;
+
+      while (row < _data.nrows_ && current_query.size() < BULK_INSERT_SIZE) {
+        if (current_query.size() > query.size()) {
+          current_query += ',';
+        }
+        MySQLInfile::append_values_row(_data, row++, &current_query);
+      }
+
+      current_query += ';';
+
+      exec(current_query, _conn);
+    }
+
+    exec("COMMIT;", _conn);
+  } catch (std::exception& e) {
+    exec("ROLLBACK;", _conn);
+    throw std::runtime_error(e.what());
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void MySQL::check_colnames(
+    const std::vector<std::string>& _colnames,
+    const std::vector<std::string>& _csv_colnames) const {
+  if (_csv_colnames.size() != _colnames.size()) {
     throw std::runtime_error("Wrong number of columns. Expected " +
                              std::to_string(_colnames.size()) + ", saw " +
-                             std::to_string(csv_colnames.size()) + ".");
+                             std::to_string(_csv_colnames.size()) + ".");
   }
 
   for (size_t i = 0; i < _colnames.size(); ++i) {
-    if (csv_colnames.at(i) != _colnames.at(i)) {
+    if (_csv_colnames.at(i) != _colnames.at(i)) {
       throw std::runtime_error("Column " + std::to_string(i + 1) +
                                " has wrong name. Expected '" + _colnames.at(i) +
-                               "', saw '" + csv_colnames.at(i) + "'.");
+                               "', saw '" + _csv_colnames.at(i) + "'.");
     }
   }
 }
@@ -288,7 +322,7 @@ void MySQL::read(const std::string& _table, const size_t _skip,
 
   assert_true(colnames.size() == coltypes.size());
 
-  check_colnames(colnames, _reader);
+  check_colnames(colnames, _reader->colnames());
 
   // Skip lines, if necessary.
   size_t line_count = 0;
@@ -349,5 +383,43 @@ void MySQL::read(const std::string& _table, const size_t _skip,
   // ----------------------------------------------------------------
 }
 
+// ----------------------------------------------------------------------------
+
+void MySQL::write(const std::string& _table, const io::ColumnarData& _data) {
+  check_colnames(get_colnames_from_table(_table), _data.colnames_);
+
+  assert_true(_data.columns_.size() == _data.coltypes_.size());
+
+  if (_data.columns_.size() == 0 || _data.nrows_ == 0) {
+    return;
+  }
+
+  const auto conn = make_connection(true);
+
+  auto infile = MySQLInfile(_data);
+
+  mysql_set_local_infile_handler(
+      conn.get(), MySQLInfile::infile_init, MySQLInfile::infile_read,
+      MySQLInfile::infile_end, MySQLInfile::infile_error, &infile);
+
+  // LOAD DATA is a single statement, so it either succeeds or fails as a
+  // whole. If local_infile has been disabled, we fall back to bulk inserts.
+  // Any other error is a genuine error and must be passed on.
+  try {
+    exec(MySQLInfile::make_load_data_query(_table, _data), conn);
+  } catch (std::exception& e) {
+    const auto err = mysql_errno(conn.get());
+
+    mysql_set_local_infile_default(conn.get());
+
+    if (err != ERR_LOCAL_INFILE_NOT_ALLOWED &&
+        err != ERR_LOCAL_INFILE_REJECTED && err != ERR_LOCAL_FILES_DISABLED) {
+      throw;
+    }
+
+    bulk_insert(_table, _data, conn);
+  }
+}
+
 // ----------------------------------------------------------------------------
 }  // namespace database
@@ -0,0 +1,230 @@
+// Copyright 2024 Code17 GmbH
+//
+// This file is licensed under the Elastic License 2.0 (ELv2).
+// Refer to the LICENSE.txt file in the root of the repository
+// for details.
+//
+
+#include "database/MySQLInfile.hpp"
+
+#include "io/Parser.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <type_traits>
+#include <variant>
+
+namespace database {
+
+MySQLInfile::MySQLInfile(const io::ColumnarData& _data)
+    : data_(_data), pos_(0), row_(0) {}
+
+// ----------------------------------------------------------------------------
+
+void MySQLInfile::append_infile_row(const io::ColumnarData& _data,
+                                    const size_t _row, std::string* _buffer) {
+  for (size_t j = 0; j < _data.columns_.size(); ++j) {
+    if (j != 0) {
+      *_buffer += '\t';
+    }
+    append_value(_data, j, _row, "\\N", false, _buffer);
+  }
+  *_buffer += '\n';
+}
+
+// ----------------------------------------------------------------------------
+
+void MySQLInfile::append_value(const io::ColumnarData& _data,
+                               const size_t _col, const size_t _row,
+                               const char* _null, const bool _quote_strings,
+                               std::string* _buffer) {
+  const auto append_string = [_buffer,
+                              _quote_strings](const std::string& _str) {
+    if (_quote_strings) {
+      *_buffer += '\'';
+    }
+    escape(_str, _buffer);
+    if (_quote_strings) {
+      *_buffer += '\'';
+    }
+  };
+
+  const auto append_number = [_buffer](const auto _val) {
+    char buf[32];
+    const auto [ptr, ec] = std::to_chars(buf, buf + sizeof(buf), _val);
+    _buffer->append(buf, ptr);
+  };
+
+  const auto append = [&](const auto& _c) {
+    using ColType = std::decay_t<decltype(_c)>;
+
+    if constexpr (std::is_same_v<ColType,
+                                 typename io::ColumnarData::StringColumn>) {
+      append_string(_c(_row));
+    } else {
+      const auto val = _c[_row];
+
+      if (!std::isfinite(val)) {
+        *_buffer += _null;
+        return;
+      }
+
+      switch (_data.coltypes_[_col]) {
+        case io::Datatype::integer:
+          append_number(static_cast<std::int64_t>(val));
+          break;
+
+        case io::Datatype::time_stamp:
+          append_string(io::Parser::ts_to_string(val));
+          break;
+
+        default:
+          append_number(val);
+          break;
+      }
+    }
+  };
+
+  std::visit(append, _data.columns_[_col]);
+}
+
+// ----------------------------------------------------------------------------
+
+void MySQLInfile::append_values_row(const io::ColumnarData& _data,
+                                    const size_t _row, std::string* _buffer) {
+  *_buffer += '(';
+  for (size_t j = 0; j < _data.columns_.size(); ++j) {
+    if (j != 0) {
+      *_buffer += ',';
+    }
+    append_value(_data, j, _row, "NULL", true, _buffer);
+  }
+  *_buffer += ')';
+}
+
+// ----------------------------------------------------------------------------
+
+void MySQLInfile::escape(const std::string& _str, std::string* _buffer) {
+  for (const char c : _str) {
+    switch (c) {
+      case '\0':
+        *_buffer += "\\0";
+        break;
+
+      case '\n':
+        *_buffer += "\\n";
+        break;
+
+      case '\r':
+        *_buffer += "\\r";
+        break;
+
+      case '\t':
+        *_buffer += "\\t";
+        break;
+
+      case '\x1a':
+        *_buffer += "\\Z";
+        break;
+
+      case '\\':
+      case '\'':
+      case '"':
+        *_buffer += '\\';
+        *_buffer += c;
+        break;
+
+      default:
+        *_buffer += c;
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+int MySQLInfile::infile_error(void* _ptr, char* _msg, unsigned int _len) {
+  const auto infile = static_cast<MySQLInfile*>(_ptr);
+
+  const auto& msg = infile->error_;
+
+  if (_len > 0) {
+    const auto n = std::min(static_cast<size_t>(_len - 1), msg.size());
+    std::memcpy(_msg, msg.data(), n);
+    _msg[n] = '\0';
+  }
+
+  // Corresponds to CR_UNKNOWN_ERROR.
+  return 2000;
+}
+
+// ----------------------------------------------------------------------------
+
+int MySQLInfile::infile_init(void** _ptr, const char*, void* _userdata) {
+  *_ptr = _userdata;
+  return 0;
+}
+
+// ----------------------------------------------------------------------------
+
+int MySQLInfile::infile_read(void* _ptr, char* _buf, unsigned int _len) {
+  const auto infile = static_cast<MySQLInfile*>(_ptr);
+
+  // This is called from C code, so we must not let any exceptions escape.
+  try {
+    return infile->read(_buf, _len);
+  } catch (std::exception& e) {
+    infile->error_ = e.what();
+    return -1;
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+std::string MySQLInfile::make_load_data_query(const std::string& _table,
+                                              const io::ColumnarData& _data) {
+  std::string query = std::string("LOAD DATA LOCAL INFILE '") + FILE_NAME +
+                      "' INTO TABLE `" + _table +
+                      "` FIELDS TERMINATED BY '\\t' ESCAPED BY '\\\\' "
+                      "LINES TERMINATED BY '\\n' (";
+
+  for (size_t i = 0; i < _data.colnames_.size(); ++i) {
+    query += "`";
+    query += _data.colnames_[i];
+    query += "`";
+
+    if (i + 1 < _data.colnames_.size()) {
+      query += ",";
+    }
+  }
+
+  query += ");";
+
+  return query;
+}
+
+// ----------------------------------------------------------------------------
+
+int MySQLInfile::read(char* _buf, unsigned int _len) {
+  buffer_.erase(0, pos_);
+
+  pos_ = 0;
+
+  while (buffer_.size() < _len && row_ < data_.nrows_) {
+    append_infile_row(data_, row_++, &buffer_);
+  }
+
+  const auto n = std::min(static_cast<size_t>(_len), buffer_.size());
+
+  std::memcpy(_buf, buffer_.data(), n);
+
+  pos_ = n;
+
+  return static_cast<int>(n);
+}
+
+// ----------------------------------------------------------------------------
+}  // namespace database
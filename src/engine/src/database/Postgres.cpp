@@ -12,6 +12,11 @@
 
 #include <rfl/json/write.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <variant>
+
 namespace database {
 
 Postgres::Postgres(const typename Command::PostgresOp& _obj,
@@ -22,27 +27,108 @@ Postgres::Postgres(const typename Command::PostgresOp& _obj,
 Postgres::Postgres(const std::vector<std::string>& _time_formats)
     : time_formats_(_time_formats) {}
 
-void Postgres::check_colnames(const std::vector<std::string>& _colnames,
-                              io::Reader* _reader) {
-  const auto csv_colnames = _reader->colnames();
+void Postgres::append_field(const io::ColumnarData& _data, const size_t _col,
+                            const size_t _row, std::string* _buffer) {
+  const auto append_null = [_buffer]() {
+    append_big_endian(static_cast<std::int32_t>(-1), _buffer);
+  };
+
+  const auto append = [&](const auto& _c) {
+    using ColType = std::decay_t<decltype(_c)>;
+
+    if constexpr (std::is_same_v<ColType,
+                                 typename io::ColumnarData::StringColumn>) {
+      const auto str = _c(_row);
+      append_big_endian(static_cast<std::int32_t>(str.size()), _buffer);
+      _buffer->append(str);
+    } else {
+      const auto val = _c[_row];
+
+      if (!std::isfinite(val)) {
+        append_null();
+        return;
+      }
+
+      switch (_data.coltypes_[_col]) {
+        case io::Datatype::integer:
+          append_big_endian(static_cast<std::int32_t>(4), _buffer);
+          append_big_endian(static_cast<std::int32_t>(val), _buffer);
+          break;
+
+        case io::Datatype::time_stamp:
+          append_big_endian(static_cast<std::int32_t>(8), _buffer);
+          append_big_endian(static_cast<std::int64_t>(
+                                std::llround((val - POSTGRES_EPOCH) * 1e6)),
+                            _buffer);
+          break;
+
+        default:
+          append_big_endian(static_cast<std::int32_t>(8), _buffer);
+          append_big_endian(std::bit_cast<std::uint64_t>(val), _buffer);
+          break;
+      }
+    }
+  };
 
-  if (csv_colnames.size() != _colnames.size()) {
+  std::visit(append, _data.columns_[_col]);
+}
+
+// ----------------------------------------------------------------------------
+
+void Postgres::check_colnames(
+    const std::vector<std::string>& _colnames,
+    const std::vector<std::string>& _csv_colnames) const {
+  if (_csv_colnames.size() != _colnames.size()) {
     throw std::runtime_error("Wrong number of columns. Expected " +
                              std::to_string(_colnames.size()) + ", saw " +
-                             std::to_string(csv_colnames.size()) + ".");
+                             std::to_string(_csv_colnames.size()) + ".");
   }
 
   for (size_t i = 0; i < _colnames.size(); ++i) {
-    if (csv_colnames.at(i) != _colnames.at(i)) {
+    if (_csv_colnames.at(i) != _colnames.at(i)) {
       throw std::runtime_error("Column " + std::to_string(i + 1) +
                                " has wrong name. Expected '" + _colnames.at(i) +
-                               "', saw '" + csv_colnames.at(i) + "'.");
+                               "', saw '" + _csv_colnames.at(i) + "'.");
     }
   }
 }
 
 // ----------------------------------------------------------------------------
 
+std::int64_t Postgres::count_pages(const std::string& _tname) const {
+  const auto tname = io::StatementMaker::handle_schema(_tname, "\"", "\"");
+
+  const auto sql =
+      "SELECT relkind, pg_relation_size(oid) / "
+      "current_setting('block_size')::bigint FROM pg_class WHERE "
+      "oid = to_regclass('\"" +
+      tname + "\"');";
+
+  const auto conn = make_connection();
+
+  // TID range scans were introduced in Postgres 14. Before that, every
+  // partition would require a full table scan.
+  if (PQserverVersion(conn.get()) < 140000) {
+    return 0;
+  }
+
+  const auto result = exec(sql, conn.get());
+
+  if (PQntuples(result.get()) == 0) {
+    return 0;
+  }
+
+  const std::string relkind = PQgetvalue(result.get(), 0, 0);
+
+  if (relkind != "r" && relkind != "m") {
+    return 0;
+  }
+
+  return std::stoll(PQgetvalue(result.get(), 0, 1));
+}
+
+// ----------------------------------------------------------------------------
+
 std::string Postgres::describe() const {
   const auto description =
       rfl::make_field<"connection_string">(connection_string_) *
@@ -217,7 +303,7 @@ void Postgres::read(const std::string& _table, const size_t _skip,
 
   assert_true(colnames.size() == coltypes.size());
 
-  check_colnames(colnames, _reader);
+  check_colnames(colnames, _reader->colnames());
 
   size_t line_count = 0;
 
@@ -283,5 +369,130 @@ void Postgres::read(const std::string& _table, const size_t _skip,
   PQgetResult(conn.get());
 }
 
+// ----------------------------------------------------------------------------
+
+std::vector<rfl::Ref<Iterator>> Postgres::select_partitioned(
+    const std::vector<std::string>& _colnames, const std::string& _tname,
+    const std::string& _where, const size_t _num_partitions) {
+  const auto num_pages = count_pages(_tname);
+
+  const auto num_partitions = std::min(
+      static_cast<std::int64_t>(_num_partitions),
+      num_pages / MIN_PAGES_PER_PARTITION);
+
+  if (num_partitions <= 1) {
+    return {select(_colnames, _tname, _where)};
+  }
+
+  const auto pages_per_partition =
+      (num_pages + num_partitions - 1) / num_partitions;
+
+  const auto make_tid = [](const std::int64_t _page) {
+    return "'(" + std::to_string(_page) + ",0)'::tid";
+  };
+
+  // The snapshot must remain exported until all iterators have imported
+  // it, which happens in their constructors.
+  const auto conn = make_connection();
+
+  exec("BEGIN ISOLATION LEVEL REPEATABLE READ", conn.get());
+
+  const auto result = exec("SELECT pg_export_snapshot();", conn.get());
+
+  const std::string snapshot = PQgetvalue(result.get(), 0, 0);
+
+  std::vector<rfl::Ref<Iterator>> iterators;
+
+  for (std::int64_t i = 0; i < num_partitions; ++i) {
+    // The last partition is open-ended, in case the table has grown since
+    // we counted the pages.
+    auto range = "ctid >= " + make_tid(i * pages_per_partition);
+
+    if (i + 1 < num_partitions) {
+      range += " AND ctid < " + make_tid((i + 1) * pages_per_partition);
+    }
+
+    const auto where = (_where == "") ? range : "(" + _where + ") AND " + range;
+
+    iterators.push_back(rfl::Ref<PostgresIterator>::make(
+        make_connection(), _colnames, time_formats_, _tname, where, -1, -1,
+        snapshot));
+  }
+
+  exec("COMMIT", conn.get());
+
+  return iterators;
+}
+
+// ----------------------------------------------------------------------------
+
+void Postgres::write(const std::string& _table,
+                     const io::ColumnarData& _data) {
+  check_colnames(get_colnames_from_table(_table), _data.colnames_);
+
+  assert_true(_data.columns_.size() == _data.coltypes_.size());
+
+  const auto table = io::StatementMaker::handle_schema(_table, "\"", "\"");
+
+  const auto copy_statement =
+      std::string("COPY \"") + table + "\" FROM STDIN (FORMAT binary);";
+
+  const auto conn = make_connection();
+
+  const auto res = std::shared_ptr<PGresult>(
+      PQexec(conn.get(), copy_statement.c_str()), PQclear);
+
+  if (PQresultStatus(res.get()) != PGRES_COPY_IN) {
+    throw std::runtime_error(PQerrorMessage(conn.get()));
+  }
+
+  const auto num_cols = _data.columns_.size();
+
+  // The signature, followed by the flags field and the header extension
+  // length, see https://www.postgresql.org/docs/current/sql-copy.html.
+  std::string buffer("PGCOPY\n\377\r\n\0", 11);
+  append_big_endian(static_cast<std::int32_t>(0), &buffer);
+  append_big_endian(static_cast<std::int32_t>(0), &buffer);
+
+  try {
+    for (size_t i = 0; i < _data.nrows_; ++i) {
+      append_big_endian(static_cast<std::int16_t>(num_cols), &buffer);
+
+      for (size_t j = 0; j < num_cols; ++j) {
+        append_field(_data, j, i, &buffer);
+      }
+
+      if (buffer.size() >= COPY_BUFFER_SIZE) {
+        put_copy_data(conn.get(), &buffer);
+      }
+    }
+
+    append_big_endian(static_cast<std::int16_t>(-1), &buffer);
+
+    put_copy_data(conn.get(), &buffer);
+  } catch (std::exception& e) {
+    PQputCopyEnd(conn.get(), e.what());
+
+    throw std::runtime_error(e.what());
+  }
+
+  if (PQputCopyEnd(conn.get(), NULL) != 1) {
+    throw std::runtime_error(PQerrorMessage(conn.get()));
+  }
+
+  std::string error_msg;
+
+  while (const auto raw_ptr = PQgetResult(conn.get())) {
+    const auto result = std::shared_ptr<PGresult>(raw_ptr, PQclear);
+    if (PQresultStatus(result.get()) != PGRES_COMMAND_OK) {
+      error_msg = PQresultErrorMessage(result.get());
+    }
+  }
+
+  if (error_msg != "") {
+    throw std::runtime_error("Writing to postgres failed: " + error_msg);
+  }
+}
+
 // ----------------------------------------------------------------------------
 }  // namespace database
@@ -10,6 +10,11 @@
 #include "database/Getter.hpp"
 #include "io/StatementMaker.hpp"
 
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
 namespace database {
 // Refer to the following sources in the documentation:
 // https://www.postgresql.org/docs/8.4/libpq-example.html
@@ -18,14 +23,19 @@ namespace database {
 PostgresIterator::PostgresIterator(
     const std::shared_ptr<PGconn>& _connection, const std::string& _sql,
     const std::vector<std::string>& _time_formats, const std::int32_t _begin,
-    const std::int32_t _end)
+    const std::int32_t _end, const std::optional<std::string>& _snapshot)
     : close_required_(false),
       colnum_(0),
       connection_(_connection),
       end_required_(false),
       rownum_(0),
       time_formats_(_time_formats) {
-  execute("BEGIN");
+  if (_snapshot) {
+    execute("BEGIN ISOLATION LEVEL REPEATABLE READ");
+    execute("SET TRANSACTION SNAPSHOT '" + *_snapshot + "'");
+  } else {
+    execute("BEGIN");
+  }
 
   end_required_ = true;
 
@@ -59,9 +69,9 @@ PostgresIterator::PostgresIterator(
     const std::vector<std::string>& _colnames,
     const std::vector<std::string>& _time_formats, const std::string& _tname,
     const std::string& _where, const std::int32_t _begin,
-    const std::int32_t _end)
+    const std::int32_t _end, const std::optional<std::string>& _snapshot)
     : PostgresIterator(_connection, make_sql(_colnames, _tname, _where),
-                       _time_formats, _begin, _end) {}
+                       _time_formats, _begin, _end, _snapshot) {}
 
 // ----------------------------------------------------------------------------
 
@@ -77,6 +87,73 @@ PostgresIterator::~PostgresIterator() {
 
 // ----------------------------------------------------------------------------
 
+void PostgresIterator::append_values(const int _col, const int _begin,
+                                     const int _end, const io::Datatype _type,
+                                     BatchColumn* _out) const {
+  if (_type == io::Datatype::unknown) {
+    return;
+  }
+
+  const auto oid = PQftype(result(), _col);
+
+  // The binary format of the string types is identical to the text format.
+  const bool is_binary =
+      (PQfformat(result(), _col) == 1) && !is_text_oid(oid);
+
+  for (int i = _begin; i < _end; ++i) {
+    if (PQgetisnull(result(), i, _col)) {
+      _out->push_null();
+      continue;
+    }
+
+    const char* val = PQgetvalue(result(), i, _col);
+
+    const auto len = static_cast<size_t>(PQgetlength(result(), i, _col));
+
+    if (_type == io::Datatype::string) {
+      _out->push_string(val, len);
+      continue;
+    }
+
+    if (is_binary && _type == io::Datatype::integer) {
+      if (oid == INT8_OID) {
+        _out->push_int(read_big_endian<std::int64_t>(val), false);
+        continue;
+      }
+      const auto x = decode_binary(oid, val, len);
+      _out->push_int(std::isfinite(x) ? static_cast<std::int64_t>(x) : 0,
+                     false);
+      continue;
+    }
+
+    if (is_binary) {
+      _out->push_float(decode_binary(oid, val, len));
+      continue;
+    }
+
+    const auto str = std::string(val, len);
+
+    switch (_type) {
+      case io::Datatype::double_precision:
+        _out->push_float(Getter::get_double(str));
+        break;
+
+      case io::Datatype::integer:
+        _out->push_int(Getter::get_int(str), false);
+        break;
+
+      case io::Datatype::time_stamp:
+        _out->push_float(Getter::get_time_stamp(str, time_formats_));
+        break;
+
+      default:
+        break;
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+
 std::vector<std::string> PostgresIterator::colnames() const {
   std::vector<std::string> colnames(num_cols_);
 
@@ -89,9 +166,74 @@ std::vector<std::string> PostgresIterator::colnames() const {
 
 // ----------------------------------------------------------------------------
 
-std::shared_ptr<PGresult> PostgresIterator::execute(
-    const std::string& _sql) const {
-  auto raw_ptr = PQexec(connection(), _sql.c_str());
+Float PostgresIterator::decode_binary(const Oid _oid, const char* _val,
+                                      const size_t _len) {
+  switch (_oid) {
+    case INT2_OID:
+      return static_cast<Float>(read_big_endian<std::int16_t>(_val));
+
+    case INT4_OID:
+      return static_cast<Float>(read_big_endian<std::int32_t>(_val));
+
+    case INT8_OID:
+      return static_cast<Float>(read_big_endian<std::int64_t>(_val));
+
+    case FLOAT4_OID:
+      return static_cast<Float>(
+          std::bit_cast<float>(read_big_endian<std::uint32_t>(_val)));
+
+    case FLOAT8_OID:
+      return static_cast<Float>(
+          std::bit_cast<double>(read_big_endian<std::uint64_t>(_val)));
+
+    case NUMERIC_OID: {
+      // ndigits, weight, sign and dscale, followed by ndigits base-10000
+      // digits.
+      const auto ndigits = read_big_endian<std::int16_t>(_val);
+      const auto weight = read_big_endian<std::int16_t>(_val + 2);
+      const auto sign = read_big_endian<std::uint16_t>(_val + 4);
+
+      switch (sign) {
+        case 0xC000:
+          return static_cast<Float>(NAN);
+
+        case 0xD000:
+          return std::numeric_limits<Float>::infinity();
+
+        case 0xF000:
+          return -std::numeric_limits<Float>::infinity();
+
+        default:
+          break;
+      }
+
+      assert_true(_len >= 8 + 2 * static_cast<size_t>(ndigits));
+
+      Float val = 0.0;
+
+      for (int i = 0; i < ndigits; ++i) {
+        const auto digit = read_big_endian<std::int16_t>(_val + 8 + 2 * i);
+        val = val * 10000.0 + static_cast<Float>(digit);
+      }
+
+      val *= std::pow(10000.0, weight - ndigits + 1);
+
+      return (sign == 0x4000) ? -val : val;
+    }
+
+    default:
+      throw std::runtime_error("Unsupported type in binary format: " +
+                               std::to_string(_oid) + ".");
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+std::shared_ptr<PGresult> PostgresIterator::execute(const std::string& _sql,
+                                                    const bool _binary) const {
+  auto raw_ptr = _binary ? PQexecParams(connection(), _sql.c_str(), 0, nullptr,
+                                        nullptr, nullptr, nullptr, 1)
+                         : PQexec(connection(), _sql.c_str());
 
   auto result = std::shared_ptr<PGresult>(raw_ptr, PQclear);
 
@@ -109,6 +251,46 @@ std::shared_ptr<PGresult> PostgresIterator::execute(
 
 // ----------------------------------------------------------------------------
 
+size_t PostgresIterator::fetch_batch(const std::vector<io::Datatype>& _coltypes,
+                                     const size_t _max_rows, Batch* _batch) {
+  if (colnum_ != 0) {
+    throw std::runtime_error(
+        "fetch_batch(...) cannot be called in the middle of a row.");
+  }
+
+  prepare_batch(_coltypes, _batch);
+
+  size_t nrows = 0;
+
+  while (nrows < _max_rows && !end()) {
+    const auto n = static_cast<int>(
+        std::min(_max_rows - nrows,
+                 static_cast<size_t>(PQntuples(result()) - rownum_)));
+
+    for (int j = 0; j < num_cols_; ++j) {
+      append_values(j, rownum_, rownum_ + n, _coltypes[j], &(*_batch)[j]);
+    }
+
+    nrows += static_cast<size_t>(n);
+
+    rownum_ += n;
+
+    if (rownum_ == PQntuples(result())) {
+      fetch_next(10000, supports_binary(_coltypes));
+      rownum_ = 0;
+
+      if (end()) {
+        close_cursor();
+        end_transaction();
+      }
+    }
+  }
+
+  return nrows;
+}
+
+// ----------------------------------------------------------------------------
+
 Float PostgresIterator::get_double() {
   const auto [str, is_null] = get_value();
 
@@ -191,4 +373,38 @@ std::string PostgresIterator::make_sql(
 
 // ----------------------------------------------------------------------------
 
+bool PostgresIterator::supports_binary(
+    const std::vector<io::Datatype>& _coltypes) const {
+  for (int j = 0; j < num_cols_; ++j) {
+    const auto oid = PQftype(result(), j);
+
+    // String types are parsed like in the text format.
+    if (_coltypes[j] == io::Datatype::unknown || is_text_oid(oid)) {
+      continue;
+    }
+
+    const bool is_number =
+        (oid == INT2_OID || oid == INT4_OID || oid == INT8_OID ||
+         oid == FLOAT4_OID || oid == FLOAT8_OID || oid == NUMERIC_OID);
+
+    switch (_coltypes[j]) {
+      case io::Datatype::double_precision:
+      case io::Datatype::integer:
+        if (!is_number) {
+          return false;
+        }
+        break;
+
+      // Time stamps are parsed from the text format, which honors the
+      // time formats and the time zone of the session.
+      default:
+        return false;
+    }
+  }
+
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
 }  // namespace database
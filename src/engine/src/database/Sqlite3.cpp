@@ -13,6 +13,11 @@
 
 #include <rfl/json/write.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <variant>
+
 namespace database {
 
 Sqlite3::Sqlite3(const typename Command::SQLite3Op& _obj)
@@ -21,21 +26,20 @@ Sqlite3::Sqlite3(const typename Command::SQLite3Op& _obj)
       read_write_lock_(rfl::Ref<multithreading::ReadWriteLock>::make()),
       time_formats_(_obj.time_formats()) {}
 
-void Sqlite3::check_colnames(const std::vector<std::string>& _colnames,
-                             io::Reader* _reader) {
-  const auto csv_colnames = _reader->colnames();
-
-  if (csv_colnames.size() != _colnames.size()) {
+void Sqlite3::check_colnames(
+    const std::vector<std::string>& _colnames,
+    const std::vector<std::string>& _csv_colnames) const {
+  if (_csv_colnames.size() != _colnames.size()) {
     throw std::runtime_error("Wrong number of columns. Expected " +
                              std::to_string(_colnames.size()) + ", saw " +
-                             std::to_string(csv_colnames.size()) + ".");
+                             std::to_string(_csv_colnames.size()) + ".");
   }
 
   for (size_t i = 0; i < _colnames.size(); ++i) {
-    if (csv_colnames.at(i) != _colnames.at(i)) {
+    if (_csv_colnames.at(i) != _colnames.at(i)) {
       throw std::runtime_error("Column " + std::to_string(i + 1) +
                                " has wrong name. Expected '" + _colnames.at(i) +
-                               "', saw '" + csv_colnames.at(i) + "'.");
+                               "', saw '" + _csv_colnames.at(i) + "'.");
     }
   }
 }
@@ -218,17 +222,71 @@ void Sqlite3::insert_line(const std::vector<std::string>& _line,
     }
   }
 
-  int rc = sqlite3_step(_stmt);
-
-  if (rc != SQLITE_OK && rc != SQLITE_ROW && rc != SQLITE_DONE) {
-    throw std::runtime_error(sqlite3_errmsg(db()));
-  }
+  step_and_reset(_stmt);
+}
 
-  rc = sqlite3_reset(_stmt);
+// ----------------------------------------------------------------------------
 
-  if (rc != SQLITE_OK) {
-    throw std::runtime_error(sqlite3_errmsg(db()));
+void Sqlite3::insert_batch(const io::ColumnarData& _data, const size_t _begin,
+                           const size_t _end, sqlite3_stmt* _stmt,
+                           std::vector<std::string>* _buffer) const {
+  const auto num_cols = _data.columns_.size();
+
+  assert_true(_buffer->size() >= (_end - _begin) * num_cols);
+
+  for (size_t i = _begin; i < _end; ++i) {
+    for (size_t j = 0; j < num_cols; ++j) {
+      const auto ix = (i - _begin) * num_cols + j;
+
+      const auto param = static_cast<int>(ix + 1);
+
+      const auto bind_text = [_buffer, _stmt, ix, param]() -> int {
+        const auto& str = _buffer->at(ix);
+        return sqlite3_bind_text(_stmt, param, str.c_str(),
+                                 static_cast<int>(str.size()), SQLITE_STATIC);
+      };
+
+      const auto bind = [&](const auto& _col) -> int {
+        using ColType = std::decay_t<decltype(_col)>;
+
+        if constexpr (std::is_same_v<ColType,
+                                     typename io::ColumnarData::StringColumn>) {
+          (*_buffer)[ix] = _col(i);
+          return bind_text();
+        } else {
+          const auto val = _col[i];
+
+          if (!std::isfinite(val)) {
+            return sqlite3_bind_null(_stmt, param);
+          }
+
+          switch (_data.coltypes_[j]) {
+            case io::Datatype::integer:
+              return sqlite3_bind_int64(_stmt, param,
+                                        static_cast<sqlite3_int64>(val));
+
+            case io::Datatype::time_stamp:
+              (*_buffer)[ix] = io::Parser::ts_to_string(val);
+              return bind_text();
+
+            default:
+              return sqlite3_bind_double(_stmt, param, val);
+          }
+        }
+      };
+
+      const auto rc = std::visit(bind, _data.columns_[j]);
+
+      if (rc != SQLITE_OK) {
+        throw std::runtime_error("Could not insert value in column '" +
+                                 _data.colnames_[j] + "', row " +
+                                 std::to_string(i + 1) + ": " +
+                                 sqlite3_errmsg(db()));
+      }
+    }
   }
+
+  step_and_reset(_stmt);
 }
 
 // ----------------------------------------------------------------------------
@@ -317,23 +375,31 @@ std::shared_ptr<sqlite3> Sqlite3::make_db(const std::string& _name) {
 // ----------------------------------------------------------------------------
 
 std::unique_ptr<sqlite3_stmt, int (*)(sqlite3_stmt*)>
-Sqlite3::make_insert_statement(
-    const std::string& _table,
-    const std::vector<std::string>& _colnames) const {
+Sqlite3::make_insert_statement(const std::string& _table,
+                               const size_t _num_cols,
+                               const size_t _num_rows) const {
   multithreading::ReadLock read_lock(read_write_lock_,
                                      std::chrono::milliseconds(1000));
 
   std::string sql = "INSERT INTO \"";
   sql += _table;
-  sql += "\" VALUES (";
+  sql += "\" VALUES ";
+
+  for (size_t row = 0; row < _num_rows; ++row) {
+    sql += '(';
 
-  for (size_t col = 0; col < _colnames.size(); ++col) {
-    sql += '?';
+    for (size_t col = 0; col < _num_cols; ++col) {
+      sql += '?';
 
-    if (col + 1 < _colnames.size()) {
+      if (col + 1 < _num_cols) {
+        sql += ',';
+      } else {
+        sql += ')';
+      }
+    }
+
+    if (row + 1 < _num_rows) {
       sql += ',';
-    } else {
-      sql += ')';
     }
   }
 
@@ -376,9 +442,9 @@ void Sqlite3::read(const std::string& _table, const size_t _skip,
                              "' has been altered while reading!");
   }
 
-  const auto stmt = make_insert_statement(_table, colnames);
+  const auto stmt = make_insert_statement(_table, colnames.size(), 1);
 
-  check_colnames(colnames, _reader);
+  check_colnames(colnames, _reader->colnames());
 
   size_t line_count = 0;
 
@@ -420,5 +486,76 @@ void Sqlite3::read(const std::string& _table, const size_t _skip,
   }
 }
 
+// ----------------------------------------------------------------------------
+
+void Sqlite3::step_and_reset(sqlite3_stmt* _stmt) const {
+  int rc = sqlite3_step(_stmt);
+
+  if (rc != SQLITE_OK && rc != SQLITE_ROW && rc != SQLITE_DONE) {
+    throw std::runtime_error(sqlite3_errmsg(db()));
+  }
+
+  rc = sqlite3_reset(_stmt);
+
+  if (rc != SQLITE_OK) {
+    throw std::runtime_error(sqlite3_errmsg(db()));
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void Sqlite3::write(const std::string& _table, const io::ColumnarData& _data) {
+  check_colnames(get_colnames_from_table(_table), _data.colnames_);
+
+  assert_true(_data.columns_.size() == _data.coltypes_.size());
+
+  const auto num_cols = _data.columns_.size();
+
+  if (num_cols == 0 || _data.nrows_ == 0) {
+    return;
+  }
+
+  // SQLite limits the number of parameters a single statement can have.
+  const auto max_params = static_cast<size_t>(
+      sqlite3_limit(db(), SQLITE_LIMIT_VARIABLE_NUMBER, -1));
+
+  const auto rows_per_insert = std::max(
+      static_cast<size_t>(1), std::min(max_params / num_cols,
+                                       MAX_ROWS_PER_INSERT));
+
+  const auto remainder = _data.nrows_ % rows_per_insert;
+
+  const auto stmt = make_insert_statement(_table, num_cols, rows_per_insert);
+
+  const auto remainder_stmt =
+      make_insert_statement(_table, num_cols, std::max(remainder, 1uz));
+
+  std::vector<std::string> buffer(rows_per_insert * num_cols);
+
+  execute("BEGIN;");
+
+  try {
+    multithreading::WriteLock write_lock(read_write_lock_);
+
+    for (size_t begin = 0; begin < _data.nrows_; begin += rows_per_insert) {
+      const auto end = std::min(begin + rows_per_insert, _data.nrows_);
+
+      auto current_stmt =
+          end - begin == rows_per_insert ? stmt.get() : remainder_stmt.get();
+
+      insert_batch(_data, begin, end, current_stmt, &buffer);
+    }
+
+    write_lock.unlock();
+
+    execute("COMMIT;");
+
+  } catch (std::exception& e) {
+    execute("ROLLBACK;");
+
+    throw std::runtime_error(e.what());
+  }
+}
+
 // ----------------------------------------------------------------------------
 }  // namespace database
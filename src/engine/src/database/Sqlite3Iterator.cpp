@@ -77,6 +77,79 @@ std::vector<std::string> Sqlite3Iterator::colnames() const {
 
 // ----------------------------------------------------------------------------
 
+size_t Sqlite3Iterator::fetch_batch(const std::vector<io::Datatype>& _coltypes,
+                                    const size_t _max_rows, Batch* _batch) {
+  if (colnum_ != 0) {
+    throw std::runtime_error(
+        "fetch_batch(...) cannot be called in the middle of a row.");
+  }
+
+  prepare_batch(_coltypes, _batch);
+
+  const auto get_text = [this](const int _j) -> std::string {
+    return reinterpret_cast<const char*>(sqlite3_column_text(stmt(), _j));
+  };
+
+  size_t nrows = 0;
+
+  for (; nrows < _max_rows && !end_; ++nrows) {
+    for (int j = 0; j < num_cols_; ++j) {
+      auto& col = (*_batch)[j];
+
+      if (_coltypes[j] == io::Datatype::unknown) {
+        continue;
+      }
+
+      const auto type = sqlite3_column_type(stmt(), j);
+
+      if (type == SQLITE_NULL) {
+        col.push_null();
+        continue;
+      }
+
+      const bool is_number = (type == SQLITE_INTEGER || type == SQLITE_FLOAT);
+
+      switch (_coltypes[j]) {
+        case io::Datatype::double_precision:
+          col.push_float(is_number ? static_cast<Float>(
+                                         sqlite3_column_double(stmt(), j))
+                                   : Getter::get_double(get_text(j)));
+          break;
+
+        case io::Datatype::integer:
+          col.push_int(is_number ? static_cast<std::int64_t>(
+                                       sqlite3_column_int64(stmt(), j))
+                                 : Getter::get_int(get_text(j)),
+                       false);
+          break;
+
+        case io::Datatype::string: {
+          // sqlite3_column_bytes(...) must be called after
+          // sqlite3_column_text(...), see the SQLite documentation.
+          const auto ptr =
+              reinterpret_cast<const char*>(sqlite3_column_text(stmt(), j));
+          const auto len = sqlite3_column_bytes(stmt(), j);
+          col.push_string(ptr, static_cast<size_t>(len));
+          break;
+        }
+
+        case io::Datatype::time_stamp:
+          col.push_float(Getter::get_time_stamp(get_text(j), time_formats_));
+          break;
+
+        default:
+          break;
+      }
+    }
+
+    next_row();
+  }
+
+  return nrows;
+}
+
+// ----------------------------------------------------------------------------
+
 Float Sqlite3Iterator::get_double() {
   if (end_) {
     throw std::runtime_error("End of table!");
@@ -10,8 +10,18 @@
 namespace engine::config {
 
 EngineOptions::EngineOptions(const ReflectionType& _obj)
-    : in_memory_(IN_MEMORY), port_(_obj.get<"port">()) {}
+    : in_memory_(IN_MEMORY),
+      lazy_loading_(false),
+      memory_budget_(0),
+      persistent_cache_(false),
+      persistent_cache_size_(PERSISTENT_CACHE_SIZE),
+      port_(_obj.get<"port">()) {}
 
-EngineOptions::EngineOptions() : port_(1708) {}
+EngineOptions::EngineOptions()
+    : lazy_loading_(false),
+      memory_budget_(0),
+      persistent_cache_(false),
+      persistent_cache_size_(PERSISTENT_CACHE_SIZE),
+      port_(1708) {}
 
 }  // namespace engine::config
@@ -84,6 +84,18 @@ void Options::parse_flags(int _argc, char* argv[]) {
 
     success = success || parse_string(arg, "project", &(engine_.project_));
 
+    success = success ||
+              parse_boolean(arg, "lazy-loading", &(engine_.lazy_loading_));
+
+    success = success ||
+              parse_size_t(arg, "memory-budget", &(engine_.memory_budget_));
+
+    success = success || parse_boolean(arg, "persistent-cache",
+                                       &(engine_.persistent_cache_));
+
+    success = success || parse_size_t(arg, "persistent-cache-size",
+                                      &(engine_.persistent_cache_size_));
+
     success = success || parse_size_t(arg, "http-port", &(monitor_.http_port_));
 
     success = success || parse_size_t(arg, "tcp-port", &(monitor_.tcp_port_));
@@ -0,0 +1,281 @@
+// Copyright 2024 Code17 GmbH
+//
+// This file is licensed under the Elastic License 2.0 (ELv2).
+// Refer to the LICENSE.txt file in the root of the repository
+// for details.
+//
+
+#include "engine/dependency/PersistentCache.hpp"
+
+#include <Poco/DigestEngine.h>
+#include <Poco/SHA2Engine.h>
+#include <rfl/json/read.hpp>
+#include <rfl/json/write.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+namespace engine {
+namespace dependency {
+
+PersistentCache::PersistentCache(
+    const std::string& _dir, const size_t _max_bytes,
+    const rfl::Ref<containers::Encoding>& _categories,
+    const rfl::Ref<containers::Encoding>& _join_keys_encoding)
+    : categories_(_categories),
+      dir_(_dir),
+      join_keys_encoding_(_join_keys_encoding),
+      max_bytes_(_max_bytes),
+      nbytes_(0) {
+  std::filesystem::create_directories(dir_);
+  read_entries();
+  evict();
+}
+
+// -------------------------------------------------------------------------
+
+size_t PersistentCache::calc_nbytes(const std::filesystem::path& _path) {
+  size_t nbytes = 0;
+  std::error_code ec;
+  for (const auto& f :
+       std::filesystem::recursive_directory_iterator(_path, ec)) {
+    if (f.is_regular_file(ec)) {
+      nbytes += static_cast<size_t>(f.file_size(ec));
+    }
+  }
+  return nbytes;
+}
+
+// -------------------------------------------------------------------------
+
+std::string PersistentCache::digest(const containers::Encoding& _encoding,
+                                    const size_t _size) {
+  const auto key = std::make_pair(&_encoding, _size);
+
+  const auto it = digests_.find(key);
+
+  if (it != digests_.end()) {
+    return it->second;
+  }
+
+  const auto strings = _encoding.strings();
+
+  auto engine = Poco::SHA2Engine(Poco::SHA2Engine::SHA_256);
+
+  for (size_t i = 0; i < _size; ++i) {
+    const auto str = strings[i];
+    // The terminating zero separates the strings.
+    engine.update(str.c_str(), str.size() + 1);
+  }
+
+  const auto result = Poco::DigestEngine::digestToHex(engine.digest());
+
+  digests_[key] = result;
+
+  return result;
+}
+
+// -------------------------------------------------------------------------
+
+void PersistentCache::evict() {
+  while (nbytes_ > max_bytes_ && entries_.size() > 0) {
+    auto lru = entries_.begin();
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+      if (it->second.last_access_ < lru->second.last_access_) {
+        lru = it;
+      }
+    }
+    remove_key(lru->first);
+  }
+}
+
+// -------------------------------------------------------------------------
+
+std::optional<std::string> PersistentCache::lookup(const std::string& _f_str) {
+  const auto key = make_key(_f_str);
+
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  const auto it = entries_.find(key);
+
+  if (it == entries_.end()) {
+    return std::nullopt;
+  }
+
+  const auto path = dir_ / key;
+
+  std::ifstream input(path / FINGERPRINT_FILE);
+  std::stringstream stream;
+  stream << input.rdbuf();
+
+  // On the off-chance that there was a collision, we double-check.
+  if (stream.str() != _f_str) {
+    return std::nullopt;
+  }
+
+  std::ifstream encodings_input(path / ENCODINGS_FILE);
+  std::stringstream encodings_stream;
+  encodings_stream << encodings_input.rdbuf();
+
+  const auto states =
+      rfl::json::read<EncodingStates>(encodings_stream.str());
+
+  // The object refers to strings by ids that no longer match.
+  if (!states || !is_valid(states.value())) {
+    remove_key(key);
+    return std::nullopt;
+  }
+
+  std::error_code ec;
+  const auto now = std::filesystem::file_time_type::clock::now();
+  std::filesystem::last_write_time(path / FINGERPRINT_FILE, now, ec);
+  it->second.last_access_ = now;
+
+  return (path / OBJECT_FILE).string();
+}
+
+// -------------------------------------------------------------------------
+
+bool PersistentCache::is_valid(const EncodingStates& _states) {
+  const auto is_valid_state = [this](const containers::Encoding& _encoding,
+                                     const EncodingState& _state) {
+    return _state.size_ <= _encoding.size() &&
+           digest(_encoding, _state.size_) == _state.digest_;
+  };
+
+  return is_valid_state(*categories_, _states.categories_) &&
+         is_valid_state(*join_keys_encoding_, _states.join_keys_encoding_);
+}
+
+// -------------------------------------------------------------------------
+
+typename PersistentCache::EncodingStates
+PersistentCache::make_encoding_states() {
+  const auto make_state = [this](const containers::Encoding& _encoding) {
+    const auto size = _encoding.size();
+    return EncodingState{.digest_ = digest(_encoding, size), .size_ = size};
+  };
+
+  return EncodingStates{
+      .categories_ = make_state(*categories_),
+      .join_keys_encoding_ = make_state(*join_keys_encoding_)};
+}
+
+// -------------------------------------------------------------------------
+
+std::string PersistentCache::make_key(const std::string& _f_str) {
+  auto engine = Poco::SHA2Engine(Poco::SHA2Engine::SHA_256);
+  engine.update(_f_str);
+  return Poco::DigestEngine::digestToHex(engine.digest());
+}
+
+// -------------------------------------------------------------------------
+
+void PersistentCache::read_entries() {
+  std::error_code ec;
+
+  std::vector<std::filesystem::path> incomplete;
+
+  for (const auto& d : std::filesystem::directory_iterator(dir_, ec)) {
+    if (!d.is_directory(ec)) {
+      continue;
+    }
+
+    const auto fingerprint_file = d.path() / FINGERPRINT_FILE;
+
+    if (!std::filesystem::exists(fingerprint_file, ec)) {
+      incomplete.push_back(d.path());
+      continue;
+    }
+
+    const auto nbytes = calc_nbytes(d.path());
+
+    const auto last_access =
+        std::filesystem::last_write_time(fingerprint_file, ec);
+
+    entries_.insert_or_assign(
+        d.path().filename().string(),
+        Entry{.nbytes_ = nbytes, .last_access_ = last_access});
+
+    nbytes_ += nbytes;
+  }
+
+  for (const auto& p : incomplete) {
+    std::filesystem::remove_all(p, ec);
+  }
+}
+
+// -------------------------------------------------------------------------
+
+void PersistentCache::remove(const std::string& _f_str) {
+  std::lock_guard<std::mutex> lock(mtx_);
+  remove_key(make_key(_f_str));
+}
+
+// -------------------------------------------------------------------------
+
+void PersistentCache::remove_key(const std::string& _key) {
+  const auto it = entries_.find(_key);
+
+  if (it != entries_.end()) {
+    nbytes_ -= it->second.nbytes_;
+    entries_.erase(it);
+  }
+
+  std::error_code ec;
+  std::filesystem::remove_all(dir_ / _key, ec);
+}
+
+// -------------------------------------------------------------------------
+
+void PersistentCache::store(
+    const std::string& _f_str,
+    const std::function<void(const std::string&)>& _save) {
+  const auto key = make_key(_f_str);
+
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  remove_key(key);
+
+  const auto path = dir_ / key;
+
+  // The cache is merely an optimization, so failing to write to it
+  // must never interrupt the fitting process.
+  try {
+    std::filesystem::create_directories(path);
+
+    std::ofstream encodings_output(path / ENCODINGS_FILE);
+    encodings_output << rfl::json::write(make_encoding_states());
+    encodings_output.close();
+
+    _save((path / OBJECT_FILE).string());
+
+    std::ofstream output(path / FINGERPRINT_FILE);
+    output << _f_str;
+    output.close();
+
+    if (!output) {
+      throw std::runtime_error("Could not write fingerprint.");
+    }
+  } catch (std::exception& e) {
+    remove_key(key);
+    return;
+  }
+
+  const auto nbytes = calc_nbytes(path);
+
+  entries_.insert_or_assign(
+      key, Entry{.nbytes_ = nbytes,
+                 .last_access_ = std::filesystem::file_time_type::clock::now()});
+
+  nbytes_ += nbytes;
+
+  evict();
+}
+
+// -------------------------------------------------------------------------
+}  // namespace dependency
+}  // namespace engine
@@ -12,9 +12,19 @@
 #include "engine/handlers/ArrowSocketInputStream.hpp"
 #include "engine/handlers/ArrowSocketOutputStream.hpp"
 #include "io/Parser.hpp"
+#include "multithreading/parallel_for.hpp"
 
+#include <parquet/file_reader.h>
+#include <parquet/schema.h>
+#include <parquet/statistics.h>
+#include <parquet/types.h>
 #include <range/v3/view/concat.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <ranges>
+
 namespace engine {
 namespace handlers {
 
@@ -30,7 +40,7 @@ std::shared_ptr<arrow::Table> ArrowHandler::df_to_table(
     const containers::DataFrame& _df) const {
   const auto schema = df_to_schema(_df);
 
-  const auto chunked_arrays = extract_arrays(_df);
+  const auto chunked_arrays = extract_arrays(_df, 0, _df.nrows());
 
   return arrow::Table::Make(schema, chunked_arrays,
                             static_cast<std::int64_t>(_df.nrows()));
@@ -39,42 +49,62 @@ std::shared_ptr<arrow::Table> ArrowHandler::df_to_table(
 // ----------------------------------------------------------------------------
 
 std::vector<std::shared_ptr<arrow::ChunkedArray>> ArrowHandler::extract_arrays(
-    const containers::DataFrame& _df) const {
+    const containers::DataFrame& _df, const size_t _begin,
+    const size_t _end) const {
   using Array = std::shared_ptr<arrow::ChunkedArray>;
 
-  const auto categoricals_to_string_array = [this](const auto& _col) -> Array {
-    const auto to_str = [this](const Int _i) -> std::string {
-      return (*categories_)[_i].str();
+  using ArrayFunction = std::function<Array()>;
+
+  assert_true(_begin <= _end);
+
+  const auto rows = std::views::iota(_begin, _end);
+
+  const auto categoricals_to_string_array =
+      [this, rows](const auto& _col) -> ArrayFunction {
+    return [this, rows, _col]() -> Array {
+      const auto to_str = [this, &_col](const size_t _i) -> std::string {
+        return (*categories_)[_col[_i]].str();
+      };
+      auto range = rows | std::views::transform(to_str);
+      return containers::ArrayMaker::make_string_array(range.begin(),
+                                                       range.end());
     };
-    auto range = _col | std::views::transform(to_str);
-    return containers::ArrayMaker::make_string_array(range.begin(),
-                                                     range.end());
   };
 
-  const auto join_keys_to_string_array = [this](const auto& _col) -> Array {
-    const auto to_str = [this](const Int _i) -> std::string {
-      return (*join_keys_encoding_)[_i].str();
+  const auto join_keys_to_string_array =
+      [this, rows](const auto& _col) -> ArrayFunction {
+    return [this, rows, _col]() -> Array {
+      const auto to_str = [this, &_col](const size_t _i) -> std::string {
+        return (*join_keys_encoding_)[_col[_i]].str();
+      };
+      auto range = rows | std::views::transform(to_str);
+      return containers::ArrayMaker::make_string_array(range.begin(),
+                                                       range.end());
     };
-    auto range = _col | std::views::transform(to_str);
-    return containers::ArrayMaker::make_string_array(range.begin(),
-                                                     range.end());
   };
 
-  const auto to_float_or_ts_array = [](const auto& _col) -> Array {
-    if (_col.unit().find("time stamp") != std::string::npos) {
-      return containers::ArrayMaker::make_time_stamp_array(_col.begin(),
-                                                           _col.end());
-    }
-    return containers::ArrayMaker::make_float_array(_col.begin(), _col.end());
+  const auto to_float_or_ts_array = [rows](const auto& _col) -> ArrayFunction {
+    return [rows, _col]() -> Array {
+      const auto get = [&_col](const size_t _i) -> Float { return _col[_i]; };
+      auto range = rows | std::views::transform(get);
+      if (_col.unit().find("time stamp") != std::string::npos) {
+        return containers::ArrayMaker::make_time_stamp_array(range.begin(),
+                                                             range.end());
+      }
+      return containers::ArrayMaker::make_float_array(range.begin(),
+                                                      range.end());
+    };
   };
 
-  const auto to_string_array = [](const auto& _col) -> Array {
-    const auto to_str = [](const strings::String& _str) -> std::string {
-      return _str.str();
+  const auto to_string_array = [rows](const auto& _col) -> ArrayFunction {
+    return [rows, _col]() -> Array {
+      const auto to_str = [&_col](const size_t _i) -> std::string {
+        return _col[_i].str();
+      };
+      auto range = rows | std::views::transform(to_str);
+      return containers::ArrayMaker::make_string_array(range.begin(),
+                                                       range.end());
     };
-    auto range = _col | std::views::transform(to_str);
-    return containers::ArrayMaker::make_string_array(range.begin(),
-                                                     range.end());
   };
 
   const auto categoricals =
@@ -100,10 +130,27 @@ std::vector<std::shared_ptr<arrow::ChunkedArray>> ArrowHandler::extract_arrays(
   const auto unused_strings =
       _df.unused_strings() | std::views::transform(to_string_array);
 
-  return ranges::views::concat(categoricals, join_keys, numericals, targets,
-                               text, time_stamps, unused_floats,
-                               unused_strings) |
-         std::ranges::to<std::vector>();
+  const auto functions =
+      ranges::views::concat(categoricals, join_keys, numericals, targets, text,
+                            time_stamps, unused_floats, unused_strings) |
+      std::ranges::to<std::vector>();
+
+  // The columns are independent of each other, so they can be converted in
+  // parallel.
+  auto arrays = std::vector<Array>(functions.size());
+
+  const auto convert = [&functions, &arrays](const size_t _begin,
+                                             const size_t _end,
+                                             const size_t /*_thread_num*/) {
+    for (size_t i = _begin; i < _end; ++i) {
+      arrays[i] = functions[i]();
+    }
+  };
+
+  multithreading::parallel_for(functions.size(),
+                               multithreading::default_num_threads(), convert);
+
+  return arrays;
 }
 
 // ----------------------------------------------------------------------------
@@ -185,9 +232,11 @@ parquet::Compression::type ArrowHandler::parse_compression(
 
 // ----------------------------------------------------------------------------
 
-std::shared_ptr<arrow::Table> ArrowHandler::read_parquet(
-    const std::string& _filename) const {
-  const auto pool = arrow::default_memory_pool();
+containers::DataFrame ArrowHandler::read_parquet(
+    const std::string& _filename, const std::string& _name,
+    const containers::Schema& _schema,
+    const std::vector<commands::ParquetFilter>& _filters) const {
+  const auto arrow_pool = arrow::default_memory_pool();
 
   const auto result = arrow::io::ReadableFile::Open(_filename);
 
@@ -200,22 +249,282 @@ std::shared_ptr<arrow::Table> ArrowHandler::read_parquet(
 
   std::unique_ptr<parquet::arrow::FileReader> arrow_reader;
 
-  auto status = parquet::arrow::OpenFile(input, pool, &arrow_reader);
+  const auto status =
+      parquet::arrow::OpenFile(input, arrow_pool, &arrow_reader);
 
   if (!status.ok()) {
     throw std::runtime_error("Could not open parquet file '" + _filename +
                              "': " + status.message());
   }
 
+  const auto metadata = arrow_reader->parquet_reader()->metadata();
+
+  const auto parquet_schema = metadata->schema();
+
+  // ------------------------------------------------------------------------
+
+  const auto float_colnames =
+      ranges::views::concat(_schema.numericals(), _schema.targets(),
+                            _schema.time_stamps(), _schema.unused_floats()) |
+      std::ranges::to<std::vector<std::string>>();
+
+  const auto string_colnames =
+      ranges::views::concat(_schema.categoricals(), _schema.join_keys(),
+                            _schema.text(), _schema.unused_strings()) |
+      std::ranges::to<std::vector<std::string>>();
+
+  for (const auto& filter : _filters) {
+    throw_unless(std::ranges::find(float_colnames, filter.column()) !=
+                     float_colnames.end(),
+                 "Cannot filter by column '" + filter.column() +
+                     "': Filters can only be applied to numerical columns, "
+                     "targets, time stamps or unused float columns.");
+  }
+
+  auto column_indices = std::vector<int>();
+
+  for (const auto& colname :
+       ranges::views::concat(float_colnames, string_colnames)) {
+    const auto ix = parquet_schema->ColumnIndex(colname);
+    throw_unless(ix >= 0, "Column '" + colname + "' not found!");
+    column_indices.push_back(ix);
+  }
+
+  std::ranges::sort(column_indices);
+
+  const auto [first, last] = std::ranges::unique(column_indices);
+
+  column_indices.erase(first, last);
+
+  // ------------------------------------------------------------------------
+
+  auto row_groups = std::vector<int>();
+
+  for (int i = 0; i < metadata->num_row_groups(); ++i) {
+    const auto row_group = metadata->RowGroup(i);
+
+    const auto may_pass = [&](const commands::ParquetFilter& _filter) {
+      const auto ix = parquet_schema->ColumnIndex(_filter.column());
+      return row_group_may_pass(*row_group->ColumnChunk(ix),
+                                *parquet_schema->Column(ix), _filter);
+    };
+
+    if (std::ranges::all_of(_filters, may_pass)) {
+      row_groups.push_back(i);
+    }
+  }
+
+  // ------------------------------------------------------------------------
+  // Every thread gets its own reader, which share the metadata and the
+  // underlying file.
+
+  const auto num_threads = std::max(
+      static_cast<size_t>(1),
+      std::min(multithreading::default_num_threads(), row_groups.size()));
+
+  auto readers =
+      std::vector<std::unique_ptr<parquet::arrow::FileReader>>(num_threads);
+
+  readers.at(0) = std::move(arrow_reader);
+
+  for (size_t i = 1; i < num_threads; ++i) {
+    const auto make_status = parquet::arrow::FileReader::Make(
+        arrow_pool,
+        parquet::ParquetFileReader::Open(
+            input, parquet::default_reader_properties(), metadata),
+        &readers.at(i));
+
+    if (!make_status.ok()) {
+      throw std::runtime_error("Could not open parquet file '" + _filename +
+                               "': " + make_status.message());
+    }
+  }
+
+  // ------------------------------------------------------------------------
+
+  const auto pool = options_.make_pool();
+
+  auto floats = std::vector<containers::Column<Float>>();
+
+  for (const auto& colname : float_colnames) {
+    floats.emplace_back(containers::Column<Float>(pool));
+    floats.back().set_name(colname);
+  }
+
+  const auto num_encoded =
+      _schema.categoricals().size() + _schema.join_keys().size();
+
+  auto ints = std::vector<containers::Column<Int>>();
+
+  auto strings = std::vector<containers::Column<strings::String>>();
+
+  for (size_t j = 0; j < string_colnames.size(); ++j) {
+    if (j < num_encoded) {
+      ints.emplace_back(containers::Column<Int>(pool));
+      ints.back().set_name(string_colnames[j]);
+    } else {
+      strings.emplace_back(containers::Column<strings::String>(pool));
+      strings.back().set_name(string_colnames[j]);
+    }
+  }
+
+  // The parts are appended in the order of the row groups, so the encodings
+  // do not depend on the number of threads. Note that the strings are
+  // encoded row group by row group, whereas table_to_df encodes one column
+  // at a time, so the integer codes may differ from those assigned by
+  // table_to_df when several columns share an encoding.
+  const auto append_part = [&](const ParquetPart& _part) {
+    for (size_t j = 0; j < floats.size(); ++j) {
+      floats[j].append(_part.floats_[j]);
+    }
+
+    for (size_t j = 0; j < _part.strings_.size(); ++j) {
+      if (j >= num_encoded) {
+        strings[j - num_encoded].append(_part.strings_[j]);
+        continue;
+      }
+
+      auto& encoding = j < _schema.categoricals().size()
+                           ? *categories_
+                           : *join_keys_encoding_;
+
+      for (const auto& str : _part.strings_[j]) {
+        ints[j].push_back(encoding[str]);
+      }
+    }
+  };
+
+  // We only ever hold as many row groups in memory as there are threads.
+  for (size_t begin = 0; begin < row_groups.size(); begin += num_threads) {
+    const auto end = std::min(begin + num_threads, row_groups.size());
+
+    auto parts = std::vector<ParquetPart>(end - begin);
+
+    const auto read_parts = [&](const size_t _begin, const size_t _end,
+                                const size_t _thread_num) {
+      for (size_t i = _begin; i < _end; ++i) {
+        parts[i] = read_row_group(readers.at(_thread_num).get(),
+                                  row_groups[begin + i], column_indices,
+                                  float_colnames, string_colnames, _filters);
+      }
+    };
+
+    multithreading::parallel_for(end - begin, num_threads, read_parts);
+
+    for (const auto& part : parts) {
+      append_part(part);
+    }
+  }
+
+  // ------------------------------------------------------------------------
+
+  auto df = containers::DataFrame(_name, categories_.ptr(),
+                                  join_keys_encoding_.ptr(), pool);
+
+  const auto add_float_columns = [&df, &floats](const size_t _begin,
+                                                const size_t _size,
+                                                const std::string& _role) {
+    for (size_t j = _begin; j < _begin + _size; ++j) {
+      df.add_float_column(floats[j], _role);
+    }
+  };
+
+  add_float_columns(0, _schema.numericals().size(),
+                    containers::DataFrame::ROLE_NUMERICAL);
+
+  add_float_columns(_schema.numericals().size(), _schema.targets().size(),
+                    containers::DataFrame::ROLE_TARGET);
+
+  add_float_columns(
+      _schema.numericals().size() + _schema.targets().size(),
+      _schema.time_stamps().size(), containers::DataFrame::ROLE_TIME_STAMP);
+
+  add_float_columns(_schema.numericals().size() + _schema.targets().size() +
+                        _schema.time_stamps().size(),
+                    _schema.unused_floats().size(),
+                    containers::DataFrame::ROLE_UNUSED_FLOAT);
+
+  for (size_t j = 0; j < ints.size(); ++j) {
+    df.add_int_column(ints[j], j < _schema.categoricals().size()
+                                   ? containers::DataFrame::ROLE_CATEGORICAL
+                                   : containers::DataFrame::ROLE_JOIN_KEY);
+  }
+
+  for (size_t j = 0; j < strings.size(); ++j) {
+    const auto role = j < _schema.text().size()
+                          ? containers::DataFrame::ROLE_TEXT
+                          : containers::DataFrame::ROLE_UNUSED_STRING;
+    df.add_string_column(strings[j], role);
+  }
+
+  return df;
+}
+
+// ----------------------------------------------------------------------------
+
+typename ArrowHandler::ParquetPart ArrowHandler::read_row_group(
+    parquet::arrow::FileReader* _reader, const int _row_group,
+    const std::vector<int>& _column_indices,
+    const std::vector<std::string>& _float_colnames,
+    const std::vector<std::string>& _string_colnames,
+    const std::vector<commands::ParquetFilter>& _filters) const {
   std::shared_ptr<arrow::Table> table;
 
-  status = arrow_reader->ReadTable(&table);
+  const auto status =
+      _reader->ReadRowGroup(_row_group, _column_indices, &table);
 
   if (!status.ok()) {
-    throw std::runtime_error("Could not read table: " + status.message());
+    throw std::runtime_error("Could not read row group " +
+                             std::to_string(_row_group) + ": " +
+                             status.message());
+  }
+
+  // The parts are only temporary, so they are kept in memory.
+  const auto no_pool = std::shared_ptr<memmap::Pool>();
+
+  auto part = ParquetPart();
+
+  for (const auto& colname : _float_colnames) {
+    part.floats_.push_back(
+        to_column<Float>(no_pool, colname, table->GetColumnByName(colname)));
+  }
+
+  for (const auto& colname : _string_colnames) {
+    part.strings_.push_back(to_column<strings::String>(
+        no_pool, colname, table->GetColumnByName(colname)));
   }
 
-  return table;
+  if (_filters.size() == 0) {
+    return part;
+  }
+
+  auto keep = std::vector<bool>(static_cast<size_t>(table->num_rows()), true);
+
+  for (const auto& filter : _filters) {
+    const auto it = std::ranges::find(_float_colnames, filter.column());
+
+    assert_true(it != _float_colnames.end());
+
+    const auto& col =
+        part.floats_.at(std::distance(_float_colnames.begin(), it));
+
+    for (size_t i = 0; i < col.nrows(); ++i) {
+      const auto val = col[i];
+      keep[i] = keep[i] && !std::isnan(val) &&
+                (!filter.min() || val >= *filter.min()) &&
+                (!filter.max() || val <= *filter.max());
+    }
+  }
+
+  for (auto& col : part.floats_) {
+    col = col.where(keep);
+  }
+
+  for (auto& col : part.strings_) {
+    col = col.where(keep);
+  }
+
+  return part;
 }
 
 // ----------------------------------------------------------------------------
@@ -245,6 +554,93 @@ std::shared_ptr<arrow::Table> ArrowHandler::recv_table(
 
 // ----------------------------------------------------------------------------
 
+bool ArrowHandler::row_group_may_pass(
+    const parquet::ColumnChunkMetaData& _chunk,
+    const parquet::ColumnDescriptor& _descr,
+    const commands::ParquetFilter& _filter) {
+  const auto stats = _chunk.statistics();
+
+  if (!_chunk.is_stats_set() || !stats) {
+    return true;
+  }
+
+  // Rows containing NULL values in a filtered column are always dropped, so
+  // a column chunk that contains nothing but NULL values cannot pass.
+  if (stats->HasNullCount() && _chunk.num_values() > 0 &&
+      stats->null_count() == _chunk.num_values()) {
+    return false;
+  }
+
+  if (!stats->HasMinMax()) {
+    return true;
+  }
+
+  // Time stamps, dates and decimals are not stored in the unit we compare
+  // against and unsigned integers are not ordered like their physical type,
+  // so we only use the statistics of plain numbers.
+  const auto logical_type = _descr.logical_type();
+
+  const bool is_plain_number =
+      !logical_type || logical_type->is_none() ||
+      (logical_type->is_int() &&
+       std::static_pointer_cast<const parquet::IntLogicalType>(logical_type)
+           ->is_signed());
+
+  if (!is_plain_number) {
+    return true;
+  }
+
+  const auto min_max = [&]() -> std::optional<std::pair<Float, Float>> {
+    switch (_descr.physical_type()) {
+      case parquet::Type::DOUBLE: {
+        const auto s =
+            std::static_pointer_cast<parquet::DoubleStatistics>(stats);
+        return std::make_pair(s->min(), s->max());
+      }
+
+      case parquet::Type::FLOAT: {
+        const auto s =
+            std::static_pointer_cast<parquet::FloatStatistics>(stats);
+        return std::make_pair(static_cast<Float>(s->min()),
+                              static_cast<Float>(s->max()));
+      }
+
+      case parquet::Type::INT32: {
+        const auto s =
+            std::static_pointer_cast<parquet::Int32Statistics>(stats);
+        return std::make_pair(static_cast<Float>(s->min()),
+                              static_cast<Float>(s->max()));
+      }
+
+      case parquet::Type::INT64: {
+        const auto s =
+            std::static_pointer_cast<parquet::Int64Statistics>(stats);
+        return std::make_pair(static_cast<Float>(s->min()),
+                              static_cast<Float>(s->max()));
+      }
+
+      default:
+        return std::nullopt;
+    }
+  }();
+
+  if (!min_max) {
+    return true;
+  }
+
+  if (_filter.min() && min_max->second < *_filter.min()) {
+    return false;
+  }
+
+  if (_filter.max() && min_max->first > *_filter.max()) {
+    return false;
+  }
+
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
 containers::DataFrame ArrowHandler::table_to_df(
     const std::shared_ptr<arrow::Table>& _table, const std::string& _name,
     const containers::Schema& _schema) const {
@@ -374,9 +770,13 @@ void ArrowHandler::send_table(const std::shared_ptr<arrow::Table>& _table,
 
 // ----------------------------------------------------------------------------
 
-void ArrowHandler::to_parquet(const std::shared_ptr<arrow::Table>& _table,
+void ArrowHandler::to_parquet(const containers::DataFrame& _df,
                               const std::string& _filename,
-                              const std::string& _compression) const {
+                              const std::string& _compression,
+                              const size_t _row_group_size,
+                              const bool _use_dictionary) const {
+  throw_unless(_row_group_size > 0, "The row group size must be positive.");
+
   const auto filename = _filename.find(".parquet") == std::string::npos
                             ? _filename + ".parquet"
                             : _filename;
@@ -394,12 +794,51 @@ void ArrowHandler::to_parquet(const std::shared_ptr<arrow::Table>& _table,
 
   builder.compression(parse_compression(_compression));
 
+  if (_use_dictionary) {
+    builder.enable_dictionary();
+  } else {
+    builder.disable_dictionary();
+  }
+
+  builder.max_row_group_length(static_cast<std::int64_t>(_row_group_size));
+
   const auto props = builder.build();
 
-  assert_true(_table);
+  // Allows the parquet writer to encode and compress the columns of a row
+  // group in parallel.
+  const auto arrow_props =
+      parquet::ArrowWriterProperties::Builder().set_use_threads(true)->build();
+
+  const auto schema = df_to_schema(_df);
+
+  auto writer_result = parquet::arrow::FileWriter::Open(
+      *schema, arrow::default_memory_pool(), outfile, props, arrow_props);
+
+  if (!writer_result.ok()) {
+    throw std::runtime_error("Could not write table: " +
+                             writer_result.status().message());
+  }
+
+  const auto writer = std::move(writer_result).ValueOrDie();
+
+  // We only ever convert a single row group at a time, so we never hold a
+  // second copy of the entire data frame in memory.
+  for (size_t begin = 0; begin < _df.nrows(); begin += _row_group_size) {
+    const auto end = std::min(begin + _row_group_size, _df.nrows());
+
+    const auto table =
+        arrow::Table::Make(schema, extract_arrays(_df, begin, end),
+                           static_cast<std::int64_t>(end - begin));
+
+    const auto status =
+        writer->WriteTable(*table, static_cast<std::int64_t>(_row_group_size));
+
+    if (!status.ok()) {
+      throw std::runtime_error("Could not write table: " + status.message());
+    }
+  }
 
-  const auto status = parquet::arrow::WriteTable(
-      *_table, arrow::default_memory_pool(), outfile, 100000, props);
+  const auto status = writer->Close();
 
   if (!status.ok()) {
     throw std::runtime_error("Could not write table: " + status.message());
@@ -16,12 +16,21 @@
 #include "engine/handlers/ViewParser.hpp"
 #include "io/CSVWriter.hpp"
 #include "io/StatementMaker.hpp"
+#include "logging/ScopedTimer.hpp"
+#include "memmap/MemoryLedger.hpp"
 #include "metrics/Summarizer.hpp"
+#include "multithreading/ReadLock.hpp"
 #include "multithreading/WriteLock.hpp"
 
 #include <Poco/TemporaryFile.h>
 #include <rfl/json/write.hpp>
 
+#include <algorithm>
+#include <optional>
+#include <ranges>
+#include <utility>
+#include <vector>
+
 namespace engine {
 namespace handlers {
 
@@ -573,9 +582,9 @@ void DataFrameManager::df_to_db(
     const containers::DataFrame& _df,
     const rfl::Ref<containers::Encoding>& _categories,
     const rfl::Ref<containers::Encoding>& _join_keys_encoding) const {
-  // We are using the bell character (\a) as the quotechar. It is least
-  // likely to appear in any field.
-  auto reader = containers::DataFrameReader(
+  // The reader is only used to generate the column names and types, the
+  // data itself is passed to the connector in typed, column-oriented form.
+  const auto reader = containers::DataFrameReader(
       _df, _categories.ptr(), _join_keys_encoding.ptr(), '\a', '|');
 
   const auto conn = connector(_conn_id);
@@ -587,13 +596,46 @@ void DataFrameManager::df_to_db(
 
   conn->execute(statement);
 
-  conn->read(_table_name, 0, &reader);
+  conn->write(_table_name, reader.to_columnar());
 
   params_.database_manager_->post_tables();
 }
 
 // ------------------------------------------------------------------------
 
+void DataFrameManager::enforce_memory_budget() {
+  const auto budget = params_.options_.engine().memory_budget_ * 1000000;
+
+  if (!memmap::MemoryLedger::global().exceeds_budget(budget)) {
+    return;
+  }
+
+  // Once all data frames are memory-mapped, there is nothing left to move
+  // and the write lock would only hold up the other requests.
+  multithreading::ReadLock read_lock(params_.read_write_lock_);
+
+  if (memory_budget_candidates().empty()) {
+    return;
+  }
+
+  read_lock.unlock();
+
+  // Long-running commands, such as fitting a pipeline, hold a weak write
+  // lock. Rather than blocking every other request until they are done, the
+  // budget is left to the next request.
+  auto write_lock = std::optional<multithreading::WriteLock>();
+
+  try {
+    write_lock.emplace(params_.read_write_lock_, MEMORY_BUDGET_LOCK_TIMEOUT);
+  } catch (const std::runtime_error&) {
+    return;
+  }
+
+  move_to_memory_mapping();
+}
+
+// ------------------------------------------------------------------------
+
 void DataFrameManager::freeze(const typename Command::FreezeDataFrameOp& _cmd,
                               Poco::Net::StreamSocket* _socket) {
   const auto& name = _cmd.name();
@@ -622,6 +664,8 @@ void DataFrameManager::from_arrow(
 
   multithreading::WeakWriteLock weak_write_lock(params_.read_write_lock_);
 
+  logging::ScopedTimer timer("ingest.arrow", "ingest");
+
   const auto pool = params_.options_.make_pool();
 
   const auto local_categories = rfl::Ref<containers::Encoding>::make(
@@ -636,6 +680,10 @@ void DataFrameManager::from_arrow(
   auto df = arrow_handler.table_to_df(arrow_handler.recv_table(_socket), name,
                                       schema);
 
+  timer.add_rows(df.nrows());
+
+  timer.add_bytes(df.nbytes());
+
   // Now we upgrade the weak write lock to a strong write lock to commit
   // the changes.
   weak_write_lock.upgrade();
@@ -656,6 +704,8 @@ void DataFrameManager::from_arrow(
 
   data_frames()[name].create_indices();
 
+  move_to_memory_mapping();
+
   weak_write_lock.unlock();
 
   communication::Sender::send_string("Success!", _socket);
@@ -688,6 +738,8 @@ void DataFrameManager::from_csv(const typename Command::AddDfFromCSVOp& _cmd,
   // We need the weak write lock for the categories and join keys encoding.
   multithreading::WeakWriteLock weak_write_lock(params_.read_write_lock_);
 
+  logging::ScopedTimer timer("ingest.csv", "ingest");
+
   const auto pool = params_.options_.make_pool();
 
   const auto local_categories =
@@ -702,6 +754,10 @@ void DataFrameManager::from_csv(const typename Command::AddDfFromCSVOp& _cmd,
   df.from_csv(colnames, fnames, quotechar, sep, num_lines_read, skip,
               time_formats, schema);
 
+  timer.add_rows(df.nrows());
+
+  timer.add_bytes(df.nbytes());
+
   // Now we upgrade the weak write lock to a strong write lock to commit
   // the changes.
   weak_write_lock.upgrade();
@@ -722,6 +778,8 @@ void DataFrameManager::from_csv(const typename Command::AddDfFromCSVOp& _cmd,
 
   data_frames()[name].create_indices();
 
+  move_to_memory_mapping();
+
   weak_write_lock.unlock();
 
   communication::Sender::send_string("Success!", _socket);
@@ -743,6 +801,8 @@ void DataFrameManager::from_db(const typename Command::AddDfFromDBOp& _cmd,
 
   multithreading::WeakWriteLock weak_write_lock(params_.read_write_lock_);
 
+  logging::ScopedTimer timer("ingest.db", "ingest");
+
   const auto pool = params_.options_.make_pool();
 
   const auto local_categories = std::make_shared<containers::Encoding>(
@@ -756,6 +816,10 @@ void DataFrameManager::from_db(const typename Command::AddDfFromDBOp& _cmd,
 
   df.from_db(connector(conn_id), table_name, schema);
 
+  timer.add_rows(df.nrows());
+
+  timer.add_bytes(df.nbytes());
+
   weak_write_lock.upgrade();
 
   params_.categories_->append(*local_categories);
@@ -774,6 +838,8 @@ void DataFrameManager::from_db(const typename Command::AddDfFromDBOp& _cmd,
 
   data_frames()[name].create_indices();
 
+  move_to_memory_mapping();
+
   weak_write_lock.unlock();
 
   communication::Sender::send_string("Success!", _socket);
@@ -794,6 +860,8 @@ void DataFrameManager::from_parquet(
 
   multithreading::WeakWriteLock weak_write_lock(params_.read_write_lock_);
 
+  logging::ScopedTimer timer("ingest.parquet", "ingest");
+
   const auto pool = params_.options_.make_pool();
 
   const auto local_categories =
@@ -805,8 +873,14 @@ void DataFrameManager::from_parquet(
   const auto arrow_handler = handlers::ArrowHandler(
       local_categories, local_join_keys_encoding, params_.options_);
 
-  auto df = arrow_handler.table_to_df(arrow_handler.read_parquet(fname), name,
-                                      schema);
+  const auto filters =
+      _cmd.filters().value_or(std::vector<commands::ParquetFilter>());
+
+  auto df = arrow_handler.read_parquet(fname, name, schema, filters);
+
+  timer.add_rows(df.nrows());
+
+  timer.add_bytes(df.nbytes());
 
   // Now we upgrade the weak write lock to a strong write lock to commit
   // the changes.
@@ -828,6 +902,8 @@ void DataFrameManager::from_parquet(
 
   data_frames()[name].create_indices();
 
+  move_to_memory_mapping();
+
   weak_write_lock.unlock();
 
   communication::Sender::send_string("Success!", _socket);
@@ -850,6 +926,8 @@ void DataFrameManager::from_query(
 
   multithreading::WeakWriteLock weak_write_lock(params_.read_write_lock_);
 
+  logging::ScopedTimer timer("ingest.query", "ingest");
+
   const auto pool = params_.options_.make_pool();
 
   const auto local_categories =
@@ -863,6 +941,10 @@ void DataFrameManager::from_query(
 
   df.from_query(connector(conn_id), query, schema);
 
+  timer.add_rows(df.nrows());
+
+  timer.add_bytes(df.nbytes());
+
   weak_write_lock.upgrade();
 
   params_.categories_->append(*local_categories);
@@ -881,6 +963,8 @@ void DataFrameManager::from_query(
 
   data_frames()[name].create_indices();
 
+  move_to_memory_mapping();
+
   weak_write_lock.unlock();
 
   communication::Sender::send_string("Success!", _socket);
@@ -929,6 +1013,8 @@ void DataFrameManager::from_view(const typename Command::AddDfFromViewOp& _cmd,
 
   data_frames()[name].create_indices();
 
+  move_to_memory_mapping();
+
   weak_write_lock.unlock();
 
   communication::Sender::send_string("Success!", _socket);
@@ -1056,6 +1142,85 @@ void DataFrameManager::last_change(const typename Command::LastChangeOp& _cmd,
 
 // ------------------------------------------------------------------------
 
+bool DataFrameManager::may_unload(const containers::DataFrame& _df) const {
+  return params_.lazy_data_frames_ && params_.options_.engine().lazy_loading_ &&
+         params_.lazy_data_frames_->unload_allowed() &&
+         LazyDataFrames::is_saved(_df, params_.options_.project_directory());
+}
+
+// ------------------------------------------------------------------------
+
+std::vector<std::string> DataFrameManager::memory_budget_candidates() const {
+  std::vector<std::pair<std::string, std::string>> last_changes;
+
+  for (const auto& [name, df] : data_frames()) {
+    if (!df.pool()) {
+      last_changes.emplace_back(df.last_change(), name);
+    }
+  }
+
+  // The data frames that have not been changed for the longest time are
+  // the least likely to be needed soon, so they are moved first.
+  std::ranges::sort(last_changes);
+
+  auto names = std::vector<std::string>();
+
+  for (const auto& last_change : last_changes) {
+    names.push_back(last_change.second);
+  }
+
+  return names;
+}
+
+// ------------------------------------------------------------------------
+
+void DataFrameManager::move_to_memory_mapping() {
+  const auto budget = params_.options_.engine().memory_budget_ * 1000000;
+
+  const auto& ledger = memmap::MemoryLedger::global();
+
+  for (const auto& name : memory_budget_candidates()) {
+    if (!ledger.exceeds_budget(budget)) {
+      break;
+    }
+
+    const auto resident_bytes = ledger.resident_bytes();
+
+    auto& df = data_frames().at(name);
+
+    if (may_unload(df)) {
+      params_.lazy_data_frames_->add(df);
+
+      data_frames().erase(name);
+
+      logger().log("Unloaded data frame '" + name +
+                   "', because the memory budget of " +
+                   std::to_string(params_.options_.engine().memory_budget_) +
+                   " MB was exceeded. It will be loaded from the project "
+                   "directory once it is needed.");
+    } else {
+      df = df.to_memory_mapped(params_.options_.temp_dir());
+
+      logger().log("Moved data frame '" + name +
+                   "' to memory mapping, because the memory budget of " +
+                   std::to_string(params_.options_.engine().memory_budget_) +
+                   " MB was exceeded.");
+    }
+
+    // The columns might still be shared with other copies of the data
+    // frame, or the allocator might keep the freed memory. Either way,
+    // moving the remaining data frames would only cost time.
+    if (ledger.resident_bytes() >= resident_bytes) {
+      logger().log(
+          "Stopped moving data frames to memory mapping, because moving '" +
+          name + "' did not lower the resident memory.");
+      break;
+    }
+  }
+}
+
+// ------------------------------------------------------------------------
+
 void DataFrameManager::recv_and_add_float_column(
     const RecvAndAddOp& _cmd, containers::DataFrame* _df,
     multithreading::WeakWriteLock* _weak_write_lock,
@@ -1132,6 +1297,17 @@ void DataFrameManager::refresh(const typename Command::RefreshDataFrameOp& _cmd,
 
   multithreading::ReadLock read_lock(params_.read_write_lock_);
 
+  // Unloaded data frames do not have to be loaded just to retrieve their
+  // roles.
+  if (params_.lazy_data_frames_ && !data_frames().contains(name)) {
+    const auto roles = params_.lazy_data_frames_->roles(name);
+    if (roles) {
+      read_lock.unlock();
+      communication::Sender::send_string(*roles, _socket);
+      return;
+    }
+  }
+
   const auto df = utils::Getter::get(name, data_frames());
 
   const auto roles = containers::Roles::from_schema(df.to_schema(false));
@@ -1177,7 +1353,35 @@ void DataFrameManager::summarize(
 
   const auto& df = utils::Getter::get(name, &data_frames());
 
-  const auto summary = df.to_monitor();
+  // The numerical columns are summarized against all targets, column by
+  // column and in parallel. The entries in feature_summary_ are in the same
+  // order as numerical_.
+  const auto nrows = df.nrows();
+
+  const auto get_feature = [&df](const size_t _i) {
+    return helpers::Feature<Float>(df.numerical(_i).data_ptr());
+  };
+
+  const auto features =
+      std::views::iota(0uz, nrows > 0 ? df.num_numericals() : 0uz) |
+      std::views::transform(get_feature) |
+      std::ranges::to<containers::NumericalFeatures>();
+
+  std::vector<const Float*> targets;
+
+  for (size_t j = 0; j < df.num_targets(); ++j) {
+    targets.push_back(df.target(j).data());
+  }
+
+  const auto num_bins =
+      std::max(std::min(static_cast<size_t>(30), nrows / 30),
+               static_cast<size_t>(10));
+
+  const auto summary =
+      df.to_monitor() *
+      rfl::make_field<"feature_summary_">(
+          metrics::Summarizer::calculate_feature_summary(
+              features, nrows, features.size(), num_bins, targets));
 
   read_lock.unlock();
 
@@ -1266,15 +1470,21 @@ void DataFrameManager::to_parquet(const typename Command::ToParquetOp& _cmd,
 
   const auto& df = utils::Getter::get(name, data_frames());
 
+  const auto row_group_size = _cmd.row_group_size().value_or(
+      handlers::ArrowHandler::DEFAULT_ROW_GROUP_SIZE);
+
+  const auto use_dictionary = _cmd.use_dictionary().value_or(true);
+
   const auto arrow_handler = handlers::ArrowHandler(
       params_.categories_, params_.join_keys_encoding_, params_.options_);
 
-  const auto table = arrow_handler.df_to_table(df);
+  // The data frame is converted while it is being written, so we have to
+  // hold the read lock until we are done.
+  arrow_handler.to_parquet(df, fname, compression, row_group_size,
+                           use_dictionary);
 
   read_lock.unlock();
 
-  arrow_handler.to_parquet(table, fname, compression);
-
   communication::Sender::send_string("Success!", _socket);
 }
 }  // namespace handlers
@@ -9,6 +9,14 @@
 
 #include "helpers/Endianness.hpp"
 
+#include <Poco/DigestEngine.h>
+#include <Poco/SHA2Engine.h>
+
+#include <cstdint>
+#include <fstream>
+#include <string_view>
+#include <type_traits>
+
 namespace engine {
 namespace handlers {
 // ------------------------------------------------------------------------
@@ -28,6 +36,21 @@ void FileHandler::create_project_directory(
 
 // ------------------------------------------------------------------------
 
+std::string FileHandler::digest(const containers::Encoding& _encoding,
+                                const size_t _size) {
+  auto engine = Poco::SHA2Engine(Poco::SHA2Engine::SHA_256);
+
+  for (size_t i = 0; i < _size; ++i) {
+    const auto str = _encoding[static_cast<Int>(i)];
+    // The terminating zero separates the strings.
+    engine.update(str.c_str(), str.size() + 1);
+  }
+
+  return Poco::DigestEngine::digestToHex(engine.digest());
+}
+
+// ------------------------------------------------------------------------
+
 containers::DataFrame FileHandler::load(
     const std::map<std::string, containers::DataFrame>& _data_frames,
     const std::shared_ptr<containers::Encoding>& _categories,
@@ -60,30 +83,136 @@ containers::DataFrame FileHandler::load(
 void FileHandler::load_encodings(const std::string& _path,
                                  containers::Encoding* _categories,
                                  containers::Encoding* _join_keys_encodings) {
-  if (helpers::Endianness::is_little_endian()) {
-    if (Poco::File(_path + "categories").exists()) {
-      *_categories =
-          FileHandler::read_strings_little_endian(_path + "categories");
+  const auto load = [&_path](const std::string& _name,
+                             containers::Encoding* _encoding) {
+    if (Poco::File(_path + _name + ".offsets").exists()) {
+      read_encoding(_path + _name, _encoding);
+      return;
     }
 
-    if (Poco::File(_path + "join_keys_encoding").exists()) {
-      *_join_keys_encodings =
-          FileHandler::read_strings_little_endian(_path + "join_keys_encoding");
-    }
-  } else {
-    if (Poco::File(_path + "categories").exists()) {
-      *_categories = FileHandler::read_strings_big_endian(_path + "categories");
+    if (!Poco::File(_path + _name).exists()) {
+      return;
     }
 
-    if (Poco::File(_path + "join_keys_encoding").exists()) {
-      *_join_keys_encodings =
-          FileHandler::read_strings_big_endian(_path + "join_keys_encoding");
-    }
+    *_encoding = helpers::Endianness::is_little_endian()
+                     ? read_strings_little_endian(_path + _name)
+                     : read_strings_big_endian(_path + _name);
+  };
+
+  load("categories", _categories);
+
+  load("join_keys_encoding", _join_keys_encodings);
+}
+
+// ----------------------------------------------------------------------------
+
+size_t FileHandler::num_saved(const std::string& _fname,
+                              const containers::Encoding& _encoding) {
+  const auto strings_file = Poco::File(_fname + ".strings");
+
+  const auto offsets_file = Poco::File(_fname + ".offsets");
+
+  if (!strings_file.exists() || !offsets_file.exists()) {
+    return 0;
   }
+
+  const auto offsets_size = static_cast<size_t>(offsets_file.getSize());
+
+  const auto n = offsets_size / sizeof(std::uint64_t);
+
+  if (n == 0 || n > _encoding.size() ||
+      offsets_size != n * sizeof(std::uint64_t)) {
+    return 0;
+  }
+
+  // The offsets file ends with the size of the strings file, unless we
+  // have been interrupted while writing.
+  std::ifstream offsets(_fname + ".offsets", std::ios::binary);
+
+  offsets.seekg((n - 1) * sizeof(std::uint64_t));
+
+  std::uint64_t end = 0;
+
+  offsets.read(reinterpret_cast<char*>(&end), sizeof(end));
+
+  if (!offsets) {
+    return 0;
+  }
+
+  if (helpers::Endianness::is_little_endian()) {
+    helpers::Endianness::reverse_byte_order(&end);
+  }
+
+  if (end != static_cast<std::uint64_t>(strings_file.getSize())) {
+    return 0;
+  }
+
+  // The saved strings are a prefix of _encoding, if and only if they have
+  // the same digest as the first n strings of _encoding.
+  std::ifstream digest_file(_fname + ".digest");
+
+  auto saved_digest = std::string();
+
+  digest_file >> saved_digest;
+
+  if (!digest_file || saved_digest != digest(_encoding, n)) {
+    return 0;
+  }
+
+  return n;
 }
 
 // ----------------------------------------------------------------------------
 
+void FileHandler::read_encoding(const std::string& _fname,
+                                containers::Encoding* _encoding) {
+  const auto read_file = [](const std::string& _file, auto* _data) {
+    const auto size = static_cast<size_t>(Poco::File(_file).getSize());
+
+    using ValueType = typename std::decay_t<decltype(*_data)>::value_type;
+
+    _data->resize(size / sizeof(ValueType));
+
+    std::ifstream input(_file, std::ios::binary);
+
+    input.read(reinterpret_cast<char*>(_data->data()),
+               _data->size() * sizeof(ValueType));
+
+    if (!input) {
+      throw std::runtime_error("Could not read '" + _file + "'.");
+    }
+  };
+
+  auto arena = std::string();
+
+  read_file(_fname + ".strings", &arena);
+
+  auto offsets = std::vector<std::uint64_t>();
+
+  read_file(_fname + ".offsets", &offsets);
+
+  if (helpers::Endianness::is_little_endian()) {
+    for (auto& offset : offsets) {
+      helpers::Endianness::reverse_byte_order(&offset);
+    }
+  }
+
+  auto views = std::vector<std::string_view>(offsets.size());
+
+  std::uint64_t begin = 0;
+
+  for (size_t i = 0; i < offsets.size(); ++i) {
+    if (offsets[i] < begin || offsets[i] > arena.size()) {
+      throw std::runtime_error("The encoding in '" + _fname +
+                               "' is corrupted.");
+    }
+    views[i] = std::string_view(arena.data() + begin, offsets[i] - begin);
+    begin = offsets[i];
+  }
+
+  _encoding->load(views, _fname + ".hashes");
+}
+
 std::vector<std::string> FileHandler::read_strings_big_endian(
     const std::string& _fname) {
   auto read_string = [](std::ifstream& _input) {
@@ -156,66 +285,92 @@ void FileHandler::save_encodings(
     const std::string& _path,
     const std::shared_ptr<const containers::Encoding> _categories,
     const std::shared_ptr<const containers::Encoding> _join_keys_encodings) {
-  if (helpers::Endianness::is_little_endian()) {
-    if (_categories && _categories->size() > 0) {
-      FileHandler::write_string_little_endian(_path + "categories",
-                                              *_categories);
+  const auto save = [&_path](const std::string& _name, const auto& _encoding) {
+    if (!_encoding || _encoding->size() == 0) {
+      return;
     }
 
-    if (_join_keys_encodings && _join_keys_encodings->size() > 0) {
-      FileHandler::write_string_little_endian(_path + "join_keys_encoding",
-                                              *_join_keys_encodings);
-    }
-  } else {
-    if (_categories && _categories->size() > 0) {
-      FileHandler::write_string_big_endian(_path + "categories", *_categories);
-    }
+    write_encoding(_path + _name, *_encoding);
 
-    if (_join_keys_encodings && _join_keys_encodings->size() > 0) {
-      FileHandler::write_string_big_endian(_path + "join_keys_encoding",
-                                           *_join_keys_encodings);
+    // Files in the legacy format would be outdated from now on.
+    auto legacy = Poco::File(_path + _name);
+
+    if (legacy.exists()) {
+      legacy.remove();
     }
-  }
+  };
+
+  save("categories", _categories);
+
+  save("join_keys_encoding", _join_keys_encodings);
 }
 
 // ----------------------------------------------------------------------------
 
-void FileHandler::write_string_big_endian(
-    const std::string& _fname, const containers::Encoding& _strings) {
-  std::ofstream output(_fname, std::ios::binary);
+void FileHandler::write_encoding(const std::string& _fname,
+                                 const containers::Encoding& _encoding) {
+  const auto begin = num_saved(_fname, _encoding);
 
-  auto write_string = [&output](const strings::String& _str) {
-    size_t str_size = _str.size();
+  auto hashes = Poco::File(_fname + ".hashes");
 
-    output.write(reinterpret_cast<const char*>(&str_size), sizeof(size_t));
-
-    output.write(_str.c_str(), _str.size());
-  };
+  if (begin == _encoding.size()) {
+    if (!hashes.exists()) {
+      _encoding.save_hash_table(hashes.path());
+    }
+    return;
+  }
 
-  for (size_t i = 0; i < _strings.size(); ++i) {
-    write_string(_strings[i]);
+  // The hash table is only valid for the strings it has been written for,
+  // so it must not survive a change to the strings.
+  if (hashes.exists()) {
+    hashes.remove();
   }
-}
 
-// ----------------------------------------------------------------------------
+  const auto mode = begin == 0 ? std::ios::binary | std::ios::trunc
+                               : std::ios::binary | std::ios::app;
 
-void FileHandler::write_string_little_endian(
-    const std::string& _fname, const containers::Encoding& _strings) {
-  std::ofstream output(_fname, std::ios::binary);
+  std::ofstream arena(_fname + ".strings", mode);
 
-  auto write_string = [&output](const strings::String& _str) {
-    size_t str_size = _str.size();
+  std::ofstream offsets(_fname + ".offsets", mode);
 
-    helpers::Endianness::reverse_byte_order(&str_size);
+  auto end = begin == 0 ? static_cast<std::uint64_t>(0)
+                        : static_cast<std::uint64_t>(
+                              Poco::File(_fname + ".strings").getSize());
 
-    output.write(reinterpret_cast<const char*>(&str_size), sizeof(size_t));
+  for (size_t i = begin; i < _encoding.size(); ++i) {
+    const auto str = _encoding[static_cast<Int>(i)];
 
-    output.write(_str.c_str(), _str.size());
-  };
+    arena.write(str.c_str(), str.size());
+
+    end += str.size();
 
-  for (size_t i = 0; i < _strings.size(); ++i) {
-    write_string(_strings[i]);
+    auto offset = end;
+
+    if (helpers::Endianness::is_little_endian()) {
+      helpers::Endianness::reverse_byte_order(&offset);
+    }
+
+    offsets.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
   }
+
+  arena.close();
+
+  offsets.close();
+
+  // Should we be interrupted before the digest has been written, num_saved(...)
+  // detects the inconsistency and the next call rewrites all files.
+  std::ofstream digest_file(_fname + ".digest", std::ios::trunc);
+
+  digest_file << digest(_encoding, _encoding.size());
+
+  digest_file.close();
+
+  if (!arena || !offsets || !digest_file) {
+    throw std::runtime_error("Could not write the encoding to '" + _fname +
+                             "'.");
+  }
+
+  _encoding.save_hash_table(hashes.path());
 }
 
 // ------------------------------------------------------------------------
@@ -0,0 +1,150 @@
+// Copyright 2024 Code17 GmbH
+//
+// This file is licensed under the Elastic License 2.0 (ELv2).
+// Refer to the LICENSE.txt file in the root of the repository
+// for details.
+//
+
+#include "engine/handlers/LazyDataFrames.hpp"
+
+#include "containers/Roles.hpp"
+
+#include <rfl/json/write.hpp>
+
+#include <fstream>
+#include <stdexcept>
+
+namespace engine {
+namespace handlers {
+
+void LazyDataFrames::add(const std::string& _name,
+                         const std::string& _project_directory) {
+  const auto last_change =
+      read_textfile(_name, _project_directory, "last_change.txt");
+
+  if (!last_change) {
+    throw std::runtime_error("Data frame '" + _name +
+                             "' could not be found in '" + _project_directory +
+                             "data/'!");
+  }
+
+  entries_[_name] =
+      Entry{.last_change_ = *last_change,
+            .roles_ = read_textfile(_name, _project_directory, "roles.json")};
+}
+
+// ------------------------------------------------------------------------
+
+void LazyDataFrames::add(const containers::DataFrame& _df) {
+  const auto roles = containers::Roles::from_schema(_df.to_schema(false));
+
+  entries_[_df.name()] = Entry{.last_change_ = _df.last_change(),
+                               .roles_ = rfl::json::write(roles)};
+}
+
+// ------------------------------------------------------------------------
+
+bool LazyDataFrames::is_saved(const containers::DataFrame& _df,
+                              const std::string& _project_directory) {
+  return read_textfile(_df.name(), _project_directory, "last_change.txt") ==
+         _df.last_change();
+}
+
+// ------------------------------------------------------------------------
+
+containers::DataFrame LazyDataFrames::load(
+    const std::string& _name,
+    const std::shared_ptr<containers::Encoding>& _categories,
+    const std::shared_ptr<containers::Encoding>& _join_keys_encoding,
+    const config::Options& _options) const {
+  const auto it = entries_.find(_name);
+
+  if (it == entries_.end()) {
+    throw std::runtime_error("Data frame '" + _name +
+                             "' has not been registered for lazy loading!");
+  }
+
+  auto df = containers::DataFrame(_name, _categories, _join_keys_encoding,
+                                  _options.make_pool());
+
+  df.load(_options.project_directory() + "data/" + _name + "/");
+
+  // The categories and join keys are stored as integers, which are only
+  // meaningful as long as the saved version is the one we know of.
+  if (df.last_change() != it->second.last_change_) {
+    throw std::runtime_error(
+        "Data frame '" + _name +
+        "' has been changed on disk since it was registered, so it cannot "
+        "be loaded. Please reload the project.");
+  }
+
+  df.create_indices();
+
+  return df;
+}
+
+// ------------------------------------------------------------------------
+
+std::vector<std::string> LazyDataFrames::names() const {
+  auto names = std::vector<std::string>();
+
+  for (const auto& [name, _] : entries_) {
+    names.push_back(name);
+  }
+
+  return names;
+}
+
+// ------------------------------------------------------------------------
+
+std::optional<std::string> LazyDataFrames::read_textfile(
+    const std::string& _name, const std::string& _project_directory,
+    const std::string& _fname) {
+  std::ifstream textfile(_project_directory + "data/" + _name + "/" + _fname);
+
+  if (!textfile.is_open()) {
+    return std::nullopt;
+  }
+
+  std::string content;
+
+  for (std::string line; std::getline(textfile, line);) {
+    content += line;
+  }
+
+  return content;
+}
+
+// ------------------------------------------------------------------------
+
+std::vector<std::string> LazyDataFrames::referenced_by(
+    const std::string& _cmd_str) const {
+  auto names = std::vector<std::string>();
+
+  // Names are always passed as JSON strings, so looking for the quoted
+  // name cannot match part of another name.
+  for (const auto& [name, _] : entries_) {
+    if (_cmd_str.find(rfl::json::write(name)) != std::string::npos) {
+      names.push_back(name);
+    }
+  }
+
+  return names;
+}
+
+// ------------------------------------------------------------------------
+
+std::optional<std::string> LazyDataFrames::roles(
+    const std::string& _name) const {
+  const auto it = entries_.find(_name);
+
+  if (it == entries_.end()) {
+    return std::nullopt;
+  }
+
+  return it->second.roles_;
+}
+
+// ------------------------------------------------------------------------
+}  // namespace handlers
+}  // namespace engine
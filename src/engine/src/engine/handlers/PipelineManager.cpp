@@ -478,7 +478,7 @@ void PipelineManager::refresh(const typename Command::RefreshOp& _cmd,
 
   const auto pipeline = utils::Getter::get(name, pipelines());
 
-  if (!pipeline.fitted()) {
+  if (!pipeline.is_fitted()) {
     throw std::runtime_error("Pipeline '" + name +
                              "' cannot be refreshed. It has not been fitted.");
   }
@@ -502,7 +502,7 @@ void PipelineManager::refresh_all(const typename Command::RefreshAllOp&,
 
   for (const auto& name : names) {
     const auto pipe = utils::Getter::get(name, pipelines());
-    if (!pipe.fitted()) {
+    if (!pipe.is_fitted()) {
       continue;
     }
     vec.push_back(refresh_pipeline(pipe));
@@ -539,18 +539,22 @@ typename PipelineManager::RefreshPipelineType PipelineManager::refresh_pipeline(
       rfl::make_field<"obj">(_pipeline.obj()) *
       rfl::make_field<"scores">(scores);
 
-  if (!_pipeline.fitted()) {
+  // The metadata is stored in pipeline.json, so refreshing does not load
+  // lazily loaded pipelines.
+  const auto metadata = _pipeline.fitted_metadata();
+
+  if (!metadata) {
     return base;
   }
 
-  const auto peripheral_metadata = *_pipeline.fitted()->peripheral_schema_ |
+  const auto peripheral_metadata = *metadata->peripheral_schema_ |
                                    std::views::transform(extract_roles) |
                                    std::ranges::to<std::vector>();
 
   const auto population_metadata =
-      extract_roles(*_pipeline.fitted()->population_schema_);
+      extract_roles(*metadata->population_schema_);
 
-  const auto& targets = _pipeline.fitted()->targets();
+  const auto& targets = metadata->targets_;
 
   return RefreshFittedPipelineType(
       base * rfl::make_field<"peripheral_metadata">(peripheral_metadata) *
@@ -656,9 +660,9 @@ void PipelineManager::to_db(
 
   const auto table_name = _cmd.table_name();
 
-  // We are using the bell character (\a) as the quotechar. It is least likely
-  // to appear in any field.
-  auto reader = containers::DataFrameReader(
+  // The reader is only used to generate the column names and types, the
+  // data itself is passed to the connector in typed, column-oriented form.
+  const auto reader = containers::DataFrameReader(
       df, _categories.ptr(), _join_keys_encoding.ptr(), '\a', '|');
 
   const auto conn = connector("default");
@@ -670,7 +674,7 @@ void PipelineManager::to_db(
 
   conn->execute(statement);
 
-  conn->read(table_name, 0, &reader);
+  conn->write(table_name, reader.to_columnar());
 
   params_.database_manager_->post_tables();
 }
@@ -37,6 +37,7 @@ typename PipelineManager::FullTransformOp PipelineManager::receive_data(
                              .database_manager_ = params_.database_manager_,
                              .data_frames_ = _data_frames,
                              .join_keys_encoding_ = _join_keys_encoding,
+                             .lazy_data_frames_ = nullptr,
                              .logger_ = params_.logger_,
                              .monitor_ = params_.monitor_,
                              .options_ = params_.options_,
@@ -93,6 +94,16 @@ typename PipelineManager::FullTransformOp PipelineManager::receive_data(
     };
     const auto cmd = rfl::visit(handle, op);
     if (cmd) {
+      // The data frames are loaded using the global encodings, because the
+      // integers they were saved with refer to them.
+      for (const auto& name :
+           params_.lazy_data_frames_->referenced_by(json_str)) {
+        if (!_data_frames->contains(name)) {
+          (*_data_frames)[name] = params_.lazy_data_frames_->load(
+              name, params_.categories_.ptr(),
+              params_.join_keys_encoding_.ptr(), params_.options_);
+        }
+      }
       return *cmd;
     }
   }
@@ -16,13 +16,19 @@
 #include "engine/pipelines/save.hpp"
 #include "helpers/Loader.hpp"
 #include "helpers/Saver.hpp"
+#include "memmap/MemoryLedger.hpp"
 
 #include <Poco/DirectoryIterator.h>
+#include <rfl/Field.hpp>
+#include <rfl/NamedTuple.hpp>
 #include <rfl/always_false.hpp>
 #include <rfl/json/write.hpp>
 #include <rfl/make_named_tuple.hpp>
 
+#include <algorithm>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace engine {
 namespace handlers {
@@ -117,6 +123,8 @@ void ProjectManager::copy_pipeline(const typename Command::CopyPipelineOp& _cmd,
 void ProjectManager::clear() {
   data_frames() = std::map<std::string, containers::DataFrame>();
 
+  lazy_data_frames().clear();
+
   pipelines() = engine::handlers::PipelineManager::PipelineMapType();
 
   categories().clear();
@@ -139,6 +147,8 @@ void ProjectManager::delete_data_frame(
 
   multithreading::WriteLock write_lock(params_.read_write_lock_);
 
+  lazy_data_frames().erase(name);
+
   FileHandler::remove(name, project_directory(), _cmd.mem_only(),
                       &data_frames());
 
@@ -191,6 +201,27 @@ void ProjectManager::delete_project(
 
 // ------------------------------------------------------------------------
 
+void ProjectManager::init_persistent_cache() {
+  const auto& engine_options = params_.options_.engine();
+
+  if (!engine_options.persistent_cache_) {
+    return;
+  }
+
+  const auto persistent_cache = std::make_shared<dependency::PersistentCache>(
+      project_directory() + "cache/",
+      engine_options.persistent_cache_size_ * 1000000, params_.categories_,
+      params_.join_keys_encoding_);
+
+  preprocessor_tracker().set_persistent_cache(persistent_cache);
+
+  fe_tracker().set_persistent_cache(persistent_cache);
+
+  pred_tracker().set_persistent_cache(persistent_cache);
+}
+
+// ------------------------------------------------------------------------
+
 void ProjectManager::list_data_frames(const typename Command::ListDfsOp&,
                                       Poco::Net::StreamSocket* _socket) const {
   multithreading::ReadLock read_lock(params_.read_write_lock_);
@@ -201,6 +232,16 @@ void ProjectManager::list_data_frames(const typename Command::ListDfsOp&,
     in_memory.push_back(key);
   }
 
+  // Unloaded data frames are listed as being in memory, because they are
+  // loaded as soon as they are needed.
+  for (const auto& name : lazy_data_frames().names()) {
+    if (!data_frames().contains(name)) {
+      in_memory.push_back(name);
+    }
+  }
+
+  std::ranges::sort(in_memory);
+
   std::vector<std::string> on_disk;
 
   Poco::DirectoryIterator end;
@@ -297,6 +338,20 @@ void ProjectManager::load_data_frame(const typename Command::LoadDfOp& _cmd,
                                      Poco::Net::StreamSocket* _socket) {
   const auto& name = _cmd.name();
 
+  if (params_.options_.engine().lazy_loading_) {
+    multithreading::WriteLock write_lock(params_.read_write_lock_);
+
+    lazy_data_frames().add(name, project_directory());
+
+    data_frames().erase(name);
+
+    write_lock.unlock();
+
+    communication::Sender::send_string("Success!", _socket);
+
+    return;
+  }
+
   multithreading::WeakWriteLock weak_write_lock(params_.read_write_lock_);
 
   auto df = FileHandler::load(data_frames(), params_.categories_.ptr(),
@@ -320,6 +375,66 @@ void ProjectManager::load_data_frame(const typename Command::LoadDfOp& _cmd,
 
 // ------------------------------------------------------------------------
 
+void ProjectManager::load_lazy_data_frames(const std::string& _type,
+                                           const std::string& _cmd_str) {
+  // These commands handle unloaded data frames themselves.
+  if (_type == "DataFrame.delete" || _type == "DataFrame.load" ||
+      _type == "list_data_frames" || _type == "memory_usage") {
+    return;
+  }
+
+  const auto referenced = [this, &_type, &_cmd_str]() {
+    auto names = lazy_data_frames().referenced_by(_cmd_str);
+    if (_type == "DataFrame.refresh") {
+      std::erase_if(names, [this](const auto& _name) {
+        return lazy_data_frames().roles(_name).has_value();
+      });
+    }
+    return names;
+  };
+
+  multithreading::ReadLock read_lock(params_.read_write_lock_);
+
+  if (referenced().empty()) {
+    return;
+  }
+
+  read_lock.unlock();
+
+  multithreading::WeakWriteLock weak_write_lock(params_.read_write_lock_);
+
+  // Another request might have loaded them in the meantime.
+  const auto names = referenced();
+
+  auto loaded = std::vector<containers::DataFrame>();
+
+  for (const auto& name : names) {
+    // Data frames that have been recreated in memory take precedence over
+    // the saved ones.
+    if (!data_frames().contains(name)) {
+      loaded.push_back(lazy_data_frames().load(
+          name, params_.categories_.ptr(), params_.join_keys_encoding_.ptr(),
+          params_.options_));
+    }
+  }
+
+  weak_write_lock.upgrade();
+
+  for (const auto& name : names) {
+    lazy_data_frames().erase(name);
+  }
+
+  for (const auto& df : loaded) {
+    data_frames()[df.name()] = df;
+
+    if (df.build_history()) {
+      data_frame_tracker().add(df, *df.build_history());
+    }
+  }
+}
+
+// ------------------------------------------------------------------------
+
 void ProjectManager::load_pipeline(const typename Command::LoadPipelineOp& _cmd,
                                    Poco::Net::StreamSocket* _socket) {
   const auto& name = _cmd.name();
@@ -332,7 +447,8 @@ void ProjectManager::load_pipeline(const typename Command::LoadPipelineOp& _cmd,
       rfl::make_field<"pred_tracker_">(params_.pred_tracker_),
       rfl::make_field<"preprocessor_tracker_">(params_.preprocessor_tracker_));
 
-  const auto pipeline = pipelines::load::load(path, pipeline_trackers);
+  const auto pipeline = pipelines::load::load(
+      path, pipeline_trackers, params_.options_.engine().lazy_loading_);
 
   set_pipeline(name, pipeline);
 
@@ -341,6 +457,52 @@ void ProjectManager::load_pipeline(const typename Command::LoadPipelineOp& _cmd,
 
 // ------------------------------------------------------------------------
 
+void ProjectManager::memory_usage(const typename Command::MemoryUsageOp&,
+                                  Poco::Net::StreamSocket* _socket) const {
+  using DataFrameUsage =
+      rfl::NamedTuple<rfl::Field<"name", std::string>,
+                      rfl::Field<"nbytes", size_t>,
+                      rfl::Field<"memory_mapped", bool>>;
+
+  multithreading::ReadLock read_lock(params_.read_write_lock_);
+
+  std::vector<DataFrameUsage> data_frame_usage;
+
+  for (const auto& [name, df] : data_frames()) {
+    data_frame_usage.push_back(
+        rfl::make_field<"name">(name) *
+        rfl::make_field<"nbytes">(static_cast<size_t>(df.nbytes())) *
+        rfl::make_field<"memory_mapped">(df.pool() != nullptr));
+  }
+
+  const auto num_categories = categories().size();
+
+  const auto num_join_keys = join_keys_encoding().size();
+
+  const auto unloaded = lazy_data_frames().names();
+
+  read_lock.unlock();
+
+  const auto& ledger = memmap::MemoryLedger::global();
+
+  const auto obj =
+      rfl::make_field<"budget">(params_.options_.engine().memory_budget_ *
+                                1000000) *
+      rfl::make_field<"resident">(ledger.resident_bytes()) *
+      rfl::make_field<"memory_mapped">(ledger.memory_mapped_bytes()) *
+      rfl::make_field<"num_pools">(ledger.num_pools()) *
+      rfl::make_field<"num_categories">(num_categories) *
+      rfl::make_field<"num_join_keys">(num_join_keys) *
+      rfl::make_field<"data_frames">(data_frame_usage) *
+      rfl::make_field<"unloaded_data_frames">(unloaded);
+
+  communication::Sender::send_string("Success!", _socket);
+
+  communication::Sender::send_string(rfl::json::write(obj), _socket);
+}
+
+// ------------------------------------------------------------------------
+
 void ProjectManager::project_name(const typename Command::ProjectNameOp&,
                                   Poco::Net::StreamSocket* _socket) const {
   communication::Sender::send_string(params_.project_, _socket);
@@ -409,7 +571,9 @@ void ProjectManager::save_pipeline(const typename Command::SavePipelineOp& _cmd,
 
   // Saving the pipeline happens automatically, so it is unlikely that the field
   // will ever be set. Therefore, the format chosen is actually determined here.
-  const auto format = _cmd.format().value_or(Format::make<"json">());
+  // We default to msgpack, because parsing large JSON files slows down loading
+  // projects considerably. JSON can still be requested for debugging.
+  const auto format = _cmd.format().value_or(Format::make<"msgpack">());
 
   const auto params =
       pipelines::SaveParams{.categories = categories().strings(),
@@ -443,6 +607,8 @@ void ProjectManager::set_project(const std::string& _project) {
 
   clear();
 
+  init_persistent_cache();
+
   FileHandler::load_encodings(project_directory(), &categories(),
                               &join_keys_encoding());
 
@@ -67,6 +67,9 @@ void ProjectManager::execute_command(const Command& _command,
     } else if constexpr (std::is_same<Type,
                                       typename Command::LoadPipelineOp>()) {
       load_pipeline(_cmd, _socket);
+    } else if constexpr (std::is_same<Type,
+                                      typename Command::MemoryUsageOp>()) {
+      memory_usage(_cmd, _socket);
     } else if constexpr (std::is_same<Type,
                                       typename Command::ProjectNameOp>()) {
       project_name(_cmd, _socket);
@@ -312,24 +312,25 @@ containers::ColumnView<strings::String> StringOpParser::to_view(
     return (*_encoding)[_col[_i]];
   };
 
-  return containers::ColumnView<strings::String>(to_str, _col.nrows(),
-                                                 _col.subroles(), _col.unit());
+  const auto to_str_batch = [_encoding, _col](
+                                const size_t _begin, const size_t _end,
+                                std::vector<strings::String>* _out) {
+    _out->resize(_end - _begin);
+    const auto data = _col.data();
+    for (size_t i = _begin; i < _end; ++i) {
+      (*_out)[i - _begin] = (*_encoding)[data[i]];
+    }
+  };
+
+  return containers::ColumnView<strings::String>(
+      to_str, _col.nrows(), _col.subroles(), _col.unit(), to_str_batch);
 }
 
 // ----------------------------------------------------------------------------
 
 containers::ColumnView<strings::String> StringOpParser::to_view(
     const containers::Column<strings::String>& _col) const {
-  const auto to_str = [_col](size_t _i) -> std::optional<strings::String> {
-    if (_i >= _col.nrows()) {
-      return std::nullopt;
-    }
-
-    return _col[_i];
-  };
-
-  return containers::ColumnView<strings::String>(to_str, _col.nrows(),
-                                                 _col.subroles(), _col.unit());
+  return containers::ColumnView<strings::String>::from_column(_col);
 }
 
 // ----------------------------------------------------------------------------
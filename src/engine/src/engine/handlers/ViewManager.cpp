@@ -205,15 +205,22 @@ void ViewManager::view_to_parquet(const typename Command::ViewToParquetOp& _cmd,
   const auto local_join_keys_encoding = rfl::Ref<containers::Encoding>::make(
       pool, params_.join_keys_encoding_.ptr());
 
-  const auto table = ViewParser(local_categories, local_join_keys_encoding,
-                                params_.data_frames_, params_.options_)
-                         .to_table(view);
+  const auto row_group_size = _cmd.row_group_size().value_or(
+      handlers::ArrowHandler::DEFAULT_ROW_GROUP_SIZE);
 
-  read_lock.unlock();
+  const auto use_dictionary = _cmd.use_dictionary().value_or(true);
 
-  handlers::ArrowHandler(params_.categories_, params_.join_keys_encoding_,
+  const auto df = ViewParser(local_categories, local_join_keys_encoding,
+                             params_.data_frames_, params_.options_)
+                      .parse(view);
+
+  // The view is converted while it is being written, so we have to hold the
+  // read lock until we are done.
+  handlers::ArrowHandler(local_categories, local_join_keys_encoding,
                          params_.options_)
-      .to_parquet(table, fname, compression);
+      .to_parquet(df, fname, compression, row_group_size, use_dictionary);
+
+  read_lock.unlock();
 
   communication::Sender::send_string("Success!", _socket);
 }
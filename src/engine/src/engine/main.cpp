@@ -6,6 +6,7 @@
 //
 
 #include "engine/handlers/DataFrameManagerParams.hpp"
+#include "memmap/MemoryLedger.hpp"
 
 #include <Poco/Net/TCPServer.h>
 
@@ -57,6 +58,9 @@ int main(int argc, char* argv[]) {
   } catch (std::exception& e) {
   }
 
+  memmap::MemoryLedger::global().set_budget(
+      options.engine().memory_budget_ * 1000000, options.temp_dir());
+
   const auto monitor = rfl::Ref<const communication::Monitor>::make(options);
 
   const auto logger =
@@ -91,6 +95,9 @@ int main(int argc, char* argv[]) {
 
   const auto read_write_lock = rfl::Ref<multithreading::ReadWriteLock>::make();
 
+  const auto lazy_data_frames =
+      rfl::Ref<engine::handlers::LazyDataFrames>::make();
+
   const auto database_manager =
       rfl::Ref<engine::handlers::DatabaseManager>::make(logger, monitor,
                                                         options);
@@ -102,6 +109,7 @@ int main(int argc, char* argv[]) {
               .database_manager_ = database_manager,
               .data_frames_ = data_frames,
               .join_keys_encoding_ = join_keys_encoding,
+              .lazy_data_frames_ = lazy_data_frames.ptr(),
               .logger_ = logger,
               .monitor_ = monitor,
               .options_ = options,
@@ -117,6 +125,7 @@ int main(int argc, char* argv[]) {
       .data_frame_tracker_ = data_frame_tracker,
       .fe_tracker_ = fe_tracker,
       .join_keys_encoding_ = join_keys_encoding,
+      .lazy_data_frames_ = lazy_data_frames,
       .logger_ = logger,
       .monitor_ = monitor,
       .options_ = options,
@@ -138,6 +147,7 @@ int main(int argc, char* argv[]) {
       .data_frame_tracker_ = data_frame_tracker,
       .fe_tracker_ = fe_tracker,
       .join_keys_encoding_ = join_keys_encoding,
+      .lazy_data_frames_ = lazy_data_frames,
       .logger_ = logger,
       .monitor_ = monitor,
       .options_ = options,
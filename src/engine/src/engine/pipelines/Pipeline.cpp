@@ -62,6 +62,24 @@ std::shared_ptr<std::string> Pipeline::parse_population() const {
 
 // ----------------------------------------------------------------------------
 
+std::optional<FittedPipelineMetadata> Pipeline::fitted_metadata() const {
+  if (lazy_fitted_) {
+    return lazy_fitted_->metadata();
+  }
+
+  if (!fitted_) {
+    return std::nullopt;
+  }
+
+  return FittedPipelineMetadata{
+      .num_features_ = fitted_->num_features(),
+      .peripheral_schema_ = fitted_->peripheral_schema_,
+      .population_schema_ = fitted_->population_schema_,
+      .targets_ = fitted_->targets()};
+}
+
+// ----------------------------------------------------------------------------
+
 MonitorSummary Pipeline::to_monitor(const helpers::StringIterator&,
                                     const std::string& _name) const {
   const auto not_fitted = MonitorSummaryNotFitted{
@@ -69,15 +87,23 @@ MonitorSummary Pipeline::to_monitor(const helpers::StringIterator&,
       .allow_http = allow_http(),
       .creation_time = creation_time()};
 
-  if (!fitted()) {
+  const auto metadata = fitted_metadata();
+
+  if (!metadata) {
     return not_fitted;
   }
 
+  // Pipelines saved by older versions do not store the number of features,
+  // so they have to be loaded.
+  const auto num_features = metadata->num_features_
+                                ? *metadata->num_features_
+                                : fitted()->num_features();
+
   return MonitorSummaryFitted{.not_fitted = not_fitted,
-                              .num_features = fitted()->num_features(),
-                              .peripheral_schema = fitted()->peripheral_schema_,
-                              .population_schema = fitted()->population_schema_,
-                              .targets = fitted()->targets()};
+                              .num_features = num_features,
+                              .peripheral_schema = metadata->peripheral_schema_,
+                              .population_schema = metadata->population_schema_,
+                              .targets = metadata->targets_};
 }
 
 // ----------------------------------------------------------------------------
@@ -20,6 +20,7 @@
 #include "engine/preprocessors/PreprocessorParser.hpp"
 #include "featurelearners/AbstractFeatureLearner.hpp"
 #include "helpers/StringReplacer.hpp"
+#include "logging/ScopedTimer.hpp"
 #include "predictors/Predictor.hpp"
 #include "predictors/PredictorParser.hpp"
 
@@ -423,7 +424,11 @@ fit_feature_learners(
 
     const auto fingerprint = fe->fingerprint();
 
-    const auto retrieved_fe = _params.fe_tracker()->retrieve(fingerprint);
+    auto retrieved_fe = _params.fe_tracker()->retrieve(fingerprint);
+
+    if (!retrieved_fe) {
+      retrieved_fe = _params.fe_tracker()->retrieve_persisted(fe);
+    }
 
     if (retrieved_fe) {
       socket_logger->log("Retrieving features from cache...");
@@ -437,17 +442,25 @@ fit_feature_learners(
       continue;
     }
 
+    logging::ScopedTimer timer("feature_learner." + fe->type() + ".fit",
+                               "feature_learner");
+
+    timer.add_rows(_population_df.nrows());
+
     const auto params = featurelearners::FitParams{
         rfl::make_field<"cmd_">(_params.cmd()),
         rfl::make_field<"peripheral_dfs_">(_peripheral_dfs),
         rfl::make_field<"population_df_">(_population_df),
         rfl::make_field<"prefix_">(std::to_string(i + 1) + "_"),
         rfl::make_field<"socket_logger_">(socket_logger),
-        rfl::make_field<"temp_dir_">(_params.categories()->temp_dir())};
+        rfl::make_field<"temp_dir_">(
+            transform::temp_dir(*_params.categories()))};
 
     fe->fit(params);
 
     _params.fe_tracker()->add(fe);
+
+    _params.fe_tracker()->persist(fe);
   }
 
   const auto fl_fingerprints = extract_fl_fingerprints(
@@ -515,6 +528,9 @@ fit_predictors(const FitPredictorsParams& _params) {
 
   assert_true(predictors.size() == retrieved_predictors.size());
 
+  const auto features_nbytes =
+      transform::nbytes(categorical_features, numerical_features);
+
   for (size_t t = 0; t < _params.fit_params().population_df().num_targets();
        ++t) {
     const auto target_col = helpers::Feature<Float>(
@@ -549,11 +565,20 @@ fit_predictors(const FitPredictorsParams& _params) {
       socket_logger->log(p->type() + ": Training as " +
                          beautify_purpose(_params.purpose().name()) + "...");
 
+      logging::ScopedTimer timer("predictor." + p->type() + ".fit",
+                                 "predictor");
+
+      timer.add_rows(target_col.size());
+
+      timer.add_bytes(features_nbytes);
+
       p->fit(socket_logger, categorical_features, numerical_features,
              target_col, categorical_features_valid, numerical_features_valid,
              target_col_valid);
 
       _params.fit_params().pred_tracker()->add(p);
+
+      _params.fit_params().pred_tracker()->persist(p);
     }
   }
 
@@ -577,7 +602,9 @@ Preprocessed fit_preprocessors_only(const Pipeline& _pipeline,
 
   auto [population_df, peripheral_dfs] = transform::stage_data_frames(
       _pipeline, _params.population_df(), _params.peripheral_dfs(),
-      _params.logger(), _params.categories()->temp_dir(), _params.socket());
+      _params.logger(), transform::temp_dir(*_params.categories()),
+      std::nullopt,
+      _params.socket());
 
   const auto [preprocessors, preprocessor_fingerprints] =
       fit_transform_preprocessors(_pipeline, _params, df_fingerprints,
@@ -619,6 +646,14 @@ fit_transform_preprocessors(
     socket_logger->log("Preprocessing...");
   }
 
+  // The sizes are recorded once for all preprocessors, so they are not
+  // recomputed for every single one of them.
+  logging::ScopedTimer stage_timer("preprocessing", "preprocessor");
+
+  stage_timer.add_rows(_population_df->nrows());
+
+  stage_timer.add_bytes(transform::nbytes(*_population_df, *_peripheral_dfs));
+
   for (size_t i = 0; i < preprocessors.size(); ++i) {
     if (socket_logger) {
       const auto progress = (i * 100) / preprocessors.size();
@@ -627,11 +662,20 @@ fit_transform_preprocessors(
 
     auto& p = preprocessors.at(i);
 
+    logging::ScopedTimer timer("preprocessor." + p->type(), "preprocessor");
+
+    timer.add_rows(_population_df->nrows());
+
     const auto fingerprint = p->fingerprint();
 
-    const auto retrieved_preprocessor =
+    auto retrieved_preprocessor =
         _params.preprocessor_tracker()->retrieve(fingerprint);
 
+    if (!retrieved_preprocessor) {
+      retrieved_preprocessor =
+          _params.preprocessor_tracker()->retrieve_persisted(p);
+    }
+
     const auto params = preprocessors::Params{
         .categories = _params.categories(),
         .cmd = _params.cmd(),
@@ -652,6 +696,8 @@ fit_transform_preprocessors(
     std::tie(*_population_df, *_peripheral_dfs) = p->fit_transform(params);
 
     _params.preprocessor_tracker()->add(p);
+
+    _params.preprocessor_tracker()->persist(p);
   }
 
   if (socket_logger) {
@@ -897,6 +943,7 @@ make_features_validation(const FitPredictorsParams& _params) {
       .pipeline = _params.pipeline(),
       .preprocessors = _params.preprocessors(),
       .predictor_impl = _params.impl(),
+      .referenced_columns = std::nullopt,
       .transform_params = transform_params};
 
   const auto [numerical_features, categorical_features, _] =
@@ -993,7 +1040,11 @@ retrieve_predictors(
     std::vector<std::shared_ptr<predictors::Predictor>> r;
 
     for (auto& p : vec) {
-      const auto optional = _pred_tracker->retrieve(p->fingerprint());
+      auto optional = _pred_tracker->retrieve(p->fingerprint());
+
+      if (!optional) {
+        optional = _pred_tracker->retrieve_persisted(p);
+      }
 
       if (!optional) {
         all_retrieved = false;
@@ -13,7 +13,9 @@
 #include "helpers/Loader.hpp"
 
 #include <rfl/Field.hpp>
+#include <rfl/json/write.hpp>
 
+#include <stdexcept>
 #include <string>
 
 namespace engine {
@@ -21,7 +23,8 @@ namespace pipelines {
 namespace load {
 
 Pipeline load(const std::string& _path,
-              const dependency::PipelineTrackers& _pipeline_trackers) {
+              const dependency::PipelineTrackers& _pipeline_trackers,
+              const bool _lazy) {
   const auto obj =
       helpers::Loader::load<rfl::Ref<const commands::Pipeline>>(_path + "obj");
 
@@ -36,7 +39,40 @@ Pipeline load(const std::string& _path,
                      .with_creation_time(pipeline_json.creation_time())
                      .with_allow_http(pipeline_json.allow_http());
 
-  return pipelines::load_fitted::load_fitted(_path, p, _pipeline_trackers);
+  if (!_lazy) {
+    return pipelines::load_fitted::load_fitted(_path, p, _pipeline_trackers);
+  }
+
+  // The pipeline is only loaded on first access, by which time the files
+  // might have been overwritten by a different pipeline of the same name.
+  const auto expected_json = rfl::json::write(pipeline_json);
+
+  const auto loader = [_path, p, _pipeline_trackers, expected_json]() {
+    const auto actual_json = rfl::json::write(
+        helpers::Loader::load<PipelineJSON>(_path + "pipeline"));
+
+    if (actual_json != expected_json) {
+      throw std::runtime_error("Pipeline '" + p.obj().name() +
+                               "' has been changed on disk since the project "
+                               "was loaded, so it cannot be loaded from '" +
+                               _path + "'. Please reload the project.");
+    }
+
+    const auto fitted =
+        pipelines::load_fitted::load_fitted(_path, p, _pipeline_trackers)
+            .fitted();
+
+    return rfl::Ref<const FittedPipeline>::make(fitted).value();
+  };
+
+  const auto metadata = FittedPipelineMetadata{
+      .num_features_ = pipeline_json.num_features(),
+      .peripheral_schema_ = pipeline_json.peripheral_schema(),
+      .population_schema_ = pipeline_json.population_schema(),
+      .targets_ = pipeline_json.targets()};
+
+  return p.with_lazy_fitted(
+      rfl::Ref<const LazyFittedPipeline>::make(loader, metadata));
 }
 
 }  // namespace load
@@ -142,6 +142,7 @@ void save_pipeline_json(const SaveParams& _params,
                    .creation_time = p.creation_time(),
                    .modified_peripheral_schema = f.modified_peripheral_schema_,
                    .modified_population_schema = f.modified_population_schema_,
+                   .num_features = f.num_features(),
                    .peripheral_schema = f.peripheral_schema_,
                    .population_schema = f.population_schema_,
                    .targets = f.targets()};
@@ -82,10 +82,7 @@ std::shared_ptr<const metrics::Scores> calculate_feature_stats(
 
   auto scores = std::make_shared<metrics::Scores>(_pipeline.scores());
 
-  scores->update(metrics::Summarizer::calculate_feature_correlations(
-      _features, nrows, ncols, targets));
-
-  scores->update(metrics::Summarizer::calculate_feature_plots(
+  scores->update(metrics::Summarizer::calculate_feature_summary(
       _features, nrows, ncols, num_bins, targets));
 
   const auto [n1, n2, n3] = _fitted.feature_names();
@@ -10,6 +10,14 @@
 #include "engine/Float.hpp"
 #include "engine/Int.hpp"
 #include "helpers/StringSplitter.hpp"
+#include "logging/ScopedTimer.hpp"
+#include "multithreading/parallel_for.hpp"
+
+#include <functional>
+#include <map>
+#include <optional>
+#include <set>
+#include <type_traits>
 
 namespace engine {
 namespace pipelines {
@@ -33,17 +41,31 @@ containers::DataFrame find_peripheral(
     const std::string& _name, const std::vector<std::string>& _peripheral_names,
     const std::vector<containers::DataFrame>& _peripheral_dfs);
 
+/// Returns a copy of the column sorted by the index, or the column itself, if
+/// the index is the identity.
+template <class T>
+containers::Column<T> gather(const containers::Column<T>& _col,
+                             const std::vector<size_t>& _index,
+                             const bool _is_identity);
+
+/// Whether the index maps every row onto itself, in which case the columns
+/// can be shared instead of copied.
+bool is_identity(const std::vector<size_t>& _index, const size_t _nrows);
+
 containers::DataFrame join_all(
     const size_t _number, const bool _is_population,
     const std::string& _joined_name,
     const std::vector<std::string>& _origin_peripheral_names,
     const containers::DataFrame& _population_df,
-    const std::vector<containers::DataFrame>& _peripheral_dfs);
+    const std::vector<containers::DataFrame>& _peripheral_dfs,
+    const std::optional<std::set<std::string>>& _referenced,
+    std::map<std::string, containers::DataFrame>* _joined);
 
 containers::DataFrame join_one(
     const std::string& _splitted, const containers::DataFrame& _population,
     const std::vector<containers::DataFrame>& _peripheral_dfs,
-    const std::vector<std::string>& _peripheral_names);
+    const std::vector<std::string>& _peripheral_names,
+    const std::optional<std::set<std::string>>& _referenced);
 
 std::vector<size_t> make_index(
     const std::string& _name, const std::string& _alias,
@@ -145,12 +167,42 @@ containers::DataFrame find_peripheral(
 
 // ----------------------------------------------------------------------------
 
+template <class T>
+containers::Column<T> gather(const containers::Column<T>& _col,
+                             const std::vector<size_t>& _index,
+                             const bool _is_identity) {
+  if (_is_identity) {
+    return _col;
+  }
+  return _col.sort_by_key(_index);
+}
+
+// ----------------------------------------------------------------------------
+
+bool is_identity(const std::vector<size_t>& _index, const size_t _nrows) {
+  if (_index.size() != _nrows) {
+    return false;
+  }
+
+  for (size_t i = 0; i < _index.size(); ++i) {
+    if (_index[i] != i) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
 containers::DataFrame join_all(
     const size_t _number, const bool _is_population,
     const std::string& _joined_name,
     const std::vector<std::string>& _origin_peripheral_names,
     const containers::DataFrame& _population_df,
-    const std::vector<containers::DataFrame>& _peripheral_dfs) {
+    const std::vector<containers::DataFrame>& _peripheral_dfs,
+    const std::optional<std::set<std::string>>& _referenced,
+    std::map<std::string, containers::DataFrame>* _joined) {
   const auto splitted = helpers::StringSplitter::split(
       _joined_name, helpers::Macros::delimiter());
 
@@ -163,9 +215,27 @@ containers::DataFrame join_all(
                                  _peripheral_dfs);
   }
 
+  // The same chain of joins is often needed by more than one table (for
+  // instance, when the same peripheral table is used in several
+  // placeholders). Because the columns are shared between copies of a data
+  // frame, we can simply reuse the joined data frames.
+  auto key = (_is_population ? std::string("population") : std::string()) +
+             helpers::Macros::delimiter() + splitted.at(0);
+
   for (size_t i = 1; i < splitted.size(); ++i) {
+    key += helpers::Macros::delimiter() + splitted.at(i);
+
+    const auto it = _joined->find(key);
+
+    if (it != _joined->end()) {
+      population = it->second;
+      continue;
+    }
+
     population = join_one(splitted.at(i), population, _peripheral_dfs,
-                          _origin_peripheral_names);
+                          _origin_peripheral_names, _referenced);
+
+    _joined->insert_or_assign(key, population);
   }
 
   population.set_name(_joined_name + helpers::Macros::staging_table_num() +
@@ -179,7 +249,8 @@ containers::DataFrame join_all(
 containers::DataFrame join_one(
     const std::string& _splitted, const containers::DataFrame& _population,
     const std::vector<containers::DataFrame>& _peripheral_dfs,
-    const std::vector<std::string>& _peripheral_names) {
+    const std::vector<std::string>& _peripheral_names,
+    const std::optional<std::set<std::string>>& _referenced) {
   auto joined = _population;
 
   const auto [name, alias, join_key, other_join_key, time_stamp,
@@ -195,45 +266,116 @@ containers::DataFrame join_one(
                  other_time_stamp, upper_time_stamp, joined_to_name,
                  joined_to_alias, one_to_one, _population, peripheral);
 
+  const auto identity = is_identity(index, peripheral.nrows());
+
+  std::vector<containers::Column<Int>> categoricals;
+  std::vector<containers::Column<Int>> join_keys;
+  std::vector<containers::Column<Float>> numericals;
+  std::vector<containers::Column<strings::String>> text;
+  std::vector<containers::Column<Float>> time_stamps;
+  std::vector<containers::Column<strings::String>> unused_strings;
+
+  // During transform, we only copy the columns the fitted pipeline actually
+  // reads. Join keys and time stamps are always kept, because later joins in
+  // the same chain might depend on them.
+  const auto is_referenced = [&_referenced, &name,
+                              &alias](const auto& _col) -> bool {
+    return !_referenced ||
+           _referenced->contains(
+               helpers::Macros::make_colname(name, alias, _col.name()));
+  };
+
   for (size_t i = 0; i < peripheral.num_categoricals(); ++i) {
-    auto col = peripheral.categorical(i).sort_by_key(index);
-    col.set_name(helpers::Macros::make_colname(name, alias, col.name()));
-    joined.add_int_column(col, containers::DataFrame::ROLE_CATEGORICAL);
+    if (!is_referenced(peripheral.categorical(i))) {
+      continue;
+    }
+    categoricals.push_back(peripheral.categorical(i));
   }
 
   for (size_t i = 0; i < peripheral.num_join_keys(); ++i) {
-    auto col = peripheral.join_key(i).sort_by_key(index);
-    col.set_name(helpers::Macros::make_colname(name, alias, col.name()));
-    joined.add_int_column(col, containers::DataFrame::ROLE_JOIN_KEY);
+    join_keys.push_back(peripheral.join_key(i));
   }
 
   for (size_t i = 0; i < peripheral.num_numericals(); ++i) {
-    auto col = peripheral.numerical(i).sort_by_key(index);
-    col.set_name(helpers::Macros::make_colname(name, alias, col.name()));
-    joined.add_float_column(col, containers::DataFrame::ROLE_NUMERICAL);
+    if (!is_referenced(peripheral.numerical(i))) {
+      continue;
+    }
+    numericals.push_back(peripheral.numerical(i));
   }
 
   for (size_t i = 0; i < peripheral.num_text(); ++i) {
-    auto col = peripheral.text(i).sort_by_key(index);
-    col.set_name(helpers::Macros::make_colname(name, alias, col.name()));
-    joined.add_string_column(col, containers::DataFrame::ROLE_TEXT);
+    if (!is_referenced(peripheral.text(i))) {
+      continue;
+    }
+    text.push_back(peripheral.text(i));
   }
 
   for (size_t i = 0; i < peripheral.num_time_stamps(); ++i) {
-    auto col = peripheral.time_stamp(i).sort_by_key(index);
-    col.set_name(helpers::Macros::make_colname(name, alias, col.name()));
-    joined.add_float_column(col, containers::DataFrame::ROLE_TIME_STAMP);
+    time_stamps.push_back(peripheral.time_stamp(i));
   }
 
   for (size_t i = 0; i < peripheral.num_unused_strings(); ++i) {
-    if (peripheral.unused_string(i).unit() == "") {
+    if (peripheral.unused_string(i).unit() == "" ||
+        !is_referenced(peripheral.unused_string(i))) {
       continue;
     }
-    auto col = peripheral.unused_string(i).sort_by_key(index);
-    col.set_name(helpers::Macros::make_colname(name, alias, col.name()));
-    joined.add_string_column(col, containers::DataFrame::ROLE_UNUSED_STRING);
+    unused_strings.push_back(peripheral.unused_string(i));
   }
 
+  // Every column is gathered independently, so we can distribute the columns
+  // over several threads. The memory pool is not thread-safe, so this is
+  // only possible in memory.
+  std::vector<std::function<void()>> tasks;
+
+  const auto add_tasks = [&tasks, &index, identity](auto* _cols) {
+    for (auto& col : *_cols) {
+      tasks.push_back([&col, &index, identity]() {
+        col = gather(col, index, identity);
+      });
+    }
+  };
+
+  add_tasks(&categoricals);
+  add_tasks(&join_keys);
+  add_tasks(&numericals);
+  add_tasks(&text);
+  add_tasks(&time_stamps);
+  add_tasks(&unused_strings);
+
+  const auto num_threads =
+      peripheral.pool() ? 1 : multithreading::default_num_threads();
+
+  multithreading::parallel_for(
+      tasks.size(), num_threads,
+      [&tasks](const size_t _begin, const size_t _end, const size_t) {
+        for (size_t i = _begin; i < _end; ++i) {
+          tasks[i]();
+        }
+      });
+
+  const auto add_columns = [&joined, &name, &alias](auto* _cols,
+                                                    const std::string& _role) {
+    for (auto& col : *_cols) {
+      col.set_name(helpers::Macros::make_colname(name, alias, col.name()));
+      if constexpr (std::is_same<std::remove_cvref_t<decltype(col)>,
+                                 containers::Column<Int>>()) {
+        joined.add_int_column(col, _role);
+      } else if constexpr (std::is_same<std::remove_cvref_t<decltype(col)>,
+                                        containers::Column<Float>>()) {
+        joined.add_float_column(col, _role);
+      } else {
+        joined.add_string_column(col, _role);
+      }
+    }
+  };
+
+  add_columns(&categoricals, containers::DataFrame::ROLE_CATEGORICAL);
+  add_columns(&join_keys, containers::DataFrame::ROLE_JOIN_KEY);
+  add_columns(&numericals, containers::DataFrame::ROLE_NUMERICAL);
+  add_columns(&text, containers::DataFrame::ROLE_TEXT);
+  add_columns(&time_stamps, containers::DataFrame::ROLE_TIME_STAMP);
+  add_columns(&unused_strings, containers::DataFrame::ROLE_UNUSED_STRING);
+
   return joined;
 }
 
@@ -242,11 +384,16 @@ containers::DataFrame join_one(
 void join_tables(const std::vector<std::string>& _origin_peripheral_names,
                  const std::string& _joined_population_name,
                  const std::vector<std::string>& _joined_peripheral_names,
+                 const std::optional<std::set<std::string>>& _referenced,
                  containers::DataFrame* _population_df,
                  std::vector<containers::DataFrame>* _peripheral_dfs) {
+  logging::ScopedTimer timer("staging.join_tables", "staging");
+
+  auto joined = std::map<std::string, containers::DataFrame>();
+
   const auto population_df =
       join_all(1, true, _joined_population_name, _origin_peripheral_names,
-               *_population_df, *_peripheral_dfs);
+               *_population_df, *_peripheral_dfs, _referenced, &joined);
 
   auto peripheral_dfs =
       std::vector<containers::DataFrame>(_joined_peripheral_names.size());
@@ -254,7 +401,16 @@ void join_tables(const std::vector<std::string>& _origin_peripheral_names,
   for (size_t i = 0; i < peripheral_dfs.size(); ++i) {
     peripheral_dfs.at(i) =
         join_all(i + 2, false, _joined_peripheral_names.at(i),
-                 _origin_peripheral_names, *_population_df, *_peripheral_dfs);
+                 _origin_peripheral_names, *_population_df, *_peripheral_dfs,
+                 _referenced, &joined);
+  }
+
+  timer.add_rows(population_df.nrows());
+
+  timer.add_bytes(population_df.nbytes());
+
+  for (const auto& df : peripheral_dfs) {
+    timer.add_bytes(df.nbytes());
   }
 
   *_population_df = population_df;
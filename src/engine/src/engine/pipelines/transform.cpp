@@ -13,11 +13,15 @@
 #include "engine/pipelines/modify_data_frames.hpp"
 #include "engine/pipelines/score.hpp"
 #include "engine/pipelines/staging.hpp"
+#include "logging/ScopedTimer.hpp"
+#include "memmap/MemoryLedger.hpp"
 #include "metrics/Scores.hpp"
 
 #include <rfl/as.hpp>
 
+#include <set>
 #include <stdexcept>
+#include <string>
 
 namespace engine {
 namespace pipelines {
@@ -51,6 +55,11 @@ containers::NumericalFeatures make_autofeatures(
         _feature_learners,
     const predictors::PredictorImpl& _predictor_impl);
 
+/// Collects the names of the staged columns that are read by the
+/// preprocessors or contained in the schemata the feature learners were
+/// fitted on.
+std::set<std::string> referenced_columns(const FittedPipeline& _fitted);
+
 /// Retrieves the features from a cached data frame.
 std::tuple<containers::NumericalFeatures, containers::CategoricalFeatures,
            containers::NumericalFeatures>
@@ -89,6 +98,14 @@ apply_preprocessors(const FeaturesOnlyParams& _params,
     socket_logger->log("Preprocessing...");
   }
 
+  // The sizes are recorded once for all preprocessors, so they are not
+  // recomputed for every single one of them.
+  logging::ScopedTimer stage_timer("preprocessing", "preprocessor");
+
+  stage_timer.add_rows(population_df.nrows());
+
+  stage_timer.add_bytes(nbytes(population_df, peripheral_dfs));
+
   for (size_t i = 0; i < _params.preprocessors().size(); ++i) {
     const auto progress = (i * 100) / _params.preprocessors().size();
 
@@ -98,6 +115,10 @@ apply_preprocessors(const FeaturesOnlyParams& _params,
 
     auto& p = _params.preprocessors().at(i);
 
+    logging::ScopedTimer timer("preprocessor." + p->type(), "preprocessor");
+
+    timer.add_rows(population_df.nrows());
+
     const auto params = preprocessors::Params{
         .categories = _params.transform_params().categories(),
         .cmd = rfl::as<commands::DataFramesOrViews>(
@@ -138,6 +159,11 @@ containers::NumericalFeatures generate_autofeatures(
 
     const auto& index = _params.predictor_impl()->autofeatures().at(i);
 
+    logging::ScopedTimer timer("feature_learner." + fe->type() + ".transform",
+                               "feature_learner");
+
+    timer.add_rows(_params.population_df().nrows());
+
     const auto params = featurelearners::TransformParams{
         .cmd = _params.cmd(),
         .index = index,
@@ -145,7 +171,7 @@ containers::NumericalFeatures generate_autofeatures(
         .population_df = _params.population_df(),
         .prefix = std::to_string(i + 1) + "_",
         .socket_logger = socket_logger,
-        .temp_dir = _params.categories()->temp_dir()};
+        .temp_dir = temp_dir(*_params.categories())};
 
     auto new_features = fe->transform(params);
 
@@ -184,6 +210,9 @@ containers::NumericalFeatures generate_predictions(
 
   auto predictions = containers::NumericalFeatures();
 
+  const auto features_nbytes =
+      nbytes(_categorical_features, _numerical_features);
+
   for (size_t i = 0; i < _fitted.predictors_.size(); ++i) {
     const auto num_predictors_per_set = _fitted.predictors_.at(i).size();
 
@@ -194,6 +223,14 @@ containers::NumericalFeatures generate_predictions(
             nrows()));  // TODO: Use actual pool
 
     for (size_t j = 0; j < num_predictors_per_set; ++j) {
+      logging::ScopedTimer timer("predictor." + predictor(i, j)->type() +
+                                     ".predict",
+                                 "predictor");
+
+      timer.add_rows(nrows());
+
+      timer.add_bytes(features_nbytes);
+
       const auto new_prediction =
           predictor(i, j)->predict(_categorical_features, _numerical_features);
 
@@ -314,6 +351,65 @@ make_features(
 
 // ----------------------------------------------------------------------------
 
+size_t nbytes(const containers::CategoricalFeatures& _categorical_features,
+              const containers::NumericalFeatures& _numerical_features) {
+  size_t result = 0;
+
+  for (const auto& f : _categorical_features) {
+    result += f.size() * sizeof(Int);
+  }
+
+  for (const auto& f : _numerical_features) {
+    result += f.size() * sizeof(Float);
+  }
+
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+
+size_t nbytes(const containers::DataFrame& _population_df,
+              const std::vector<containers::DataFrame>& _peripheral_dfs) {
+  size_t result = _population_df.nbytes();
+
+  for (const auto& df : _peripheral_dfs) {
+    result += df.nbytes();
+  }
+
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+
+std::set<std::string> referenced_columns(const FittedPipeline& _fitted) {
+  std::set<std::string> names;
+
+  const auto add_schema = [&names](const helpers::Schema& _schema) {
+    for (const auto* cols :
+         {&_schema.categoricals(), &_schema.discretes(), &_schema.join_keys(),
+          &_schema.numericals(), &_schema.targets(), &_schema.text(),
+          &_schema.time_stamps(), &_schema.unused_floats(),
+          &_schema.unused_strings()}) {
+      names.insert(cols->begin(), cols->end());
+    }
+  };
+
+  add_schema(*_fitted.modified_population_schema_);
+
+  for (const auto& schema : *_fitted.modified_peripheral_schema_) {
+    add_schema(schema);
+  }
+
+  for (const auto& p : _fitted.preprocessors_) {
+    const auto cols = p->input_columns();
+    names.insert(cols.begin(), cols.end());
+  }
+
+  return names;
+}
+
+// ----------------------------------------------------------------------------
+
 std::tuple<containers::NumericalFeatures, containers::CategoricalFeatures,
            containers::NumericalFeatures>
 retrieve_features_from_cache(const containers::DataFrame& _df) {
@@ -394,6 +490,7 @@ transform(const TransformParams& _params, const Pipeline& _pipeline,
       .pipeline = _pipeline,
       .preprocessors = _fitted.preprocessors_,
       .predictor_impl = _fitted.predictors_.impl_,
+      .referenced_columns = referenced_columns(_fitted),
       .transform_params = _params};
 
   const auto [numerical_features, categorical_features, population_df] =
@@ -425,6 +522,7 @@ stage_data_frames(const Pipeline& _pipeline,
                   const std::vector<containers::DataFrame>& _peripheral_dfs,
                   const std::shared_ptr<const communication::Logger>& _logger,
                   const std::optional<std::string>& _temp_dir,
+                  const std::optional<std::set<std::string>>& _referenced,
                   Poco::Net::StreamSocket* _socket) {
   const auto socket_logger =
       std::make_shared<communication::SocketLogger>(_logger, true, _socket);
@@ -452,7 +550,7 @@ stage_data_frames(const Pipeline& _pipeline,
       make_placeholder::make_peripheral(*placeholder);
 
   staging::join_tables(*peripheral_names, placeholder->name(),
-                       joined_peripheral_names, &population_df,
+                       joined_peripheral_names, _referenced, &population_df,
                        &peripheral_dfs);
 
   socket_logger->log("Progress: 100%.");
@@ -462,6 +560,18 @@ stage_data_frames(const Pipeline& _pipeline,
 
 // ----------------------------------------------------------------------------
 
+std::optional<std::string> temp_dir(const containers::Encoding& _categories) {
+  const auto temp_dir = _categories.temp_dir();
+
+  if (temp_dir) {
+    return temp_dir;
+  }
+
+  return memmap::MemoryLedger::global().overflow_dir();
+}
+
+// ----------------------------------------------------------------------------
+
 std::tuple<containers::NumericalFeatures, containers::CategoricalFeatures,
            containers::DataFrame>
 transform_features_only(const FeaturesOnlyParams& _params) {
@@ -469,8 +579,8 @@ transform_features_only(const FeaturesOnlyParams& _params) {
       _params.pipeline(), _params.transform_params().original_population_df(),
       _params.transform_params().original_peripheral_dfs(),
       _params.transform_params().logger(),
-      _params.transform_params().categories()->temp_dir(),
-      _params.transform_params().socket());
+      temp_dir(*_params.transform_params().categories()),
+      _params.referenced_columns(), _params.transform_params().socket());
 
   std::tie(population_df, peripheral_dfs) =
       apply_preprocessors(_params, population_df, peripheral_dfs);
@@ -142,6 +142,25 @@ std::vector<typename CategoryTrimmer::CategoryPair> CategoryTrimmer::fit_df(
 
 // ----------------------------------------------------
 
+std::vector<std::string> CategoryTrimmer::input_columns() const {
+  const auto get_name = [](const CategoryPair& _pair) -> std::string {
+    return _pair.first.name();
+  };
+
+  auto names = population_sets_ | std::views::transform(get_name) |
+               std::ranges::to<std::vector>();
+
+  for (const auto& sets : peripheral_sets_) {
+    for (const auto& pair : sets) {
+      names.push_back(get_name(pair));
+    }
+  }
+
+  return names;
+}
+
+// ----------------------------------------------------
+
 void CategoryTrimmer::load(const std::string& _fname) {
   const auto named_tuple = helpers::Loader::load<ReflectionType>(_fname);
   peripheral_sets_ = named_tuple.peripheral_sets();
@@ -12,6 +12,8 @@
 #include "helpers/Loader.hpp"
 #include "helpers/Saver.hpp"
 
+#include <ranges>
+
 namespace engine {
 namespace preprocessors {
 
@@ -131,6 +133,17 @@ containers::DataFrame Imputation::fit_transform_df(
 
 // ----------------------------------------------------
 
+std::vector<std::string> Imputation::input_columns() const {
+  return column_descriptions() |
+         std::views::transform(
+             [](const helpers::ColumnDescription& _desc) -> std::string {
+               return _desc.name();
+             }) |
+         std::ranges::to<std::vector>();
+}
+
+// ----------------------------------------------------
+
 void Imputation::load(const std::string& _fname) {
   const auto named_tuple = helpers::Loader::load<ReflectionType>(_fname);
 
@@ -293,6 +293,25 @@ containers::DataFrame Seasonal::fit_transform_df(
 
 // ----------------------------------------------------
 
+std::vector<std::string> Seasonal::input_columns() const {
+  const auto get_name =
+      [](const rfl::Ref<helpers::ColumnDescription>& _desc) -> std::string {
+    return _desc->name();
+  };
+
+  std::vector<std::string> names;
+
+  for (const auto* cols : {&hour_, &minute_, &month_, &weekday_, &year_}) {
+    for (const auto& desc : *cols) {
+      names.push_back(get_name(desc));
+    }
+  }
+
+  return names;
+}
+
+// ----------------------------------------------------
+
 void Seasonal::load(const std::string& _fname) {
   const auto named_tuple = helpers::Loader::load<ReflectionType>(_fname);
   hour_ = named_tuple.hour();
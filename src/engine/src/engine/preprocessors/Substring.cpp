@@ -11,6 +11,8 @@
 #include "helpers/Loader.hpp"
 #include "helpers/Saver.hpp"
 
+#include <ranges>
+
 namespace engine {
 namespace preprocessors {
 
@@ -126,6 +128,16 @@ containers::DataFrame Substring::fit_transform_df(
 
 // -----------------------------------------------------------------------------
 
+std::vector<std::string> Substring::input_columns() const {
+  return cols_ |
+         std::views::transform(
+             [](const rfl::Ref<helpers::ColumnDescription>& _desc)
+                 -> std::string { return _desc->name(); }) |
+         std::ranges::to<std::vector>();
+}
+
+// ----------------------------------------------------
+
 void Substring::load(const std::string& _fname) {
   const auto named_tuple = helpers::Loader::load<ReflectionType>(_fname);
   cols_ = named_tuple.cols();
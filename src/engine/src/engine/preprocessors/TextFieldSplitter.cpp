@@ -14,6 +14,7 @@
 #include <rfl/replace.hpp>
 
 #include <memory>
+#include <ranges>
 
 namespace engine {
 namespace preprocessors {
@@ -99,6 +100,16 @@ std::vector<rfl::Ref<helpers::ColumnDescription>> TextFieldSplitter::fit_df(
 
 // ----------------------------------------------------
 
+std::vector<std::string> TextFieldSplitter::input_columns() const {
+  return cols_ |
+         std::views::transform(
+             [](const rfl::Ref<helpers::ColumnDescription>& _desc)
+                 -> std::string { return _desc->name(); }) |
+         std::ranges::to<std::vector>();
+}
+
+// ----------------------------------------------------
+
 void TextFieldSplitter::load(const std::string& _fname) {
   const auto named_tuple = helpers::Loader::load<ReflectionType>(_fname);
   cols_ = named_tuple.cols();
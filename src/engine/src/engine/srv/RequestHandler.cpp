@@ -14,15 +14,23 @@
 #include "commands/PipelineCommand.hpp"
 #include "commands/ProjectCommand.hpp"
 #include "commands/ViewCommand.hpp"
+#include "logging/Tracer.hpp"
+#include "memmap/MemoryLedger.hpp"
 
 #include <Poco/JSON/Object.h>
 #include <Poco/JSON/Parser.h>
+#include <rfl/Field.hpp>
+#include <rfl/NamedTuple.hpp>
 #include <rfl/always_false.hpp>
 #include <rfl/extract_discriminators.hpp>
 #include <rfl/get.hpp>
 #include <rfl/json/read.hpp>
 
+#include <memory>
+#include <optional>
 #include <stdexcept>
+#include <string>
+#include <variant>
 
 namespace engine {
 namespace srv {
@@ -45,7 +53,74 @@ RequestHandler::RequestHandler(
       project_manager_(_project_manager),
       shutdown_(_shutdown) {}
 
+std::optional<std::string> RequestHandler::cmd_type(
+    const std::string& _cmd_str) const {
+  const auto cmd_type =
+      rfl::json::read<rfl::NamedTuple<rfl::Field<"type_", std::string>>>(
+          _cmd_str);
+
+  if (!cmd_type) {
+    return std::nullopt;
+  }
+
+  return cmd_type.value().get<"type_">();
+}
+
+// -----------------------------------------------------------------
+
+void RequestHandler::get_trace(
+    const typename commands::Command::GetTraceOp& _cmd) {
+  auto& tracer = logging::Tracer::global();
+
+  const auto json = tracer.to_json();
+
+  if (_cmd.clear()) {
+    tracer.clear();
+  }
+
+  communication::Sender::send_string("Success!", &socket());
+
+  communication::Sender::send_string(json, &socket());
+}
+
+// -----------------------------------------------------------------
+
+std::unique_ptr<logging::ScopedTimer> RequestHandler::make_timer(
+    const std::optional<std::string>& _type) const {
+  // The monitor polls is_alive, which would drown out everything else.
+  if (!_type || *_type == "is_alive" || *_type == "get_trace") {
+    return nullptr;
+  }
+
+  return std::make_unique<logging::ScopedTimer>("request." + *_type,
+                                                "request");
+}
+
+// -----------------------------------------------------------------
+
+bool RequestHandler::may_allocate(const commands::Command& _cmd) const {
+  return !std::holds_alternative<typename commands::Command::GetTraceOp>(
+             _cmd.val_) &&
+         !std::holds_alternative<typename commands::Command::IsAliveOp>(
+             _cmd.val_) &&
+         !std::holds_alternative<typename commands::Command::MonitorURLOp>(
+             _cmd.val_) &&
+         !std::holds_alternative<typename commands::Command::ShutdownOp>(
+             _cmd.val_);
+}
+
+// -----------------------------------------------------------------
+
 void RequestHandler::run() {
+  // Data frames may only be unloaded while no other request is being
+  // handled.
+  const auto request_scope = handlers::LazyDataFrames::RequestScope(
+      data_params_->lazy_data_frames_.get());
+
+  // The resident memory before the command was handled, if it may allocate
+  // any memory at all.
+  auto resident_bytes = std::optional<size_t>();
+
   try {
     if (socket().peerAddress().host().toString() != "127.0.0.1") {
       throw std::runtime_error("Illegal connection attempt from " +
@@ -58,6 +133,18 @@ void RequestHandler::run() {
 
     const auto cmd = rfl::json::read<commands::Command>(cmd_str).value();
 
+    const auto type = cmd_type(cmd_str);
+
+    const auto timer = make_timer(type);
+
+    if (may_allocate(cmd)) {
+      resident_bytes = memmap::MemoryLedger::resident_bytes();
+    }
+
+    if (type) {
+      project_manager().load_lazy_data_frames(*type, cmd_str);
+    }
+
     const auto handle = [this](const auto& _cmd) {
       using Type = std::decay_t<decltype(_cmd)>;
       if constexpr (std::is_same<Type, commands::ColumnCommand>()) {
@@ -72,6 +159,10 @@ void RequestHandler::run() {
         return project_manager().execute_command(_cmd, &socket());
       } else if constexpr (std::is_same<Type, commands::ViewCommand>()) {
         return view_manager().execute_command(_cmd, &socket());
+      } else if constexpr (std::is_same<
+                               Type,
+                               typename commands::Command::GetTraceOp>()) {
+        get_trace(_cmd);
       } else if constexpr (std::is_same<
                                Type, typename commands::Command::IsAliveOp>()) {
         return;
@@ -96,6 +187,21 @@ void RequestHandler::run() {
 
     communication::Sender::send_string(e.what(), &socket());
   }
+
+  // This happens after the response has been sent, so errors can only be
+  // logged. Requests that have not grown the memory, such as the polling by
+  // the monitor or the getters, leave the budget to the next request that
+  // does.
+  if (!resident_bytes ||
+      memmap::MemoryLedger::resident_bytes() <= *resident_bytes) {
+    return;
+  }
+
+  try {
+    data_frame_manager().enforce_memory_budget();
+  } catch (std::exception& e) {
+    logger_->log(std::string("Error: ") + e.what());
+  }
 }
 }  // namespace srv
 }  // namespace engine
@@ -15,55 +15,47 @@ Float Aggregator::apply_aggregation(
     const containers::DataFrame &_peripheral,
     const std::optional<containers::Features> &_subfeatures,
     const std::vector<containers::Match> &_matches,
-    const std::function<bool(const containers::Match &)> &_condition_function,
     const containers::AbstractFeature &_abstract_feature,
     const rfl::Ref<Memoization> &_memoization) {
   switch (_abstract_feature.data_used_.value()) {
     case enums::DataUsed::value_of<"categorical">():
       return apply_categorical(_population, _peripheral, _matches,
-                               _condition_function, _abstract_feature,
-                               _memoization);
+                               _abstract_feature, _memoization);
 
     case enums::DataUsed::value_of<"discrete">():
       return apply_discrete(_population, _peripheral, _matches,
-                            _condition_function, _abstract_feature,
-                            _memoization);
+                            _abstract_feature, _memoization);
 
     case enums::DataUsed::value_of<"na">():
-      return apply_not_applicable(_peripheral, _matches, _condition_function,
-                                  _abstract_feature, _memoization);
+      return apply_not_applicable(_peripheral, _matches, _abstract_feature,
+                                  _memoization);
 
     case enums::DataUsed::value_of<"numerical">():
       return apply_numerical(_population, _peripheral, _matches,
-                             _condition_function, _abstract_feature,
-                             _memoization);
+                             _abstract_feature, _memoization);
 
     case enums::DataUsed::value_of<"same_units_categorical">():
       return apply_same_units_categorical(_population, _peripheral, _matches,
-                                          _condition_function,
                                           _abstract_feature, _memoization);
 
     case enums::DataUsed::value_of<"same_units_discrete">():
     case enums::DataUsed::value_of<"same_units_discrete_ts">():
       return apply_same_units_discrete(_population, _peripheral, _matches,
-                                       _condition_function, _abstract_feature,
-                                       _memoization);
+                                       _abstract_feature, _memoization);
 
     case enums::DataUsed::value_of<"same_units_numerical">():
     case enums::DataUsed::value_of<"same_units_numerical_ts">():
       return apply_same_units_numerical(_population, _peripheral, _matches,
-                                        _condition_function, _abstract_feature,
-                                        _memoization);
+                                        _abstract_feature, _memoization);
 
     case enums::DataUsed::value_of<"subfeatures">():
       assert_true(_subfeatures);
       return apply_subfeatures(_population, _peripheral, *_subfeatures,
-                               _matches, _condition_function, _abstract_feature,
-                               _memoization);
+                               _matches, _abstract_feature, _memoization);
 
     case enums::DataUsed::value_of<"text">():
-      return apply_text(_population, _peripheral, _matches, _condition_function,
-                        _abstract_feature, _memoization);
+      return apply_text(_population, _peripheral, _matches, _abstract_feature,
+                        _memoization);
 
     default:
       assert_msg(false, "Unknown data_used: '" +
@@ -78,7 +70,6 @@ Float Aggregator::apply_categorical(
     const containers::DataFrame &_population,
     const containers::DataFrame &_peripheral,
     const std::vector<containers::Match> &_matches,
-    const std::function<bool(const containers::Match &)> &_condition_function,
     const containers::AbstractFeature &_abstract_feature,
     const rfl::Ref<Memoization> &_memoization) {
   assert_true(_abstract_feature.input_col_ < _peripheral.num_categoricals());
@@ -91,8 +82,8 @@ Float Aggregator::apply_categorical(
       return col[match.ix_input];
     };
 
-    return aggregate_matches_categorical(
-        _matches, extract_value, _condition_function, _abstract_feature);
+    return aggregate_matches_categorical(_matches, extract_value,
+                                         _abstract_feature);
   }
 
   const auto extract_value =
@@ -105,12 +96,11 @@ Float Aggregator::apply_categorical(
 
   if (is_first_last(_abstract_feature.aggregation_)) {
     return apply_first_last(_population, _peripheral, _matches, extract_value,
-                            _condition_function, _abstract_feature,
-                            _memoization);
+                            _abstract_feature, _memoization);
   }
 
-  memorize_numerical_range(_matches, extract_value, _condition_function,
-                           _abstract_feature, _memoization);
+  memorize_numerical_range(_matches, extract_value, _abstract_feature,
+                           _memoization);
 
   return aggregate_numerical_range(_memoization->numerical_begin(),
                                    _memoization->numerical_end(),
@@ -123,7 +113,6 @@ Float Aggregator::apply_discrete(
     const containers::DataFrame &_population,
     const containers::DataFrame &_peripheral,
     const std::vector<containers::Match> &_matches,
-    const std::function<bool(const containers::Match &)> &_condition_function,
     const containers::AbstractFeature &_abstract_feature,
     const rfl::Ref<Memoization> &_memoization) {
   assert_true(_abstract_feature.input_col_ < _peripheral.num_discretes());
@@ -136,12 +125,11 @@ Float Aggregator::apply_discrete(
 
   if (is_first_last(_abstract_feature.aggregation_)) {
     return apply_first_last(_population, _peripheral, _matches, extract_value,
-                            _condition_function, _abstract_feature,
-                            _memoization);
+                            _abstract_feature, _memoization);
   }
 
-  memorize_numerical_range(_matches, extract_value, _condition_function,
-                           _abstract_feature, _memoization);
+  memorize_numerical_range(_matches, extract_value, _abstract_feature,
+                           _memoization);
 
   return aggregate_numerical_range(_memoization->numerical_begin(),
                                    _memoization->numerical_end(),
@@ -153,7 +141,6 @@ Float Aggregator::apply_discrete(
 Float Aggregator::apply_not_applicable(
     const containers::DataFrame &_peripheral,
     const std::vector<containers::Match> &_matches,
-    const std::function<bool(const containers::Match &)> &_condition_function,
     const containers::AbstractFeature &_abstract_feature,
     const rfl::Ref<Memoization> &_memoization) {
   assert_true(_abstract_feature.aggregation_.value() ==
@@ -167,8 +154,8 @@ Float Aggregator::apply_not_applicable(
       return 0.0;
     };
 
-    memorize_numerical_range(_matches, extract_value, _condition_function,
-                             _abstract_feature, _memoization);
+    memorize_numerical_range(_matches, extract_value, _abstract_feature,
+                             _memoization);
 
     return aggregate_numerical_range(_memoization->numerical_begin(),
                                      _memoization->numerical_end(),
@@ -183,8 +170,8 @@ Float Aggregator::apply_not_applicable(
     return col[match.ix_input];
   };
 
-  memorize_numerical_range(_matches, extract_value, _condition_function,
-                           _abstract_feature, _memoization);
+  memorize_numerical_range(_matches, extract_value, _abstract_feature,
+                           _memoization);
 
   return aggregate_numerical_range(_memoization->numerical_begin(),
                                    _memoization->numerical_end(),
@@ -197,7 +184,6 @@ Float Aggregator::apply_numerical(
     const containers::DataFrame &_population,
     const containers::DataFrame &_peripheral,
     const std::vector<containers::Match> &_matches,
-    const std::function<bool(const containers::Match &)> &_condition_function,
     const containers::AbstractFeature &_abstract_feature,
     const rfl::Ref<Memoization> &_memoization) {
   assert_true(_abstract_feature.input_col_ < _peripheral.num_numericals());
@@ -210,12 +196,11 @@ Float Aggregator::apply_numerical(
 
   if (is_first_last(_abstract_feature.aggregation_)) {
     return apply_first_last(_population, _peripheral, _matches, extract_value,
-                            _condition_function, _abstract_feature,
-                            _memoization);
+                            _abstract_feature, _memoization);
   }
 
-  memorize_numerical_range(_matches, extract_value, _condition_function,
-                           _abstract_feature, _memoization);
+  memorize_numerical_range(_matches, extract_value, _abstract_feature,
+                           _memoization);
 
   return aggregate_numerical_range(_memoization->numerical_begin(),
                                    _memoization->numerical_end(),
@@ -228,7 +213,6 @@ Float Aggregator::apply_same_units_categorical(
     const containers::DataFrame &_population,
     const containers::DataFrame &_peripheral,
     const std::vector<containers::Match> &_matches,
-    const std::function<bool(const containers::Match &)> &_condition_function,
     const containers::AbstractFeature &_abstract_feature,
     const rfl::Ref<Memoization> &_memoization) {
   assert_true(_abstract_feature.input_col_ < _peripheral.num_categoricals());
@@ -250,12 +234,11 @@ Float Aggregator::apply_same_units_categorical(
 
   if (is_first_last(_abstract_feature.aggregation_)) {
     return apply_first_last(_population, _peripheral, _matches, extract_value,
-                            _condition_function, _abstract_feature,
-                            _memoization);
+                            _abstract_feature, _memoization);
   }
 
-  memorize_numerical_range(_matches, extract_value, _condition_function,
-                           _abstract_feature, _memoization);
+  memorize_numerical_range(_matches, extract_value, _abstract_feature,
+                           _memoization);
 
   return aggregate_numerical_range(_memoization->numerical_begin(),
                                    _memoization->numerical_end(),
@@ -268,7 +251,6 @@ Float Aggregator::apply_same_units_discrete(
     const containers::DataFrame &_population,
     const containers::DataFrame &_peripheral,
     const std::vector<containers::Match> &_matches,
-    const std::function<bool(const containers::Match &)> &_condition_function,
     const containers::AbstractFeature &_abstract_feature,
     const rfl::Ref<Memoization> &_memoization) {
   assert_true(_abstract_feature.input_col_ < _peripheral.num_discretes());
@@ -286,12 +268,11 @@ Float Aggregator::apply_same_units_discrete(
 
   if (is_first_last(_abstract_feature.aggregation_)) {
     return apply_first_last(_population, _peripheral, _matches, extract_value,
-                            _condition_function, _abstract_feature,
-                            _memoization);
+                            _abstract_feature, _memoization);
   }
 
-  memorize_numerical_range(_matches, extract_value, _condition_function,
-                           _abstract_feature, _memoization);
+  memorize_numerical_range(_matches, extract_value, _abstract_feature,
+                           _memoization);
 
   return aggregate_numerical_range(_memoization->numerical_begin(),
                                    _memoization->numerical_end(),
@@ -304,7 +285,6 @@ Float Aggregator::apply_same_units_numerical(
     const containers::DataFrame &_population,
     const containers::DataFrame &_peripheral,
     const std::vector<containers::Match> &_matches,
-    const std::function<bool(const containers::Match &)> &_condition_function,
     const containers::AbstractFeature &_abstract_feature,
     const rfl::Ref<Memoization> &_memoization) {
   assert_true(_abstract_feature.input_col_ < _peripheral.num_numericals());
@@ -322,12 +302,11 @@ Float Aggregator::apply_same_units_numerical(
 
   if (is_first_last(_abstract_feature.aggregation_)) {
     return apply_first_last(_population, _peripheral, _matches, extract_value,
-                            _condition_function, _abstract_feature,
-                            _memoization);
+                            _abstract_feature, _memoization);
   }
 
-  memorize_numerical_range(_matches, extract_value, _condition_function,
-                           _abstract_feature, _memoization);
+  memorize_numerical_range(_matches, extract_value, _abstract_feature,
+                           _memoization);
 
   return aggregate_numerical_range(_memoization->numerical_begin(),
                                    _memoization->numerical_end(),
@@ -341,7 +320,6 @@ Float Aggregator::apply_subfeatures(
     const containers::DataFrame &_peripheral,
     const containers::Features &_subfeatures,
     const std::vector<containers::Match> &_matches,
-    const std::function<bool(const containers::Match &)> &_condition_function,
     const containers::AbstractFeature &_abstract_feature,
     const rfl::Ref<Memoization> &_memoization) {
   assert_true(_abstract_feature.input_col_ < _subfeatures.size());
@@ -354,12 +332,11 @@ Float Aggregator::apply_subfeatures(
 
   if (is_first_last(_abstract_feature.aggregation_)) {
     return apply_first_last(_population, _peripheral, _matches, extract_value,
-                            _condition_function, _abstract_feature,
-                            _memoization);
+                            _abstract_feature, _memoization);
   }
 
-  memorize_numerical_range(_matches, extract_value, _condition_function,
-                           _abstract_feature, _memoization);
+  memorize_numerical_range(_matches, extract_value, _abstract_feature,
+                           _memoization);
 
   return aggregate_numerical_range(_memoization->numerical_begin(),
                                    _memoization->numerical_end(),
@@ -372,7 +349,6 @@ Float Aggregator::apply_text(
     const containers::DataFrame &_population,
     const containers::DataFrame &_peripheral,
     const std::vector<containers::Match> &_matches,
-    const std::function<bool(const containers::Match &)> &_condition_function,
     const containers::AbstractFeature &_abstract_feature,
     const rfl::Ref<Memoization> &_memoization) {
   assert_true(_peripheral.text_.size() == _peripheral.word_indices_.size());
@@ -401,12 +377,11 @@ Float Aggregator::apply_text(
 
   if (is_first_last(_abstract_feature.aggregation_)) {
     return apply_first_last(_population, _peripheral, _matches, extract_value,
-                            _condition_function, _abstract_feature,
-                            _memoization);
+                            _abstract_feature, _memoization);
   }
 
-  memorize_numerical_range(_matches, extract_value, _condition_function,
-                           _abstract_feature, _memoization);
+  memorize_numerical_range(_matches, extract_value, _abstract_feature,
+                           _memoization);
 
   return aggregate_numerical_range(_memoization->numerical_begin(),
                                    _memoization->numerical_end(),
@@ -0,0 +1,74 @@
+// Copyright 2024 Code17 GmbH
+//
+// This file is licensed under the Elastic License 2.0 (ELv2).
+// Refer to the LICENSE.txt file in the root of the repository
+// for details.
+//
+
+#include "fastprop/algorithm/CategoryBuckets.hpp"
+
+#include <algorithm>
+
+namespace fastprop {
+namespace algorithm {
+
+CategoryBuckets::CategoryBuckets(const size_t _input_col)
+    : input_col_(_input_col) {}
+
+// ----------------------------------------------------------------------------
+
+size_t CategoryBuckets::add_category(const Int _category) {
+  const auto it = std::ranges::lower_bound(
+      lookup_, _category, std::ranges::less(),
+      [](const std::pair<Int, size_t>& _p) { return _p.first; });
+
+  if (it != lookup_.end() && it->first == _category) {
+    return it->second;
+  }
+
+  const auto k = buckets_.size();
+
+  buckets_.emplace_back();
+
+  lookup_.insert(it, std::make_pair(_category, k));
+
+  return k;
+}
+
+// ----------------------------------------------------------------------------
+
+void CategoryBuckets::partition(
+    const containers::DataFrame& _peripheral,
+    const std::vector<containers::Match>& _matches) {
+  assert_true(input_col_ < _peripheral.num_categoricals());
+
+  partition(_peripheral.categorical_col(input_col_).data_, _matches);
+}
+
+// ----------------------------------------------------------------------------
+
+void CategoryBuckets::partition(
+    const Int* _categories, const std::vector<containers::Match>& _matches) {
+  for (auto& b : buckets_) {
+    b.clear();
+  }
+
+  const auto get_category = [](const std::pair<Int, size_t>& _p) {
+    return _p.first;
+  };
+
+  for (const auto& match : _matches) {
+    const auto category = _categories[match.ix_input];
+
+    const auto it = std::ranges::lower_bound(lookup_, category,
+                                             std::ranges::less(), get_category);
+
+    if (it != lookup_.end() && it->first == category) {
+      buckets_[it->second].push_back(match);
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+}  // namespace algorithm
+}  // namespace fastprop
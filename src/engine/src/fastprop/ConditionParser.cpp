@@ -11,8 +11,7 @@ namespace fastprop {
 namespace algorithm {
 // ----------------------------------------------------------------------------
 
-std::vector<std::function<bool(const containers::Match &)>>
-ConditionParser::make_condition_functions(
+std::vector<ConditionFunction> ConditionParser::make_condition_functions(
     const TableHolder &_table_holder, const std::vector<size_t> &_index,
     const std::vector<containers::AbstractFeature> &_abstract_features) {
   const auto make_function = [&_table_holder,
@@ -28,42 +27,35 @@ ConditionParser::make_condition_functions(
 
 // ----------------------------------------------------------------------------
 
-std::function<bool(const containers::Match &)>
-ConditionParser::make_apply_conditions(
+ConditionFunction ConditionParser::make_apply_conditions(
     const TableHolder &_table_holder,
     const containers::AbstractFeature &_abstract_feature) {
-  const auto conditions = parse_conditions(_table_holder, _abstract_feature);
-
-  return [conditions](const containers::Match &match) -> bool {
-    for (const auto &cond : conditions) {
-      if (!cond(match)) {
-        return false;
-      }
-    }
-
-    return true;
-  };
+  return ConditionFunction(parse_conditions(_table_holder, _abstract_feature));
 }
 
 // ----------------------------------------------------------------------------
 
-std::function<bool(const containers::Match &)>
-ConditionParser::make_categorical(const containers::DataFrame &_peripheral,
-                                  const containers::Condition &_condition) {
+ConditionFunction::Instruction ConditionParser::make_categorical(
+    const containers::DataFrame &_peripheral,
+    const containers::Condition &_condition) {
   assert_true(_condition.input_col_ < _peripheral.num_categoricals());
 
   const auto col = _peripheral.categorical_col(_condition.input_col_);
 
-  const auto category_used = _condition.category_used_;
-
-  return [col, category_used](const containers::Match &match) -> bool {
-    return (col[match.ix_input] == category_used);
-  };
+  return ConditionFunction::Instruction{
+      .kind_ = ConditionFunction::Kind::categorical,
+      .category_used_ = _condition.category_used_,
+      .categorical_input_ = col.data_,
+      .categorical_output_ = nullptr,
+      .lower_ = 0.0,
+      .upper_ = 0.0,
+      .ts_input_ = nullptr,
+      .ts_output_ = nullptr};
 }
 
 // ----------------------------------------------------------------------------
 
-std::function<bool(const containers::Match &)> ConditionParser::make_lag(
+ConditionFunction::Instruction ConditionParser::make_lag(
     const containers::DataFrame &_population,
     const containers::DataFrame &_peripheral,
     const containers::Condition &_condition) {
@@ -75,20 +67,20 @@ std::function<bool(const containers::Match &)> ConditionParser::make_lag(
 
   const auto col2 = _peripheral.time_stamp_col();
 
-  const auto lower = _condition.bound_lower_;
-
-  const auto upper = _condition.bound_upper_;
-
-  return [col1, col2, lower, upper](const containers::Match &match) -> bool {
-    return (col2[match.ix_input] + upper > col1[match.ix_output]) &&
-           (col2[match.ix_input] + lower <= col1[match.ix_output]);
-  };
+  return ConditionFunction::Instruction{
+      .kind_ = ConditionFunction::Kind::lag,
+      .category_used_ = 0,
+      .categorical_input_ = nullptr,
+      .categorical_output_ = nullptr,
+      .lower_ = _condition.bound_lower_,
+      .upper_ = _condition.bound_upper_,
+      .ts_input_ = col2.data_,
+      .ts_output_ = col1.data_};
 }
 
 // ----------------------------------------------------------------------------
 
-std::function<bool(const containers::Match &)>
-ConditionParser::make_same_units_categorical(
+ConditionFunction::Instruction ConditionParser::make_same_units_categorical(
     const containers::DataFrame &_population,
     const containers::DataFrame &_peripheral,
     const containers::Condition &_condition) {
@@ -100,15 +92,20 @@ ConditionParser::make_same_units_categorical(
 
   const auto col2 = _peripheral.categorical_col(_condition.input_col_);
 
-  return [col1, col2](const containers::Match &match) -> bool {
-    return (col1[match.ix_output] == col2[match.ix_input]);
-  };
+  return ConditionFunction::Instruction{
+      .kind_ = ConditionFunction::Kind::same_units_categorical,
+      .category_used_ = 0,
+      .categorical_input_ = col2.data_,
+      .categorical_output_ = col1.data_,
+      .lower_ = 0.0,
+      .upper_ = 0.0,
+      .ts_input_ = nullptr,
+      .ts_output_ = nullptr};
 }
 
 // ----------------------------------------------------------------------------
 
-std::vector<std::function<bool(const containers::Match &)>>
-ConditionParser::parse_conditions(
+std::vector<ConditionFunction::Instruction> ConditionParser::parse_conditions(
     const TableHolder &_table_holder,
     const containers::AbstractFeature &_abstract_feature) {
   assert_true(_table_holder.main_tables().size() ==
@@ -125,7 +122,7 @@ ConditionParser::parse_conditions(
 
   const auto parse = [_abstract_feature, &population,
                       &peripheral](const containers::Condition &cond)
-      -> std::function<bool(const containers::Match &)> {
+      -> ConditionFunction::Instruction {
     assert_true(cond.peripheral_ == _abstract_feature.peripheral_);
     return ConditionParser::parse_single_condition(population, peripheral,
                                                    cond);
@@ -137,8 +134,7 @@ ConditionParser::parse_conditions(
 
 // ----------------------------------------------------------------------------
 
-std::function<bool(const containers::Match &)>
-ConditionParser::parse_single_condition(
+ConditionFunction::Instruction ConditionParser::parse_single_condition(
     const containers::DataFrame &_population,
     const containers::DataFrame &_peripheral,
     const containers::Condition &_condition) {
@@ -155,7 +151,7 @@ ConditionParser::parse_single_condition(
     default:
       throw_unless(false,
                    "Unknown condition: '" + _condition.data_used_.name() + "'");
-      return [](const containers::Match &) { return true; };
+      return ConditionFunction::Instruction{};
   }
 }
 
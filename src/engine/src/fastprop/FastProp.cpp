@@ -12,10 +12,16 @@
 #include "fastprop/algorithm/RSquared.hpp"
 #include "fastprop/algorithm/TableHolderParams.hpp"
 #include "helpers/Matchmaker.hpp"
+#include "logging/ScopedTimer.hpp"
 #include "transpilation/HumanReadableSQLGenerator.hpp"
 
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <numeric>
 #include <random>
+#include <string>
+#include <variant>
 
 namespace fastprop {
 namespace algorithm {
@@ -54,9 +60,9 @@ void FastProp::build_row(
     const TableHolder &_table_holder,
     const std::vector<containers::Features> &_subfeatures,
     const std::vector<size_t> &_index,
-    const std::vector<std::function<bool(const containers::Match &)>>
-        &_condition_functions,
+    const std::vector<ConditionFunction> &_condition_functions,
     const size_t _rownum, const rfl::Ref<Memoization> &_memoization,
+    MatchBuckets *_match_buckets, std::vector<containers::Match> *_selected,
     Float *_row) const {
   assert_true(_condition_functions.size() == _index.size());
 
@@ -64,11 +70,22 @@ void FastProp::build_row(
 
   assert_true(all_matches.size() == _table_holder.peripheral_tables().size());
 
+  _match_buckets->partition(_table_holder, all_matches);
+
   assert_true(_table_holder.main_tables().size() ==
               _table_holder.peripheral_tables().size());
 
   assert_true(_subfeatures.size() <= _table_holder.peripheral_tables().size());
 
+  const auto is_same_selection = [](const containers::AbstractFeature &_af1,
+                                    const containers::AbstractFeature &_af2) {
+    return _af1.peripheral_ == _af2.peripheral_ &&
+           _af1.conditions_ == _af2.conditions_;
+  };
+
+  // The feature the matches in _selected have been selected for.
+  const containers::AbstractFeature *selected_for = nullptr;
+
   for (size_t i = 0; i < _index.size(); ++i) {
     const auto ix = _index.at(i);
 
@@ -89,12 +106,24 @@ void FastProp::build_row(
                           ? _subfeatures.at(abstract_feature.peripheral_)
                           : std::optional<containers::Features>();
 
-    const auto &matches = all_matches.at(abstract_feature.peripheral_);
+    // Features with a lag or categorical condition only need to look at the
+    // matches in their bucket.
+    const auto &matches = _match_buckets->matches(i, all_matches);
 
     const auto &condition_function = _condition_functions.at(i);
 
+    // Consecutive features often only differ by their aggregation or their
+    // column, so we only select the matches again when the conditions
+    // change.
+    if (!condition_function.is_trivial() &&
+        !(selected_for && is_same_selection(*selected_for, abstract_feature))) {
+      condition_function.select(matches, _selected);
+      selected_for = &abstract_feature;
+    }
+
     const auto value = Aggregator::apply_aggregation(
-        population, peripheral, subf, matches, condition_function,
+        population, peripheral, subf,
+        condition_function.is_trivial() ? matches : *_selected,
         abstract_feature, _memoization);
 
     _row[i] = (std::isnan(value) || std::isinf(value)) ? 0.0 : value;
@@ -103,12 +132,13 @@ void FastProp::build_row(
 
 // ----------------------------------------------------------------------------
 
-void FastProp::build_rows(const TransformParams &_params,
-                          const std::vector<containers::Features> &_subfeatures,
-                          const std::shared_ptr<std::vector<size_t>> &_rownums,
-                          const size_t _thread_num,
-                          std::atomic<size_t> *_num_completed,
-                          containers::Features *_features) const {
+void FastProp::build_rows(
+    const TransformParams &_params, const TableHolder &_table_holder,
+    const std::vector<containers::Features> &_subfeatures,
+    const std::vector<ConditionFunction> &_condition_functions,
+    const std::shared_ptr<std::vector<size_t>> &_rownums,
+    const size_t _thread_num, std::atomic<size_t> *_num_completed,
+    containers::Features *_features) const {
   if (_features->size() == 0) {
     return;
   }
@@ -116,34 +146,22 @@ void FastProp::build_rows(const TransformParams &_params,
   const auto rownums =
       make_rownums(_thread_num, _params.population_.nrows(), _rownums);
 
-  const auto population_view =
-      containers::DataFrameView(_params.population_, rownums);
+  // Matchmaking and aggregation are interleaved row by row, so we can only
+  // time them together.
+  logging::ScopedTimer timer("fastprop.build_rows", "fastprop");
 
-  const auto make_staging_table_colname =
-      [](const std::string &_colname) -> std::string {
-    return transpilation::HumanReadableSQLGenerator()
-        .make_staging_table_colname(_colname);
-  };
+  timer.add_rows(rownums->size());
 
-  const auto params = TableHolderParams{
-      .feature_container_ = std::nullopt,
-      .make_staging_table_colname_ = make_staging_table_colname,
-      .peripheral_ = _params.peripheral_,
-      .peripheral_names_ = peripheral(),
-      .placeholder_ = placeholder(),
-      .population_ = population_view,
-      .row_index_container_ = std::nullopt,
-      .word_index_container_ = _params.word_indices_};
+  const auto memoization = rfl::Ref<Memoization>::make();
 
-  const auto table_holder = TableHolder(params);
+  auto selected = std::vector<containers::Match>();
 
-  const auto memoization = rfl::Ref<Memoization>::make();
+  auto match_buckets = MatchBuckets(
+      abstract_features(), _params.index_, hyperparameters().delta_t(),
+      hyperparameters().max_lag(), _table_holder.peripheral_tables().size());
 
   constexpr size_t log_iter = 5000;
 
-  const auto condition_functions = ConditionParser::make_condition_functions(
-      table_holder, _params.index_, abstract_features());
-
   const auto nrows = _rownums ? _rownums->size() : _params.population_.nrows();
 
   assert_true(_features->size() == _params.index_.size());
@@ -172,8 +190,9 @@ void FastProp::build_rows(const TransformParams &_params,
                    ", log_iter: " + std::to_string(log_iter) +
                    ", cache.size(): " + std::to_string(cache.size()));
 
-    build_row(table_holder, _subfeatures, _params.index_, condition_functions,
-              (*rownums)[i], memoization, &cache[ncols * (i % log_iter)]);
+    build_row(_table_holder, _subfeatures, _params.index_,
+              _condition_functions, (*rownums)[i], memoization,
+              &match_buckets, &selected, &cache[ncols * (i % log_iter)]);
   }
 
   const size_t begin = rownums->size() > log_iter
@@ -189,7 +208,8 @@ void FastProp::build_rows(const TransformParams &_params,
 
 std::vector<containers::Features> FastProp::build_subfeatures(
     const TransformParams &_params,
-    const std::shared_ptr<std::vector<size_t>> &_rownums) const {
+    const std::shared_ptr<std::vector<size_t>> &_rownums,
+    TableHolderCache *_table_holder_cache) const {
   assert_true(placeholder().joined_tables().size() <= subfeatures().size());
 
   std::vector<containers::Features> features;
@@ -228,8 +248,8 @@ std::vector<containers::Features> FastProp::build_subfeatures(
                                         .temp_dir_ = _params.temp_dir_,
                                         .word_indices_ = new_word_indices};
 
-    const auto f =
-        subfeatures().at(i)->transform(params, subfeature_rownums, true);
+    const auto f = subfeatures().at(i)->transform(
+        params, subfeature_rownums, true, _table_holder_cache);
 
     const auto f_expanded = expand_subfeatures(
         f, subfeature_index, subfeatures().at(i)->num_features());
@@ -269,7 +289,8 @@ void FastProp::cache_to_features(const std::vector<size_t> &_rownums,
 
 std::vector<Float> FastProp::calc_r_squared(
     const FitParams &_params,
-    const std::shared_ptr<std::vector<size_t>> &_rownums) const {
+    const std::shared_ptr<std::vector<size_t>> &_rownums,
+    TableHolderCache *_table_holder_cache) const {
   assert_true(_rownums);
 
   auto r_squared = std::vector<Float>();
@@ -291,7 +312,8 @@ std::vector<Float> FastProp::calc_r_squared(
                                         .temp_dir_ = _params.temp_dir_,
                                         .word_indices_ = _params.word_indices_};
 
-    const auto features = transform(params, _rownums, false);
+    const auto features =
+        transform(params, _rownums, false, _table_holder_cache);
 
     const auto r =
         RSquared::calculate(_params.population_.targets_, features, *_rownums);
@@ -494,26 +516,17 @@ void FastProp::fit(const FitParams &_params, const bool _as_subfeatures) {
 
   const auto rownums = sample_from_population(_params.population_.nrows());
 
-  const auto population_view =
-      containers::DataFrameView(_params.population_, rownums);
-
-  const auto make_staging_table_colname =
-      [](const std::string &_colname) -> std::string {
-    return transpilation::HumanReadableSQLGenerator()
-        .make_staging_table_colname(_colname);
-  };
+  // The TableHolders are only cached while the features are fitted and
+  // selected, so every batch in calc_r_squared and every transform of the
+  // subfeatures therein reuses them. The cache is destroyed when fit
+  // returns and is never seen by transform outside of fit.
+  auto table_holder_cache = TableHolderCache();
 
-  const auto params = TableHolderParams{
-      .feature_container_ = std::nullopt,
-      .make_staging_table_colname_ = make_staging_table_colname,
-      .peripheral_ = _params.peripheral_,
-      .peripheral_names_ = peripheral(),
-      .placeholder_ = placeholder(),
-      .population_ = population_view,
-      .row_index_container_ = std::nullopt,
-      .word_index_container_ = _params.word_indices_};
+  const auto table_holder_ptr =
+      make_table_holder(_params.population_, _params.peripheral_,
+                        _params.word_indices_, rownums, &table_holder_cache);
 
-  const auto table_holder = TableHolder(params);
+  const auto &table_holder = *table_holder_ptr;
 
   extract_schemas(table_holder);
 
@@ -547,7 +560,8 @@ void FastProp::fit(const FitParams &_params, const bool _as_subfeatures) {
   }
 
   if (!_as_subfeatures) {
-    abstract_features_ = select_features(_params, rownums);
+    abstract_features_ =
+        select_features(_params, rownums, &table_holder_cache);
   }
 }
 
@@ -1149,6 +1163,62 @@ bool FastProp::is_numerical(const enums::Aggregation _agg) const {
 
 // ----------------------------------------------------------------------------
 
+std::string FastProp::make_fingerprint(
+    const containers::DataFrame &_population,
+    const std::vector<containers::DataFrame> &_peripheral,
+    const std::shared_ptr<std::vector<size_t>> &_rownums) const {
+  const auto describe_column = [](const auto &_col) -> std::string {
+    const auto data = std::visit(
+        [](const auto &_ptr) -> const void * { return _ptr.get(); }, _col.ptr_);
+    return _col.name_ + "@" +
+           std::to_string(reinterpret_cast<std::uintptr_t>(data)) + "(" +
+           std::to_string(_col.nrows_) + ")";
+  };
+
+  const auto describe_columns = [describe_column](const auto &_cols) {
+    auto description = std::string();
+    for (const auto &col : _cols) {
+      description += describe_column(col) + ",";
+    }
+    return description;
+  };
+
+  const auto describe = [describe_columns](
+                            const containers::DataFrame &_df) -> std::string {
+    return _df.name() + "(" + std::to_string(_df.nrows()) + "){" +
+           describe_columns(_df.categoricals_) +
+           describe_columns(_df.discretes_) +
+           describe_columns(_df.join_keys_) +
+           describe_columns(_df.numericals_) +
+           describe_columns(_df.targets_) + describe_columns(_df.text_) +
+           describe_columns(_df.time_stamps_) + "}";
+  };
+
+  auto fingerprint = describe(_population);
+
+  for (const auto &df : _peripheral) {
+    fingerprint += "," + describe(df);
+  }
+
+  if (!_rownums) {
+    return fingerprint + ";all";
+  }
+
+  // We combine the hashes of the individual rownums using the mixing
+  // function from boost::hash_combine.
+  size_t seed = _rownums->size();
+
+  for (const auto rownum : *_rownums) {
+    seed ^= std::hash<size_t>()(rownum) + 0x9e3779b97f4a7c15ull + (seed << 6) +
+            (seed >> 2);
+  }
+
+  return fingerprint + ";" + std::to_string(_rownums->size()) + ";" +
+         std::to_string(seed);
+}
+
+// ----------------------------------------------------------------------------
+
 std::vector<std::vector<containers::Match>> FastProp::make_matches(
     const TableHolder &_table_holder, const size_t _rownum) const {
   const auto make_match = [](const size_t ix_input, const size_t ix_output) {
@@ -1397,6 +1467,55 @@ std::shared_ptr<std::vector<size_t>> FastProp::make_subfeature_rownums(
 
 // ----------------------------------------------------------------------------
 
+std::shared_ptr<const TableHolder> FastProp::make_table_holder(
+    const containers::DataFrame &_population,
+    const std::vector<containers::DataFrame> &_peripheral,
+    const helpers::WordIndexContainer &_word_indices,
+    const std::shared_ptr<std::vector<size_t>> &_rownums,
+    TableHolderCache *_table_holder_cache) const {
+  // All threads share the same TableHolder, so it must contain the rows of
+  // all threads.
+  const auto make = [this, &_population, &_peripheral, &_word_indices,
+                     &_rownums]() -> TableHolder {
+    auto rownums = _rownums;
+
+    if (!rownums) {
+      rownums = std::make_shared<std::vector<size_t>>(_population.nrows());
+      std::iota(rownums->begin(), rownums->end(), 0);
+    }
+
+    const auto population_view =
+        containers::DataFrameView(_population, rownums);
+
+    const auto make_staging_table_colname =
+        [](const std::string &_colname) -> std::string {
+      return transpilation::HumanReadableSQLGenerator()
+          .make_staging_table_colname(_colname);
+    };
+
+    const auto params = TableHolderParams{
+        .feature_container_ = std::nullopt,
+        .make_staging_table_colname_ = make_staging_table_colname,
+        .peripheral_ = _peripheral,
+        .peripheral_names_ = peripheral(),
+        .placeholder_ = placeholder(),
+        .population_ = population_view,
+        .row_index_container_ = std::nullopt,
+        .word_index_container_ = _word_indices};
+
+    return TableHolder(params);
+  };
+
+  if (!_table_holder_cache) {
+    return std::make_shared<const TableHolder>(make());
+  }
+
+  return _table_holder_cache->get(
+      make_fingerprint(_population, _peripheral, _rownums), _rownums, make);
+}
+
+// ----------------------------------------------------------------------------
+
 std::shared_ptr<std::vector<size_t>> FastProp::make_rownums(
     const size_t _thread_num, const size_t _nrows,
     const std::shared_ptr<std::vector<size_t>> &_rownums) const {
@@ -1480,7 +1599,8 @@ std::shared_ptr<std::vector<size_t>> FastProp::sample_from_population(
 std::shared_ptr<const std::vector<containers::AbstractFeature>>
 FastProp::select_features(
     const FitParams &_params,
-    const std::shared_ptr<std::vector<size_t>> &_rownums) const {
+    const std::shared_ptr<std::vector<size_t>> &_rownums,
+    TableHolderCache *_table_holder_cache) const {
   if (abstract_features().size() <= hyperparameters().num_features()) {
     if (_params.logger_) {
       _params.logger_->log("Trained features. Progress: 100%.");
@@ -1489,7 +1609,8 @@ FastProp::select_features(
     return abstract_features_;
   }
 
-  const auto r_squared = calc_r_squared(_params, _rownums);
+  const auto r_squared =
+      calc_r_squared(_params, _rownums, _table_holder_cache);
 
   const auto threshold = calc_threshold(r_squared);
 
@@ -1525,18 +1646,21 @@ bool FastProp::skip_first_last(const enums::Aggregation _agg,
 // ----------------------------------------------------------------------------
 
 void FastProp::spawn_threads(
-    const TransformParams &_params,
+    const TransformParams &_params, const TableHolder &_table_holder,
     const std::vector<containers::Features> &_subfeatures,
     const std::shared_ptr<std::vector<size_t>> &_rownums,
     containers::Features *_features) const {
   auto num_completed = std::atomic<size_t>(0);
 
-  const auto execute_task = [this, &_params, _subfeatures, _rownums,
-                             &num_completed,
+  const auto condition_functions = ConditionParser::make_condition_functions(
+      _table_holder, _params.index_, abstract_features());
+
+  const auto execute_task = [this, &_params, &_table_holder, &_subfeatures,
+                             &condition_functions, _rownums, &num_completed,
                              _features](const size_t _thread_num) {
     try {
-      build_rows(_params, _subfeatures, _rownums, _thread_num, &num_completed,
-                 _features);
+      build_rows(_params, _table_holder, _subfeatures, condition_functions,
+                 _rownums, _thread_num, &num_completed, _features);
     } catch (std::exception &e) {
       if (_thread_num == 0) {
         throw std::runtime_error(e.what());
@@ -1595,12 +1719,22 @@ containers::Features FastProp::transform(
     const TransformParams &_params,
     const std::shared_ptr<std::vector<size_t>> &_rownums,
     const bool _as_subfeatures) const {
+  return transform(_params, _rownums, _as_subfeatures, nullptr);
+}
+
+// ----------------------------------------------------------------------------
+
+containers::Features FastProp::transform(
+    const TransformParams &_params,
+    const std::shared_ptr<std::vector<size_t>> &_rownums,
+    const bool _as_subfeatures, TableHolderCache *_table_holder_cache) const {
   if (_params.population_.nrows() == 0) {
     throw std::runtime_error(
         "Population table needs to contain at least some data!");
   }
 
-  const auto subfeatures = build_subfeatures(_params, _rownums);
+  const auto subfeatures =
+      build_subfeatures(_params, _rownums, _table_holder_cache);
 
   if (_params.logger_) {
     const auto msg = _as_subfeatures ? "FastProp: Building subfeatures..."
@@ -1612,7 +1746,18 @@ containers::Features FastProp::transform(
   auto features = containers::Features(
       _params.population_.nrows(), _params.index_.size(), _params.temp_dir_);
 
-  spawn_threads(_params, subfeatures, _rownums, &features);
+  if (_params.index_.size() == 0) {
+    return features;
+  }
+
+  const auto table_holder = [&]() {
+    logging::ScopedTimer timer("fastprop.make_table_holder", "fastprop");
+    return make_table_holder(_params.population_, _params.peripheral_,
+                             _params.word_indices_, _rownums,
+                             _table_holder_cache);
+  }();
+
+  spawn_threads(_params, *table_holder, subfeatures, _rownums, &features);
 
   return features;
 }
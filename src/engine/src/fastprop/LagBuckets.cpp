@@ -0,0 +1,114 @@
+// Copyright 2024 Code17 GmbH
+//
+// This file is licensed under the Elastic License 2.0 (ELv2).
+// Refer to the LICENSE.txt file in the root of the repository
+// for details.
+//
+
+#include "fastprop/algorithm/LagBuckets.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace fastprop {
+namespace algorithm {
+
+LagBuckets::LagBuckets(const Float _delta_t, const size_t _max_lag)
+    : buckets_(_max_lag), delta_t_(_delta_t) {
+  assert_true(_delta_t > 0.0);
+  assert_true(_max_lag > 0);
+}
+
+// ----------------------------------------------------------------------------
+
+std::optional<size_t> LagBuckets::find_bucket(
+    const containers::Condition& _condition) const {
+  if (_condition.data_used_.value() != enums::DataUsed::value_of<"lag">()) {
+    return std::nullopt;
+  }
+
+  return find_bucket(_condition.bound_lower_, _condition.bound_upper_);
+}
+
+// ----------------------------------------------------------------------------
+
+std::optional<size_t> LagBuckets::find_bucket(const Float _bound_lower,
+                                              const Float _bound_upper) const {
+  const auto k = std::round(_bound_lower / delta_t_);
+
+  if (!(k >= 0.0 && k < static_cast<Float>(buckets_.size()))) {
+    return std::nullopt;
+  }
+
+  const auto ix = static_cast<size_t>(k);
+
+  if (bound(ix) != _bound_lower || bound(ix + 1) != _bound_upper) {
+    return std::nullopt;
+  }
+
+  return ix;
+}
+
+// ----------------------------------------------------------------------------
+
+void LagBuckets::partition(const containers::DataFrame& _population,
+                           const containers::DataFrame& _peripheral,
+                           const std::vector<containers::Match>& _matches) {
+  if (_matches.size() == 0) {
+    partition(nullptr, nullptr, _matches);
+    return;
+  }
+
+  assert_true(_population.num_time_stamps() > 0);
+
+  assert_true(_peripheral.num_time_stamps() > 0);
+
+  partition(_population.time_stamp_col().data_,
+            _peripheral.time_stamp_col().data_, _matches);
+}
+
+// ----------------------------------------------------------------------------
+
+void LagBuckets::partition(const Float* _ts_output, const Float* _ts_input,
+                           const std::vector<containers::Match>& _matches) {
+  for (auto& b : buckets_) {
+    b.clear();
+  }
+
+  const auto max_k = static_cast<Float>(buckets_.size() - 1);
+
+  for (const auto& match : _matches) {
+    const auto ts1 = _ts_output[match.ix_output];
+
+    const auto ts2 = _ts_input[match.ix_input];
+
+    if (std::isnan(ts1) || std::isnan(ts2)) {
+      continue;
+    }
+
+    // The division is only an estimate, rounding may place us in a
+    // neighbouring bucket. But since ts2 + bound(k) is monotonic in k, we
+    // can find the right bucket by walking from there.
+    const auto estimate = std::floor((ts1 - ts2) / delta_t_);
+
+    auto k = std::isnan(estimate)
+                 ? static_cast<size_t>(0)
+                 : static_cast<size_t>(std::clamp(estimate, 0.0, max_k));
+
+    while (k > 0 && !(ts2 + bound(k) <= ts1)) {
+      --k;
+    }
+
+    while (k + 1 < buckets_.size() && ts2 + bound(k + 1) <= ts1) {
+      ++k;
+    }
+
+    if (ts2 + bound(k + 1) > ts1 && ts2 + bound(k) <= ts1) {
+      buckets_[k].push_back(match);
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+}  // namespace algorithm
+}  // namespace fastprop
@@ -0,0 +1,123 @@
+// Copyright 2024 Code17 GmbH
+//
+// This file is licensed under the Elastic License 2.0 (ELv2).
+// Refer to the LICENSE.txt file in the root of the repository
+// for details.
+//
+
+#include "fastprop/algorithm/MatchBuckets.hpp"
+
+namespace fastprop {
+namespace algorithm {
+
+MatchBuckets::MatchBuckets(
+    const std::vector<containers::AbstractFeature>& _abstract_features,
+    const std::vector<size_t>& _index, const Float _delta_t,
+    const size_t _max_lag, const size_t _num_peripheral)
+    : category_buckets_(_num_peripheral),
+      category_bucket_ix_(_index.size()),
+      lag_buckets_(_num_peripheral),
+      lag_bucket_ix_(_index.size()) {
+  // Only used to identify the lag conditions.
+  auto lags = std::optional<LagBuckets>();
+
+  if (_delta_t > 0.0 && _max_lag > 0) {
+    lags.emplace(_delta_t, _max_lag);
+  }
+
+  const auto find_category_buckets = [this](const size_t _peripheral,
+                                            const size_t _input_col) {
+    auto& buckets = category_buckets_.at(_peripheral);
+    for (size_t j = 0; j < buckets.size(); ++j) {
+      if (buckets[j].input_col() == _input_col) {
+        return j;
+      }
+    }
+    buckets.emplace_back(_input_col);
+    return buckets.size() - 1;
+  };
+
+  for (size_t i = 0; i < _index.size(); ++i) {
+    assert_true(_index[i] < _abstract_features.size());
+
+    const auto& abstract_feature = _abstract_features[_index[i]];
+
+    const auto p = abstract_feature.peripheral_;
+
+    assert_true(p < _num_peripheral);
+
+    peripheral_.push_back(p);
+
+    for (const auto& cond : abstract_feature.conditions_) {
+      if (lags && lags->find_bucket(cond)) {
+        if (!lag_buckets_.at(p)) {
+          lag_buckets_.at(p).emplace(_delta_t, _max_lag);
+        }
+
+        lag_bucket_ix_[i] = lags->find_bucket(cond);
+
+        break;
+      }
+
+      if (cond.data_used_.value() ==
+          enums::DataUsed::value_of<"categorical">()) {
+        const auto j = find_category_buckets(p, cond.input_col_);
+
+        const auto k =
+            category_buckets_.at(p).at(j).add_category(cond.category_used_);
+
+        category_bucket_ix_[i] = std::make_pair(j, k);
+
+        break;
+      }
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+const std::vector<containers::Match>& MatchBuckets::matches(
+    const size_t _i,
+    const std::vector<std::vector<containers::Match>>& _all_matches) const {
+  assert_true(_i < peripheral_.size());
+
+  const auto p = peripheral_[_i];
+
+  if (lag_bucket_ix_[_i]) {
+    return lag_buckets_.at(p)->bucket(*lag_bucket_ix_[_i]);
+  }
+
+  if (category_bucket_ix_[_i]) {
+    const auto [j, k] = *category_bucket_ix_[_i];
+    return category_buckets_.at(p).at(j).bucket(k);
+  }
+
+  return _all_matches.at(p);
+}
+
+// ----------------------------------------------------------------------------
+
+void MatchBuckets::partition(
+    const TableHolder& _table_holder,
+    const std::vector<std::vector<containers::Match>>& _all_matches) {
+  assert_true(_all_matches.size() == lag_buckets_.size());
+
+  assert_true(_all_matches.size() == category_buckets_.size());
+
+  for (size_t p = 0; p < _all_matches.size(); ++p) {
+    if (lag_buckets_[p]) {
+      lag_buckets_[p]->partition(_table_holder.main_tables().at(p).df(),
+                                 _table_holder.peripheral_tables().at(p),
+                                 _all_matches[p]);
+    }
+
+    for (auto& buckets : category_buckets_[p]) {
+      buckets.partition(_table_holder.peripheral_tables().at(p),
+                        _all_matches[p]);
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+}  // namespace algorithm
+}  // namespace fastprop
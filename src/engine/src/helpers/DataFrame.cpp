@@ -11,6 +11,7 @@
 
 #include <range/v3/view/concat.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <vector>
 
@@ -135,30 +136,12 @@ std::pair<const size_t*, const size_t*> DataFrame::find(
   assert_true(indices_[_ix_join_key]);
 
   if (std::holds_alternative<InMemoryIndex>(*indices_[_ix_join_key])) {
-    const auto& idx = std::get<InMemoryIndex>(*indices_[_ix_join_key]);
-
-    const auto it = idx.find(_join_key);
-
-    if (it == idx.end()) {
-      return std::make_pair<const size_t*, const size_t*>(nullptr, nullptr);
-    }
-
-    return std::make_pair(it->second.data(),
-                          it->second.data() + it->second.size());
+    return std::get<InMemoryIndex>(*indices_[_ix_join_key]).find(_join_key);
   }
 
   if (std::holds_alternative<MemoryMappedIndex>(*indices_[_ix_join_key])) {
-    const auto& idx = std::get<MemoryMappedIndex>(*indices_[_ix_join_key]);
-
-    const auto opt = idx[_join_key];
-
-    if (!opt) {
-      return std::make_pair<const size_t*, const size_t*>(nullptr, nullptr);
-    }
-
-    const auto begin = opt->data();
-
-    return std::make_pair(begin, begin + opt->size());
+    return std::get<MemoryMappedIndex>(*indices_[_ix_join_key])
+        .find(_join_key);
   }
 
   assert_true(false);
@@ -306,8 +289,16 @@ std::shared_ptr<tsindex::Index> DataFrame::make_ts_index(
 
   const auto memory = upper_ts[0] - lower_ts.begin()[0];
 
-  const auto unique_join_keys =
-      *_params.population_join_keys_ | std::ranges::to<std::set>();
+  // A sorted vector yields the same order as a std::set, but avoids
+  // allocating a node for every row in the population table.
+  auto unique_join_keys =
+      *_params.population_join_keys_ | std::ranges::to<std::vector>();
+
+  std::ranges::sort(unique_join_keys);
+
+  const auto [first, last] = std::ranges::unique(unique_join_keys);
+
+  unique_join_keys.erase(first, last);
 
   const auto find_rownums =
       [this, _ix_join_key](const Int jk) -> fct::Range<const size_t*> {
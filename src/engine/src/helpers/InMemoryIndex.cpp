@@ -0,0 +1,208 @@
+// Copyright 2024 Code17 GmbH
+//
+// This file is licensed under the Elastic License 2.0 (ELv2).
+// Refer to the LICENSE.txt file in the root of the repository
+// for details.
+//
+
+#include "helpers/InMemoryIndex.hpp"
+
+#include "debug/assert_true.hpp"
+#include "multithreading/parallel_for.hpp"
+
+#include <algorithm>
+
+namespace helpers {
+
+size_t InMemoryIndex::add_key(const Int _key) {
+  const auto [it, inserted] = key_nums_.try_emplace(_key, begins_.size());
+
+  if (inserted) {
+    begins_.push_back(0);
+    ends_.push_back(0);
+    limits_.push_back(0);
+  }
+
+  return it->second;
+}
+
+// ----------------------------------------------------------------------------
+
+void InMemoryIndex::append(const Int* _keys, const size_t _nrows) {
+  assert_true(_nrows >= nrows_);
+
+  if (_nrows == nrows_) {
+    return;
+  }
+
+  const auto begin = nrows_;
+
+  // The first append and appends that at least double the number of rows
+  // pay for a rebuild, all others are written into the segments.
+  if (_nrows - begin >= begin) {
+    for (size_t i = begin; i < _nrows; ++i) {
+      if (_keys[i] >= 0) {
+        add_key(_keys[i]);
+      }
+    }
+
+    rebuild(_keys, begin, _nrows);
+
+    nrows_ = _nrows;
+
+    return;
+  }
+
+  for (size_t i = begin; i < _nrows; ++i) {
+    if (_keys[i] < 0) {
+      continue;
+    }
+
+    const auto k = add_key(_keys[i]);
+
+    if (ends_[k] == limits_[k]) {
+      grow_segment(k);
+    }
+
+    rownums_[ends_[k]++] = i;
+  }
+
+  if (2 * num_abandoned_ > rownums_.size()) {
+    rebuild(_keys, _nrows, _nrows);
+  }
+
+  nrows_ = _nrows;
+}
+
+// ----------------------------------------------------------------------------
+
+size_t InMemoryIndex::calc_num_threads(const size_t _num_new_rows,
+                                       const size_t _num_keys) {
+  const auto max_by_rows =
+      std::max(static_cast<size_t>(1), _num_new_rows / MIN_ROWS_PER_THREAD);
+
+  const auto max_by_keys = std::max(
+      static_cast<size_t>(1),
+      _num_new_rows / std::max(static_cast<size_t>(1), _num_keys));
+
+  return std::min(
+      {multithreading::default_num_threads(), max_by_rows, max_by_keys});
+}
+
+// ----------------------------------------------------------------------------
+
+void InMemoryIndex::grow_segment(const size_t _k) {
+  const auto size = ends_[_k] - begins_[_k];
+
+  const auto capacity = std::max(static_cast<size_t>(1), 2 * size);
+
+  // The last segment can simply be extended.
+  if (limits_[_k] == rownums_.size()) {
+    rownums_.resize(begins_[_k] + capacity);
+    limits_[_k] = rownums_.size();
+    return;
+  }
+
+  const auto new_begin = rownums_.size();
+
+  rownums_.resize(new_begin + capacity);
+
+  std::copy(rownums_.begin() + begins_[_k], rownums_.begin() + ends_[_k],
+            rownums_.begin() + new_begin);
+
+  num_abandoned_ += limits_[_k] - begins_[_k];
+
+  begins_[_k] = new_begin;
+
+  ends_[_k] = new_begin + size;
+
+  limits_[_k] = rownums_.size();
+}
+
+// ----------------------------------------------------------------------------
+
+void InMemoryIndex::rebuild(const Int* _keys, const size_t _begin,
+                            const size_t _end) {
+  // The new rows are sorted by a counting sort on the local key numbers.
+  // Because the new row numbers are greater than all existing ones, the rows
+  // of every key remain sorted when the new rows are placed behind the
+  // existing ones.
+
+  const auto num_new_rows = _end - _begin;
+
+  const auto num_keys = begins_.size();
+
+  const auto num_threads = calc_num_threads(num_new_rows, num_keys);
+
+  // positions[t * num_keys + k] first holds the number of new rows with key
+  // number k in the chunk processed by thread t and is then turned into the
+  // position at which thread t writes the next row with key number k.
+  auto positions = std::vector<size_t>(num_threads * num_keys);
+
+  const auto count = [&](const size_t _b, const size_t _e,
+                         const size_t _thread_num) {
+    auto* counts = positions.data() + _thread_num * num_keys;
+    for (size_t i = _begin + _b; i < _begin + _e; ++i) {
+      if (_keys[i] >= 0) {
+        ++counts[key_nums_.find(_keys[i])->second];
+      }
+    }
+  };
+
+  multithreading::parallel_for(num_new_rows, num_threads, count);
+
+  auto offsets = std::vector<size_t>(num_keys + 1);
+
+  for (size_t k = 0; k < num_keys; ++k) {
+    auto pos = offsets[k] + ends_[k] - begins_[k];
+
+    for (size_t t = 0; t < num_threads; ++t) {
+      const auto c = positions[t * num_keys + k];
+      positions[t * num_keys + k] = pos;
+      pos += c;
+    }
+
+    offsets[k + 1] = pos;
+  }
+
+  // ------------------------------------------------------------------------
+
+  auto rownums = std::vector<size_t>(offsets.back());
+
+  const auto copy_old_rows = [&](const size_t _b, const size_t _e,
+                                 const size_t) {
+    for (size_t k = _b; k < _e; ++k) {
+      std::copy(rownums_.begin() + begins_[k], rownums_.begin() + ends_[k],
+                rownums.begin() + offsets[k]);
+    }
+  };
+
+  multithreading::parallel_for(num_keys, num_threads, copy_old_rows);
+
+  const auto scatter = [&](const size_t _b, const size_t _e,
+                           const size_t _thread_num) {
+    auto* pos = positions.data() + _thread_num * num_keys;
+    for (size_t i = _begin + _b; i < _begin + _e; ++i) {
+      if (_keys[i] >= 0) {
+        rownums[pos[key_nums_.find(_keys[i])->second]++] = i;
+      }
+    }
+  };
+
+  multithreading::parallel_for(num_new_rows, num_threads, scatter);
+
+  // ------------------------------------------------------------------------
+
+  for (size_t k = 0; k < num_keys; ++k) {
+    begins_[k] = offsets[k];
+    ends_[k] = offsets[k + 1];
+    limits_[k] = offsets[k + 1];
+  }
+
+  num_abandoned_ = 0;
+
+  rownums_ = std::move(rownums);
+}
+
+// ----------------------------------------------------------------------------
+}  // namespace helpers
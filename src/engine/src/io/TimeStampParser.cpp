@@ -0,0 +1,261 @@
+// Copyright 2024 Code17 GmbH
+//
+// This file is licensed under the Elastic License 2.0 (ELv2).
+// Refer to the LICENSE.txt file in the root of the repository
+// for details.
+//
+
+#include "io/TimeStampParser.hpp"
+
+#include <Poco/DateTime.h>
+#include <Poco/DateTimeFormatter.h>
+#include <Poco/DateTimeParser.h>
+#include <Poco/Timestamp.h>
+
+namespace io {
+
+TimeStampParser::TimeStampParser(const std::vector<std::string>& _time_formats)
+    : time_formats_(_time_formats) {
+  for (const auto& fmt : _time_formats) {
+    formats_.push_back(Format{.format_ = fmt, .tokens_ = compile(fmt)});
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+std::optional<std::vector<TimeStampParser::Token>> TimeStampParser::compile(
+    const std::string& _format) {
+  std::vector<Token> tokens;
+
+  std::string seen;
+
+  for (size_t i = 0; i < _format.size(); ++i) {
+    if (_format[i] != '%') {
+      tokens.push_back(Token{.is_field_ = false, .char_ = _format[i]});
+      continue;
+    }
+
+    if (++i == _format.size()) {
+      return std::nullopt;
+    }
+
+    const char c = _format[i];
+
+    if (std::string_view("YmdHMSiFsz").find(c) == std::string_view::npos) {
+      return std::nullopt;
+    }
+
+    // Fields that set the same component of the time stamp would make the
+    // result depend on the order of evaluation, so we leave them to Poco.
+    const bool is_duplicate =
+        seen.find(c) != std::string::npos ||
+        (std::string_view("iFs").find(c) != std::string_view::npos &&
+         seen.find_first_of("iFs") != std::string::npos) ||
+        (std::string_view("Ss").find(c) != std::string_view::npos &&
+         seen.find_first_of("Ss") != std::string::npos);
+
+    if (is_duplicate) {
+      return std::nullopt;
+    }
+
+    seen += c;
+
+    tokens.push_back(Token{.is_field_ = true, .char_ = c});
+  }
+
+  return tokens;
+}
+
+// ----------------------------------------------------------------------------
+
+std::int64_t TimeStampParser::days_from_civil(const std::int64_t _year,
+                                              const std::int64_t _month,
+                                              const std::int64_t _day) {
+  // See http://howardhinnant.github.io/date_algorithms.html#days_from_civil.
+  const auto y = (_month <= 2) ? _year - 1 : _year;
+  const auto era = (y >= 0 ? y : y - 399) / 400;
+  const auto yoe = y - era * 400;
+  const auto doy = (153 * (_month > 2 ? _month - 3 : _month + 9) + 2) / 5 +
+                   _day - 1;
+  const auto doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + doe - 719468;
+}
+
+// ----------------------------------------------------------------------------
+
+std::pair<Float, bool> TimeStampParser::parse(
+    const std::string_view _str) const {
+  const auto begin = _str.find_first_not_of("\t\v\f\r\n ");
+
+  if (begin == std::string_view::npos) {
+    return std::make_pair(0.0, false);
+  }
+
+  const auto end = _str.find_last_not_of("\t\v\f\r\n ") + 1;
+
+  const auto trimmed = _str.substr(begin, end - begin);
+
+  for (const auto& fmt : formats_) {
+    const auto val = fmt.tokens_ ? parse_tokens(*fmt.tokens_, trimmed)
+                                 : parse_poco(fmt.format_, trimmed);
+
+    if (val) {
+      return std::make_pair(*val, true);
+    }
+  }
+
+  return std::make_pair(0.0, false);
+}
+
+// ----------------------------------------------------------------------------
+
+std::optional<Float> TimeStampParser::parse_poco(const std::string& _format,
+                                                 const std::string_view _str) {
+  const auto str = std::string(_str);
+
+  int utc = Poco::DateTimeFormatter::UTC;
+
+  Poco::DateTime date_time;
+
+  if (!Poco::DateTimeParser::tryParse(_format, str, date_time, utc)) {
+    return std::nullopt;
+  }
+
+  const auto time_stamp = date_time.timestamp();
+
+  if (Poco::DateTimeFormatter::format(time_stamp, _format) != str) {
+    return std::nullopt;
+  }
+
+  return static_cast<Float>(time_stamp.epochMicroseconds()) / 1.0e6;
+}
+
+// ----------------------------------------------------------------------------
+
+std::optional<Float> TimeStampParser::parse_tokens(
+    const std::vector<Token>& _tokens, const std::string_view _str) {
+  std::int64_t year = 0;
+  std::int64_t month = 1;
+  std::int64_t day = 1;
+  std::int64_t hour = 0;
+  std::int64_t minute = 0;
+  std::int64_t second = 0;
+  std::int64_t microsecond = 0;
+
+  size_t pos = 0;
+
+  const auto read_char = [&_str, &pos](const char _c) {
+    if (pos >= _str.size() || _str[pos] != _c) {
+      return false;
+    }
+    ++pos;
+    return true;
+  };
+
+  // Poco formats all of these fields with leading zeros, so we require
+  // exactly _n digits.
+  const auto read_digits = [&_str, &pos](const size_t _n,
+                                         std::int64_t* _val) {
+    if (pos + _n > _str.size()) {
+      return false;
+    }
+    *_val = 0;
+    for (size_t i = pos; i < pos + _n; ++i) {
+      if (_str[i] < '0' || _str[i] > '9') {
+        return false;
+      }
+      *_val = *_val * 10 + (_str[i] - '0');
+    }
+    pos += _n;
+    return true;
+  };
+
+  for (const auto& token : _tokens) {
+    bool success = false;
+
+    if (!token.is_field_) {
+      success = read_char(token.char_);
+    } else {
+      switch (token.char_) {
+        case 'Y':
+          success = read_digits(4, &year);
+          break;
+
+        case 'm':
+          success = read_digits(2, &month);
+          break;
+
+        case 'd':
+          success = read_digits(2, &day);
+          break;
+
+        case 'H':
+          success = read_digits(2, &hour);
+          break;
+
+        case 'M':
+          success = read_digits(2, &minute);
+          break;
+
+        case 'S':
+          success = read_digits(2, &second);
+          break;
+
+        case 'i':
+          success = read_digits(3, &microsecond);
+          microsecond *= 1000;
+          break;
+
+        case 'F':
+          success = read_digits(6, &microsecond);
+          break;
+
+        case 's':
+          success = read_digits(2, &second) && read_char('.') &&
+                    read_digits(6, &microsecond);
+          break;
+
+        case 'z':
+          // Poco formats the UTC time zone differential as 'Z'.
+          success = read_char('Z');
+          break;
+
+        default:
+          break;
+      }
+    }
+
+    if (!success) {
+      return std::nullopt;
+    }
+  }
+
+  if (pos != _str.size()) {
+    return std::nullopt;
+  }
+
+  constexpr std::int64_t days_in_month[] = {31, 28, 31, 30, 31, 30,
+                                            31, 31, 30, 31, 30, 31};
+
+  if (month < 1 || month > 12) {
+    return std::nullopt;
+  }
+
+  const bool is_leap_year =
+      (year % 4 == 0 && year % 100 != 0) || (year % 400 == 0);
+
+  const auto max_day =
+      days_in_month[month - 1] + ((month == 2 && is_leap_year) ? 1 : 0);
+
+  if (day < 1 || day > max_day || hour > 23 || minute > 59 || second > 59) {
+    return std::nullopt;
+  }
+
+  const auto seconds = days_from_civil(year, month, day) * 86400 +
+                       hour * 3600 + minute * 60 + second;
+
+  return static_cast<Float>(seconds * 1000000 + microsecond) / 1.0e6;
+}
+
+// ----------------------------------------------------------------------------
+}  // namespace io
@@ -0,0 +1,140 @@
+// Copyright 2024 Code17 GmbH
+//
+// This file is licensed under the Elastic License 2.0 (ELv2).
+// Refer to the LICENSE.txt file in the root of the repository
+// for details.
+//
+
+#include "logging/Tracer.hpp"
+
+#include <rfl/json/write.hpp>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+
+namespace logging {
+
+Tracer::Tracer()
+    : begin_(std::chrono::steady_clock::now()), dropped_events_(0) {}
+
+// ----------------------------------------------------------------------------
+
+void Tracer::add_to_counter(const std::string& _name, const size_t _value) {
+  std::lock_guard<std::mutex> lock(mtx_);
+  counters_[_name] += _value;
+}
+
+// ----------------------------------------------------------------------------
+
+void Tracer::clear() {
+  std::lock_guard<std::mutex> lock(mtx_);
+  counters_.clear();
+  dropped_events_ = 0;
+  events_.clear();
+  stages_.clear();
+}
+
+// ----------------------------------------------------------------------------
+
+Tracer& Tracer::global() {
+  static Tracer tracer;
+  return tracer;
+}
+
+// ----------------------------------------------------------------------------
+
+std::int64_t Tracer::now() const {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - begin_)
+      .count();
+}
+
+// ----------------------------------------------------------------------------
+
+size_t Tracer::peak_rss_kb() {
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+  return static_cast<size_t>(usage.ru_maxrss);
+}
+
+// ----------------------------------------------------------------------------
+
+void Tracer::record(const std::string& _name, const std::string& _category,
+                    const std::int64_t _begin, const size_t _rows,
+                    const size_t _bytes) {
+  const auto dur = now() - _begin;
+
+  const auto peak_rss = peak_rss_kb();
+
+  const auto args =
+      Args{.rows = _rows, .bytes = _bytes, .peak_rss_kb = peak_rss};
+
+  auto event = Event{.name = _name,
+                     .cat = _category,
+                     .ph = rfl::Literal<"X">(),
+                     .ts = _begin,
+                     .dur = dur,
+                     .pid = static_cast<int>(getpid()),
+                     .tid = thread_id(),
+                     .args = args};
+
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  if (events_.size() == MAX_EVENTS) {
+    events_.pop_front();
+    ++dropped_events_;
+  }
+
+  events_.emplace_back(std::move(event));
+
+  auto it = stages_.find(_name);
+
+  if (it == stages_.end()) {
+    it = stages_
+             .emplace(_name, Stage{.count = 0,
+                                   .total_us = 0,
+                                   .max_us = 0,
+                                   .rows = 0,
+                                   .bytes = 0,
+                                   .peak_rss_kb = 0})
+             .first;
+  }
+
+  auto& stage = it->second;
+  stage.count() += 1;
+  stage.total_us() += dur;
+  stage.max_us() = std::max(stage.max_us(), dur);
+  stage.rows() += _rows;
+  stage.bytes() += _bytes;
+  stage.peak_rss_kb() = std::max(stage.peak_rss_kb(), peak_rss);
+}
+
+// ----------------------------------------------------------------------------
+
+size_t Tracer::thread_id() {
+  static std::atomic<size_t> next_id = 0;
+  thread_local const size_t id = next_id++;
+  return id;
+}
+
+// ----------------------------------------------------------------------------
+
+std::string Tracer::to_json() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  const auto trace =
+      Trace{.trace_events = std::vector<Event>(events_.begin(), events_.end()),
+            .display_time_unit = "ms",
+            .stages = stages_,
+            .counters = counters_,
+            .dropped_events = dropped_events_};
+
+  return rfl::json::write(trace);
+}
+
+// ----------------------------------------------------------------------------
+}  // namespace logging
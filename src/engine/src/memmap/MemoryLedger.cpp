@@ -0,0 +1,51 @@
+// Copyright 2024 Code17 GmbH
+//
+// This file is licensed under the Elastic License 2.0 (ELv2).
+// Refer to the LICENSE.txt file in the root of the repository
+// for details.
+//
+
+#include "memmap/MemoryLedger.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace memmap {
+
+MemoryLedger& MemoryLedger::global() {
+  static MemoryLedger ledger;
+  return ledger;
+}
+
+// ----------------------------------------------------------------------------
+
+size_t MemoryLedger::resident_bytes() {
+  auto file = std::ifstream("/proc/self/status");
+
+  size_t rss_kb = 0;
+
+  std::string line;
+
+  while (std::getline(file, line)) {
+    const bool is_anon = line.starts_with("RssAnon:");
+
+    if (!is_anon && !line.starts_with("VmRSS:")) {
+      continue;
+    }
+
+    auto stream = std::istringstream(line.substr(line.find(':') + 1));
+
+    stream >> rss_kb;
+
+    // RssAnon follows VmRSS, so it overrides it, if it exists.
+    if (is_anon) {
+      break;
+    }
+  }
+
+  return rss_kb * 1024;
+}
+
+// ----------------------------------------------------------------------------
+}  // namespace memmap
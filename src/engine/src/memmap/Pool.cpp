@@ -8,6 +8,7 @@
 #include "memmap/Pool.hpp"
 
 #include "debug/assert_msg.hpp"
+#include "memmap/MemoryLedger.hpp"
 
 #include <Poco/File.h>
 #include <Poco/TemporaryFile.h>
@@ -34,11 +35,14 @@ Pool::Pool(const std::string& _temp_dir)
   std::tie(path_data_, fd_data_) = create_file(_temp_dir);
 
   resize_pool(1000);
+
+  MemoryLedger::global().add_pool();
 }
 
 // ----------------------------------------------------------------------------
 
 Pool::~Pool() {
+  MemoryLedger::global().remove_pool(num_pages_ * (page_size_ + sizeof(Page)));
   unmap();
   remove_file(fd_data_, path_data_);
   remove_file(fd_pages_, path_pages_);
@@ -58,6 +62,14 @@ size_t Pool::allocate_block(const size_t _block_size,
                             const size_t _current_page) {
   assert_true(_block_size > 0);
 
+  // The current block is already large enough. Note that this must not be
+  // treated as an extension by zero or fewer pages, because the pages
+  // behind the current block might not be free.
+  if (_current_page != NOT_ALLOCATED &&
+      _block_size <= pages_[_current_page].block_size_) {
+    return _current_page;
+  }
+
   const bool extend_current_block =
       current_block_can_be_extended(_block_size, _current_page);
 
@@ -142,10 +154,6 @@ bool Pool::current_block_can_be_extended(const size_t _block_size,
     return false;
   }
 
-  if (_block_size <= pages_[_current_page].block_size_) [[unlikely]] {
-    return true;
-  }
-
   const auto is_free = [](const Page& _page) -> bool {
     return !_page.is_allocated_;
   };
@@ -264,6 +272,7 @@ void Pool::resize_pool(const size_t _num_pages) {
   init_pages(num_pages_, _num_pages);
   num_pages_ = _num_pages;
   free_blocks_tracker_.increase_pool_size(num_pages_);
+  MemoryLedger::global().grow_pool(additional_bytes);
 }
 
 // ----------------------------------------------------------------------------
@@ -7,6 +7,10 @@
 
 #include "metrics/AUC.hpp"
 
+#include "multithreading/parallel_for.hpp"
+#include "multithreading/parallel_sort.hpp"
+
+#include <algorithm>
 #include <numeric>
 
 namespace metrics {
@@ -104,60 +108,41 @@ std::vector<Float> AUC::calc_rate(const std::vector<Float>& _raw,
 
 // ----------------------------------------------------------------------------
 
-std::pair<std::vector<Float>, Float> AUC::calc_true_positives_uncompressed(
+std::tuple<std::vector<Float>, std::vector<Float>, Float> AUC::compress(
     const std::vector<std::pair<Float, Float>>& _pairs) const {
-  auto true_positives_uncompressed = std::vector<Float>(nrows());
-
-  for (size_t i = 0; i < nrows(); ++i) {
-    true_positives_uncompressed.at(i) = std::get<1>(_pairs.at(i));
-  }
-
-  std::partial_sum(true_positives_uncompressed.begin(),
-                   true_positives_uncompressed.end(),
-                   true_positives_uncompressed.begin());
-
-  const Float all_positives = true_positives_uncompressed.back();
-
-  std::for_each(true_positives_uncompressed.begin(),
-                true_positives_uncompressed.end(),
-                [all_positives](Float& val) { val = all_positives - val; });
-
-  return std::make_pair(true_positives_uncompressed, all_positives);
-}
+  const auto add_target = [](const Float _init,
+                             const std::pair<Float, Float>& _p) {
+    return _init + std::get<1>(_p);
+  };
 
-// ----------------------------------------------------------------------------
+  const Float all_positives =
+      std::accumulate(_pairs.begin(), _pairs.end(), 0.0, add_target);
 
-std::pair<std::vector<Float>, std::vector<Float>> AUC::compress(
-    const std::vector<std::pair<Float, Float>>& _pairs,
-    const std::vector<Float>& _true_positives_uncompressed,
-    const Float _all_positives) const {
-  auto true_positives = std::vector<Float>({_all_positives});
+  auto true_positives = std::vector<Float>({all_positives});
 
   auto predicted_negative = std::vector<Float>({0.0});
 
-  for (size_t i = 0; i < _pairs.size();) {
-    const auto it1 = _pairs.begin() + i;
+  Float cumulative_positives = 0.0;
 
-    const auto prediction_is_greater = [it1](const std::pair<Float, Float>& p) {
-      return std::get<0>(p) > std::get<0>(*it1);
-    };
-
-    const auto it2 = std::find_if(it1, _pairs.end(), prediction_is_greater);
+  for (size_t i = 0; i < _pairs.size();) {
+    const auto prediction = std::get<0>(_pairs[i]);
 
-    const auto dist = static_cast<size_t>(std::distance(it1, it2));
+    auto end = i;
 
-    assert_true(dist > 0);
-    assert_true(i + dist - 1 < _true_positives_uncompressed.size());
+    for (; end < _pairs.size() && !(std::get<0>(_pairs[end]) > prediction);
+         ++end) {
+      cumulative_positives += std::get<1>(_pairs[end]);
+    }
 
-    true_positives.push_back(_true_positives_uncompressed.at(i + dist - 1));
+    true_positives.push_back(all_positives - cumulative_positives);
 
     predicted_negative.push_back(predicted_negative.back() +
-                                 static_cast<Float>(dist));
+                                 static_cast<Float>(end - i));
 
-    i += dist;
+    i = end;
   }
 
-  return std::make_pair(true_positives, predicted_negative);
+  return std::make_tuple(true_positives, predicted_negative, all_positives);
 }
 
 // ----------------------------------------------------------------------------
@@ -201,40 +186,44 @@ std::pair<Float, Float> AUC::find_min_max(const size_t _j) const {
 
 // ----------------------------------------------------------------------------
 
-void AUC::make_default_values(
-    std::vector<std::vector<Float>>* _true_positive_arr,
-    std::vector<std::vector<Float>>* _false_positive_arr,
-    std::vector<std::vector<Float>>* _lift_arr,
-    std::vector<std::vector<Float>>* _precision_arr,
-    std::vector<std::vector<Float>>* _proportion_arr, Float* _auc) const {
-  _true_positive_arr->push_back({1.0, 0.0});
+void AUC::make_default_values(std::vector<Float>* _true_positive_rate,
+                              std::vector<Float>* _false_positive_rate,
+                              std::vector<Float>* _lift,
+                              std::vector<Float>* _precision,
+                              std::vector<Float>* _proportion,
+                              Float* _auc) const {
+  *_true_positive_rate = {1.0, 0.0};
 
-  _false_positive_arr->push_back({0.0, 1.0});
+  *_false_positive_rate = {0.0, 1.0};
 
-  _lift_arr->push_back({1.0, 1.0});
+  *_lift = {1.0, 1.0};
 
-  _precision_arr->push_back({0.0, 0.0});
+  *_precision = {0.0, 0.0};
 
-  _proportion_arr->push_back({0.0, 1.0});
+  *_proportion = {0.0, 1.0};
 
   *_auc = 0.5;
 }
 
 // ----------------------------------------------------------------------------
 
-std::vector<std::pair<Float, Float>> AUC::make_pairs(const size_t _j) const {
+std::vector<std::pair<Float, Float>> AUC::make_pairs(
+    const size_t _j, const size_t _num_threads) const {
   std::vector<std::pair<Float, Float>> pairs(nrows());
 
   for (size_t i = 0; i < pairs.size(); ++i) {
-    pairs.at(i) = std::make_pair(yhat(i, _j), y(i, _j));
+    pairs[i] = std::make_pair(yhat(i, _j), y(i, _j));
   }
 
+  // The order of pairs with the same prediction does not matter, because
+  // they are summarized by compress(...), so we need no stable sort.
   const auto sort_by_prediction = [](const std::pair<Float, Float>& p1,
                                      const std::pair<Float, Float>& p2) {
     return (std::get<0>(p1) < std::get<0>(p2));
   };
 
-  std::stable_sort(pairs.begin(), pairs.end(), sort_by_prediction);
+  multithreading::parallel_sort(pairs.begin(), pairs.end(), _num_threads,
+                                sort_by_prediction);
 
   return pairs;
 }
@@ -245,81 +234,90 @@ typename AUC::ResultType AUC::score(const Features _yhat, const Features _y) {
   impl_.set_data(_yhat, _y);
 
   if (nrows() < 1) {
-    std::runtime_error(
+    throw std::runtime_error(
         "There needs to be at least one row for the AUC score to "
         "work!");
   }
 
-  std::vector<Float> auc(ncols());
+  auto auc = std::vector<Float>(ncols());
 
-  auto true_positive_arr = std::vector<std::vector<Float>>();
+  auto true_positive_arr = std::vector<std::vector<Float>>(ncols());
 
-  auto false_positive_arr = std::vector<std::vector<Float>>();
+  auto false_positive_arr = std::vector<std::vector<Float>>(ncols());
 
-  auto lift_arr = std::vector<std::vector<Float>>();
+  auto lift_arr = std::vector<std::vector<Float>>(ncols());
 
-  auto precision_arr = std::vector<std::vector<Float>>();
+  auto precision_arr = std::vector<std::vector<Float>>(ncols());
 
-  auto proportion_arr = std::vector<std::vector<Float>>();
+  auto proportion_arr = std::vector<std::vector<Float>>(ncols());
 
-  for (size_t j = 0; j < ncols(); ++j) {
-    const auto [yhat_min, yhat_max] = find_min_max(j);
+  // The targets are scored concurrently and the threads that are left over
+  // are used for sorting.
+  const auto num_threads = multithreading::default_num_threads();
 
-    if (yhat_min == yhat_max) {
-      make_default_values(&true_positive_arr, &false_positive_arr, &lift_arr,
-                          &precision_arr, &proportion_arr, &auc.at(j));
+  const auto num_threads_per_column =
+      std::max(static_cast<size_t>(1), num_threads / ncols());
 
-      continue;
+  const auto score_columns = [&](const size_t _begin, const size_t _end,
+                                 const size_t) {
+    for (size_t j = _begin; j < _end; ++j) {
+      score_column(j, num_threads_per_column, &true_positive_arr[j],
+                   &false_positive_arr[j], &lift_arr[j], &precision_arr[j],
+                   &proportion_arr[j], &auc[j]);
     }
+  };
 
-    const auto pairs = make_pairs(j);
-
-    const auto [true_positives_uncompressed, all_positives] =
-        calc_true_positives_uncompressed(pairs);
-
-    const auto [true_positives, predicted_negative] =
-        compress(pairs, true_positives_uncompressed, all_positives);
-
-    const auto false_positives =
-        calc_false_positives(true_positives, predicted_negative);
-
-    const Float all_negatives = static_cast<Float>(nrows()) - all_positives;
+  multithreading::parallel_for(ncols(), num_threads, score_columns);
 
-    const auto true_positive_rate = calc_rate(true_positives, all_positives);
+  return f_auc(auc) * f_fpr(false_positive_arr) * f_tpr(true_positive_arr) *
+         f_lift(lift_arr) * f_precision(precision_arr) *
+         f_proportion(proportion_arr);
+}
 
-    const auto false_positive_rate = calc_rate(false_positives, all_negatives);
+// ----------------------------------------------------------------------------
 
-    const auto precision = calc_precision(true_positives, predicted_negative);
+void AUC::score_column(const size_t _j, const size_t _num_threads,
+                       std::vector<Float>* _true_positive_rate,
+                       std::vector<Float>* _false_positive_rate,
+                       std::vector<Float>* _lift,
+                       std::vector<Float>* _precision,
+                       std::vector<Float>* _proportion, Float* _auc) const {
+  const auto [yhat_min, yhat_max] = find_min_max(_j);
+
+  if (yhat_min == yhat_max) {
+    make_default_values(_true_positive_rate, _false_positive_rate, _lift,
+                        _precision, _proportion, _auc);
+    return;
+  }
 
-    const auto [lift, proportion] =
-        calc_lift(precision, predicted_negative, all_negatives);
+  const auto [true_positives, predicted_negative, all_positives] =
+      compress(make_pairs(_j, _num_threads));
 
-    auc.at(j) = calc_auc(true_positive_rate, false_positive_rate);
+  const auto false_positives =
+      calc_false_positives(true_positives, predicted_negative);
 
-    const auto tpr_downsampled = downsample(true_positive_rate);
+  const Float all_negatives = static_cast<Float>(nrows()) - all_positives;
 
-    const auto fpr_downsampled = downsample(false_positive_rate);
+  const auto true_positive_rate = calc_rate(true_positives, all_positives);
 
-    const auto lift_downsampled = downsample(lift);
+  const auto false_positive_rate = calc_rate(false_positives, all_negatives);
 
-    const auto precision_downsampled = downsample(precision);
+  const auto precision = calc_precision(true_positives, predicted_negative);
 
-    const auto proportion_downsampled = downsample(proportion);
+  const auto [lift, proportion] =
+      calc_lift(precision, predicted_negative, all_negatives);
 
-    false_positive_arr.push_back(fpr_downsampled);
+  *_auc = calc_auc(true_positive_rate, false_positive_rate);
 
-    true_positive_arr.push_back(tpr_downsampled);
+  *_true_positive_rate = downsample(true_positive_rate);
 
-    lift_arr.push_back(lift_downsampled);
+  *_false_positive_rate = downsample(false_positive_rate);
 
-    precision_arr.push_back(precision_downsampled);
+  *_lift = downsample(lift);
 
-    proportion_arr.push_back(proportion_downsampled);
-  }
+  *_precision = downsample(precision);
 
-  return f_auc(auc) * f_fpr(false_positive_arr) * f_tpr(true_positive_arr) *
-         f_lift(lift_arr) * f_precision(precision_arr) *
-         f_proportion(proportion_arr);
+  *_proportion = downsample(proportion);
 }
 
 // ----------------------------------------------------------------------------
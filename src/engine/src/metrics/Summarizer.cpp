@@ -7,9 +7,11 @@
 
 #include "metrics/Summarizer.hpp"
 
+#include "multithreading/parallel_for.hpp"
 #include "strings/StringHasher.hpp"
 
 #include <cmath>
+#include <limits>
 #include <numeric>
 
 namespace metrics {
@@ -98,84 +100,15 @@ Summarizer::calc_categorical_column_plot(
 }
 // ----------------------------------------------------------------------------
 
-std::vector<std::vector<std::vector<Float>>>
-Summarizer::calculate_average_targets(
-    const std::vector<Float>& _minima, const std::vector<Float>& _step_sizes,
-    const std::vector<size_t>& _actual_num_bins,
-    const std::vector<std::vector<Int>>& _feature_densities,
+typename Summarizer::f_feature_correlations
+Summarizer::calculate_feature_correlations(
     const Features& _features, const size_t _nrows, const size_t _ncols,
     const std::vector<const Float*>& _targets) {
-  if (_targets.size() == 0) {
-    return {};
-  }
-
-  assert_true(_actual_num_bins.size() == _step_sizes.size());
-
-  assert_true(_actual_num_bins.size() == _ncols);
-
-  const auto num_targets = _targets.size();
-
-  auto average_targets = std::vector<std::vector<std::vector<Float>>>(_ncols);
-
-  std::for_each(average_targets.begin(), average_targets.end(),
-                [num_targets](std::vector<std::vector<Float>>& vec) {
-                  vec.resize(num_targets);
-                });
-
-  for (size_t j = 0; j < _feature_densities.size(); ++j) {
-    for (size_t k = 0; k < num_targets; ++k) {
-      average_targets[j][k].resize(_actual_num_bins[j]);
-    }
-  }
-
-  auto counts = average_targets;
-
-  assert_true(_feature_densities.size() == _ncols);
-
-  for (size_t j = 0; j < _ncols; ++j) {
-    if (_actual_num_bins[j] == 0) {
-      continue;
-    }
-
-    for (size_t i = 0; i < _nrows; ++i) {
-      const auto feat = get(i, j, _features);
-
-      if (std::isinf(feat) || std::isnan(feat)) {
-        continue;
-      }
-
-      const auto bin =
-          identify_bin(_actual_num_bins[j], _step_sizes[j], feat, _minima[j]);
-
-      assert_true(bin < _feature_densities[j].size());
-
-      for (size_t k = 0; k < average_targets[j].size(); ++k) {
-        assert_true(bin < average_targets[j][k].size());
+  // Without any bins, the histograms are skipped.
+  const auto summary =
+      calculate_feature_summary(_features, _nrows, _ncols, 0, _targets);
 
-        const auto tar = _targets[k][i];
-
-        if (std::isinf(tar) || std::isnan(tar)) {
-          continue;
-        }
-
-        average_targets[j][k][bin] += tar;
-
-        ++counts[j][k][bin];
-      }
-    }
-  }
-
-  for (size_t j = 0; j < _ncols; ++j) {
-    for (size_t k = 0; k < average_targets[j].size(); ++k) {
-      for (size_t bin = 0; bin < average_targets[j][k].size(); ++bin) {
-        if (counts[j][k][bin] > 0) {
-          average_targets[j][k][bin] /= counts[j][k][bin];
-        }
-      }
-    }
-  }
-
-  return average_targets;
+  return f_feature_correlations(summary.get<f_feature_correlations>());
 }
 
 // ----------------------------------------------------------------------------
@@ -183,224 +116,64 @@ Summarizer::calculate_average_targets(
 typename Summarizer::FeaturePlots Summarizer::calculate_feature_plots(
     const Features& _features, const size_t _nrows, const size_t _ncols,
     const size_t _num_bins, const std::vector<const Float*>& _targets) {
-  if (_num_bins > 100000) {
-    throw std::runtime_error("Number of bins cannot be greater than 100000!");
-  }
-
-  auto minima = std::vector<Float>(0);
-
-  auto maxima = std::vector<Float>(0);
-
-  find_min_and_max(_features, _nrows, _ncols, &minima, &maxima);
-
-  // Note that actual_num_bins can be smaller than num_bins.
-  auto step_sizes = std::vector<Float>(0);
-
-  auto actual_num_bins = std::vector<size_t>(0);
-
-  calculate_step_sizes_and_num_bins(minima, maxima,
-                                    static_cast<Float>(_num_bins), &step_sizes,
-                                    &actual_num_bins);
+  const auto summary = calculate_feature_summary(_features, _nrows, _ncols,
+                                                 _num_bins, _targets);
 
-  assert_true(step_sizes.size() == _ncols);
-  assert_true(actual_num_bins.size() == _ncols);
-
-  auto feature_densities = std::vector<std::vector<Int>>(_ncols);
-
-  for (size_t j = 0; j < _ncols; ++j) {
-    feature_densities[j].resize(actual_num_bins[j]);
-  }
-
-  for (size_t i = 0; i < _nrows; ++i) {
-    for (size_t j = 0; j < _ncols; ++j) {
-      const auto val = get(i, j, _features);
-
-      if (actual_num_bins[j] == 0 || std::isinf(val) || std::isnan(val)) {
-        continue;
-      }
-
-      auto bin =
-          identify_bin(actual_num_bins[j], step_sizes[j], val, minima[j]);
-
-      ++feature_densities[j][bin];
-    }
-  }
-
-  const auto labels =
-      calculate_labels(minima, step_sizes, actual_num_bins, feature_densities,
-                       _features, _nrows, _ncols);
-
-  const auto average_targets = calculate_average_targets(
-      minima, step_sizes, actual_num_bins, feature_densities, _features, _nrows,
-      _ncols, _targets);
-
-  return f_average_targets(average_targets) *
-         f_feature_densities(feature_densities) * f_labels(labels);
+  return f_average_targets(summary.get<f_average_targets>()) *
+         f_feature_densities(summary.get<f_feature_densities>()) *
+         f_labels(summary.get<f_labels>());
 }
 
 // ----------------------------------------------------------------------------
 
-typename Summarizer::f_feature_correlations
-Summarizer::calculate_feature_correlations(
+typename Summarizer::FeatureSummary Summarizer::calculate_feature_summary(
     const Features& _features, const size_t _nrows, const size_t _ncols,
-    const std::vector<const Float*>& _targets) {
-  assert_true(_ncols == _features.size());
-
-  const auto t_ncols = _targets.size();
-
-  std::vector<Float> sum_yhat(_ncols);
-
-  std::vector<Float> sum_yhat_yhat(_ncols);
-
-  std::vector<Float> sum_y(t_ncols);
-
-  std::vector<Float> sum_y_y(t_ncols);
-
-  std::vector<Float> sum_yhat_y(_ncols * t_ncols);
-
-  for (size_t i = 0; i < _nrows; ++i)
-    for (size_t j = 0; j < _ncols; ++j) sum_yhat[j] += get(i, j, _features);
-
-  for (size_t i = 0; i < _nrows; ++i)
-    for (size_t j = 0; j < _ncols; ++j)
-      sum_yhat_yhat[j] += get(i, j, _features) * get(i, j, _features);
-
-  for (size_t k = 0; k < t_ncols; ++k)
-    for (size_t i = 0; i < _nrows; ++i) sum_y[k] += _targets[k][i];
-
-  for (size_t k = 0; k < t_ncols; ++k)
-    for (size_t i = 0; i < _nrows; ++i)
-      sum_y_y[k] += _targets[k][i] * _targets[k][i];
-
-  for (size_t k = 0; k < t_ncols; ++k)
-    for (size_t i = 0; i < _nrows; ++i)
-      for (size_t j = 0; j < _ncols; ++j)
-        get(j, k, t_ncols, &sum_yhat_y) +=
-            get(i, j, _features) * _targets[k][i];
-
-  const auto n = static_cast<Float>(_nrows);
-
-  auto feature_correlations =
-      std::vector<std::vector<Float>>(_ncols, std::vector<Float>(t_ncols));
-
-  for (size_t j = 0; j < _ncols; ++j)
-    for (size_t k = 0; k < t_ncols; ++k) {
-      const Float var_yhat =
-          sum_yhat_yhat[j] / n - (sum_yhat[j] / n) * (sum_yhat[j] / n);
-
-      const Float var_y = sum_y_y[k] / n - (sum_y[k] / n) * (sum_y[k] / n);
-
-      const Float cov_y_yhat = get(j, k, t_ncols, &sum_yhat_y) / n -
-                               (sum_yhat[j] / n) * (sum_y[k] / n);
-
-      feature_correlations[j][k] = cov_y_yhat / sqrt(var_yhat * var_y);
-
-      if (std::isnan(feature_correlations[j][k]) ||
-          std::isinf(feature_correlations[j][k])) {
-        feature_correlations[j][k] = 0.0;
-      }
-    }
-
-  return f_feature_correlations(feature_correlations);
-}
-
-// ----------------------------------------------------------------------------
-
-std::vector<std::vector<Float>> Summarizer::calculate_labels(
-    const std::vector<Float>& _minima, const std::vector<Float>& _step_sizes,
-    const std::vector<size_t>& _actual_num_bins,
-    const std::vector<std::vector<Int>>& _feature_densities,
-    const Features& _features, const size_t _nrows, const size_t _ncols) {
-  auto labels = std::vector<std::vector<Float>>(_ncols);
-
-  for (size_t j = 0; j < _ncols; ++j) {
-    labels[j].resize(_actual_num_bins[j]);
+    const size_t _num_bins, const std::vector<const Float*>& _targets) {
+  if (_num_bins > 100000) {
+    throw std::runtime_error("Number of bins cannot be greater than 100000!");
   }
 
-  for (size_t i = 0; i < _nrows; ++i) {
-    for (size_t j = 0; j < _ncols; ++j) {
-      const auto val = get(i, j, _features);
-
-      if (_actual_num_bins[j] == 0 || std::isinf(val) || std::isnan(val)) {
-        continue;
-      }
+  assert_true(_ncols == _features.size());
 
-      auto bin =
-          identify_bin(_actual_num_bins[j], _step_sizes[j], val, _minima[j]);
+  const auto num_targets = _targets.size();
 
-      labels[j][bin] += val;
-    }
-  }
+  auto sum_y = std::vector<Float>(num_targets);
 
-  for (size_t j = 0; j < _ncols; ++j) {
-    assert_true(labels[j].size() == _feature_densities[j].size());
+  auto sum_y_y = std::vector<Float>(num_targets);
 
-    for (size_t bin = 0; bin < labels[j].size(); ++bin) {
-      if (_feature_densities[j][bin] > 0) {
-        labels[j][bin] /= static_cast<Float>(_feature_densities[j][bin]);
-      } else {
-        labels[j][bin] =
-            _minima[j] + (static_cast<Float>(bin) + 0.5) * _step_sizes[j];
-      }
+  for (size_t k = 0; k < num_targets; ++k) {
+    for (size_t i = 0; i < _nrows; ++i) {
+      sum_y[k] += _targets[k][i];
+      sum_y_y[k] += _targets[k][i] * _targets[k][i];
     }
   }
 
-  return labels;
-}
-
-// ----------------------------------------------------------------------------
-
-void Summarizer::calculate_step_sizes_and_num_bins(
-    const std::vector<Float>& _minima, const std::vector<Float>& _maxima,
-    const Float _num_bins, std::vector<Float>* _step_sizes,
-    std::vector<size_t>* _actual_num_bins) {
-  assert_true(_minima.size() == _maxima.size());
-
-  _step_sizes->resize(_minima.size());
+  auto feature_correlations = std::vector<std::vector<Float>>(_ncols);
 
-  _actual_num_bins->resize(_minima.size());
-
-  for (size_t j = 0; j < _minima.size(); ++j) {
-    const auto min = _minima[j];
+  auto feature_densities = std::vector<std::vector<Int>>(_ncols);
 
-    const auto max = _maxima[j];
+  auto labels = std::vector<std::vector<Float>>(_ncols);
 
-    if (min >= max || std::isinf(min) || std::isnan(min) || std::isinf(max) ||
-        std::isnan(max)) {
-      continue;
+  auto average_targets = std::vector<std::vector<std::vector<Float>>>(
+      num_targets > 0 ? _ncols : 0);
+
+  const auto summarize_features = [&](const size_t _begin, const size_t _end,
+                                      const size_t) {
+    for (size_t j = _begin; j < _end; ++j) {
+      assert_true(_features[j].size() >= _nrows);
+      summarize_feature(_features[j].data(), _nrows, _num_bins, _targets,
+                        sum_y, sum_y_y, &feature_correlations[j],
+                        &feature_densities[j], &labels[j],
+                        num_targets > 0 ? &average_targets[j] : nullptr);
     }
+  };
 
-    (*_step_sizes)[j] = (max - min) / _num_bins;
-
-    if (min >= max || std::isinf(min) || std::isnan(min) || std::isinf(max) ||
-        std::isnan(max)) {
-      continue;
-    }
-
-    (*_actual_num_bins)[j] =
-        static_cast<size_t>((max - min) / (*_step_sizes)[j]);
-  }
-}
-
-// ----------------------------------------------------------------------------
-
-void Summarizer::find_min_and_max(const Features& _features,
-                                  const size_t _nrows, const size_t _ncols,
-                                  std::vector<Float>* _minima,
-                                  std::vector<Float>* _maxima) {
-  *_minima = std::vector<Float>(_ncols, std::numeric_limits<Float>::max());
-
-  *_maxima = std::vector<Float>(_ncols, std::numeric_limits<Float>::lowest());
+  multithreading::parallel_for(_ncols, multithreading::default_num_threads(),
+                               summarize_features);
 
-  for (size_t i = 0; i < _nrows; ++i) {
-    for (size_t j = 0; j < _ncols; ++j) {
-      if (get(i, j, _features) < (*_minima)[j]) {
-        (*_minima)[j] = get(i, j, _features);
-      } else if (get(i, j, _features) > (*_maxima)[j]) {
-        (*_maxima)[j] = get(i, j, _features);
-      }
-    }
-  }
+  return f_average_targets(average_targets) *
+         f_feature_correlations(feature_correlations) *
+         f_feature_densities(feature_densities) * f_labels(labels);
 }
 
 // ----------------------------------------------------------------------------
@@ -564,4 +337,142 @@ typename Summarizer::PlotWithFrequencies Summarizer::make_object(
 
 // ----------------------------------------------------------------------------
 
+void Summarizer::summarize_feature(
+    const Float* _feature, const size_t _nrows, const size_t _num_bins,
+    const std::vector<const Float*>& _targets,
+    const std::vector<Float>& _sum_y, const std::vector<Float>& _sum_y_y,
+    std::vector<Float>* _correlations, std::vector<Int>* _densities,
+    std::vector<Float>* _labels,
+    std::vector<std::vector<Float>>* _average_targets) {
+  const auto num_targets = _targets.size();
+
+  // The first pass gathers everything that does not depend on the bins.
+
+  auto min = std::numeric_limits<Float>::max();
+
+  auto max = std::numeric_limits<Float>::lowest();
+
+  Float sum_yhat = 0.0;
+
+  Float sum_yhat_yhat = 0.0;
+
+  auto sum_yhat_y = std::vector<Float>(num_targets);
+
+  for (size_t i = 0; i < _nrows; ++i) {
+    const auto val = _feature[i];
+
+    if (val < min) {
+      min = val;
+    }
+
+    if (val > max) {
+      max = val;
+    }
+
+    sum_yhat += val;
+
+    sum_yhat_yhat += val * val;
+
+    for (size_t k = 0; k < num_targets; ++k) {
+      sum_yhat_y[k] += val * _targets[k][i];
+    }
+  }
+
+  // ------------------------------------------------------------------------
+
+  const auto n = static_cast<Float>(_nrows);
+
+  const Float var_yhat = sum_yhat_yhat / n - (sum_yhat / n) * (sum_yhat / n);
+
+  _correlations->resize(num_targets);
+
+  for (size_t k = 0; k < num_targets; ++k) {
+    const Float var_y = _sum_y_y[k] / n - (_sum_y[k] / n) * (_sum_y[k] / n);
+
+    const Float cov_y_yhat =
+        sum_yhat_y[k] / n - (sum_yhat / n) * (_sum_y[k] / n);
+
+    auto& correlation = (*_correlations)[k];
+
+    correlation = cov_y_yhat / std::sqrt(var_yhat * var_y);
+
+    if (std::isnan(correlation) || std::isinf(correlation)) {
+      correlation = 0.0;
+    }
+  }
+
+  // ------------------------------------------------------------------------
+  // Note that num_bins can be smaller than _num_bins.
+
+  const bool is_binnable = min < max && !std::isinf(min) &&
+                           !std::isnan(min) && !std::isinf(max) &&
+                           !std::isnan(max);
+
+  const auto step_size =
+      is_binnable ? (max - min) / static_cast<Float>(_num_bins) : 0.0;
+
+  const auto num_bins =
+      is_binnable ? static_cast<size_t>((max - min) / step_size) : 0;
+
+  _densities->resize(num_bins);
+
+  _labels->resize(num_bins);
+
+  if (_average_targets) {
+    _average_targets->resize(num_targets, std::vector<Float>(num_bins));
+  }
+
+  auto counts = std::vector<std::vector<Float>>(
+      _average_targets ? num_targets : 0, std::vector<Float>(num_bins));
+
+  // ------------------------------------------------------------------------
+  // The second pass fills the histograms.
+
+  for (size_t i = 0; num_bins > 0 && i < _nrows; ++i) {
+    const auto val = _feature[i];
+
+    if (std::isinf(val) || std::isnan(val)) {
+      continue;
+    }
+
+    const auto bin = identify_bin(num_bins, step_size, val, min);
+
+    ++(*_densities)[bin];
+
+    (*_labels)[bin] += val;
+
+    for (size_t k = 0; k < counts.size(); ++k) {
+      const auto tar = _targets[k][i];
+
+      if (std::isinf(tar) || std::isnan(tar)) {
+        continue;
+      }
+
+      (*_average_targets)[k][bin] += tar;
+
+      ++counts[k][bin];
+    }
+  }
+
+  // ------------------------------------------------------------------------
+
+  for (size_t bin = 0; bin < num_bins; ++bin) {
+    if ((*_densities)[bin] > 0) {
+      (*_labels)[bin] /= static_cast<Float>((*_densities)[bin]);
+    } else {
+      (*_labels)[bin] = min + (static_cast<Float>(bin) + 0.5) * step_size;
+    }
+  }
+
+  for (size_t k = 0; k < counts.size(); ++k) {
+    for (size_t bin = 0; bin < num_bins; ++bin) {
+      if (counts[k][bin] > 0) {
+        (*_average_targets)[k][bin] /= counts[k][bin];
+      }
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+
 }  // namespace metrics
@@ -13,24 +13,38 @@ namespace textmining {
 std::vector<std::string> StringSplitter::split(const std::string& _str) {
   std::vector<std::string> splitted;
 
-  auto remaining = _str;
+  size_t begin = 0;
 
-  while (true) {
-    const auto pos = remaining.find_first_of(separators_);
-
-    if (pos == std::string::npos) {
-      splitted.push_back(remaining);
-      break;
+  for (size_t i = 0; i < _str.size(); ++i) {
+    if (is_separator(_str[i])) {
+      splitted.push_back(_str.substr(begin, i - begin));
+      begin = i + 1;
     }
+  }
+
+  splitted.push_back(_str.substr(begin));
+
+  return splitted;
+}
 
-    const auto token = remaining.substr(0, pos);
+// ----------------------------------------------------------------------------
 
-    splitted.push_back(token);
+void StringSplitter::split(const std::string_view _str,
+                           std::vector<std::string_view>* _tokens) {
+  size_t begin = 0;
 
-    remaining.erase(0, pos + 1);
+  for (size_t i = 0; i < _str.size(); ++i) {
+    if (is_separator(_str[i])) {
+      if (i > begin) {
+        _tokens->push_back(_str.substr(begin, i - begin));
+      }
+      begin = i + 1;
+    }
   }
 
-  return splitted;
+  if (_str.size() > begin) {
+    _tokens->push_back(_str.substr(begin));
+  }
 }
 
 // ----------------------------------------------------------------------------
@@ -9,35 +9,56 @@
 
 #include "textmining/StringSplitter.hpp"
 
+#include <cctype>
+
 namespace textmining {
 // ----------------------------------------------------------------------------
 
 std::set<std::string> Vocabulary::process_text_field(
     const strings::String& _text_field) {
-  const auto make_unique =
-      [](const std::vector<std::string>& _tokens) -> std::set<std::string> {
-    return std::set<std::string>(_tokens.begin(), _tokens.end());
-  };
+  std::string buffer;
+
+  std::vector<std::string_view> tokens;
 
-  return make_unique(split_text_field(_text_field));
+  tokenize(_text_field, &buffer, &tokens);
+
+  return std::set<std::string>(tokens.begin(), tokens.end());
 }
 
 // ----------------------------------------------------------------------------
 
 std::vector<std::string> Vocabulary::split_text_field(
     const strings::String& _text_field) {
-  const auto is_non_empty = [](const std::string& str) -> bool {
-    return str.size() > 0;
-  };
+  const auto lower = _text_field.to_lower();
+
+  std::vector<std::string_view> tokens;
+
+  StringSplitter::split(std::string_view(lower.c_str(), lower.size()),
+                        &tokens);
+
+  return std::vector<std::string>(tokens.begin(), tokens.end());
+}
+
+// ----------------------------------------------------------------------------
+
+void Vocabulary::tokenize(const strings::String& _text_field,
+                          std::string* _buffer,
+                          std::vector<std::string_view>* _tokens) {
+  _buffer->assign(_text_field.c_str(), _text_field.size());
+
+  for (auto& c : *_buffer) {
+    c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  }
+
+  _tokens->clear();
+
+  StringSplitter::split(std::string_view(*_buffer), _tokens);
 
-  const auto remove_empty = [is_non_empty](const auto& vec) {
-    return vec | std::views::filter(is_non_empty) |
-           std::ranges::to<std::vector>();
-  };
+  std::ranges::sort(*_tokens);
 
-  const auto splitted = StringSplitter::split(_text_field.to_lower().str());
+  const auto [begin, end] = std::ranges::unique(*_tokens);
 
-  return remove_empty(splitted);
+  _tokens->erase(begin, end);
 }
 
 // ----------------------------------------------------------------------------
@@ -0,0 +1,70 @@
+#include <Poco/Net/ServerSocket.h>
+#include <Poco/Net/SocketAddress.h>
+#include <Poco/Net/StreamSocket.h>
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "communication/Sender.hpp"
+#include "synthetic.hpp"
+
+namespace {
+
+/// A loopback connection with a thread on the other end that discards
+/// everything it receives, so we measure the sending side only.
+class Loopback {
+ public:
+  Loopback() : server_(Poco::Net::SocketAddress("127.0.0.1", 0)) {
+    client_.connect(server_.address());
+    peer_ = server_.acceptConnection();
+    drain_ = std::thread([this]() {
+      auto buf = std::vector<char>(1 << 16);
+      while (peer_.receiveBytes(buf.data(), static_cast<int>(buf.size())) >
+             0) {
+      }
+    });
+  }
+
+  /// Shutting down the sending side makes receiveBytes() return 0, which
+  /// ends the drain thread.
+  ~Loopback() {
+    client_.shutdownSend();
+    drain_.join();
+  }
+
+  Poco::Net::StreamSocket* socket() { return &client_; }
+
+ private:
+  Poco::Net::StreamSocket client_;
+
+  std::thread drain_;
+
+  Poco::Net::StreamSocket peer_;
+
+  Poco::Net::ServerSocket server_;
+};
+
+}  // namespace
+
+static void BM_Sender_SendFloats(benchmark::State& _state) {
+  const auto n = static_cast<size_t>(_state.range(0));
+
+  const auto floats = synthetic::floats(n);
+
+  const auto nbytes = n * sizeof(double);
+
+  auto loopback = Loopback();
+
+  for (auto _ : _state) {
+    communication::Sender::send<double>(nbytes, floats->data(),
+                                        loopback.socket());
+  }
+
+  _state.SetItemsProcessed(_state.iterations() *
+                           static_cast<std::int64_t>(n));
+  _state.SetBytesProcessed(_state.iterations() *
+                           static_cast<std::int64_t>(nbytes));
+}
+BENCHMARK(BM_Sender_SendFloats)->Apply(synthetic::sizes);
@@ -0,0 +1,53 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <optional>
+
+#include "containers/Column.hpp"
+#include "containers/ColumnView.hpp"
+#include "containers/Float.hpp"
+#include "synthetic.hpp"
+
+static void BM_ColumnView_ToVectorFromColumn(benchmark::State& _state) {
+  const auto n = static_cast<size_t>(_state.range(0));
+
+  const auto column =
+      containers::Column<containers::Float>(synthetic::floats(n));
+
+  const auto view =
+      containers::ColumnView<containers::Float>::from_column(column);
+
+  for (auto _ : _state) {
+    benchmark::DoNotOptimize(view.to_vector(0, n, true));
+  }
+
+  _state.SetItemsProcessed(_state.iterations() *
+                           static_cast<std::int64_t>(n));
+  _state.SetBytesProcessed(
+      _state.iterations() *
+      static_cast<std::int64_t>(n * sizeof(containers::Float)));
+}
+BENCHMARK(BM_ColumnView_ToVectorFromColumn)->Apply(synthetic::sizes);
+
+static void BM_ColumnView_ToVectorFromBinOp(benchmark::State& _state) {
+  const auto n = static_cast<size_t>(_state.range(0));
+
+  const auto column1 =
+      containers::Column<containers::Float>(synthetic::floats(n, 1));
+
+  const auto column2 =
+      containers::Column<containers::Float>(synthetic::floats(n, 2));
+
+  const auto view = containers::ColumnView<containers::Float>::from_bin_op(
+      containers::ColumnView<containers::Float>::from_column(column1),
+      containers::ColumnView<containers::Float>::from_column(column2),
+      [](const auto _val1, const auto _val2) { return _val1 * _val2; });
+
+  for (auto _ : _state) {
+    benchmark::DoNotOptimize(view.to_vector(0, std::nullopt, false));
+  }
+
+  _state.SetItemsProcessed(_state.iterations() *
+                           static_cast<std::int64_t>(n));
+}
+BENCHMARK(BM_ColumnView_ToVectorFromBinOp)->Apply(synthetic::sizes);
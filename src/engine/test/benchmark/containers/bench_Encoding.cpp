@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "containers/Encoding.hpp"
+#include "memmap/Pool.hpp"
+#include "synthetic.hpp"
+
+namespace {
+
+/// The in-memory encoding is used when there is no pool, the memory-mapped
+/// encoding otherwise.
+std::shared_ptr<memmap::Pool> make_pool(const bool _memory_mapped) {
+  return _memory_mapped ? std::make_shared<memmap::Pool>(
+                              std::filesystem::temp_directory_path().string() +
+                              "/")
+                        : nullptr;
+}
+
+}  // namespace
+
+static void BM_Encoding_Insert(benchmark::State& _state) {
+  const auto n = static_cast<size_t>(_state.range(0));
+
+  const auto memory_mapped = _state.range(1) != 0;
+
+  const auto strings =
+      synthetic::strings(n, static_cast<std::int32_t>(n / 10 + 1));
+
+  for (auto _ : _state) {
+    auto encoding = containers::Encoding(make_pool(memory_mapped));
+    for (const auto& str : strings) {
+      benchmark::DoNotOptimize(encoding[str]);
+    }
+  }
+
+  _state.SetItemsProcessed(_state.iterations() *
+                           static_cast<std::int64_t>(n));
+}
+BENCHMARK(BM_Encoding_Insert)
+    ->Apply(synthetic::sizes_with_flag)
+    ->ArgNames({"nrows", "memory_mapped"});
+
+static void BM_Encoding_Lookup(benchmark::State& _state) {
+  const auto n = static_cast<size_t>(_state.range(0));
+
+  const auto memory_mapped = _state.range(1) != 0;
+
+  const auto cardinality = static_cast<std::int32_t>(n / 10 + 1);
+
+  auto encoding = containers::Encoding(make_pool(memory_mapped));
+
+  for (const auto& str : synthetic::strings(n, cardinality)) {
+    encoding[str];
+  }
+
+  const auto lookups = synthetic::strings(n, cardinality, 7);
+
+  const auto& const_encoding = encoding;
+
+  for (auto _ : _state) {
+    for (const auto& str : lookups) {
+      benchmark::DoNotOptimize(const_encoding[str]);
+    }
+  }
+
+  _state.SetItemsProcessed(_state.iterations() *
+                           static_cast<std::int64_t>(n));
+}
+BENCHMARK(BM_Encoding_Lookup)
+    ->Apply(synthetic::sizes_with_flag)
+    ->ArgNames({"nrows", "memory_mapped"});
+
+static void BM_Encoding_Assign(benchmark::State& _state) {
+  const auto n = static_cast<size_t>(_state.range(0));
+
+  const auto memory_mapped = _state.range(1) != 0;
+
+  // Loading an encoding from disk assigns distinct values.
+  const auto strings = synthetic::strings(n, static_cast<std::int32_t>(n));
+
+  const auto views = std::vector<std::string_view>(strings.begin(),
+                                                   strings.end());
+
+  for (auto _ : _state) {
+    auto encoding = containers::Encoding(make_pool(memory_mapped));
+    encoding = views;
+    benchmark::DoNotOptimize(&encoding);
+  }
+
+  _state.SetItemsProcessed(_state.iterations() *
+                           static_cast<std::int64_t>(n));
+}
+BENCHMARK(BM_Encoding_Assign)
+    ->Apply(synthetic::sizes_with_flag)
+    ->ArgNames({"nrows", "memory_mapped"});
@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+#include "containers/Column.hpp"
+#include "containers/Index.hpp"
+#include "containers/Int.hpp"
+#include "memmap/Pool.hpp"
+#include "synthetic.hpp"
+
+namespace {
+
+/// The in-memory index is used when there is no pool, the memory-mapped
+/// index otherwise.
+std::shared_ptr<memmap::Pool> make_pool(const bool _memory_mapped) {
+  return _memory_mapped ? std::make_shared<memmap::Pool>(
+                              std::filesystem::temp_directory_path().string() +
+                              "/")
+                        : nullptr;
+}
+
+}  // namespace
+
+static void BM_Index_Calculate(benchmark::State& _state) {
+  const auto n = static_cast<size_t>(_state.range(0));
+
+  const auto memory_mapped = _state.range(1) != 0;
+
+  const auto keys = containers::Column<containers::Int>(
+      synthetic::ints(n, static_cast<std::int32_t>(n / 10 + 1)));
+
+  for (auto _ : _state) {
+    auto index = containers::Index<containers::Int>(make_pool(memory_mapped));
+    index.calculate(keys);
+    benchmark::DoNotOptimize(index.map());
+  }
+
+  _state.SetItemsProcessed(_state.iterations() *
+                           static_cast<std::int64_t>(n));
+}
+BENCHMARK(BM_Index_Calculate)
+    ->Apply(synthetic::sizes_with_flag)
+    ->ArgNames({"nrows", "memory_mapped"});
+
+static void BM_Index_Find(benchmark::State& _state) {
+  const auto n = static_cast<size_t>(_state.range(0));
+
+  const auto memory_mapped = _state.range(1) != 0;
+
+  const auto cardinality = static_cast<std::int32_t>(n / 10 + 1);
+
+  const auto keys =
+      containers::Column<containers::Int>(synthetic::ints(n, cardinality));
+
+  auto index = containers::Index<containers::Int>(make_pool(memory_mapped));
+  index.calculate(keys);
+
+  const auto lookups = synthetic::ints(n, cardinality, 7);
+
+  for (auto _ : _state) {
+    size_t num_rows = 0;
+    for (const auto key : *lookups) {
+      const auto [begin, end] = index.find(key);
+      num_rows += static_cast<size_t>(end - begin);
+    }
+    benchmark::DoNotOptimize(num_rows);
+  }
+
+  _state.SetItemsProcessed(_state.iterations() *
+                           static_cast<std::int64_t>(n));
+}
+BENCHMARK(BM_Index_Find)
+    ->Apply(synthetic::sizes_with_flag)
+    ->ArgNames({"nrows", "memory_mapped"});
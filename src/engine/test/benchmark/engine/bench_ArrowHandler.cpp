@@ -0,0 +1,103 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "containers/Column.hpp"
+#include "containers/DataFrame.hpp"
+#include "containers/Encoding.hpp"
+#include "engine/config/Options.hpp"
+#include "engine/handlers/ArrowHandler.hpp"
+#include "synthetic.hpp"
+
+namespace {
+
+/// Holds everything needed to convert a data frame back and forth.
+struct Fixture {
+  explicit Fixture(const size_t _n)
+      : categories_(rfl::Ref<containers::Encoding>::make(nullptr)),
+        join_keys_encoding_(rfl::Ref<containers::Encoding>::make(nullptr)),
+        handler_(categories_, join_keys_encoding_, engine::config::Options()),
+        df_("df", categories_.ptr(), join_keys_encoding_.ptr(), nullptr) {
+    auto categorical = containers::Column<std::int32_t>(
+        encode(synthetic::strings(_n, 1000, 1), categories_.get()));
+    categorical.set_name("categorical");
+    df_.add_int_column(categorical, containers::DataFrame::ROLE_CATEGORICAL);
+
+    auto join_key = containers::Column<std::int32_t>(
+        encode(synthetic::strings(_n, 100000, 2), join_keys_encoding_.get()));
+    join_key.set_name("join_key");
+    df_.add_int_column(join_key, containers::DataFrame::ROLE_JOIN_KEY);
+
+    for (unsigned i = 0; i < 4; ++i) {
+      auto numerical = containers::Column<double>(synthetic::floats(_n, i));
+      numerical.set_name("numerical_" + std::to_string(i));
+      df_.add_float_column(numerical, containers::DataFrame::ROLE_NUMERICAL);
+    }
+
+    auto time_stamp = containers::Column<double>(synthetic::time_stamps(_n));
+    time_stamp.set_name("time_stamp");
+    df_.add_float_column(time_stamp, containers::DataFrame::ROLE_TIME_STAMP);
+  }
+
+  /// Maps the strings to integers using _encoding.
+  static std::shared_ptr<std::vector<std::int32_t>> encode(
+      const std::vector<std::string>& _strings,
+      containers::Encoding* _encoding) {
+    auto vec = std::make_shared<std::vector<std::int32_t>>(_strings.size());
+    for (size_t i = 0; i < _strings.size(); ++i) {
+      (*vec)[i] = (*_encoding)[_strings[i]];
+    }
+    return vec;
+  }
+
+  rfl::Ref<containers::Encoding> categories_;
+
+  rfl::Ref<containers::Encoding> join_keys_encoding_;
+
+  engine::handlers::ArrowHandler handler_;
+
+  containers::DataFrame df_;
+};
+
+}  // namespace
+
+static void BM_ArrowHandler_DfToTable(benchmark::State& _state) {
+  const auto n = static_cast<size_t>(_state.range(0));
+
+  const auto fixture = Fixture(n);
+
+  for (auto _ : _state) {
+    const auto table = fixture.handler_.df_to_table(fixture.df_);
+    benchmark::DoNotOptimize(table.get());
+  }
+
+  _state.SetItemsProcessed(_state.iterations() *
+                           static_cast<std::int64_t>(n));
+  _state.SetBytesProcessed(_state.iterations() *
+                           static_cast<std::int64_t>(fixture.df_.nbytes()));
+}
+BENCHMARK(BM_ArrowHandler_DfToTable)->Apply(synthetic::sizes);
+
+static void BM_ArrowHandler_TableToDf(benchmark::State& _state) {
+  const auto n = static_cast<size_t>(_state.range(0));
+
+  const auto fixture = Fixture(n);
+
+  const auto table = fixture.handler_.df_to_table(fixture.df_);
+
+  const auto schema = fixture.df_.to_schema(false);
+
+  for (auto _ : _state) {
+    const auto df = fixture.handler_.table_to_df(table, "df", schema);
+    benchmark::DoNotOptimize(df.nrows());
+  }
+
+  _state.SetItemsProcessed(_state.iterations() *
+                           static_cast<std::int64_t>(n));
+  _state.SetBytesProcessed(_state.iterations() *
+                           static_cast<std::int64_t>(fixture.df_.nbytes()));
+}
+BENCHMARK(BM_ArrowHandler_TableToDf)->Apply(synthetic::sizes);
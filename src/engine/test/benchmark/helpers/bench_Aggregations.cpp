@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "helpers/Aggregations.hpp"
+#include "synthetic.hpp"
+
+namespace {
+
+template <class F>
+void run_aggregation(benchmark::State& _state, const F& _f) {
+  const auto n = static_cast<size_t>(_state.range(0));
+  const auto values = synthetic::floats(n);
+
+  for (auto _ : _state) {
+    benchmark::DoNotOptimize(_f(values->begin(), values->end()));
+  }
+
+  _state.SetItemsProcessed(_state.iterations() *
+                           static_cast<std::int64_t>(n));
+  _state.SetBytesProcessed(_state.iterations() *
+                           static_cast<std::int64_t>(n * sizeof(double)));
+}
+
+}  // namespace
+
+static void BM_Aggregations_Sum(benchmark::State& _state) {
+  run_aggregation(_state, [](auto _begin, auto _end) {
+    return helpers::Aggregations::sum(_begin, _end);
+  });
+}
+BENCHMARK(BM_Aggregations_Sum)->Apply(synthetic::sizes);
+
+static void BM_Aggregations_Var(benchmark::State& _state) {
+  run_aggregation(_state, [](auto _begin, auto _end) {
+    return helpers::Aggregations::var(_begin, _end);
+  });
+}
+BENCHMARK(BM_Aggregations_Var)->Apply(synthetic::sizes);
+
+static void BM_Aggregations_Median(benchmark::State& _state) {
+  run_aggregation(_state, [](auto _begin, auto _end) {
+    return helpers::Aggregations::median(_begin, _end);
+  });
+}
+BENCHMARK(BM_Aggregations_Median)->Apply(synthetic::sizes);
+
+static void BM_Aggregations_CountDistinct(benchmark::State& _state) {
+  run_aggregation(_state, [](auto _begin, auto _end) {
+    return helpers::Aggregations::count_distinct(_begin, _end);
+  });
+}
+BENCHMARK(BM_Aggregations_CountDistinct)->Apply(synthetic::sizes);
+
+static void BM_Aggregations_Trend(benchmark::State& _state) {
+  const auto n = static_cast<size_t>(_state.range(0));
+  const auto time_stamps = synthetic::time_stamps(n);
+  const auto values = synthetic::floats(n);
+
+  auto pairs = std::vector<std::pair<double, double>>(n);
+  for (size_t i = 0; i < n; ++i) {
+    pairs[i] = std::make_pair((*time_stamps)[i], (*values)[i]);
+  }
+
+  for (auto _ : _state) {
+    benchmark::DoNotOptimize(
+        helpers::Aggregations::trend(pairs.begin(), pairs.end()));
+  }
+
+  _state.SetItemsProcessed(_state.iterations() *
+                           static_cast<std::int64_t>(n));
+}
+BENCHMARK(BM_Aggregations_Trend)->Apply(synthetic::sizes);
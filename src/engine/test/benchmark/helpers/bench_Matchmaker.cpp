@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "containers/Column.hpp"
+#include "containers/DataFrame.hpp"
+#include "helpers/DataFrame.hpp"
+#include "helpers/Matchmaker.hpp"
+#include "synthetic.hpp"
+
+namespace {
+
+/// A data frame with a single join key with _cardinality distinct values and
+/// a single time stamp.
+helpers::DataFrame make_df(const size_t _n, const std::int32_t _cardinality,
+                           const unsigned _seed) {
+  auto df = containers::DataFrame();
+
+  auto join_key = containers::Column<std::int32_t>(
+      synthetic::ints(_n, _cardinality, _seed));
+  join_key.set_name("join_key");
+  df.add_int_column(join_key, containers::DataFrame::ROLE_JOIN_KEY);
+
+  auto time_stamp =
+      containers::Column<double>(synthetic::time_stamps(_n, _seed));
+  time_stamp.set_name("time_stamp");
+  df.add_float_column(time_stamp, containers::DataFrame::ROLE_TIME_STAMP);
+
+  df.create_indices();
+
+  return df.to_immutable<helpers::DataFrame>();
+}
+
+}  // namespace
+
+static void BM_Matchmaker_MakeMatches(benchmark::State& _state) {
+  const auto n = static_cast<size_t>(_state.range(0));
+
+  // About ten peripheral rows per join key, half of which precede the
+  // population row on average.
+  const auto cardinality = static_cast<std::int32_t>(std::max(n / 10, 1uz));
+
+  const auto population = make_df(n, cardinality, 1);
+
+  const auto peripheral = make_df(n, cardinality, 2);
+
+  const auto make_match = [](const size_t _ix_input, const size_t _ix_output) {
+    return std::make_pair(_ix_input, _ix_output);
+  };
+
+  using MatchmakerType =
+      helpers::Matchmaker<helpers::DataFrame, std::pair<size_t, size_t>,
+                          decltype(make_match)>;
+
+  size_t num_matches = 0;
+
+  for (auto _ : _state) {
+    const auto matches = MatchmakerType::make_matches(
+        population, peripheral, nullptr, make_match);
+    num_matches = matches.size();
+    benchmark::DoNotOptimize(matches.data());
+  }
+
+  _state.SetItemsProcessed(_state.iterations() *
+                           static_cast<std::int64_t>(n));
+  _state.counters["matches"] = static_cast<double>(num_matches);
+}
+BENCHMARK(BM_Matchmaker_MakeMatches)->Apply(synthetic::sizes);
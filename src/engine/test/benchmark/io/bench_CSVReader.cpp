@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "io/CSVReader.hpp"
+#include "synthetic.hpp"
+
+namespace {
+
+/// Writes a CSV file with a string, an integer and two float columns and
+/// returns its size in bytes.
+std::int64_t write_csv(const std::string& _fname, const size_t _n) {
+  const auto strings = synthetic::strings(_n, 1000);
+  const auto ints = synthetic::ints(_n, 100000);
+  const auto floats = synthetic::floats(_n);
+  const auto time_stamps = synthetic::time_stamps(_n);
+
+  auto file = std::ofstream(_fname);
+  file << "\"name\",\"id\",\"value\",\"ts\"\n";
+  for (size_t i = 0; i < _n; ++i) {
+    file << '"' << strings[i] << "\"," << (*ints)[i] << ',' << (*floats)[i]
+         << ',' << (*time_stamps)[i] << '\n';
+  }
+  file.close();
+
+  return static_cast<std::int64_t>(std::filesystem::file_size(_fname));
+}
+
+}  // namespace
+
+static void BM_CSVReader_ReadAll(benchmark::State& _state) {
+  const auto n = static_cast<size_t>(_state.range(0));
+
+  const auto fname = (std::filesystem::temp_directory_path() /
+                      ("getml_bench_" + std::to_string(n) + ".csv"))
+                         .string();
+
+  const auto nbytes = write_csv(fname, n);
+
+  for (auto _ : _state) {
+    auto reader = io::CSVReader(std::nullopt, fname, 0, '"', ',');
+    size_t nlines = 0;
+    while (!reader.eof()) {
+      const auto line = reader.next_line();
+      benchmark::DoNotOptimize(line.data());
+      ++nlines;
+    }
+    benchmark::DoNotOptimize(nlines);
+  }
+
+  std::filesystem::remove(fname);
+
+  _state.SetItemsProcessed(_state.iterations() *
+                           static_cast<std::int64_t>(n));
+  _state.SetBytesProcessed(_state.iterations() * nbytes);
+}
+BENCHMARK(BM_CSVReader_ReadAll)->Apply(synthetic::sizes);
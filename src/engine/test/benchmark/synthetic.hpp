@@ -0,0 +1,99 @@
+#ifndef BENCHMARK_SYNTHETIC_HPP_
+#define BENCHMARK_SYNTHETIC_HPP_
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+/// Synthetic data for the benchmarks. All generators are seeded, so every
+/// run measures the same data.
+namespace synthetic {
+
+/// The number of rows of the largest data set, which can be set through the
+/// environment variable GETML_BENCHMARK_NROWS.
+inline std::int64_t max_nrows() {
+  const auto env = std::getenv("GETML_BENCHMARK_NROWS");
+  return env ? std::max<std::int64_t>(std::atoll(env), 1) : 1000000;
+}
+
+/// Runs a benchmark on 1%, 10% and 100% of max_nrows(), so we can tell
+/// whether a kernel scales linearly.
+inline void sizes(benchmark::internal::Benchmark* _b) {
+  const auto n = max_nrows();
+  for (const auto size : {n / 100, n / 10, n}) {
+    _b->Arg(std::max<std::int64_t>(size, 1));
+  }
+}
+
+/// Like sizes(), but runs every size with a second argument of 0 and 1, for
+/// benchmarks that compare two implementations.
+inline void sizes_with_flag(benchmark::internal::Benchmark* _b) {
+  const auto n = max_nrows();
+  for (const auto size : {n / 100, n / 10, n}) {
+    for (const std::int64_t flag : {0, 1}) {
+      _b->Args({std::max<std::int64_t>(size, 1), flag});
+    }
+  }
+}
+
+/// Normally distributed floats.
+inline std::shared_ptr<std::vector<double>> floats(const size_t _n,
+                                                   const unsigned _seed = 42) {
+  auto rng = std::mt19937(_seed);
+  auto dist = std::normal_distribution<double>(0.0, 1.0);
+  auto vec = std::make_shared<std::vector<double>>(_n);
+  for (auto& val : *vec) {
+    val = dist(rng);
+  }
+  return vec;
+}
+
+/// Integers in [0, _cardinality).
+inline std::shared_ptr<std::vector<std::int32_t>> ints(
+    const size_t _n, const std::int32_t _cardinality,
+    const unsigned _seed = 42) {
+  auto rng = std::mt19937(_seed);
+  auto dist = std::uniform_int_distribution<std::int32_t>(0, _cardinality - 1);
+  auto vec = std::make_shared<std::vector<std::int32_t>>(_n);
+  for (auto& val : *vec) {
+    val = dist(rng);
+  }
+  return vec;
+}
+
+/// Strings drawn from _cardinality distinct values.
+inline std::vector<std::string> strings(const size_t _n,
+                                        const std::int32_t _cardinality,
+                                        const unsigned _seed = 42) {
+  const auto keys = ints(_n, _cardinality, _seed);
+  auto vec = std::vector<std::string>(_n);
+  for (size_t i = 0; i < _n; ++i) {
+    vec[i] = "category_" + std::to_string((*keys)[i]);
+  }
+  return vec;
+}
+
+/// Sorted time stamps, roughly one per second.
+inline std::shared_ptr<std::vector<double>> time_stamps(
+    const size_t _n, const unsigned _seed = 42) {
+  auto rng = std::mt19937(_seed);
+  auto dist = std::uniform_real_distribution<double>(0.0, 2.0);
+  auto vec = std::make_shared<std::vector<double>>(_n);
+  auto t = 0.0;
+  for (auto& val : *vec) {
+    t += dist(rng);
+    val = t;
+  }
+  return vec;
+}
+
+}  // namespace synthetic
+
+#endif  // BENCHMARK_SYNTHETIC_HPP_
@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include "fct/Range.hpp"
+#include "synthetic.hpp"
+#include "tsindex/InMemoryIndex.hpp"
+#include "tsindex/IndexParams.hpp"
+
+namespace {
+
+struct IndexData {
+  std::shared_ptr<std::vector<std::int32_t>> join_keys_;
+  std::shared_ptr<std::vector<double>> time_stamps_;
+  std::shared_ptr<const std::vector<size_t>> rownums_;
+};
+
+IndexData make_index_data(const size_t _n) {
+  const auto cardinality = static_cast<std::int32_t>(std::max(_n / 10, 1uz));
+
+  auto rownums = std::make_shared<std::vector<size_t>>(_n);
+  std::iota(rownums->begin(), rownums->end(), 0);
+
+  return IndexData{.join_keys_ = synthetic::ints(_n, cardinality),
+                   .time_stamps_ = synthetic::time_stamps(_n),
+                   .rownums_ = rownums};
+}
+
+tsindex::IndexParams make_params(const IndexData& _data) {
+  return tsindex::IndexParams{
+      .join_keys_ = fct::Range<const std::int32_t*>(
+          _data.join_keys_->data(),
+          _data.join_keys_->data() + _data.join_keys_->size()),
+      .lower_ts_ = fct::Range<const double*>(
+          _data.time_stamps_->data(),
+          _data.time_stamps_->data() + _data.time_stamps_->size()),
+      .memory_ = 3600.0,
+      .rownums_ = _data.rownums_};
+}
+
+}  // namespace
+
+static void BM_InMemoryIndex_Build(benchmark::State& _state) {
+  const auto n = static_cast<size_t>(_state.range(0));
+
+  const auto data = make_index_data(n);
+
+  for (auto _ : _state) {
+    const auto index = tsindex::InMemoryIndex(make_params(data));
+    benchmark::DoNotOptimize(&index);
+  }
+
+  _state.SetItemsProcessed(_state.iterations() *
+                           static_cast<std::int64_t>(n));
+}
+BENCHMARK(BM_InMemoryIndex_Build)->Apply(synthetic::sizes);
+
+static void BM_InMemoryIndex_FindRange(benchmark::State& _state) {
+  const auto n = static_cast<size_t>(_state.range(0));
+
+  const auto data = make_index_data(n);
+
+  const auto index = tsindex::InMemoryIndex(make_params(data));
+
+  size_t num_matches = 0;
+
+  for (auto _ : _state) {
+    num_matches = 0;
+    for (size_t i = 0; i < n; ++i) {
+      const auto range = index.find_range((*data.join_keys_)[i],
+                                          (*data.time_stamps_)[i]);
+      num_matches += range.size();
+    }
+    benchmark::DoNotOptimize(num_matches);
+  }
+
+  _state.SetItemsProcessed(_state.iterations() *
+                           static_cast<std::int64_t>(n));
+  _state.counters["matches"] = static_cast<double>(num_matches);
+}
+BENCHMARK(BM_InMemoryIndex_FindRange)->Apply(synthetic::sizes);
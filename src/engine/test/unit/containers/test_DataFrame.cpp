@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "containers/Column.hpp"
+#include "containers/DataFrame.hpp"
+#include "containers/Float.hpp"
+#include "containers/Int.hpp"
+#include "gwt.h"
+#include "memmap/Index.hpp"
+#include "strings/String.hpp"
+
+namespace {
+
+auto temp_dir() {
+  const auto path =
+      std::filesystem::temp_directory_path() / "getml_test_data_frame";
+  std::filesystem::create_directories(path);
+  return path.string() + "/";
+}
+
+auto make_df() {
+  auto df = containers::DataFrame("df", nullptr, nullptr, nullptr);
+
+  df.add_int_column(
+      containers::Column<containers::Int>(
+          std::make_shared<std::vector<containers::Int>>(
+              std::vector<containers::Int>{3, 7, 3, -1, 7}),
+          "jk"),
+      containers::DataFrame::ROLE_JOIN_KEY);
+
+  df.add_float_column(
+      containers::Column<containers::Float>(
+          std::make_shared<std::vector<containers::Float>>(
+              std::vector<containers::Float>{1.5, 2.5, 3.5, 4.5, 5.5}),
+          "num"),
+      containers::DataFrame::ROLE_NUMERICAL);
+
+  df.add_string_column(
+      containers::Column<strings::String>(
+          std::make_shared<std::vector<strings::String>>(
+              std::vector<strings::String>{
+                  strings::String("a"), strings::String("bb"),
+                  strings::String(""), strings::String("ccc"),
+                  strings::String("a")}),
+          "txt"),
+      containers::DataFrame::ROLE_TEXT);
+
+  return df;
+}
+
+template <class T>
+auto values(containers::Column<T> const& col) {
+  auto result = std::vector<T>();
+  for (std::size_t i = 0; i < col.nrows(); ++i) {
+    result.push_back(col[i]);
+  }
+  return result;
+}
+
+auto strs(containers::Column<strings::String> const& col) {
+  auto result = std::vector<std::string>();
+  for (std::size_t i = 0; i < col.nrows(); ++i) {
+    result.push_back(col[i].str());
+  }
+  return result;
+}
+
+auto rownums(containers::DataFrameIndex const& index,
+             containers::Int const key) {
+  auto const [begin, end] = index.find(key);
+  return std::vector<std::size_t>(begin, end);
+}
+
+}  // namespace
+
+TEST(TestDataFrame, TestToMemoryMappedKeepsValues) {
+  GWT::given([]() { return make_df(); })
+      .when([](auto&& df) { return df.to_memory_mapped(temp_dir()); })
+      .then([](auto&& mapped) {
+        EXPECT_TRUE(mapped.pool());
+        EXPECT_EQ(5uz, mapped.nrows());
+        EXPECT_EQ((std::vector<containers::Int>{3, 7, 3, -1, 7}),
+                  values(mapped.join_key(0)));
+        EXPECT_EQ((std::vector<containers::Float>{1.5, 2.5, 3.5, 4.5, 5.5}),
+                  values(mapped.numerical(0)));
+        EXPECT_EQ((std::vector<std::string>{"a", "bb", "", "ccc", "a"}),
+                  strs(mapped.text(0)));
+        EXPECT_EQ("jk", mapped.join_key(0).name());
+        EXPECT_EQ("num", mapped.numerical(0).name());
+        EXPECT_EQ("txt", mapped.text(0).name());
+      });
+}
+
+TEST(TestDataFrame, TestToMemoryMappedRebuildsIndices) {
+  GWT::given([]() { return make_df(); })
+      .when([](auto&& df) { return df.to_memory_mapped(temp_dir()); })
+      .then([](auto&& mapped) {
+        ASSERT_EQ(1uz, mapped.indices().size());
+        const auto index = mapped.index(0);
+        EXPECT_TRUE(std::holds_alternative<memmap::Index<containers::Int>>(
+            *index.map()));
+        EXPECT_EQ((std::vector<std::size_t>{0, 2}), rownums(index, 3));
+        EXPECT_EQ((std::vector<std::size_t>{1, 4}), rownums(index, 7));
+        EXPECT_TRUE(rownums(index, -1).empty());
+        EXPECT_TRUE(rownums(index, 5).empty());
+      });
+}
+
+TEST(TestDataFrame, TestToMemoryMappedLeavesOriginalInMemory) {
+  GWT::given([]() { return make_df(); })
+      .when([](auto&& df) {
+        const auto mapped = df.to_memory_mapped(temp_dir());
+        return std::make_pair(df, mapped.index(0).map() != df.index(0).map());
+      })
+      .then([](auto&& result) {
+        const auto& [df, separate_index] = result;
+        EXPECT_FALSE(df.pool());
+        EXPECT_TRUE(separate_index);
+        EXPECT_EQ((std::vector<std::size_t>{0, 2}), rownums(df.index(0), 3));
+        EXPECT_EQ((std::vector<containers::Float>{1.5, 2.5, 3.5, 4.5, 5.5}),
+                  values(df.numerical(0)));
+      });
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <arrow/api.h>
+#include <arrow/io/api.h>
+#include <parquet/arrow/writer.h>
+#include <parquet/file_reader.h>
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "commands/ParquetFilter.hpp"
+#include "engine/handlers/ArrowHandler.hpp"
+#include "gwt.h"
+
+namespace {
+
+/// Writes a nullable double column "x" as a parquet file with three row
+/// groups: [1, 2, 3], [4, NULL, 6] and [NULL, NULL, NULL].
+std::shared_ptr<parquet::FileMetaData> make_metadata() {
+  auto builder = arrow::DoubleBuilder();
+  EXPECT_TRUE(builder.AppendValues({1.0, 2.0, 3.0, 4.0}).ok());
+  EXPECT_TRUE(builder.AppendNull().ok());
+  EXPECT_TRUE(builder.Append(6.0).ok());
+  EXPECT_TRUE(builder.AppendNulls(3).ok());
+
+  const auto array = builder.Finish().ValueOrDie();
+
+  const auto table = arrow::Table::Make(
+      arrow::schema({arrow::field("x", arrow::float64())}), {array});
+
+  const auto sink = arrow::io::BufferOutputStream::Create().ValueOrDie();
+
+  EXPECT_TRUE(parquet::arrow::WriteTable(*table, arrow::default_memory_pool(),
+                                         sink, 3)
+                  .ok());
+
+  const auto buffer = sink->Finish().ValueOrDie();
+
+  return parquet::ParquetFileReader::Open(
+             std::make_shared<arrow::io::BufferReader>(buffer))
+      ->metadata();
+}
+
+/// Applies the filter to every row group.
+std::vector<bool> may_pass(const parquet::FileMetaData& _metadata,
+                           const commands::ParquetFilter& _filter) {
+  auto result = std::vector<bool>();
+  for (int i = 0; i < _metadata.num_row_groups(); ++i) {
+    result.push_back(engine::handlers::ArrowHandler::row_group_may_pass(
+        *_metadata.RowGroup(i)->ColumnChunk(0), *_metadata.schema()->Column(0),
+        _filter));
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(TestArrowHandler, TestRowGroupMayPassUsesMinMax) {
+  GWT::given(make_metadata())
+      .when([](auto const&& metadata) {
+        return std::vector<std::vector<bool>>(
+            {may_pass(*metadata, commands::ParquetFilter{.column = "x",
+                                                         .min = 3.5,
+                                                         .max = std::nullopt}),
+             may_pass(*metadata, commands::ParquetFilter{.column = "x",
+                                                         .min = std::nullopt,
+                                                         .max = 3.5}),
+             may_pass(*metadata, commands::ParquetFilter{
+                                     .column = "x", .min = 2.5, .max = 2.6})});
+      })
+      .then([](auto const&& results) {
+        EXPECT_EQ(std::vector<bool>({false, true, false}), results.at(0));
+        EXPECT_EQ(std::vector<bool>({true, false, false}), results.at(1));
+        EXPECT_EQ(std::vector<bool>({true, false, false}), results.at(2));
+      });
+}
+
+TEST(TestArrowHandler, TestRowGroupMayPassDropsAllNullRowGroups) {
+  GWT::given(make_metadata())
+      .when([](auto const&& metadata) {
+        return may_pass(*metadata,
+                        commands::ParquetFilter{.column = "x",
+                                                .min = std::nullopt,
+                                                .max = std::nullopt});
+      })
+      .then([](auto const&& result) {
+        EXPECT_EQ(std::vector<bool>({true, true, false}), result);
+      });
+}
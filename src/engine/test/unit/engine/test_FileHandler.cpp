@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "containers/Encoding.hpp"
+#include "engine/handlers/FileHandler.hpp"
+#include "gwt.h"
+#include "memmap/Pool.hpp"
+
+namespace {
+
+using FileHandler = engine::handlers::FileHandler;
+
+std::string make_fname(const std::string& _name) {
+  const auto dir =
+      std::filesystem::temp_directory_path() / "getml_test_file_handler";
+  std::filesystem::create_directories(dir);
+  return (dir / _name).string();
+}
+
+std::shared_ptr<memmap::Pool> make_pool() {
+  return std::make_shared<memmap::Pool>(make_fname("pool"));
+}
+
+std::vector<std::string> read_all(const containers::Encoding& _encoding) {
+  auto strings = std::vector<std::string>();
+  for (size_t i = 0; i < _encoding.size(); ++i) {
+    strings.push_back(_encoding[static_cast<containers::Int>(i)].str());
+  }
+  return strings;
+}
+
+}  // namespace
+
+TEST(TestFileHandler, TestEncodingRoundTripAndAppend) {
+  const auto fname = make_fname("categories");
+
+  for (const auto* ext : {".strings", ".offsets", ".digest", ".hashes"}) {
+    std::filesystem::remove(fname + ext);
+  }
+
+  GWT::given([fname]() {
+    auto encoding = containers::Encoding(make_pool());
+    encoding[std::string("a")];
+    encoding[std::string("bb")];
+    FileHandler::write_encoding(fname, encoding);
+    const auto saved_before = FileHandler::num_saved(fname, encoding);
+    encoding[std::string("ccc")];
+    encoding[std::string("dddd")];
+    const auto saved_after_insert = FileHandler::num_saved(fname, encoding);
+    FileHandler::write_encoding(fname, encoding);
+    return std::make_tuple(saved_before, saved_after_insert,
+                           FileHandler::num_saved(fname, encoding));
+  })
+      .when([fname](auto&& saved) {
+        auto loaded = containers::Encoding(make_pool());
+        FileHandler::read_encoding(fname, &loaded);
+        const auto strings = read_all(loaded);
+        const auto lookups = std::vector<containers::Int>(
+            {loaded[std::string("a")], loaded[std::string("bb")],
+             loaded[std::string("dddd")], loaded[std::string("new")]});
+        return std::make_tuple(saved, strings, lookups,
+                               std::filesystem::exists(fname + ".hashes"));
+      })
+      .then([](auto&& result) {
+        const auto& [saved, strings, lookups, has_hashes] = result;
+        const auto& [before, after_insert, after_write] = saved;
+        EXPECT_EQ(2uz, before);
+        EXPECT_EQ(2uz, after_insert);
+        EXPECT_EQ(4uz, after_write);
+        EXPECT_EQ(std::vector<std::string>({"a", "bb", "ccc", "dddd"}),
+                  strings);
+        EXPECT_EQ(std::vector<containers::Int>({0, 1, 3, 4}), lookups);
+        EXPECT_TRUE(has_hashes);
+      });
+}
+
+TEST(TestFileHandler, TestDifferentEncodingIsRewritten) {
+  const auto fname = make_fname("join_keys_encoding");
+
+  GWT::given([fname]() {
+    auto first = containers::Encoding(make_pool());
+    first[std::string("x")];
+    first[std::string("y")];
+    FileHandler::write_encoding(fname, first);
+    auto second = containers::Encoding(make_pool());
+    second[std::string("y")];
+    second[std::string("z")];
+    second[std::string("w")];
+    const auto saved = FileHandler::num_saved(fname, second);
+    FileHandler::write_encoding(fname, second);
+    return saved;
+  })
+      .when([fname](auto&& saved) {
+        auto loaded = containers::Encoding(make_pool());
+        FileHandler::read_encoding(fname, &loaded);
+        return std::make_tuple(saved, read_all(loaded),
+                               loaded[std::string("w")]);
+      })
+      .then([](auto&& result) {
+        const auto& [saved, strings, w] = result;
+        EXPECT_EQ(0uz, saved);
+        EXPECT_EQ(std::vector<std::string>({"y", "z", "w"}), strings);
+        EXPECT_EQ(2, w);
+      });
+}
+
+TEST(TestFileHandler, TestChangedPrefixIsRewritten) {
+  const auto fname = make_fname("changed_prefix");
+
+  GWT::given([fname]() {
+    auto first = containers::Encoding(make_pool());
+    first[std::string("x")];
+    first[std::string("y")];
+    FileHandler::write_encoding(fname, first);
+    // The last saved string is still in the same place, but the one before
+    // it is not.
+    auto second = containers::Encoding(make_pool());
+    second[std::string("q")];
+    second[std::string("y")];
+    second[std::string("z")];
+    const auto saved = FileHandler::num_saved(fname, second);
+    FileHandler::write_encoding(fname, second);
+    return saved;
+  })
+      .when([fname](auto&& saved) {
+        auto loaded = containers::Encoding(make_pool());
+        FileHandler::read_encoding(fname, &loaded);
+        return std::make_pair(saved, read_all(loaded));
+      })
+      .then([](auto&& result) {
+        EXPECT_EQ(0uz, result.first);
+        EXPECT_EQ(std::vector<std::string>({"q", "y", "z"}), result.second);
+      });
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "fastprop/Int.hpp"
+#include "fastprop/algorithm/CategoryBuckets.hpp"
+#include "fastprop/containers/Match.hpp"
+#include "gwt.h"
+
+namespace {
+
+using fastprop::Int;
+using fastprop::algorithm::CategoryBuckets;
+using fastprop::containers::Match;
+
+auto to_pairs(std::vector<Match> const& matches) {
+  auto pairs = std::vector<std::pair<std::size_t, std::size_t>>();
+  for (auto const& m : matches) {
+    pairs.emplace_back(m.ix_input, m.ix_output);
+  }
+  return pairs;
+}
+
+/// The categorical condition as it is evaluated for every single match.
+auto expected_bucket(std::vector<Int> const& categories,
+                     std::vector<Match> const& matches, Int const category) {
+  auto expected = std::vector<Match>();
+  for (auto const& m : matches) {
+    if (categories[m.ix_input] == category) {
+      expected.push_back(m);
+    }
+  }
+  return expected;
+}
+
+auto match_all(std::size_t const nrows) {
+  auto matches = std::vector<Match>();
+  for (std::size_t i = 0; i < nrows; ++i) {
+    matches.push_back(Match{.ix_input = i, .ix_output = 0});
+  }
+  return matches;
+}
+
+}  // namespace
+
+TEST(TestCategoryBuckets, TestBucketsMatchPerRowEvaluation) {
+  GWT::given([]() {
+    auto categories = std::vector<Int>();
+    for (Int i = 0; i < 1000; ++i) {
+      categories.push_back(i % 11 == 0 ? -1 : (i * 7919) % 37);
+    }
+    return categories;
+  })
+      .when([](auto&& categories) {
+        auto const matches = match_all(categories.size());
+        auto buckets = CategoryBuckets(0);
+        auto used = std::vector<std::pair<Int, std::size_t>>();
+        for (auto const c : {30, 2, -1, 17, 0, 36}) {
+          used.emplace_back(c, buckets.add_category(c));
+        }
+        buckets.partition(categories.data(), matches);
+        auto mismatches = 0uz;
+        auto total = 0uz;
+        for (auto const& [category, k] : used) {
+          total += buckets.bucket(k).size();
+          if (to_pairs(buckets.bucket(k)) !=
+              to_pairs(expected_bucket(categories, matches, category))) {
+            ++mismatches;
+          }
+        }
+        return std::make_pair(mismatches, total);
+      })
+      .then([](auto&& result) {
+        EXPECT_EQ(0uz, result.first);
+        EXPECT_GT(result.second, 0uz);
+      });
+}
+
+TEST(TestCategoryBuckets, TestEmptyAndUnusedCategories) {
+  GWT::given([]() { return std::vector<Int>{1, 2, 1, 3, 2, 1}; })
+      .when([](auto&& categories) {
+        auto buckets = CategoryBuckets(0);
+        auto const one = buckets.add_category(1);
+        auto const empty = buckets.add_category(4);
+        auto const one_again = buckets.add_category(1);
+        buckets.partition(categories.data(), match_all(categories.size()));
+        return std::make_tuple(one == one_again, buckets.bucket(one).size(),
+                               buckets.bucket(empty).size());
+      })
+      .then([](auto&& result) {
+        auto const& [same_bucket, num_one, num_empty] = result;
+        // The matches for 2 and 3 have no categorical condition and are
+        // dropped.
+        EXPECT_TRUE(same_bucket);
+        EXPECT_EQ(3uz, num_one);
+        EXPECT_EQ(0uz, num_empty);
+      });
+}
+
+TEST(TestCategoryBuckets, TestPartitionClearsPreviousRow) {
+  GWT::given([]() { return std::vector<Int>{5, 5, 6}; })
+      .when([](auto&& categories) {
+        auto buckets = CategoryBuckets(0);
+        auto const five = buckets.add_category(5);
+        auto const six = buckets.add_category(6);
+        buckets.partition(categories.data(), match_all(categories.size()));
+        buckets.partition(categories.data(), std::vector<Match>());
+        return std::make_pair(buckets.bucket(five).size(),
+                              buckets.bucket(six).size());
+      })
+      .then([](auto&& result) {
+        EXPECT_EQ(0uz, result.first);
+        EXPECT_EQ(0uz, result.second);
+      });
+}
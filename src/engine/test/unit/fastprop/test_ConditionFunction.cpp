@@ -0,0 +1,223 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "fastprop/Float.hpp"
+#include "fastprop/Int.hpp"
+#include "fastprop/algorithm/ConditionFunction.hpp"
+#include "fastprop/containers/Match.hpp"
+#include "gwt.h"
+
+namespace {
+
+using fastprop::Float;
+using fastprop::Int;
+using fastprop::algorithm::ConditionFunction;
+using fastprop::containers::Match;
+using Kind = ConditionFunction::Kind;
+
+struct Tables {
+  std::vector<Int> categorical_input;
+  std::vector<Int> categorical_output;
+  std::vector<Float> ts_input;
+  std::vector<Float> ts_output;
+  std::vector<Match> matches;
+};
+
+auto to_pairs(std::vector<Match> const& matches) {
+  auto pairs = std::vector<std::pair<std::size_t, std::size_t>>();
+  for (auto const& m : matches) {
+    pairs.emplace_back(m.ix_input, m.ix_output);
+  }
+  return pairs;
+}
+
+auto categorical(Tables const& t, Int const category) {
+  return ConditionFunction::Instruction{
+      .kind_ = Kind::categorical,
+      .category_used_ = category,
+      .categorical_input_ = t.categorical_input.data(),
+      .categorical_output_ = t.categorical_output.data(),
+      .lower_ = 0.0,
+      .upper_ = 0.0,
+      .ts_input_ = t.ts_input.data(),
+      .ts_output_ = t.ts_output.data()};
+}
+
+auto lag(Tables const& t, Float const lower, Float const upper) {
+  auto instruction = categorical(t, 0);
+  instruction.kind_ = Kind::lag;
+  instruction.lower_ = lower;
+  instruction.upper_ = upper;
+  return instruction;
+}
+
+auto same_units(Tables const& t) {
+  auto instruction = categorical(t, 0);
+  instruction.kind_ = Kind::same_units_categorical;
+  return instruction;
+}
+
+/// The conditions as they are evaluated for every single match.
+auto expected_categorical(Tables const& t, Int const category) {
+  return std::function<bool(Match const&)>([&t, category](Match const& m) {
+    return t.categorical_input[m.ix_input] == category;
+  });
+}
+
+auto expected_lag(Tables const& t, Float const lower, Float const upper) {
+  return std::function<bool(Match const&)>(
+      [&t, lower, upper](Match const& m) {
+        return t.ts_input[m.ix_input] + upper > t.ts_output[m.ix_output] &&
+               t.ts_input[m.ix_input] + lower <= t.ts_output[m.ix_output];
+      });
+}
+
+auto expected_same_units(Tables const& t) {
+  return std::function<bool(Match const&)>([&t](Match const& m) {
+    return t.categorical_output[m.ix_output] ==
+           t.categorical_input[m.ix_input];
+  });
+}
+
+auto expected_selection(
+    Tables const& t,
+    std::vector<std::function<bool(Match const&)>> const& conditions) {
+  auto expected = std::vector<Match>();
+  for (auto const& m : t.matches) {
+    auto passes = true;
+    for (auto const& condition : conditions) {
+      passes = passes && condition(m);
+    }
+    if (passes) {
+      expected.push_back(m);
+    }
+  }
+  return expected;
+}
+
+auto select(Tables const& t,
+            std::vector<ConditionFunction::Instruction> const& instructions) {
+  auto selected = std::vector<Match>{Match{.ix_input = 99, .ix_output = 99}};
+  ConditionFunction(instructions).select(t.matches, &selected);
+  return selected;
+}
+
+auto count_mismatch(
+    Tables const& t,
+    std::vector<ConditionFunction::Instruction> const& instructions,
+    std::vector<std::function<bool(Match const&)>> const& conditions) {
+  return to_pairs(select(t, instructions)) ==
+                 to_pairs(expected_selection(t, conditions))
+             ? 0uz
+             : 1uz;
+}
+
+auto make_tables() {
+  auto const nan = std::numeric_limits<Float>::quiet_NaN();
+  auto t = Tables();
+  for (std::size_t i = 0; i < 300; ++i) {
+    t.categorical_input.push_back(i % 13 == 0 ? -1 : (i * 7919) % 5);
+    t.ts_input.push_back(i % 17 == 0 ? nan
+                                     : 1.7e9 + static_cast<Float>(i % 40) *
+                                                   0.1);
+  }
+  for (std::size_t i = 0; i < 20; ++i) {
+    t.categorical_output.push_back(i % 5);
+    t.ts_output.push_back(i % 7 == 0 ? nan
+                                     : 1.7e9 + static_cast<Float>(i) * 0.3);
+  }
+  for (std::size_t i = 0; i < t.ts_input.size(); ++i) {
+    for (std::size_t j = 0; j < t.ts_output.size(); ++j) {
+      t.matches.push_back(Match{.ix_input = i, .ix_output = j});
+    }
+  }
+  return t;
+}
+
+}  // namespace
+
+TEST(TestConditionFunction, TestSingleConditionsMatchPerRowEvaluation) {
+  GWT::given([]() { return make_tables(); })
+      .when([](auto&& t) {
+        auto mismatches = 0uz;
+        for (Int category = -1; category < 6; ++category) {
+          mismatches += count_mismatch(t, {categorical(t, category)},
+                                       {expected_categorical(t, category)});
+        }
+        for (std::size_t k = 0; k < 10; ++k) {
+          auto const lower = 0.1 * static_cast<Float>(k);
+          auto const upper = 0.1 * static_cast<Float>(k + 1);
+          mismatches += count_mismatch(t, {lag(t, lower, upper)},
+                                       {expected_lag(t, lower, upper)});
+        }
+        mismatches +=
+            count_mismatch(t, {same_units(t)}, {expected_same_units(t)});
+        return mismatches;
+      })
+      .then([](auto&& mismatches) { EXPECT_EQ(0uz, mismatches); });
+}
+
+TEST(TestConditionFunction, TestChainedConditionsMatchPerRowEvaluation) {
+  GWT::given([]() { return make_tables(); })
+      .when([](auto&& t) {
+        auto const selected =
+            select(t, {categorical(t, 3), lag(t, 0.0, 1.5), same_units(t)});
+        auto const expected = expected_selection(
+            t, {expected_categorical(t, 3), expected_lag(t, 0.0, 1.5),
+                expected_same_units(t)});
+        return std::make_pair(to_pairs(selected), to_pairs(expected));
+      })
+      .then([](auto&& result) {
+        EXPECT_FALSE(result.second.empty());
+        EXPECT_EQ(result.second, result.first);
+      });
+}
+
+TEST(TestConditionFunction, TestLagBoundariesAndNaN) {
+  GWT::given([]() {
+    auto t = Tables();
+    t.ts_output = {10.0, std::numeric_limits<Float>::quiet_NaN()};
+    t.ts_input = {9.0, 8.0, 10.0, 7.0};
+    for (std::size_t i = 0; i < t.ts_input.size(); ++i) {
+      t.matches.push_back(Match{.ix_input = i, .ix_output = 0});
+      t.matches.push_back(Match{.ix_input = i, .ix_output = 1});
+    }
+    return t;
+  })
+      .when([](auto&& t) { return to_pairs(select(t, {lag(t, 1.0, 2.0)})); })
+      .then([](auto&& selected) {
+        // The lower bound is inclusive, the upper bound is not, and NaN
+        // never passes.
+        EXPECT_EQ((std::vector<std::pair<std::size_t, std::size_t>>{{0, 0}}),
+                  selected);
+      });
+}
+
+TEST(TestConditionFunction, TestTrivialAndEmpty) {
+  GWT::given([]() {
+    auto t = make_tables();
+    t.matches.resize(10);
+    return t;
+  })
+      .when([](auto&& t) {
+        auto const trivial = select(t, {});
+        auto empty_tables = t;
+        empty_tables.matches.clear();
+        auto const empty = select(empty_tables, {categorical(t, 1)});
+        return std::make_tuple(ConditionFunction({}).is_trivial(),
+                               to_pairs(trivial), to_pairs(t.matches),
+                               empty.size());
+      })
+      .then([](auto&& result) {
+        auto const& [is_trivial, trivial, matches, num_empty] = result;
+        EXPECT_TRUE(is_trivial);
+        EXPECT_EQ(matches, trivial);
+        EXPECT_EQ(0uz, num_empty);
+      });
+}
@@ -0,0 +1,215 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "fastprop/Float.hpp"
+#include "fastprop/algorithm/LagBuckets.hpp"
+#include "fastprop/containers/Match.hpp"
+#include "gwt.h"
+
+namespace {
+
+using fastprop::Float;
+using fastprop::algorithm::LagBuckets;
+using fastprop::containers::Match;
+
+struct TimeStamps {
+  std::vector<Float> ts_output;
+  std::vector<Float> ts_input;
+  std::vector<Match> matches;
+};
+
+auto to_pairs(std::vector<Match> const& matches) {
+  auto pairs = std::vector<std::pair<std::size_t, std::size_t>>();
+  for (auto const& m : matches) {
+    pairs.emplace_back(m.ix_input, m.ix_output);
+  }
+  return pairs;
+}
+
+/// The lag condition as it is evaluated for every single match, with the
+/// same bounds FastProp generates.
+auto expected_bucket(TimeStamps const& data, Float const delta_t,
+                     std::size_t const k) {
+  auto const lower = delta_t * static_cast<Float>(k);
+  auto const upper = delta_t * static_cast<Float>(k + 1);
+  auto expected = std::vector<Match>();
+  for (auto const& m : data.matches) {
+    auto const ts_input = data.ts_input[m.ix_input];
+    auto const ts_output = data.ts_output[m.ix_output];
+    if (ts_input + upper > ts_output && ts_input + lower <= ts_output) {
+      expected.push_back(m);
+    }
+  }
+  return expected;
+}
+
+/// Every input row is matched to a single output row, so that the time
+/// stamps differ by exactly the given values.
+auto make_time_stamps(Float const ts_output, std::vector<Float> const& diffs) {
+  auto data = TimeStamps();
+  data.ts_output.push_back(ts_output);
+  for (std::size_t i = 0; i < diffs.size(); ++i) {
+    data.ts_input.push_back(ts_output - diffs[i]);
+    data.matches.push_back(Match{.ix_input = i, .ix_output = 0});
+  }
+  return data;
+}
+
+auto count_mismatches(TimeStamps const& data, Float const delta_t,
+                      std::size_t const max_lag) {
+  auto buckets = LagBuckets(delta_t, max_lag);
+  buckets.partition(data.ts_output.data(), data.ts_input.data(),
+                    data.matches);
+  auto mismatches = 0uz;
+  for (std::size_t k = 0; k < max_lag; ++k) {
+    if (to_pairs(buckets.bucket(k)) !=
+        to_pairs(expected_bucket(data, delta_t, k))) {
+      ++mismatches;
+    }
+  }
+  return mismatches;
+}
+
+auto bucket_sizes(TimeStamps const& data, Float const delta_t,
+                  std::size_t const max_lag) {
+  auto buckets = LagBuckets(delta_t, max_lag);
+  buckets.partition(data.ts_output.data(), data.ts_input.data(),
+                    data.matches);
+  auto sizes = std::vector<std::size_t>();
+  for (std::size_t k = 0; k < max_lag; ++k) {
+    sizes.push_back(buckets.bucket(k).size());
+  }
+  return sizes;
+}
+
+}  // namespace
+
+TEST(TestLagBuckets, TestExactBoundariesMatchPerRowEvaluation) {
+  GWT::given([]() {
+    auto diffs = std::vector<Float>();
+    for (std::size_t k = 0; k <= 10; ++k) {
+      auto const boundary = 0.1 * static_cast<Float>(k);
+      diffs.push_back(boundary);
+      diffs.push_back(std::nextafter(boundary, -1.0));
+      diffs.push_back(std::nextafter(boundary, 2.0));
+      diffs.push_back(static_cast<Float>(k) / 10.0);
+    }
+    return diffs;
+  })
+      .when([](auto&& diffs) {
+        auto mismatches = std::vector<std::size_t>();
+        for (auto const ts_output : {0.0, 3.7, 1.7e9, -2.5e4}) {
+          mismatches.push_back(
+              count_mismatches(make_time_stamps(ts_output, diffs), 0.1, 10));
+        }
+        return mismatches;
+      })
+      .then([](auto&& mismatches) {
+        EXPECT_EQ((std::vector<std::size_t>{0, 0, 0, 0}), mismatches);
+      });
+}
+
+TEST(TestLagBuckets, TestHorizonBoundary) {
+  GWT::given([]() {
+    return make_time_stamps(100.0, {0.0, 1.0, 2.0, 2.5, 3.0, 4.0, -1.0});
+  })
+      .when([](auto&& data) {
+        return std::make_pair(bucket_sizes(data, 1.0, 3),
+                              count_mismatches(data, 1.0, 3));
+      })
+      .then([](auto&& result) {
+        // A difference of exactly delta_t * max_lag is outside of the
+        // last lag, just like negative differences.
+        EXPECT_EQ((std::vector<std::size_t>{1, 1, 2}), result.first);
+        EXPECT_EQ(0uz, result.second);
+      });
+}
+
+TEST(TestLagBuckets, TestNaNTimeStampsAreDropped) {
+  GWT::given([]() {
+    auto const nan = std::numeric_limits<Float>::quiet_NaN();
+    auto data = make_time_stamps(10.0, {0.5, 1.5, 2.5});
+    data.ts_input[1] = nan;
+    data.ts_output.push_back(nan);
+    data.matches.push_back(Match{.ix_input = 0, .ix_output = 1});
+    return data;
+  })
+      .when([](auto&& data) {
+        return std::make_pair(bucket_sizes(data, 1.0, 3),
+                              count_mismatches(data, 1.0, 3));
+      })
+      .then([](auto&& result) {
+        EXPECT_EQ((std::vector<std::size_t>{1, 0, 1}), result.first);
+        EXPECT_EQ(0uz, result.second);
+      });
+}
+
+TEST(TestLagBuckets, TestManyMatchesMatchPerRowEvaluation) {
+  GWT::given([]() {
+    auto data = TimeStamps();
+    for (std::size_t i = 0; i < 50; ++i) {
+      data.ts_output.push_back(1.6e9 + static_cast<Float>((i * 7919) % 613) *
+                                           0.05);
+    }
+    for (std::size_t i = 0; i < 200; ++i) {
+      data.ts_input.push_back(1.6e9 + static_cast<Float>((i * 104729) % 577) *
+                                          0.05);
+    }
+    for (std::size_t i = 0; i < data.ts_input.size(); ++i) {
+      for (std::size_t j = 0; j < data.ts_output.size(); ++j) {
+        data.matches.push_back(Match{.ix_input = i, .ix_output = j});
+      }
+    }
+    return data;
+  })
+      .when([](auto&& data) {
+        return count_mismatches(data, 0.15, 40) +
+               count_mismatches(data, 1.0, 7) + count_mismatches(data, 0.1, 1);
+      })
+      .then([](auto&& mismatches) { EXPECT_EQ(0uz, mismatches); });
+}
+
+TEST(TestLagBuckets, TestEmptyMatches) {
+  GWT::given([]() { return LagBuckets(1.0, 3); })
+      .when([](auto&& buckets) {
+        buckets.partition(nullptr, nullptr, std::vector<Match>());
+        auto sizes = std::vector<std::size_t>();
+        for (std::size_t k = 0; k < 3; ++k) {
+          sizes.push_back(buckets.bucket(k).size());
+        }
+        return sizes;
+      })
+      .then([](auto&& sizes) {
+        EXPECT_EQ((std::vector<std::size_t>{0, 0, 0}), sizes);
+      });
+}
+
+TEST(TestLagBuckets, TestFindBucket) {
+  GWT::given([]() { return LagBuckets(0.1, 10); })
+      .when([](auto&& buckets) {
+        auto found = std::vector<std::size_t>();
+        for (std::size_t k = 0; k < 10; ++k) {
+          auto const bucket = buckets.find_bucket(
+              0.1 * static_cast<Float>(k), 0.1 * static_cast<Float>(k + 1));
+          found.push_back(bucket ? *bucket : 99);
+        }
+        auto const horizon = buckets.find_bucket(1.0, 1.1);
+        auto const negative = buckets.find_bucket(-0.1, 0.0);
+        auto const misaligned = buckets.find_bucket(0.1, 0.25);
+        return std::make_tuple(found, horizon, negative, misaligned);
+      })
+      .then([](auto&& result) {
+        auto const& [found, horizon, negative, misaligned] = result;
+        EXPECT_EQ((std::vector<std::size_t>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}),
+                  found);
+        EXPECT_FALSE(horizon);
+        EXPECT_FALSE(negative);
+        EXPECT_FALSE(misaligned);
+      });
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <vector>
+
+#include "gwt.h"
+#include "helpers/InMemoryIndex.hpp"
+#include "helpers/Int.hpp"
+
+namespace {
+
+auto rownums(helpers::InMemoryIndex const& index, helpers::Int const key) {
+  auto const [begin, end] = index.find(key);
+  return std::vector<std::size_t>(begin, end);
+}
+
+auto expected_rownums(std::vector<helpers::Int> const& keys,
+                      std::size_t const nrows) {
+  auto expected = std::map<helpers::Int, std::vector<std::size_t>>();
+  for (std::size_t i = 0; i < nrows; ++i) {
+    if (keys[i] >= 0) {
+      expected[keys[i]].push_back(i);
+    }
+  }
+  return expected;
+}
+
+}  // namespace
+
+TEST(TestInMemoryIndex, TestFindReturnsSortedRownums) {
+  GWT::given([]() {
+    return std::vector<helpers::Int>{7, 3, -1, 7, 10000000, 3, 7};
+  })
+      .when([](auto&& keys) {
+        auto index = helpers::InMemoryIndex();
+        index.append(keys.data(), keys.size());
+        return std::make_tuple(rownums(index, 7), rownums(index, 3),
+                               rownums(index, 10000000), rownums(index, -1),
+                               rownums(index, 5), index.nrows());
+      })
+      .then([](auto&& result) {
+        auto const& [seven, three, large, null, missing, nrows] = result;
+        EXPECT_EQ((std::vector<std::size_t>{0, 3, 6}), seven);
+        EXPECT_EQ((std::vector<std::size_t>{1, 5}), three);
+        EXPECT_EQ((std::vector<std::size_t>{4}), large);
+        EXPECT_TRUE(null.empty());
+        EXPECT_TRUE(missing.empty());
+        EXPECT_EQ(7uz, nrows);
+      });
+}
+
+TEST(TestInMemoryIndex, TestManySmallAppends) {
+  GWT::given([]() {
+    auto keys = std::vector<helpers::Int>();
+    for (helpers::Int i = 0; i < 20000; ++i) {
+      keys.push_back(i % 7 == 0 ? -1 : (i * 7919) % 1013);
+    }
+    return keys;
+  })
+      .when([](auto&& keys) {
+        auto index = helpers::InMemoryIndex();
+        auto mismatches = 0uz;
+        for (std::size_t nrows = 1; nrows <= keys.size();
+             nrows += 1 + nrows / 1000) {
+          index.append(keys.data(), nrows);
+          if (nrows % 97 != 0) {
+            continue;
+          }
+          for (auto const& [key, expected] : expected_rownums(keys, nrows)) {
+            if (rownums(index, key) != expected) {
+              ++mismatches;
+            }
+          }
+        }
+        index.append(keys.data(), keys.size());
+        auto final_mismatches = 0uz;
+        for (auto const& [key, expected] :
+             expected_rownums(keys, keys.size())) {
+          if (rownums(index, key) != expected) {
+            ++final_mismatches;
+          }
+        }
+        return std::make_pair(mismatches, final_mismatches);
+      })
+      .then([](auto&& result) {
+        EXPECT_EQ(0uz, result.first);
+        EXPECT_EQ(0uz, result.second);
+      });
+}
+
+TEST(TestInMemoryIndex, TestClear) {
+  GWT::given([]() { return std::vector<helpers::Int>{1, 2, 1}; })
+      .when([](auto&& keys) {
+        auto index = helpers::InMemoryIndex();
+        index.append(keys.data(), keys.size());
+        index.clear();
+        return std::make_pair(rownums(index, 1), index.nrows());
+      })
+      .then([](auto&& result) {
+        EXPECT_TRUE(result.first.empty());
+        EXPECT_EQ(0uz, result.second);
+      });
+}
@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "gwt.h"
+#include "io/TimeStampParser.hpp"
+
+using namespace std::literals::string_literals;
+
+TEST(TestTimeStampParser, TestParseCompiledFormats) {
+  GWT::given(io::TimeStampParser(std::vector<std::string>(
+                 {"%Y-%m-%dT%H:%M:%s%z", "%Y-%m-%d %H:%M:%S", "%Y-%m-%d"})))
+      .when([](auto const&& parser) {
+        return std::vector<std::pair<double, bool>>(
+            {parser.parse(" 2020-02-29 23:59:59 "),
+             parser.parse("2000-01-01T00:00:00.500000Z"),
+             parser.parse("1969-12-31"), parser.parse("2019-02-29"),
+             parser.parse("2020-01-01 1:00:00")});
+      })
+      .then([](auto const&& results) {
+        EXPECT_TRUE(results.at(0).second);
+        EXPECT_DOUBLE_EQ(1583020799.0, results.at(0).first);
+        EXPECT_TRUE(results.at(1).second);
+        EXPECT_DOUBLE_EQ(946684800.5, results.at(1).first);
+        EXPECT_TRUE(results.at(2).second);
+        EXPECT_DOUBLE_EQ(-86400.0, results.at(2).first);
+        EXPECT_FALSE(results.at(3).second);
+        EXPECT_FALSE(results.at(4).second);
+      });
+}
+
+TEST(TestTimeStampParser, TestFirstMatchingFormatWins) {
+  GWT::given(io::TimeStampParser(
+                 std::vector<std::string>({"%Y-%d-%m", "%Y-%m-%d"})))
+      .when([](auto const&& parser) { return parser.parse("2020-02-01"s); })
+      .then([](auto const&& result) {
+        EXPECT_TRUE(result.second);
+        EXPECT_DOUBLE_EQ(1577923200.0, result.first);
+      });
+}
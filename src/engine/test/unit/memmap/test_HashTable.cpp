@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "gwt.h"
+#include "memmap/HashTable.hpp"
+#include "memmap/Pool.hpp"
+
+namespace {
+
+auto make_pool() {
+  return std::make_shared<memmap::Pool>(
+      (std::filesystem::temp_directory_path() / "getml_test_memmap")
+          .string());
+}
+
+using Entry = std::pair<std::size_t, std::size_t>;
+
+auto is_key(std::size_t const key) {
+  return [key](Entry const& entry) { return entry.first == key; };
+}
+
+}  // namespace
+
+TEST(TestHashTable, TestFindAfterGrowing) {
+  GWT::given([]() {
+    auto table = memmap::HashTable<Entry>(make_pool());
+    for (std::size_t key = 0; key < 1000; ++key) {
+      table.insert(key, Entry{key, key * 2});
+    }
+    return table;
+  })
+      .when([](auto&& table) {
+        std::vector<std::size_t> values;
+        for (std::size_t key = 0; key < 1000; ++key) {
+          auto const slot = table.find(key, is_key(key));
+          values.push_back(slot ? table.value(*slot).second : 0);
+        }
+        return std::make_pair(table.size(), values);
+      })
+      .then([](auto&& result) {
+        auto const& [size, values] = result;
+        EXPECT_EQ(1000uz, size);
+        for (std::size_t key = 0; key < 1000; ++key) {
+          EXPECT_EQ(key * 2, values[key]);
+        }
+      });
+}
+
+TEST(TestHashTable, TestCollidingHashesAreResolvedByMatch) {
+  GWT::given([]() {
+    auto table = memmap::HashTable<Entry>(make_pool());
+    for (std::size_t key = 0; key < 100; ++key) {
+      table.insert(42, Entry{key, key + 1});
+    }
+    return table;
+  })
+      .when([](auto&& table) {
+        auto const found = table.find(42, is_key(57));
+        auto const missing = table.find(42, is_key(100));
+        auto const other_hash = table.find(43, is_key(57));
+        return std::make_tuple(table.value(*found).second, missing.has_value(),
+                               other_hash.has_value());
+      })
+      .then([](auto&& result) {
+        auto const& [value, has_missing, has_other_hash] = result;
+        EXPECT_EQ(58uz, value);
+        EXPECT_FALSE(has_missing);
+        EXPECT_FALSE(has_other_hash);
+      });
+}
+
+TEST(TestHashTable, TestSetValueAndForEach) {
+  GWT::given([]() {
+    auto table = memmap::HashTable<Entry>(make_pool(), 10);
+    for (std::size_t key = 0; key < 10; ++key) {
+      table.insert(key, Entry{key, 0});
+    }
+    return table;
+  })
+      .when([](auto&& table) {
+        auto const slot = table.find(3, is_key(3));
+        table.set_value(*slot, Entry{3, 30});
+        std::size_t sum = 0;
+        std::size_t count = 0;
+        table.for_each([&sum, &count](Entry const& entry) {
+          sum += entry.second;
+          ++count;
+        });
+        return std::make_pair(sum, count);
+      })
+      .then([](auto&& result) {
+        EXPECT_EQ(30uz, result.first);
+        EXPECT_EQ(10uz, result.second);
+      });
+}
+
+TEST(TestHashTable, TestSaveAndLoad) {
+  auto const fname =
+      (std::filesystem::temp_directory_path() / "getml_test_hash_table.bin")
+          .string();
+
+  GWT::given([fname]() {
+    auto table = memmap::HashTable<std::size_t>(make_pool());
+    for (std::size_t key = 0; key < 1000; ++key) {
+      table.insert(key, key * 3);
+    }
+    table.save(fname);
+    return fname;
+  })
+      .when([](auto&& fname) {
+        auto const loaded =
+            memmap::HashTable<std::size_t>::load(make_pool(), fname);
+        std::vector<std::size_t> values;
+        for (std::size_t key = 0; loaded && key < 1000; ++key) {
+          auto const slot = loaded->find(
+              key, [key](std::size_t const value) { return value == key * 3; });
+          values.push_back(slot ? loaded->value(*slot) : 0);
+        }
+        auto const missing = memmap::HashTable<std::size_t>::load(
+            make_pool(), fname + ".does_not_exist");
+        return std::make_tuple(loaded ? loaded->size() : 0uz, values,
+                               missing.has_value());
+      })
+      .then([](auto&& result) {
+        auto const& [size, values, has_missing] = result;
+        EXPECT_EQ(1000uz, size);
+        ASSERT_EQ(1000uz, values.size());
+        for (std::size_t key = 0; key < 1000; ++key) {
+          EXPECT_EQ(key * 3, values[key]);
+        }
+        EXPECT_FALSE(has_missing);
+      });
+
+  std::filesystem::remove(fname);
+}
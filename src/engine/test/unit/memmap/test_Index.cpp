@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include "containers/Int.hpp"
+#include "gwt.h"
+#include "memmap/Index.hpp"
+#include "memmap/Pool.hpp"
+
+namespace {
+
+auto make_pool() {
+  return std::make_shared<memmap::Pool>(
+      (std::filesystem::temp_directory_path() / "getml_test_memmap")
+          .string());
+}
+
+auto rownums(memmap::Index<containers::Int> const& index,
+             containers::Int const key) {
+  auto const [begin, end] = index.find(key);
+  return std::vector<std::size_t>(begin, end);
+}
+
+}  // namespace
+
+TEST(TestIndex, TestFindReturnsSortedRownums) {
+  GWT::given([]() {
+    return std::vector<containers::Int>{7, 3, -1, 7, 1000000, 3, 7};
+  })
+      .when([](auto&& keys) {
+        auto index = memmap::Index<containers::Int>(make_pool());
+        index.append(keys, keys.size());
+        return std::make_tuple(rownums(index, 7), rownums(index, 3),
+                               rownums(index, 1000000), rownums(index, -1),
+                               rownums(index, 5), index.nrows());
+      })
+      .then([](auto&& result) {
+        auto const& [seven, three, large, null, missing, nrows] = result;
+        EXPECT_EQ((std::vector<std::size_t>{0, 3, 6}), seven);
+        EXPECT_EQ((std::vector<std::size_t>{1, 5}), three);
+        EXPECT_EQ((std::vector<std::size_t>{4}), large);
+        EXPECT_TRUE(null.empty());
+        EXPECT_TRUE(missing.empty());
+        EXPECT_EQ(7uz, nrows);
+      });
+}
+
+TEST(TestIndex, TestAppendInSeveralSteps) {
+  GWT::given([]() {
+    auto keys = std::vector<containers::Int>();
+    for (containers::Int i = 0; i < 10000; ++i) {
+      keys.push_back(i % 13);
+    }
+    return keys;
+  })
+      .when([](auto&& keys) {
+        auto index = memmap::Index<containers::Int>(make_pool());
+        index.append(keys, 5000);
+        index.append(keys, 5001);
+        index.append(keys, keys.size());
+        return rownums(index, 4);
+      })
+      .then([](auto&& result) {
+        auto expected = std::vector<std::size_t>();
+        for (std::size_t i = 4; i < 10000; i += 13) {
+          expected.push_back(i);
+        }
+        EXPECT_EQ(expected, result);
+      });
+}
+
+TEST(TestIndex, TestClear) {
+  GWT::given([]() { return std::vector<containers::Int>{1, 2, 1}; })
+      .when([](auto&& keys) {
+        auto index = memmap::Index<containers::Int>(make_pool());
+        index.append(keys, keys.size());
+        index.clear();
+        return std::make_pair(rownums(index, 1), index.nrows());
+      })
+      .then([](auto&& result) {
+        EXPECT_TRUE(result.first.empty());
+        EXPECT_EQ(0uz, result.second);
+      });
+}
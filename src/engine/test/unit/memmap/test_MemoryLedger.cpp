@@ -0,0 +1,31 @@
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "gwt.h"
+#include "memmap/MemoryLedger.hpp"
+
+TEST(TestMemoryLedger, TestOverflowDirOnlyOnceTheBudgetIsExceeded) {
+  GWT::given([]() { return std::string("/tmp/getml_test_overflow/"); })
+      .when([](auto&& dir) {
+        auto unlimited = memmap::MemoryLedger();
+        unlimited.set_budget(0, dir);
+        auto exceeded = memmap::MemoryLedger();
+        exceeded.set_budget(1, dir);
+        return std::make_pair(unlimited.overflow_dir(),
+                              exceeded.overflow_dir());
+      })
+      .then([](auto&& result) {
+        EXPECT_EQ(std::nullopt, result.first);
+        EXPECT_EQ(std::make_optional<std::string>("/tmp/getml_test_overflow/"),
+                  result.second);
+      });
+}
+
+TEST(TestMemoryLedger, TestUnsetBudgetNeverOverflows) {
+  GWT::given([]() { return memmap::MemoryLedger(); })
+      .when([](auto&& ledger) { return ledger.overflow_dir(); })
+      .then([](auto&& result) { EXPECT_EQ(std::nullopt, result); });
+}
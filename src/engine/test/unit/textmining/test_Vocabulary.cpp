@@ -72,4 +72,8 @@ INSTANTIATE_TEST_SUITE_P(
                     make_parameter(3uz, 2uz,
                                    {"1"s, "2"s, "3"s, "4"s, "1"s, "2"s, "3"s,
                                     "1"s, "2"s, "1"s},
-                                   {"1"s, "2"s})));
+                                   {"1"s, "2"s}),
+                    make_parameter(2uz, 0uz,
+                                   {"Hello, world!"s, "hello hello"s,
+                                    "WORLD (peace)"s},
+                                   {"hello"s, "world"s})));
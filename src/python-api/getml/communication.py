@@ -821,6 +821,37 @@ def _list_projects_impl(running_only: bool) -> List[str]:
 # --------------------------------------------------------------------
 
 
+def _get_trace(clear: bool) -> Dict[str, Any]:
+    cmd: Dict[str, Any] = {}
+
+    cmd["type_"] = "get_trace"
+    cmd["clear_"] = clear
+
+    with send_and_get_socket(cmd) as sock:
+        msg = recv_string(sock)
+        if msg != "Success!":
+            handle_engine_exception(msg)
+        return json.loads(recv_string(sock))
+
+
+# --------------------------------------------------------------------
+
+
+def _memory_usage() -> Dict[str, Any]:
+    cmd: Dict[str, Any] = {}
+
+    cmd["type_"] = "memory_usage"
+
+    with send_and_get_socket(cmd) as sock:
+        msg = recv_string(sock)
+        if msg != "Success!":
+            handle_engine_exception(msg)
+        return json.loads(recv_string(sock))
+
+
+# --------------------------------------------------------------------
+
+
 def _monitor_url() -> Optional[str]:
     cmd: Dict[str, str] = {}
 
@@ -27,6 +27,7 @@ from typing import (
     List,
     Literal,
     Optional,
+    Tuple,
     Union,
     cast,
     overload,
@@ -1662,6 +1663,7 @@ class DataFrame:
         ignore: bool = False,
         dry: Literal[False] = False,
         colnames: Iterable[str] = (),
+        filters: Optional[Dict[str, Tuple[Optional[float], Optional[float]]]] = None,
     ) -> DataFrame: ...
 
     @overload
@@ -1674,6 +1676,7 @@ class DataFrame:
         ignore: bool = False,
         dry: Literal[True] = True,
         colnames: Iterable[str] = (),
+        filters: Optional[Dict[str, Tuple[Optional[float], Optional[float]]]] = None,
     ) -> Roles: ...
 
     @classmethod
@@ -1685,6 +1688,7 @@ class DataFrame:
         ignore: bool = False,
         dry: bool = False,
         colnames: Iterable[str] = (),
+        filters: Optional[Dict[str, Tuple[Optional[float], Optional[float]]]] = None,
     ) -> Union[DataFrame, Roles]:
         """Create a DataFrame from parquet files.
 
@@ -1719,6 +1723,14 @@ class DataFrame:
                 If set to True, the data will not be read. Instead, the method
                 will return the inferred roles.
 
+            colnames:
+                The columns to be read. If empty, all columns are read.
+
+            filters:
+                Maps numerical column names to a range `(min, max)`. Only rows
+                for which `min <= value <= max` are kept, either bound may be
+                None. See [`read_parquet`][getml.DataFrame.read_parquet].
+
         Returns:
             Handler of the underlying data.
         """
@@ -1752,7 +1764,9 @@ class DataFrame:
 
         data_frame = cls(name, roles)
 
-        return data_frame.read_parquet(fnames=fnames, append=False, colnames=colnames)
+        return data_frame.read_parquet(
+            fnames=fnames, append=False, colnames=colnames, filters=filters
+        )
 
     # --------------------------------------------------------------------
 
@@ -2807,6 +2821,7 @@ class DataFrame:
         append: bool = False,
         verbose: bool = False,
         colnames: Iterable[str] = (),
+        filters: Optional[Dict[str, Tuple[Optional[float], Optional[float]]]] = None,
     ) -> DataFrame:
         """Read a parquet file.
 
@@ -2824,6 +2839,25 @@ class DataFrame:
                 If True, when `fnames` are urls, the filenames are printed to
                 stdout during the download.
 
+            colnames:
+                The columns to be read. If empty, all columns are read.
+
+            filters:
+                Maps numerical column names to a range `(min, max)`. Only rows
+                for which `min <= value <= max` are kept, either bound may be
+                None. Rows in which a filtered column is NULL are dropped.
+
+                When filters are passed, the files are read by the getML
+                Engine rather than sent from Python, so they must be
+                accessible from the Engine's file system. Row groups whose
+                statistics show that none of their rows can pass the
+                filters are skipped without being read. The filtered
+                columns must be contained in `colnames`.
+
+                ```python
+                df.read_parquet("sales.parquet", filters={"price": (10.0, None)})
+                ```
+
         Returns:
             Handler of the underlying data.
         """
@@ -2834,6 +2868,9 @@ class DataFrame:
         if not isinstance(append, bool):
             raise TypeError("'append' must be bool.")
 
+        if filters is not None and not isinstance(filters, dict):
+            raise TypeError("'filters' must be a dict or None.")
+
         if not colnames:
             colnames = self.colnames
 
@@ -2847,6 +2884,13 @@ class DataFrame:
 
         fnames = _retrieve_urls(fnames, verbose)
 
+        if filters:
+            colnames = list(colnames)
+            for fname in fnames:
+                self._read_parquet_on_engine(fname, append, colnames, filters)
+                append = True
+            return self
+
         readers = (pq.ParquetFile(fname) for fname in fnames)
 
         for reader in readers:
@@ -2869,6 +2913,61 @@ class DataFrame:
 
     # --------------------------------------------------------------------------
 
+    def _read_parquet_on_engine(
+        self,
+        fname: str,
+        append: bool,
+        colnames: Iterable[str],
+        filters: Dict[str, Tuple[Optional[float], Optional[float]]],
+    ) -> None:
+        for colname, bounds in filters.items():
+            if not isinstance(colname, str):
+                raise TypeError("The keys of 'filters' must be str.")
+            if not isinstance(bounds, tuple) or len(bounds) != 2:
+                raise TypeError(
+                    "The values of 'filters' must be tuples of the form (min, max)."
+                )
+            if not all(b is None or isinstance(b, numbers.Real) for b in bounds):
+                raise TypeError("The bounds in 'filters' must be real numbers or None.")
+
+        selected = set(colnames)
+
+        not_in_colnames = [colname for colname in filters if colname not in selected]
+
+        if not_in_colnames:
+            raise ValueError(
+                f"The columns in 'filters' must also be read, but {not_in_colnames} "
+                "are not contained in 'colnames'."
+            )
+
+        def project(names: List[str]) -> List[str]:
+            return [name for name in names if name in selected]
+
+        cmd: Dict[str, Any] = {}
+
+        cmd["type_"] = "DataFrame.read_parquet"
+        cmd["name_"] = self.name
+
+        cmd["append_"] = append
+        cmd["fname_"] = os.path.abspath(fname)
+        cmd["filters_"] = [
+            {"column_": colname, "min_": bounds[0], "max_": bounds[1]}
+            for colname, bounds in filters.items()
+        ]
+
+        cmd["categorical_"] = project(self._categorical_names)
+        cmd["join_keys_"] = project(self._join_key_names)
+        cmd["numerical_"] = project(self._numerical_names)
+        cmd["targets_"] = project(self._target_names)
+        cmd["text_"] = project(self._text_names)
+        cmd["time_stamps_"] = project(self._time_stamp_names)
+        cmd["unused_floats_"] = project(self._unused_float_names)
+        cmd["unused_strings_"] = project(self._unused_string_names)
+
+        comm.send(cmd)
+
+    # --------------------------------------------------------------------------
+
     def read_s3(
         self,
         bucket: str,
@@ -71,9 +71,11 @@ from getml.communication import is_engine_alive, is_monitor_alive
 from ._launch import EXECUTABLE_NAME, Edition, launch
 from .helpers import (
     delete_project,
+    get_trace,
     is_alive,
     list_projects,
     list_running_projects,
+    memory_usage,
     set_project,
     shutdown,
     suspend_project,
@@ -83,12 +85,14 @@ __all__ = (
     "delete_project",
     "EXECUTABLE_NAME",
     "Edition",
+    "get_trace",
     "is_alive",
     "is_engine_alive",
     "is_monitor_alive",
     "launch",
     "list_projects",
     "list_running_projects",
+    "memory_usage",
     "set_project",
     "shutdown",
     "suspend_project",
@@ -12,12 +12,14 @@ Contains various helper functions related to the getML Engine.
 
 import json
 import socket
-from typing import Dict, List
+from typing import Any, Dict, List
 
 import getml.communication as comm
 from getml.communication import (
     _delete_project,
+    _get_trace,
     _list_projects_impl,
+    _memory_usage,
     _set_project,
     _shutdown,
     _suspend_project,
@@ -47,6 +49,28 @@ def delete_project(name: str):
 # -----------------------------------------------------------------------------
 
 
+def get_trace(clear: bool = False) -> Dict[str, Any]:
+    """Returns the timings the getML Engine has recorded for its major stages.
+
+    The result is in the Chrome trace format, so it can be dumped to a file
+    using `json.dump` and loaded into chrome://tracing or Perfetto. In
+    addition, `"stages"` contains aggregate statistics per stage and
+    `"counters"` contains counters such as the number of bytes sent over
+    the socket.
+
+    Args:
+        clear:
+            Whether to remove all recorded events after retrieving them.
+
+    Returns:
+        The trace of the getML Engine.
+    """
+    return _get_trace(clear)
+
+
+# -----------------------------------------------------------------------------
+
+
 def list_projects() -> List[str]:
     """
     List all projects on the getML Engine.
@@ -73,6 +97,30 @@ def list_running_projects() -> List[str]:
 # -----------------------------------------------------------------------------
 
 
+def memory_usage() -> Dict[str, Any]:
+    """Returns how much memory the getML Engine currently uses.
+
+    The result contains the resident memory of the Engine excluding
+    memory-mapped files (`"resident"`), the size of all memory-mapped pools
+    on disk (`"memory_mapped"`), the memory budget the Engine was launched
+    with (`"budget"`, 0 meaning no limit), the number of entries in the
+    encodings and the size of every data frame in bytes. All sizes are in
+    bytes.
+
+    When the Engine was launched with `--memory-budget=<MB>` and its resident
+    memory exceeds the budget, new data is memory-mapped and existing data
+    frames are moved to memory mapping, starting with the ones that have not
+    been changed for the longest time.
+
+    Returns:
+        The memory usage of the getML Engine.
+    """
+    return _memory_usage()
+
+
+# -----------------------------------------------------------------------------
+
+
 def set_project(name: str):
     """Creates a new project or loads an existing one.
 